@@ -0,0 +1,14 @@
+#pragma once
+#include <Arduino.h>
+
+// Time source for pet and UI logic (care decay, sub-state timers, game,
+// menus, display state machines, scheduler): millis(). Host runs get
+// virtual time from lib/bubu_native, whose millis() only moves in delay()
+// and NativeHost::advanceMs(), so a simulation can fast-forward days of pet
+// life. Diagnostics (logger, flight recorder, heap telemetry), Wi-Fi and
+// OTA read millis() directly.
+namespace BubuClock {
+
+  inline uint32_t nowMs() { return millis(); }
+
+}
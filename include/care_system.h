@@ -33,6 +33,10 @@ namespace CareSystem {
   int getEnergy();
   int getCleanliness();
 
+  // Bumped whenever any stat changes (decay tick, care action, load), so
+  // consumers can cache what they derive from the stats.
+  uint32_t version();
+
   bool needsAttention();   // any stat in [20..39]
   bool isCritical();       // any stat == 0
 }
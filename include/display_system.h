@@ -33,3 +33,21 @@ bool DisplaySystem_isHatching();
 
 // Notify display system of user interaction (touch/gesture) for idle visual logic
 void DisplaySystem_notifyUserInteraction(uint32_t nowMs);
+
+#ifdef BUBU_FRAME_SCENES
+#include <time.h>
+// Scripted states for the golden-frame harness (src/native/golden_frames.cpp).
+// sceneReset() returns to neutral eyes with no overlay or menu and reseeds
+// random(); the other calls set up one state as of the current BubuClock
+// time, and sceneRender() draws it and pushes the whole screen to the panel
+// without advancing any animation.
+void DisplaySystem_sceneReset(unsigned long seed);
+void DisplaySystem_sceneEmotion(EyeEmotion emotion);
+void DisplaySystem_sceneBlink(uint32_t msIntoBlink, bool left, bool right);
+void DisplaySystem_scenePop(uint8_t frame);
+void DisplaySystem_sceneHatch(uint8_t phase, uint32_t msIntoPhase);
+void DisplaySystem_sceneRain(uint32_t msIntoClean);
+void DisplaySystem_sceneSleep(uint32_t msIntoSleep);
+void DisplaySystem_sceneClock(time_t epoch);
+void DisplaySystem_sceneRender();
+#endif
@@ -0,0 +1,118 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+// Typed publish/subscribe between subsystems.
+// Each event is a small trivially-copyable struct with a compile-time ID.
+// publish() copies it into a fixed ring (no allocation, a short critical
+// section, safe from any task); dispatch() runs in the loop task and hands
+// each queued event to the subscribers whose filter contains its ID, in
+// subscription order. A full ring drops the new event and counts it.
+// Handlers may publish; those events are delivered in the same dispatch().
+namespace EventBus {
+
+  static constexpr size_t QUEUE_CAPACITY = 32;
+  static constexpr size_t MAX_SUBSCRIBERS = 16;
+  static constexpr size_t PAYLOAD_SIZE = 8;
+
+  enum class EventId : uint8_t {
+    MENU_STATE,   // MenuChanged
+    GAME_STATE,   // GameChanged
+    STAT_DELTA,   // StatDelta
+    XP_EARNED,    // XpEarned
+    COUNT
+  };
+
+  using Mask = uint32_t;  // one bit per EventId
+  static_assert(static_cast<uint8_t>(EventId::COUNT) <= 32, "filters are 32-bit masks");
+
+  constexpr Mask bit(EventId id) { return static_cast<Mask>(1) << static_cast<uint8_t>(id); }
+  template <typename T>
+  constexpr Mask maskOf() { return bit(T::ID); }
+
+  // --- events ---
+
+  // MenuSystem entered a new MenuState.
+  struct MenuChanged {
+    static constexpr EventId ID = EventId::MENU_STATE;
+    uint8_t from;  // MenuState
+    uint8_t to;
+  };
+
+  // EyeGame started or ended.
+  struct GameChanged {
+    static constexpr EventId ID = EventId::GAME_STATE;
+    bool running;
+    uint8_t result;  // EyeGame::GameResult once stopped
+    uint8_t score;
+  };
+
+  // A care stat should change by delta (game rewards and penalties).
+  struct StatDelta {
+    static constexpr EventId ID = EventId::STAT_DELTA;
+    uint8_t stat;  // CareSystem::StatId
+    int16_t delta;
+  };
+
+  // XP earned by recovering a care stat.
+  struct XpEarned {
+    static constexpr EventId ID = EventId::XP_EARNED;
+    int16_t amount;
+  };
+
+  // --- bus ---
+
+  struct Event {
+    EventId id;
+    uint8_t payload[PAYLOAD_SIZE];
+  };
+
+  using Handler = void (*)(const Event& e, void* ctx);
+
+  struct Stats {
+    uint32_t published;
+    uint32_t delivered;  // handler calls
+    uint32_t dropped;    // ring full
+    uint32_t peakDepth;
+  };
+
+  // Receives every event whose ID is in filter.
+  bool subscribe(Mask filter, Handler fn, void* ctx = nullptr);
+  bool post(EventId id, const void* payload, size_t len);
+  // Delivers everything queued; returns the number of events taken.
+  size_t dispatch();
+  Stats stats();
+  void reset();  // forget subscribers and queued events (host tools)
+
+  template <typename T>
+  T payloadAs(const Event& e) {
+    T v;
+    memcpy(&v, e.payload, sizeof(T));
+    return v;
+  }
+
+  template <typename T>
+  bool publish(const T& event) {
+    static_assert(std::is_trivially_copyable<T>::value, "events are copied bytewise");
+    static_assert(sizeof(T) <= PAYLOAD_SIZE, "event too large for the ring");
+    return post(T::ID, &event, sizeof(T));
+  }
+
+  namespace detail {
+    using ErasedFn = void (*)();
+    bool subscribeTyped(Mask filter, void (*thunk)(const Event&, ErasedFn, void*), ErasedFn fn, void* ctx);
+
+    template <typename T>
+    void typedThunk(const Event& e, ErasedFn fn, void* ctx) {
+      reinterpret_cast<void (*)(const T&, void*)>(fn)(payloadAs<T>(e), ctx);
+    }
+  }
+
+  // Receives only T, already decoded.
+  template <typename T>
+  bool subscribe(void (*fn)(const T& event, void* ctx), void* ctx = nullptr) {
+    return detail::subscribeTyped(maskOf<T>(), &detail::typedThunk<T>, reinterpret_cast<detail::ErasedFn>(fn), ctx);
+  }
+}
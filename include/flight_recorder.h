@@ -0,0 +1,43 @@
+#pragma once
+#include <Arduino.h>
+
+// Crash-surviving flight recorder.
+// A fixed ring of small events lives in RTC slow memory (RTC_NOINIT), which
+// keeps its contents across panics, watchdog and software resets (not across
+// power-on). begin() on the next boot prints what the previous boot was doing
+// and, if it ended in a crash, keeps a text report for the OTA check to
+// upload (-DBUBU_FR_UPLOAD_URL). record() is a short critical section and a
+// 12-byte store, so it is cheap enough for any state transition.
+namespace FlightRecorder {
+
+  static constexpr uint16_t CAPACITY = 160;  // events (12 bytes each)
+
+  enum class Event : uint8_t {
+    BOOT = 1,   // a: reset reason of this boot, c: boot count
+    MENU,       // a: MenuState
+    EMOTION,    // a: EyeEmotion
+    SUBSTATE,   // a: sub-state bits (irritable, sluggish, withdrawn, uncomfortable, depressed)
+    WIFI,       // a: WifiState
+    OTA,        // a: BubuOTA::Phase
+    FRAME,      // b: longest loop pass (ms), c: passes, over the last HEALTH_PERIOD_MS
+    STALL,      // b: loop pass that took >= STALL_MS
+    HEAP,       // a: PSRAM free %, b: largest internal block (KB), c: internal free bytes
+    HEAP_WARN   // a: HeapTelemetry::Warning bit, b: 1 raised / 0 cleared, c: value
+  };
+
+  static constexpr uint32_t HEALTH_PERIOD_MS = 10000;
+  static constexpr uint32_t STALL_MS = 250;
+
+  // Call right after Logger::begin(): dumps the previous boot, starts this one.
+  void begin();
+  void record(Event type, uint8_t a = 0, uint16_t b = 0, uint32_t c = 0);
+  // Once per loop() pass; records FRAME every HEALTH_PERIOD_MS and STALL.
+  // HEAP and HEAP_WARN come from HeapTelemetry.
+  void noteLoopTick(uint32_t nowMs);
+
+  // Previous boot ended in a panic, watchdog or brownout and its events are kept.
+  bool hasCrashReport();
+  // Writes the kept events as text lines; returns the length (0 if none).
+  size_t formatCrashReport(char* out, size_t cap);
+  void clearCrashReport();
+}
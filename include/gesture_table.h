@@ -0,0 +1,152 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "menu_system.h"
+#include "touch_system.h"
+
+// What each gesture does on each UI layer, as one constexpr table.
+// DisplaySystem_update() looks the action up by (layer, gesture) and runs
+// it with run(); checks on the touch position (eyes hit, selected item,
+// connect buttons) stay inside the action. Layers are MenuState values: a running
+// EyeGame is MENU_GAME_ACTIVE, and a game that ended before the menu caught
+// up behaves as MENU_CLOSED.
+// Every cell must name an action (IGNORE included), and an action may only
+// appear on the layer it belongs to; both are checked at compile time.
+namespace GestureTable {
+
+  enum class Action : uint8_t {
+    UNSET,  // a cell left out of the table
+    IGNORE,
+    GAME_TAP,
+    GAME_EXIT,
+    OPTION_ACTIVATE,
+    OPTIONS_BACK,
+    OPTIONS_PREV,
+    OPTIONS_NEXT,
+    GAMES_START,
+    GAMES_BACK,
+    CONNECT_TAP,
+    CONNECT_EXIT,
+    MESSAGE_EXIT,
+    STATS_PREV,
+    STATS_NEXT,
+    STATS_ENTER,
+    STATS_EXIT,
+    BATTERY_EXIT,
+    LEVEL_EXIT,
+    MENU_ENTER,
+    MENU_PREV,
+    MENU_NEXT,
+    MENU_EXIT,
+    IDLE_TAP,
+    COUNT
+  };
+
+  static constexpr MenuState ANY_LAYER = MENU_STATE_COUNT;
+
+  // Layer each action belongs to, in Action order.
+  static constexpr MenuState ACTION_LAYER[] = {
+    ANY_LAYER,          // UNSET
+    ANY_LAYER,          // IGNORE
+    MENU_GAME_ACTIVE,   // GAME_TAP
+    MENU_GAME_ACTIVE,   // GAME_EXIT
+    MENU_OPTIONS_OPEN,  // OPTION_ACTIVATE
+    MENU_OPTIONS_OPEN,  // OPTIONS_BACK
+    MENU_OPTIONS_OPEN,  // OPTIONS_PREV
+    MENU_OPTIONS_OPEN,  // OPTIONS_NEXT
+    MENU_GAMES_OPEN,    // GAMES_START
+    MENU_GAMES_OPEN,    // GAMES_BACK
+    MENU_CONNECT_OPEN,  // CONNECT_TAP
+    MENU_CONNECT_OPEN,  // CONNECT_EXIT
+    MENU_MESSAGE_OPEN,  // MESSAGE_EXIT
+    MENU_STATS_OPEN,    // STATS_PREV
+    MENU_STATS_OPEN,    // STATS_NEXT
+    MENU_STATS_OPEN,    // STATS_ENTER
+    MENU_STATS_OPEN,    // STATS_EXIT
+    MENU_BATTERY_OPEN,  // BATTERY_EXIT
+    MENU_LEVEL_OPEN,    // LEVEL_EXIT
+    MENU_OPEN,          // MENU_ENTER
+    MENU_OPEN,          // MENU_PREV
+    MENU_OPEN,          // MENU_NEXT
+    MENU_OPEN,          // MENU_EXIT
+    MENU_CLOSED,        // IDLE_TAP
+  };
+  static_assert(sizeof(ACTION_LAYER) / sizeof(ACTION_LAYER[0]) == static_cast<size_t>(Action::COUNT),
+                "one layer per action");
+
+  static constexpr const char* const ACTION_NAMES[] = {
+    "UNSET", "IGNORE", "GAME_TAP", "GAME_EXIT", "OPTION_ACTIVATE", "OPTIONS_BACK", "OPTIONS_PREV",
+    "OPTIONS_NEXT", "GAMES_START", "GAMES_BACK", "CONNECT_TAP", "CONNECT_EXIT", "MESSAGE_EXIT",
+    "STATS_PREV", "STATS_NEXT", "STATS_ENTER", "STATS_EXIT", "BATTERY_EXIT", "LEVEL_EXIT",
+    "MENU_ENTER", "MENU_PREV", "MENU_NEXT", "MENU_EXIT", "IDLE_TAP"
+  };
+  static_assert(sizeof(ACTION_NAMES) / sizeof(ACTION_NAMES[0]) == static_cast<size_t>(Action::COUNT),
+                "one name per action");
+
+  using A = Action;
+  // Rows in MenuState order, columns in TouchGesture order:
+  //   NONE, TAP, LONG_PRESS, LONG, SWIPE_UP, SWIPE_DOWN, SWIPE_LEFT, SWIPE_RIGHT
+  // NONE (the release marker) is handled before the lookup.
+  static constexpr Action TABLE[][TOUCH_GESTURE_COUNT] = {
+    // MENU_CLOSED
+    {A::IGNORE, A::IDLE_TAP, A::IGNORE, A::IGNORE, A::IGNORE, A::IGNORE, A::IGNORE, A::IGNORE},
+    // MENU_OPEN
+    {A::IGNORE, A::MENU_ENTER, A::MENU_EXIT, A::IGNORE, A::MENU_PREV, A::MENU_NEXT, A::MENU_PREV, A::MENU_NEXT},
+    // MENU_FEEDING: touches are dropped during the feed animation
+    {A::IGNORE, A::IGNORE, A::IGNORE, A::IGNORE, A::IGNORE, A::IGNORE, A::IGNORE, A::IGNORE},
+    // MENU_BATTERY_OPEN
+    {A::IGNORE, A::BATTERY_EXIT, A::BATTERY_EXIT, A::IGNORE, A::IGNORE, A::IGNORE, A::IGNORE, A::IGNORE},
+    // MENU_CONNECT_OPEN
+    {A::IGNORE, A::CONNECT_TAP, A::CONNECT_EXIT, A::IGNORE, A::IGNORE, A::IGNORE, A::IGNORE, A::IGNORE},
+    // MENU_MESSAGE_OPEN
+    {A::IGNORE, A::IGNORE, A::MESSAGE_EXIT, A::IGNORE, A::IGNORE, A::IGNORE, A::IGNORE, A::IGNORE},
+    // MENU_STATS_OPEN
+    {A::IGNORE, A::STATS_ENTER, A::STATS_EXIT, A::IGNORE, A::STATS_PREV, A::STATS_NEXT, A::STATS_PREV, A::STATS_NEXT},
+    // MENU_OPTIONS_OPEN
+    {A::IGNORE, A::OPTION_ACTIVATE, A::OPTIONS_BACK, A::IGNORE,
+     A::OPTIONS_PREV, A::OPTIONS_NEXT, A::OPTIONS_PREV, A::OPTIONS_NEXT},
+    // MENU_GAMES_OPEN
+    {A::IGNORE, A::GAMES_START, A::GAMES_BACK, A::IGNORE, A::IGNORE, A::IGNORE, A::IGNORE, A::IGNORE},
+    // MENU_GAME_ACTIVE
+    {A::IGNORE, A::GAME_TAP, A::GAME_EXIT, A::IGNORE, A::IGNORE, A::IGNORE, A::IGNORE, A::IGNORE},
+    // MENU_LEVEL_OPEN
+    {A::IGNORE, A::LEVEL_EXIT, A::LEVEL_EXIT, A::IGNORE, A::IGNORE, A::IGNORE, A::IGNORE, A::IGNORE},
+  };
+  static_assert(sizeof(TABLE) / sizeof(TABLE[0]) == MENU_STATE_COUNT, "one row per MenuState");
+
+  constexpr bool cellValid(size_t layer, size_t gesture) {
+    return TABLE[layer][gesture] != Action::UNSET &&
+           (ACTION_LAYER[static_cast<size_t>(TABLE[layer][gesture])] == ANY_LAYER ||
+            ACTION_LAYER[static_cast<size_t>(TABLE[layer][gesture])] == static_cast<MenuState>(layer));
+  }
+
+  constexpr bool tableValid(size_t cell = 0) {
+    return cell >= static_cast<size_t>(MENU_STATE_COUNT) * TOUCH_GESTURE_COUNT ||
+           (cellValid(cell / TOUCH_GESTURE_COUNT, cell % TOUCH_GESTURE_COUNT) && tableValid(cell + 1));
+  }
+  static_assert(tableValid(), "gesture table: a cell is missing or names another layer's action");
+
+  constexpr MenuState layerFor(MenuState menu, bool gameRunning) {
+    return gameRunning ? MENU_GAME_ACTIVE : menu == MENU_GAME_ACTIVE ? MENU_CLOSED : menu;
+  }
+
+  constexpr Action lookup(MenuState layer, TouchGesture gesture) {
+    return layer < MENU_STATE_COUNT && gesture < TOUCH_GESTURE_COUNT ? TABLE[layer][gesture] : Action::IGNORE;
+  }
+
+  inline const char* actionName(Action a) {
+    return a < Action::COUNT ? ACTION_NAMES[static_cast<size_t>(a)] : "?";
+  }
+
+  // What the actions need from the display: the eye hit test, the clean
+  // animation and the test emotion.
+  struct Hooks {
+    bool (*tapOnEyes)(const TouchPoint& touch);
+    void (*startClean)(uint32_t nowMs);
+    void (*triggerTestEmotion)(uint32_t nowMs);
+  };
+
+  // Runs one action (src/gesture_table.cpp); returns true to block gestures
+  // until the finger lifts.
+  bool run(Action action, const TouchPoint& touch, uint32_t nowMs, const Hooks& hooks);
+}
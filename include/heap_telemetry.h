@@ -0,0 +1,71 @@
+#pragma once
+#include <Arduino.h>
+
+// Periodic heap telemetry.
+// Every SAMPLE_PERIOD_MS, update() reads free, minimum-ever-free and largest
+// free block for the internal, DMA-capable and SPIRAM heaps, plus LVGL's own
+// allocator (lv_mem_monitor). Samples go into a RECENT ring; every HISTORY_EVERY
+// samples the worst values seen are folded into a HISTORY ring, so slow
+// fragmentation shows up over a day without keeping every sample. Crossing a
+// threshold logs a warning and records a flight-recorder HEAP_WARN event;
+// the warning clears with hysteresis once the value recovers.
+// Rings live in PSRAM. Call update() and the queries from the loop task only.
+namespace HeapTelemetry {
+
+  static constexpr uint32_t SAMPLE_PERIOD_MS = 10000;
+  static constexpr uint16_t RECENT_SAMPLES = 90;    // 15 min
+  static constexpr uint16_t HISTORY_EVERY = 30;     // one history entry per 5 min
+  static constexpr uint16_t HISTORY_SAMPLES = 288;  // 24 h
+
+  // Warning thresholds (raised below / above these, cleared 25% past them)
+  static constexpr uint32_t INTERNAL_FREE_MIN = 32 * 1024;
+  static constexpr uint32_t INTERNAL_BLOCK_MIN = 16 * 1024;  // one TLS record buffer
+  static constexpr uint32_t DMA_BLOCK_MIN = 8 * 1024;
+  static constexpr uint32_t SPIRAM_FREE_MIN = 512 * 1024;
+  static constexpr uint32_t LVGL_FREE_MIN = 8 * 1024;
+  static constexpr uint8_t LVGL_FRAG_MAX_PCT = 50;
+
+  struct CapStats {
+    uint32_t free;
+    uint32_t minFree;   // lowest free since boot
+    uint32_t largest;   // largest allocatable block
+  };
+
+  struct Sample {
+    uint32_t ms;
+    CapStats internal;
+    CapStats dma;
+    CapStats spiram;
+    uint32_t lvTotal;    // 0 if LVGL is not up (or uses the C library's malloc)
+    uint32_t lvFree;
+    uint32_t lvBiggest;
+    uint32_t lvMaxUsed;
+    uint8_t lvUsedPct;
+    uint8_t lvFragPct;
+  };
+
+  enum class Warning : uint8_t {
+    INTERNAL_LOW,
+    INTERNAL_FRAGMENTED,
+    DMA_FRAGMENTED,
+    SPIRAM_LOW,
+    LVGL_LOW,
+    LVGL_FRAGMENTED,
+    COUNT
+  };
+
+  enum class Window : uint8_t { RECENT, HISTORY };
+
+  void begin();
+  void update(uint32_t nowMs);
+  Sample sampleNow();
+
+  size_t count(Window w);
+  // age 0 is the newest entry; false if there is no such entry.
+  bool get(Window w, size_t age, Sample& out);
+  uint8_t warnings();  // bit (1 << Warning) per active warning
+  const char* warningToStr(Warning w);
+
+  // Current sample, active warnings and the trend over HISTORY.
+  void logReport(const char* label);
+}
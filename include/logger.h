@@ -2,6 +2,7 @@
 
 #include <Arduino.h>
 #include <stdarg.h>
+#include <type_traits>
 
 namespace Logger {
 
@@ -11,16 +12,202 @@ void println(const char* msg);
 void vprintf(const char* fmt, va_list args);
 void printf(const char* fmt, ...);
 
+// Once begin() has run, print/printf only queue a record (format pointer and
+// arguments; strings are copied, up to 64 chars, longer ones rendered with
+// a trailing "…") and a low-priority task writes it to Serial. fmt must
+// be a string literal.
+struct Stats {
+  uint32_t written;    // records queued
+  uint32_t dropped;    // records lost to a full ring
+  uint32_t highWater;  // most ring bytes in use
+  bool deferred;       // false: ring unavailable, logging is synchronous
+};
+Stats stats();
+// Waits (up to 500 ms) until queued records reach Serial, e.g. before a restart.
+void flush();
+// Queues one tokenized frame payload (see LogToken below).
+void writeToken(const uint8_t* payload, size_t len);
+
 }  // namespace Logger
 
+// Log levels. Every module's threshold is fixed at compile time from one
+// build flag, e.g. in platformio.ini:
+//   -DBUBU_LOG_LEVELS=\"*=INFO,TouchLog=DEBUG,SoundLog=NONE\"
+// ("*" is the default for unlisted modules; levels may also be 0-5).
+// LOG_x() calls above a module's threshold compile away entirely: the
+// arguments are never evaluated and the format string is not kept in flash.
+enum class LogLevel : uint8_t { NONE, ERROR, WARN, INFO, DEBUG, TRACE };
+
+#ifndef BUBU_LOG_LEVELS
+#define BUBU_LOG_LEVELS "*=INFO"
+#endif
+
+namespace LogConfig {
+// constexpr (C++11, recursive) lookup of a module name in BUBU_LOG_LEVELS.
+constexpr int levelFromText(const char* s) {
+  return (*s >= '0' && *s <= '5') ? *s - '0'
+         : *s == 'N' ? 0 : *s == 'E' ? 1 : *s == 'W' ? 2
+         : *s == 'I' ? 3 : *s == 'D' ? 4 : *s == 'T' ? 5 : -1;
+}
+constexpr bool keyIs(const char* s, const char* name) {
+  return *name == '\0' ? *s == '=' : (*s == *name && keyIs(s + 1, name + 1));
+}
+constexpr const char* valueOf(const char* s) {
+  return *s == '=' ? s + 1 : valueOf(s + 1);
+}
+constexpr const char* nextEntry(const char* s) {
+  return *s == '\0' ? s : *s == ',' ? s + 1 : nextEntry(s + 1);
+}
+constexpr int find(const char* s, const char* name) {
+  return *s == '\0' ? -1
+         : *s == ' ' ? find(s + 1, name)
+         : keyIs(s, name) ? levelFromText(valueOf(s))
+         : find(nextEntry(s), name);
+}
+constexpr LogLevel orDefault(int level, int fallback) {
+  return static_cast<LogLevel>(level >= 0 ? level : fallback >= 0 ? fallback : 3);
+}
+// Level of module name under spec: its entry, else "*", else INFO.
+constexpr LogLevel levelIn(const char* spec, const char* name) {
+  return orDefault(find(spec, name), find(spec, "*"));
+}
+constexpr LogLevel levelFor(const char* name) {
+  return levelIn(BUBU_LOG_LEVELS, name);
+}
+
+// Spec syntax check (static_assert'ed in logger.cpp): comma-separated
+// "Key=LEVEL" entries, LEVEL a full name or one digit 0-5, spaces allowed
+// before a key. find() itself only reads the first letter of a level and
+// skips entries it cannot parse, so a typo would otherwise pass silently.
+constexpr bool valueEnds(const char* s) {
+  return *s == ',' || *s == '\0';
+}
+constexpr bool wordIs(const char* s, const char* word) {
+  return *word == '\0' ? valueEnds(s) : (*s == *word && wordIs(s + 1, word + 1));
+}
+constexpr bool validLevel(const char* s) {
+  return (*s >= '0' && *s <= '5' && valueEnds(s + 1)) || wordIs(s, "NONE") || wordIs(s, "ERROR") ||
+         wordIs(s, "WARN") || wordIs(s, "INFO") || wordIs(s, "DEBUG") || wordIs(s, "TRACE");
+}
+constexpr const char* keyEnd(const char* s) {
+  return (*s == '\0' || *s == ',' || *s == '=' || *s == ' ') ? s : keyEnd(s + 1);
+}
+constexpr bool validEntry(const char* s, const char* eq) {
+  return eq != s && *eq == '=' && validLevel(eq + 1);
+}
+constexpr const char* entryEnd(const char* s) {
+  return valueEnds(s) ? s : entryEnd(s + 1);
+}
+constexpr bool wellFormed(const char* s) {
+  return *s == ' ' ? wellFormed(s + 1)
+         : validEntry(s, keyEnd(s)) && (*entryEnd(s) == '\0' || wellFormed(entryEnd(s) + 1));
+}
+}  // namespace LogConfig
+
+// Tokenized logging (-DBUBU_LOG_TOKENIZED). LOG_x() then sends no text: the
+// format string is replaced at compile time by its 32-bit FNV-1a hash, and
+// only that token and the raw arguments reach Serial, as a COBS frame ended
+// by 0x00. tools/log_tokens.py extracts the token dictionary from the
+// sources at build time and tools/log_decode.py turns frames back into text.
+// Frame payload:
+//   token  u32 little-endian
+//   args   in call order: integers (bool, char, enums too) sign- or zero-
+//          extended to 64 bits, zigzag + LEB128 varint; float/double as f32;
+//          char* as varint (length << 1 | cut) + bytes: at most 64, and
+//          cut set if the string was longer (the decoder appends "…");
+//          other pointers as integers. Args that do not fit PAYLOAD_MAX
+//          are dropped.
+// Anything else (print/println, Logger::printf) is still rendered on the
+// device and sent as plain text, also ended by 0x00.
+namespace LogToken {
+constexpr size_t PAYLOAD_MAX = 160;
+
+constexpr uint32_t fnv1a(const char* s, uint32_t h = 2166136261u) {
+  return *s ? fnv1a(s + 1, (h ^ static_cast<uint8_t>(*s)) * 16777619u) : h;
+}
+
+struct Writer {
+  uint8_t buf[PAYLOAD_MAX];
+  size_t len;
+  bool full;
+
+  explicit Writer(uint32_t token);
+  void integer(int64_t v);
+  void real(float v);
+  void str(const char* s);
+};
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+put(Writer& w, T v) {
+  w.integer(v);
+}
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+put(Writer& w, T v) {
+  w.integer(static_cast<int64_t>(static_cast<uint64_t>(v)));
+}
+template <typename T>
+typename std::enable_if<std::is_enum<T>::value>::type put(Writer& w, T v) {
+  put(w, static_cast<typename std::underlying_type<T>::type>(v));
+}
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value>::type put(Writer& w, T v) {
+  w.real(static_cast<float>(v));
+}
+inline void put(Writer& w, const char* s) {
+  w.str(s);
+}
+template <typename T>
+void put(Writer& w, const T* p) {
+  w.integer(static_cast<int64_t>(reinterpret_cast<uintptr_t>(p)));
+}
+
+inline void putAll(Writer&) {}
+template <typename T, typename... Rest>
+void putAll(Writer& w, T v, Rest... rest) {
+  put(w, v);
+  putAll(w, rest...);
+}
+
+template <typename... Args>
+void log(uint32_t token, Args... args) {
+  Writer w(token);
+  putAll(w, args...);
+  Logger::writeToken(w.buf, w.len);
+}
+}  // namespace LogToken
+
+// LOG_EMIT(fmt, ...) logs without a level check; fmt must be a literal.
+#ifdef BUBU_LOG_TOKENIZED
+#define LOG_EMIT(fmt, ...) \
+  LogToken::log(std::integral_constant<uint32_t, LogToken::fnv1a(fmt)>::value, ##__VA_ARGS__)
+#else
+#define LOG_EMIT(...) Logger::printf(__VA_ARGS__)
+#endif
+
 // Module logger guide:
-// - MainLog: boot + memory reports (src/main.cpp)
-// - DisplayLog: display init, eyes, gestures, layer transitions (src/display_system.cpp)
+// - MainLog: boot (src/main.cpp)
+// - DisplayLog: display init, eyes, gestures, layer transitions (src/display_system.cpp,
+//   src/gesture_table.cpp)
 // - TouchLog: raw touch events + gesture classification (src/touch_system.cpp)
 // - MenuLog: menu navigation + actions (src/menu_system.cpp)
 // - WifiLog: Wi-Fi provisioning/connection state (src/wifi_service.cpp)
+// - PortalLog: captive portal HTTP/DNS tasks (src/portal/portal_server.cpp)
+// - FlightLog: previous-boot dump from the flight recorder (src/flight_recorder.cpp)
+// - HeapLog: memory reports and heap threshold warnings (src/heap_telemetry.cpp)
+// - LvMemLog: LVGL allocator size-class report (src/lvgl_mem/lv_mem_tiered.cpp)
+// - StoreLog: persistent store commits and hourly NVS write counts (src/persist_store.cpp)
+// - HistoryLog: stat history log in the spiffs partition (src/stat_log/stat_log_esp.cpp)
+// - SchedLog: loop task scheduler report and task table errors (src/scheduler.cpp)
+// Log through the LOG_x(Module, fmt, ...) macros below; Name::printf() and
+// friends bypass the level check and are never tokenized.
 #define DEFINE_MODULE_LOGGER(Name)                      \
   namespace Name {                                      \
+    constexpr LogLevel LEVEL = LogConfig::levelFor(#Name); \
+    constexpr bool enabled(LogLevel level) {            \
+      return level != LogLevel::NONE && level <= LEVEL; \
+    }                                                   \
     inline void print(const char* msg) {                \
       Logger::print(msg);                               \
     }                                                   \
@@ -34,3 +221,13 @@ void printf(const char* fmt, ...);
       va_end(args);                                     \
     }                                                   \
   }
+
+#define LOG_AT(Module, Level, ...)                              \
+  do {                                                          \
+    if (Module::enabled(LogLevel::Level)) LOG_EMIT(__VA_ARGS__); \
+  } while (0)
+#define LOG_ERROR(Module, ...) LOG_AT(Module, ERROR, __VA_ARGS__)
+#define LOG_WARN(Module, ...) LOG_AT(Module, WARN, __VA_ARGS__)
+#define LOG_INFO(Module, ...) LOG_AT(Module, INFO, __VA_ARGS__)
+#define LOG_DEBUG(Module, ...) LOG_AT(Module, DEBUG, __VA_ARGS__)
+#define LOG_TRACE(Module, ...) LOG_AT(Module, TRACE, __VA_ARGS__)
@@ -12,7 +12,8 @@ enum MenuState {
   MENU_OPTIONS_OPEN,
   MENU_GAMES_OPEN,
   MENU_GAME_ACTIVE,
-  MENU_LEVEL_OPEN
+  MENU_LEVEL_OPEN,
+  MENU_STATE_COUNT
 };
 
 enum MenuItem {
@@ -43,8 +44,7 @@ namespace MenuSystem {
   bool isGamesOpen();
   bool isGameActive();
   bool isLevelOpen();
-  void otaSetActive(bool active);
-  void otaPulse(uint32_t nowMs);
+  MenuState getState();
   
   void selectNext();
   void selectPrev();
@@ -0,0 +1,41 @@
+#pragma once
+#include <Arduino.h>
+
+// Write-back persistent store for small subsystem state.
+// Each subsystem owns one Slot: a single versioned blob in the "bubu-store"
+// NVS namespace. write() only updates the RAM copy and marks it dirty when
+// the bytes changed; update() commits all dirty slots together every
+// COMMIT_PERIOD_MS, and at once (then every LOW_BATTERY_PERIOD_MS) while
+// the battery is low. commit() forces a write for milestones that must not
+// be lost, and esp_restart() (OTA install) commits through a shutdown
+// handler. A panic or power cut loses at most one period of changes.
+// Call from the loop task.
+namespace PersistStore {
+
+  enum class Slot : uint8_t { LEVEL, CARE, CLOCK, HATCH, COUNT };
+
+  static constexpr size_t MAX_BLOB = 31;
+  static constexpr uint32_t COMMIT_PERIOD_MS = 5UL * 60UL * 1000UL;
+  static constexpr uint32_t LOW_BATTERY_PERIOD_MS = 30UL * 1000UL;
+  static constexpr uint8_t LOW_BATTERY_PCT = 10;
+
+  struct Stats {
+    uint32_t saves;        // write() calls that changed the data
+    uint32_t legacyKeys;   // NVS key writes the old per-subsystem saves would have issued
+    uint32_t nvsWrites;    // blobs actually written
+    uint32_t commits;      // NVS sessions opened to write
+  };
+
+  void begin();
+  void update(uint32_t nowMs);
+
+  // Copies the slot's blob into out; false if missing or of another
+  // version/size (the caller then starts from defaults or migrates).
+  bool read(Slot slot, uint8_t version, void* out, size_t size);
+  void write(Slot slot, uint8_t version, const void* data, size_t size);
+  // Writes every dirty slot now.
+  void commit();
+
+  Stats total();
+  Stats lastHour();  // the last full hour of uptime (zero during the first)
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <Arduino.h>
+
+// Cooperative periodic scheduler for the loop task.
+// Each subsystem registers a period and a CPU budget; runDue() calls only
+// the tasks whose deadline has passed, in registration order, and returns
+// how long loop() may sleep before the next one. A run longer than the
+// task's budget counts as an overrun. The next deadline is a period after
+// the time the task was given, so a late run never catches up, and an
+// interval check inside the task measured from that time always passes;
+// a run a whole period or more past its deadline counts as late.
+namespace Scheduler {
+
+  static constexpr uint8_t MAX_TASKS = 16;
+  static constexpr uint32_t REPORT_PERIOD_MS = 10UL * 60UL * 1000UL;
+
+  using TaskFn = void (*)(uint32_t nowMs);
+  using TaskId = int8_t;  // -1: table full
+
+  struct TaskStats {
+    const char* name;
+    uint32_t periodMs;
+    uint32_t budgetUs;
+    uint32_t runs;
+    uint32_t overruns;  // runs longer than budgetUs
+    uint32_t late;      // deadlines missed by a full period
+    uint32_t maxUs;
+    uint64_t totalUs;
+  };
+
+  // First run at BubuClock::nowMs() + firstDelayMs; periodMs 0 runs on every pass.
+  TaskId add(const char* name, TaskFn fn, uint32_t periodMs, uint32_t budgetUs, uint32_t firstDelayMs = 0);
+  void setPeriod(TaskId id, uint32_t periodMs);  // from the next run on
+  void runSoon(TaskId id);                       // due on the next runDue()
+
+  // Runs every due task once; returns ms until the next deadline.
+  uint32_t runDue(uint32_t nowMs);
+
+  uint8_t taskCount();
+  bool stats(uint8_t index, TaskStats& out);
+  void logReport();  // per-task runs, CPU share, overruns
+}
@@ -26,6 +26,9 @@ struct Snapshot {
 };
 
 void begin();
-void update(Snapshot& out);  // call once per main update loop
+// Call once per main update loop. Re-evaluates the rules only when the care
+// stats or the level changed, or a sustained-low timer expired; otherwise
+// returns the previous snapshot.
+void update(Snapshot& out);
 
 }  // namespace SubStateSystem
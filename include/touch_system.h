@@ -2,6 +2,7 @@
 #define TOUCH_SYSTEM_H
 
 #include <stdint.h>
+#include "touch_trace.h"
 
 // Touch gesture types
 enum TouchGesture {
@@ -12,7 +13,8 @@ enum TouchGesture {
   TOUCH_SWIPE_UP,
   TOUCH_SWIPE_DOWN,
   TOUCH_SWIPE_LEFT,
-  TOUCH_SWIPE_RIGHT
+  TOUCH_SWIPE_RIGHT,
+  TOUCH_GESTURE_COUNT
 };
 
 struct TouchPoint {
@@ -59,6 +61,29 @@ bool isTcaActive();
 bool hasRecentSample(uint32_t windowMs = 100);
 uint32_t lastSampleTimestamp();
 
+// --- touch traces (touch_trace.h) ---
+// Appends every controller read to writer, timed by BubuClock; nullptr
+// stops. -DBUBU_TOUCH_RECORD records from begin() and prints the samples
+// as "btr" hex lines whenever the screen has been untouched for a second
+// (tools/touch_trace.py turns a serial capture back into a trace).
+void record(TouchTrace::Writer* writer);
+
+// Feeds a trace to the gesture classifier in place of the controller, at
+// its recorded pace from the next update(); live touches are ignored until
+// it ends. trace must stay valid meanwhile. False if it is not a trace.
+// -DBUBU_TOUCH_REPLAY=\"menu_browse\" replays a canned trace from begin().
+bool startReplay(const uint8_t* trace, size_t len);
+void stopReplay();
+bool isReplaying();
+
+struct ReplayStats {
+  uint32_t samples;         // fed to the classifier since startReplay()
+  uint32_t gestures;        // taken with get()
+  uint32_t latencyMaxMs;    // last contact (long press: hold threshold) to get()
+  uint32_t latencyTotalMs;
+};
+ReplayStats replayStats();
+
 }  // namespace TouchSystem
 
 #endif  // TOUCH_SYSTEM_H
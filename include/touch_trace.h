@@ -0,0 +1,78 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Compact binary touch traces: the raw samples TouchSystem reads from the
+// CST816 (time, position, finger count, hardware gesture), recorded on the
+// device and replayed through the same gesture classifier (TouchSystem::
+// startReplay), so an interaction can be repeated exactly.
+//
+// Layout, little-endian:
+//   header  "BTR", version, uint32 record count
+//   record  uint16 ms since the previous record, x, y (screen pixels),
+//           hardware gesture << 4 | finger count
+// Finger count 0 is a controller read that found no touch. A record with
+// finger count GAP_FINGERS carries only time (pauses over 65535 ms).
+namespace TouchTrace {
+
+  static constexpr uint8_t VERSION = 1;
+  static constexpr size_t HEADER_BYTES = 8;
+  static constexpr size_t RECORD_BYTES = 5;
+  static constexpr uint8_t GAP_FINGERS = 0x0F;
+
+  struct Sample {
+    uint32_t tMs;     // since the start of the trace
+    uint16_t x;
+    uint16_t y;
+    uint8_t fingers;  // 0: no touch
+    uint8_t gesture;  // CST816 gesture register (0x01)
+  };
+
+  // Appends records to a caller buffer; the header is kept current, so the
+  // first size() bytes are a complete trace at any point.
+  class Writer {
+   public:
+    Writer(uint8_t* buf, size_t cap, uint32_t startMs);
+    bool add(const Sample& s);  // false once the buffer is full; tMs is absolute
+    // Starts a new trace in the same buffer, timed from the last sample, so
+    // the records of consecutive traces concatenate into one.
+    void restart();
+    size_t size() const { return len_; }
+    uint32_t records() const { return records_; }
+    const uint8_t* data() const { return buf_; }
+
+   private:
+    bool put(uint16_t dt, uint8_t x, uint8_t y, uint8_t packed);
+    uint8_t* buf_;
+    size_t cap_;
+    size_t len_;
+    uint32_t records_;
+    uint32_t lastMs_;
+  };
+
+  class Reader {
+   public:
+    // False if data is not a trace of this version or is cut short.
+    bool open(const uint8_t* data, size_t len);
+    bool next(Sample& out);  // skips gap records
+    uint32_t records() const { return records_; }
+
+   private:
+    const uint8_t* data_ = nullptr;
+    uint32_t records_ = 0;
+    uint32_t pos_ = 0;
+    uint32_t tMs_ = 0;
+  };
+
+  // --- canned traces ---
+  // Scripted sessions for repeatable UI benchmarks, synthesized at the
+  // controller's 5 ms read rate. Each starts and ends on the idle eyes
+  // (checked by tools/gesture_script_test, whatever the game's colours).
+  uint8_t cannedCount();
+  const char* cannedName(uint8_t index);
+  const char* cannedDescription(uint8_t index);
+  // Writes the named trace to out; returns its size, 0 if the name is
+  // unknown or cap is too small (cannedSize() tells how much is needed).
+  size_t buildCanned(const char* name, uint8_t* out, size_t cap);
+  size_t cannedSize(const char* name);
+}
@@ -0,0 +1,102 @@
+#pragma once
+// Host stand-in for the Arduino-ESP32 core, for [env:native].
+// millis() is a simulated hardware clock that only moves in delay() and
+// NativeHost::advanceMs(), so loop() fast-forwards through its idle time
+// and a run is deterministic.
+// micros() and ESP.getCycleCount() read the host's monotonic clock, so
+// Scheduler budgets and frame times measure real work.
+#include <math.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+// The ESP32 core's Arduino.h brings these in too.
+#include "esp_heap_caps.h"
+#include "esp_system.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+using std::max;
+using std::min;
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef uint16_t word;
+
+#define IRAM_ATTR
+#define ESP32 1
+
+#define LOW 0x0
+#define HIGH 0x1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+#define digitalPinToInterrupt(p) (p)
+void attachInterrupt(uint8_t pin, void (*isr)(void), int mode);
+void detachInterrupt(uint8_t pin);
+void noInterrupts();
+void interrupts();
+
+double ledcSetup(uint8_t channel, double freq, uint8_t resolutionBits);
+void ledcAttachPin(uint8_t pin, uint8_t channel);
+void ledcWrite(uint8_t channel, uint32_t duty);
+
+bool psramFound();
+
+// Sets TZ only: there is no SNTP, so time() stays the host's clock.
+void configTzTime(const char* tz, const char* server1, const char* server2 = nullptr,
+                  const char* server3 = nullptr);
+
+// Serial goes to stdout.
+class HardwareSerial {
+ public:
+  void begin(unsigned long baud);
+  void end() {}
+  size_t write(uint8_t c);
+  size_t write(const uint8_t* buf, size_t len);
+  size_t print(const char* s);
+  size_t println(const char* s = "");
+  size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+  void flush();
+  int available() { return 0; }
+  int read() { return -1; }
+  operator bool() const { return true; }
+};
+extern HardwareSerial Serial;
+
+class EspClass {
+ public:
+  uint32_t getCycleCount();  // host time at 240 MHz
+  uint32_t getFreeHeap();
+  uint32_t getCpuFreqMHz() { return 240; }
+  void restart();
+};
+extern EspClass ESP;
+
+// The sketch entry points; the native core's main() calls them.
+void setup();
+void loop();
@@ -0,0 +1,112 @@
+#pragma once
+// Host stand-in for the LovyanGFX subset the firmware uses. The panel is an
+// in-memory RGB565 framebuffer (native byte order, row-major) that
+// NativeHost reads back; sprites keep their pixels in the same format.
+// Bus and panel configs are accepted and ignored, and rotation does not
+// remap pixels (the GC9A01 is square).
+#include <stddef.h>
+#include <stdint.h>
+
+namespace lgfx {
+
+  struct rgb565_t {
+    uint16_t raw;
+    rgb565_t() : raw(0) {}
+    rgb565_t(uint16_t c) : raw(c) {}
+    operator uint16_t() const { return raw; }
+  };
+
+  constexpr uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
+    return static_cast<uint16_t>(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+  }
+
+  class Bus_Parallel8 {
+   public:
+    struct config_t {
+      int port = 0;
+      uint32_t freq_write = 0;
+      int pin_wr = -1, pin_rd = -1, pin_rs = -1;
+      int pin_d0 = -1, pin_d1 = -1, pin_d2 = -1, pin_d3 = -1;
+      int pin_d4 = -1, pin_d5 = -1, pin_d6 = -1, pin_d7 = -1;
+    };
+    config_t config() const { return cfg_; }
+    void config(const config_t& cfg) { cfg_ = cfg; }
+
+   private:
+    config_t cfg_;
+  };
+
+  class Panel_Device {
+   public:
+    struct config_t {
+      int pin_cs = -1, pin_rst = -1, pin_busy = -1;
+      uint16_t memory_width = 240, memory_height = 240;
+      uint16_t panel_width = 240, panel_height = 240;
+      int16_t offset_x = 0, offset_y = 0;
+      uint8_t offset_rotation = 0;
+      uint8_t dummy_read_pixel = 8;
+      bool readable = false, invert = false, rgb_order = false, dlen_16bit = false, bus_shared = false;
+    };
+    config_t config() const { return cfg_; }
+    void config(const config_t& cfg) { cfg_ = cfg; }
+    void setBus(Bus_Parallel8*) {}
+
+   private:
+    config_t cfg_;
+  };
+
+  class Panel_GC9A01 : public Panel_Device {};
+
+  class LGFX_Device {
+   public:
+    virtual ~LGFX_Device();
+    void setPanel(Panel_Device* panel) { panel_ = panel; }
+    bool init();
+    void setRotation(uint8_t r) { rotation_ = r; }
+    uint8_t getRotation() const { return rotation_; }
+    void setBrightness(uint8_t) {}
+    int32_t width() const;
+    int32_t height() const;
+
+    void startWrite() {}
+    void endWrite() {}
+    void setAddrWindow(int32_t x, int32_t y, int32_t w, int32_t h);
+    void writePixels(const rgb565_t* data, size_t len);
+    void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data);
+
+    const uint16_t* framebuffer() const { return fb_; }
+
+   private:
+    Panel_Device* panel_ = nullptr;
+    uint8_t rotation_ = 0;
+    uint16_t* fb_ = nullptr;
+    int32_t winX_ = 0, winY_ = 0, winW_ = 0, winH_ = 0;
+    size_t winPos_ = 0;
+  };
+
+  class LGFX_Sprite {
+   public:
+    explicit LGFX_Sprite(LGFX_Device* parent = nullptr) : parent_(parent) {}
+    ~LGFX_Sprite() { deleteSprite(); }
+    void setPsram(bool psram) { psram_ = psram; }
+    void setColorDepth(int bits) { depth_ = bits; }
+    void* createSprite(int32_t w, int32_t h);
+    void deleteSprite();
+    void* getBuffer() const { return buf_; }
+    int32_t width() const { return w_; }
+    int32_t height() const { return h_; }
+
+    void fillScreen(uint16_t color) { fillRect(0, 0, w_, h_, color); }
+    void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);
+    void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint16_t color);
+    void pushSprite(int32_t x, int32_t y);
+
+   private:
+    LGFX_Device* parent_;
+    bool psram_ = false;
+    int depth_ = 16;
+    uint16_t* buf_ = nullptr;
+    int32_t w_ = 0, h_ = 0;
+  };
+
+}  // namespace lgfx
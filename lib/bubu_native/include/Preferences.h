@@ -0,0 +1,92 @@
+#pragma once
+// In-memory NVS for host builds: namespaces live for the process, so a
+// simulated reboot (re-running begin()) finds what the last commit stored.
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+class Preferences {
+ public:
+  bool begin(const char* ns, bool readOnly = false) {
+    if (readOnly && !store().count(ns)) return false;  // like NVS: not created yet
+    ns_ = &store()[ns];
+    return true;
+  }
+  void end() { ns_ = nullptr; }
+  bool clear() {
+    if (!ns_) return false;
+    ns_->clear();
+    return true;
+  }
+  bool remove(const char* key) { return ns_ && ns_->erase(key) > 0; }
+  bool isKey(const char* key) { return find(key) != nullptr; }
+
+  size_t putBytes(const char* key, const void* data, size_t len) {
+    if (!ns_) return 0;
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    (*ns_)[key].assign(p, p + len);
+    ++writes();
+    return len;
+  }
+  size_t getBytesLength(const char* key) {
+    const std::vector<uint8_t>* v = find(key);
+    return v ? v->size() : 0;
+  }
+  size_t getBytes(const char* key, void* out, size_t len) {
+    const std::vector<uint8_t>* v = find(key);
+    if (!v || v->size() > len) return 0;
+    memcpy(out, v->data(), v->size());
+    return v->size();
+  }
+
+  size_t putUChar(const char* key, uint8_t v) { return putBytes(key, &v, sizeof(v)); }
+  uint8_t getUChar(const char* key, uint8_t def = 0) { return get(key, def); }
+  size_t putUShort(const char* key, uint16_t v) { return putBytes(key, &v, sizeof(v)); }
+  uint16_t getUShort(const char* key, uint16_t def = 0) { return get(key, def); }
+  size_t putInt(const char* key, int32_t v) { return putBytes(key, &v, sizeof(v)); }
+  int32_t getInt(const char* key, int32_t def = 0) { return get(key, def); }
+  size_t putUInt(const char* key, uint32_t v) { return putBytes(key, &v, sizeof(v)); }
+  uint32_t getUInt(const char* key, uint32_t def = 0) { return get(key, def); }
+  size_t putULong64(const char* key, uint64_t v) { return putBytes(key, &v, sizeof(v)); }
+  uint64_t getULong64(const char* key, uint64_t def = 0) { return get(key, def); }
+  size_t putBool(const char* key, bool v) { return putBytes(key, &v, sizeof(v)); }
+  bool getBool(const char* key, bool def = false) { return get(key, def); }
+  size_t putString(const char* key, const char* v) { return putBytes(key, v, strlen(v) + 1); }
+  size_t getString(const char* key, char* out, size_t len) {
+    const std::vector<uint8_t>* v = find(key);
+    if (!v || v->empty() || v->size() > len) return 0;
+    memcpy(out, v->data(), v->size());
+    return v->size();
+  }
+
+  // Host only: NVS entries written since start, for simulation reports.
+  static uint32_t& writes() {
+    static uint32_t n = 0;
+    return n;
+  }
+
+ private:
+  typedef std::map<std::string, std::vector<uint8_t> > Namespace;
+  static std::map<std::string, Namespace>& store() {
+    static std::map<std::string, Namespace> s;
+    return s;
+  }
+  const std::vector<uint8_t>* find(const char* key) const {
+    if (!ns_) return nullptr;
+    Namespace::const_iterator it = ns_->find(key);
+    return it == ns_->end() ? nullptr : &it->second;
+  }
+  template <typename T>
+  T get(const char* key, T def) {
+    const std::vector<uint8_t>* v = find(key);
+    if (!v || v->size() != sizeof(T)) return def;
+    T out;
+    memcpy(&out, v->data(), sizeof(T));
+    return out;
+  }
+
+  Namespace* ns_ = nullptr;
+};
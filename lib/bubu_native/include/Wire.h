@@ -0,0 +1,54 @@
+#pragma once
+#include <Arduino.h>
+
+// Host I2C bus. Addresses with no attached NativeWire::Device NACK, so the
+// drivers take their "not found" paths; a simulation attaches a device model
+// to answer for a chip.
+namespace NativeWire {
+
+  class Device {
+   public:
+    virtual ~Device() {}
+    // Bytes of one write transaction (register pointer first, if any).
+    // False NACKs the transaction.
+    virtual bool write(const uint8_t* data, size_t len) = 0;
+    // Fills up to len bytes for a read; returns how many were sent.
+    virtual size_t read(uint8_t* out, size_t len) = 0;
+  };
+
+  void attach(uint8_t address, Device* device);  // nullptr detaches
+}
+
+class TwoWire {
+ public:
+  bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+  bool end() { return true; }
+  bool setClock(uint32_t frequency);
+
+  void beginTransmission(uint16_t address);
+  void beginTransmission(uint8_t address) { beginTransmission(static_cast<uint16_t>(address)); }
+  void beginTransmission(int address) { beginTransmission(static_cast<uint16_t>(address)); }
+  uint8_t endTransmission(bool sendStop = true);  // 0 ok, 2 address NACK
+
+  size_t requestFrom(uint16_t address, size_t size, bool sendStop);
+  uint8_t requestFrom(uint8_t address, uint8_t size) {
+    return static_cast<uint8_t>(requestFrom(static_cast<uint16_t>(address), static_cast<size_t>(size), true));
+  }
+
+  size_t write(uint8_t data);
+  size_t write(const uint8_t* data, size_t len);
+  int available();
+  int read();
+  int peek();
+
+ private:
+  static constexpr size_t BUFFER_SIZE = 128;
+  uint16_t txAddress_ = 0;
+  uint8_t txBuf_[BUFFER_SIZE];
+  size_t txLen_ = 0;
+  uint8_t rxBuf_[BUFFER_SIZE];
+  size_t rxLen_ = 0;
+  size_t rxPos_ = 0;
+};
+
+extern TwoWire Wire;
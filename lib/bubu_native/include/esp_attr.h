@@ -0,0 +1,8 @@
+#pragma once
+// Memory placement attributes have no meaning on the host. RTC_NOINIT data
+// starts zeroed, as after a power-on.
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define EXT_RAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
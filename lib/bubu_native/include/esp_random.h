@@ -0,0 +1,5 @@
+#pragma once
+#include <stdint.h>
+
+// Fixed seed sequence on the host, so runs repeat (see NativeHost::setSeed).
+uint32_t esp_random();
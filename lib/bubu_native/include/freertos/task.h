@@ -0,0 +1,19 @@
+#pragma once
+#include "FreeRTOS.h"
+
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+void delay(uint32_t ms);
+uint32_t millis();
+
+// No second thread on the host: creation fails, so callers take their
+// synchronous fallback (the logger writes straight to Serial).
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t, const char*, uint32_t, void*, UBaseType_t,
+                                          TaskHandle_t* handle, BaseType_t) {
+  if (handle) *handle = nullptr;
+  return pdFAIL;
+}
+inline void vTaskDelete(TaskHandle_t) {}
+inline void vTaskDelay(TickType_t ticks) { delay(ticks * portTICK_PERIOD_MS); }
+inline TickType_t xTaskGetTickCount() { return millis() / portTICK_PERIOD_MS; }
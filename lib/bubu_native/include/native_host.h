@@ -0,0 +1,54 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_system.h"
+
+// Controls and read-outs of the native build ([env:native]), for the host
+// main() and for tools that drive the real setup()/loop() headlessly.
+namespace NativeHost {
+
+  // --- run ---
+  // Ends the run after the current loop() pass; main() returns exitCode.
+  void stop(int exitCode = 0);
+  bool stopped();
+  uint32_t loopPasses();
+  // Command-line arguments after "--", for the program under test.
+  int argc();
+  char** argv();
+
+  // --- display (LovyanGFX panel) ---
+  // Last image pushed to the panel, RGB565 row-major; nullptr before init().
+  const uint16_t* framebuffer();
+  int32_t panelWidth();
+  int32_t panelHeight();
+  uint32_t panelWrites();       // setAddrWindow/pushSprite transfers
+  uint64_t panelPixels();       // pixels written to the panel
+  uint64_t frameHash();         // FNV-1a over the framebuffer
+  bool writePpm(const char* path);
+
+  // --- inputs ---
+  // Drives a GPIO input; attached interrupts fire on the matching edge.
+  void setPin(uint8_t pin, int level);
+  void setBatteryMv(uint32_t vbatMv);  // voltage before the 1:2 divider
+
+  // --- outputs ---
+  int digitalLevel(uint8_t pin);  // last digitalWrite(), or the input level
+  uint32_t ledcDuty(uint8_t pin);  // duty of the LEDC channel attached to pin
+  uint64_t audioBytes();           // bytes accepted by i2s_write()
+
+  // --- heap (esp_heap_caps) ---
+  struct HeapUse {
+    size_t internalPeak;
+    size_t spiramPeak;
+    uint32_t allocations;
+    uint32_t failures;  // over a capability's budget
+  };
+  HeapUse heapUse();
+
+  // --- clock ---
+  void advanceMs(uint32_t ms);  // what delay() does, without a loop pass
+
+  // --- reset ---
+  // What esp_reset_reason() reports (ESP_RST_POWERON until set).
+  void setResetReason(esp_reset_reason_t reason);
+}
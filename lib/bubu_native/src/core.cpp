@@ -0,0 +1,220 @@
+// Native core: clock, random, GPIO, LEDC, Serial and reset.
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <esp_random.h>
+#include <esp_system.h>
+#include <time.h>
+#include <chrono>
+#include "native_host.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+
+namespace {
+
+constexpr uint8_t PIN_COUNT = 64;
+constexpr uint8_t LEDC_CHANNELS = 16;
+constexpr uint8_t MAX_SHUTDOWN_HANDLERS = 8;
+
+const std::chrono::steady_clock::time_point hostStart = std::chrono::steady_clock::now();
+uint32_t simMs = 0;
+
+struct Pin {
+  int level = LOW;
+  uint8_t mode = INPUT;
+  void (*isr)() = nullptr;
+  int isrMode = 0;
+};
+Pin pins[PIN_COUNT];
+bool interruptsOn = true;
+
+uint32_t ledcDutyOf[LEDC_CHANNELS];
+int ledcPin[LEDC_CHANNELS];
+bool ledcInit = false;
+
+uint32_t hwRandomState = 0x2545F491u;  // esp_random(): fixed sequence
+uint32_t swRandomState = 1;            // random() after randomSeed()
+bool useHwRandom = true;
+
+esp_reset_reason_t resetReason = ESP_RST_POWERON;
+shutdown_handler_t shutdownHandlers[MAX_SHUTDOWN_HANDLERS];
+uint8_t shutdownCount = 0;
+
+uint64_t hostMicros() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - hostStart).count());
+}
+
+uint32_t xorshift(uint32_t& s) {
+  s ^= s << 13;
+  s ^= s >> 17;
+  s ^= s << 5;
+  return s;
+}
+
+}  // namespace
+
+// --- clock ---
+
+uint32_t millis() { return simMs; }
+uint32_t micros() { return static_cast<uint32_t>(hostMicros()); }
+void delay(uint32_t ms) { simMs += ms; }
+void delayMicroseconds(uint32_t us) { simMs += us / 1000; }
+void yield() {}
+
+// --- random ---
+
+uint32_t esp_random() { return xorshift(hwRandomState); }
+
+void randomSeed(unsigned long seed) {
+  if (seed == 0) return;
+  swRandomState = static_cast<uint32_t>(seed);
+  useHwRandom = false;
+}
+
+long random(long howbig) {
+  if (howbig <= 0) return 0;
+  uint32_t r = useHwRandom ? esp_random() : xorshift(swRandomState);
+  return static_cast<long>(r % static_cast<uint32_t>(howbig));
+}
+
+long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) return howsmall;
+  return random(howbig - howsmall) + howsmall;
+}
+
+// --- GPIO and LEDC ---
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin >= PIN_COUNT) return;
+  pins[pin].mode = mode;
+  if (mode == INPUT_PULLUP) pins[pin].level = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  if (pin < PIN_COUNT) pins[pin].level = val ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+  return pin < PIN_COUNT ? pins[pin].level : LOW;
+}
+
+void attachInterrupt(uint8_t pin, void (*isr)(void), int mode) {
+  if (pin >= PIN_COUNT) return;
+  pins[pin].isr = isr;
+  pins[pin].isrMode = mode;
+}
+
+void detachInterrupt(uint8_t pin) {
+  if (pin < PIN_COUNT) pins[pin].isr = nullptr;
+}
+
+void noInterrupts() { interruptsOn = false; }
+void interrupts() { interruptsOn = true; }
+
+double ledcSetup(uint8_t channel, double freq, uint8_t) {
+  return channel < LEDC_CHANNELS ? freq : 0;
+}
+
+void ledcAttachPin(uint8_t pin, uint8_t channel) {
+  if (!ledcInit) {
+    for (int& p : ledcPin) p = -1;
+    ledcInit = true;
+  }
+  if (channel < LEDC_CHANNELS) ledcPin[channel] = pin;
+}
+
+void ledcWrite(uint8_t channel, uint32_t duty) {
+  if (channel < LEDC_CHANNELS) ledcDutyOf[channel] = duty;
+}
+
+bool psramFound() { return true; }
+
+void configTzTime(const char* tz, const char*, const char*, const char*) {
+  setenv("TZ", tz, 1);
+  tzset();
+}
+
+// --- Serial ---
+
+void HardwareSerial::begin(unsigned long) {}
+
+size_t HardwareSerial::write(uint8_t c) {
+  return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buf, size_t len) {
+  return fwrite(buf, 1, len, stdout);
+}
+
+size_t HardwareSerial::print(const char* s) {
+  return fputs(s, stdout) < 0 ? 0 : strlen(s);
+}
+
+size_t HardwareSerial::println(const char* s) {
+  return print(s) + print("\r\n");
+}
+
+size_t HardwareSerial::printf(const char* fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  int n = vprintf(fmt, args);
+  va_end(args);
+  return n < 0 ? 0 : static_cast<size_t>(n);
+}
+
+void HardwareSerial::flush() { fflush(stdout); }
+
+// --- ESP ---
+
+uint32_t EspClass::getCycleCount() { return static_cast<uint32_t>(hostMicros() * 240); }
+
+uint32_t EspClass::getFreeHeap() {
+  return static_cast<uint32_t>(heap_caps_get_free_size(MALLOC_CAP_INTERNAL));
+}
+
+void EspClass::restart() { esp_restart(); }
+
+esp_reset_reason_t esp_reset_reason() { return resetReason; }
+
+esp_err_t esp_register_shutdown_handler(shutdown_handler_t handler) {
+  if (shutdownCount >= MAX_SHUTDOWN_HANDLERS) return ESP_ERR_NO_MEM;
+  shutdownHandlers[shutdownCount++] = handler;
+  return ESP_OK;
+}
+
+void esp_restart() {
+  for (uint8_t i = shutdownCount; i > 0; --i) shutdownHandlers[i - 1]();
+  fflush(stdout);
+  exit(0);
+}
+
+// --- NativeHost ---
+
+namespace NativeHost {
+
+void setPin(uint8_t pin, int level) {
+  if (pin >= PIN_COUNT) return;
+  Pin& p = pins[pin];
+  int old = p.level;
+  p.level = level ? HIGH : LOW;
+  if (!p.isr || !interruptsOn || old == p.level) return;
+  bool rising = p.level == HIGH;
+  if (p.isrMode == CHANGE || (p.isrMode == RISING && rising) || (p.isrMode == FALLING && !rising)) p.isr();
+}
+
+int digitalLevel(uint8_t pin) { return digitalRead(pin); }
+
+uint32_t ledcDuty(uint8_t pin) {
+  if (!ledcInit) return 0;
+  for (uint8_t ch = 0; ch < LEDC_CHANNELS; ++ch) {
+    if (ledcPin[ch] == pin) return ledcDutyOf[ch];
+  }
+  return 0;
+}
+
+void advanceMs(uint32_t ms) { simMs += ms; }
+
+void setResetReason(esp_reset_reason_t reason) { resetReason = reason; }
+
+}  // namespace NativeHost
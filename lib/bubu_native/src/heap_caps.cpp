@@ -0,0 +1,120 @@
+// Native esp_heap_caps: malloc with per-capability budgets and peaks.
+#include <esp_heap_caps.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unordered_map>
+#include "native_host.h"
+
+namespace {
+
+// ESP32-S3 N16R8 after boot: internal heap and the 8 MB PSRAM.
+constexpr size_t INTERNAL_BUDGET = 320 * 1024;
+constexpr size_t SPIRAM_BUDGET = 8 * 1024 * 1024;
+
+enum Pool : uint8_t { INTERNAL, SPIRAM, POOL_COUNT };
+
+struct Block {
+  size_t size;
+  Pool pool;
+};
+
+// Keyed by the malloc() pointer itself, so memory the firmware releases with
+// plain free() (allowed on the device) stays valid. Such a block keeps
+// counting as used until its address is handed out again.
+std::unordered_map<void*, Block>& blocks() {
+  static std::unordered_map<void*, Block> b;
+  return b;
+}
+
+const size_t BUDGET[POOL_COUNT] = {INTERNAL_BUDGET, SPIRAM_BUDGET};
+size_t used[POOL_COUNT];
+size_t peak[POOL_COUNT];
+uint32_t allocations = 0;
+uint32_t failures = 0;
+
+void forget(void* p) {
+  auto it = blocks().find(p);
+  if (it == blocks().end()) return;
+  used[it->second.pool] -= it->second.size;
+  blocks().erase(it);
+}
+
+Pool poolFor(uint32_t caps) {
+  return (caps & MALLOC_CAP_SPIRAM) ? SPIRAM : INTERNAL;
+}
+
+size_t freeIn(uint32_t caps) {
+  if (caps & MALLOC_CAP_SPIRAM) return BUDGET[SPIRAM] - used[SPIRAM];
+  if (caps & (MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA)) return BUDGET[INTERNAL] - used[INTERNAL];
+  return BUDGET[INTERNAL] - used[INTERNAL] + BUDGET[SPIRAM] - used[SPIRAM];
+}
+
+}  // namespace
+
+void* heap_caps_malloc(size_t size, uint32_t caps) {
+  Pool pool = poolFor(caps);
+  if (size > BUDGET[pool] - used[pool]) {
+    ++failures;
+    return nullptr;
+  }
+  void* p = malloc(size ? size : 1);
+  if (!p) return nullptr;
+  forget(p);  // a block released with free()
+  blocks()[p] = Block{size, pool};
+  used[pool] += size;
+  if (used[pool] > peak[pool]) peak[pool] = used[pool];
+  ++allocations;
+  return p;
+}
+
+void* heap_caps_calloc(size_t n, size_t size, uint32_t caps) {
+  if (size && n > static_cast<size_t>(-1) / size) return nullptr;
+  void* p = heap_caps_malloc(n * size, caps);
+  if (p) memset(p, 0, n * size);
+  return p;
+}
+
+void* heap_caps_realloc(void* ptr, size_t size, uint32_t caps) {
+  if (!ptr) return heap_caps_malloc(size, caps);
+  auto it = blocks().find(ptr);
+  size_t old = it == blocks().end() ? 0 : it->second.size;
+  void* p = heap_caps_malloc(size, caps);
+  if (!p) return nullptr;
+  memcpy(p, ptr, old < size ? old : size);
+  heap_caps_free(ptr);
+  return p;
+}
+
+void heap_caps_free(void* ptr) {
+  if (!ptr) return;
+  forget(ptr);
+  free(ptr);
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+  return freeIn(caps);
+}
+
+size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+  if (caps & MALLOC_CAP_SPIRAM) return BUDGET[SPIRAM] - peak[SPIRAM];
+  return BUDGET[INTERNAL] - peak[INTERNAL];
+}
+
+// No fragmentation model: the largest block is all that is free.
+size_t heap_caps_get_largest_free_block(uint32_t caps) {
+  return freeIn(caps);
+}
+
+size_t heap_caps_get_total_size(uint32_t caps) {
+  if (caps & MALLOC_CAP_SPIRAM) return BUDGET[SPIRAM];
+  return BUDGET[INTERNAL];
+}
+
+namespace NativeHost {
+
+HeapUse heapUse() {
+  HeapUse u = {peak[INTERNAL], peak[SPIRAM], allocations, failures};
+  return u;
+}
+
+}  // namespace NativeHost
@@ -0,0 +1,171 @@
+// Native LovyanGFX: panel framebuffer and RGB565 sprites.
+#include <LovyanGFX.hpp>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "native_host.h"
+
+namespace {
+lgfx::LGFX_Device* panel = nullptr;  // the device init() ran on last
+uint32_t writes = 0;
+uint64_t pixels = 0;
+}
+
+namespace lgfx {
+
+LGFX_Device::~LGFX_Device() {
+  if (panel == this) panel = nullptr;
+  free(fb_);
+}
+
+bool LGFX_Device::init() {
+  if (!fb_) fb_ = static_cast<uint16_t*>(calloc(static_cast<size_t>(width()) * height(), sizeof(uint16_t)));
+  panel = this;
+  return fb_ != nullptr;
+}
+
+int32_t LGFX_Device::width() const {
+  return panel_ ? panel_->config().panel_width : 0;
+}
+
+int32_t LGFX_Device::height() const {
+  return panel_ ? panel_->config().panel_height : 0;
+}
+
+void LGFX_Device::setAddrWindow(int32_t x, int32_t y, int32_t w, int32_t h) {
+  winX_ = x;
+  winY_ = y;
+  winW_ = w;
+  winH_ = h;
+  winPos_ = 0;
+  ++writes;
+}
+
+// Fills the window row by row from where the last call stopped.
+void LGFX_Device::writePixels(const rgb565_t* data, size_t len) {
+  if (!fb_ || winW_ <= 0) return;
+  const int32_t fbW = width();
+  const int32_t fbH = height();
+  size_t end = winPos_ + len;
+  const size_t winSize = static_cast<size_t>(winW_) * winH_;
+  if (end > winSize) end = winSize;
+  while (winPos_ < end) {
+    int32_t col = static_cast<int32_t>(winPos_ % winW_);
+    int32_t y = winY_ + static_cast<int32_t>(winPos_ / winW_);
+    size_t run = static_cast<size_t>(winW_ - col);
+    if (run > end - winPos_) run = end - winPos_;
+    int32_t x0 = winX_ + col;
+    int32_t x1 = x0 + static_cast<int32_t>(run);
+    const rgb565_t* src = data;
+    if (x0 < 0) {
+      src -= x0;
+      x0 = 0;
+    }
+    if (x1 > fbW) x1 = fbW;
+    if (y >= 0 && y < fbH && x1 > x0) {
+      memcpy(fb_ + y * fbW + x0, src, static_cast<size_t>(x1 - x0) * sizeof(uint16_t));
+      pixels += static_cast<uint64_t>(x1 - x0);
+    }
+    data += run;
+    winPos_ += run;
+  }
+}
+
+void LGFX_Device::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data) {
+  setAddrWindow(x, y, w, h);
+  writePixels(reinterpret_cast<const rgb565_t*>(data), static_cast<size_t>(w) * h);
+}
+
+void* LGFX_Sprite::createSprite(int32_t w, int32_t h) {
+  deleteSprite();
+  if (w <= 0 || h <= 0 || depth_ != 16) return nullptr;
+  buf_ = static_cast<uint16_t*>(calloc(static_cast<size_t>(w) * h, sizeof(uint16_t)));
+  if (!buf_) return nullptr;
+  w_ = w;
+  h_ = h;
+  return buf_;
+}
+
+void LGFX_Sprite::deleteSprite() {
+  free(buf_);
+  buf_ = nullptr;
+  w_ = h_ = 0;
+}
+
+void LGFX_Sprite::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+  if (!buf_) return;
+  int32_t x0 = x < 0 ? 0 : x;
+  int32_t y0 = y < 0 ? 0 : y;
+  int32_t x1 = x + w > w_ ? w_ : x + w;
+  int32_t y1 = y + h > h_ ? h_ : y + h;
+  for (int32_t yy = y0; yy < y1; ++yy) {
+    for (int32_t xx = x0; xx < x1; ++xx) buf_[yy * w_ + xx] = color;
+  }
+}
+
+// Corners are quarter circles of radius r, as in LovyanGFX.
+void LGFX_Sprite::fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint16_t color) {
+  if (w <= 0 || h <= 0) return;
+  int32_t maxR = (w < h ? w : h) / 2;
+  if (r > maxR) r = maxR;
+  if (r <= 0) {
+    fillRect(x, y, w, h, color);
+    return;
+  }
+  fillRect(x, y + r, w, h - 2 * r, color);
+  for (int32_t dy = 0; dy < r; ++dy) {
+    int32_t ry = r - dy;  // distance from the corner circle's center row
+    int32_t dx = 0;
+    while ((dx + 1) * (dx + 1) + ry * ry <= r * r) ++dx;
+    int32_t inset = r - dx;
+    fillRect(x + inset, y + dy, w - 2 * inset, 1, color);
+    fillRect(x + inset, y + h - 1 - dy, w - 2 * inset, 1, color);
+  }
+}
+
+void LGFX_Sprite::pushSprite(int32_t x, int32_t y) {
+  if (!parent_ || !buf_) return;
+  parent_->pushImage(x, y, w_, h_, buf_);
+}
+
+}  // namespace lgfx
+
+namespace NativeHost {
+
+const uint16_t* framebuffer() { return panel ? panel->framebuffer() : nullptr; }
+int32_t panelWidth() { return panel ? panel->width() : 0; }
+int32_t panelHeight() { return panel ? panel->height() : 0; }
+uint32_t panelWrites() { return writes; }
+uint64_t panelPixels() { return pixels; }
+
+uint64_t frameHash() {
+  const uint16_t* fb = framebuffer();
+  uint64_t h = 0xcbf29ce484222325ull;
+  if (!fb) return h;
+  const int32_t n = panelWidth() * panelHeight();
+  for (int32_t i = 0; i < n; ++i) {
+    h = (h ^ (fb[i] & 0xFF)) * 0x100000001b3ull;
+    h = (h ^ (fb[i] >> 8)) * 0x100000001b3ull;
+  }
+  return h;
+}
+
+// Binary PPM (P6), RGB565 widened to 8 bits per channel.
+bool writePpm(const char* path) {
+  const uint16_t* fb = framebuffer();
+  if (!fb) return false;
+  FILE* f = fopen(path, "wb");
+  if (!f) return false;
+  int32_t w = panelWidth();
+  int32_t h = panelHeight();
+  fprintf(f, "P6\n%d %d\n255\n", static_cast<int>(w), static_cast<int>(h));
+  for (int32_t i = 0; i < w * h; ++i) {
+    uint16_t c = fb[i];
+    uint8_t rgb[3] = {static_cast<uint8_t>((c >> 11) * 255 / 31), static_cast<uint8_t>(((c >> 5) & 0x3F) * 255 / 63),
+                      static_cast<uint8_t>((c & 0x1F) * 255 / 31)};
+    fwrite(rgb, 1, 3, f);
+  }
+  return fclose(f) == 0;
+}
+
+}  // namespace NativeHost
@@ -0,0 +1,78 @@
+// main() of the native build: the real setup() and loop() on simulated time.
+//
+//   pio run -e native && .pio/build/native/program [--ms N] [--ppm FILE] [-- ARGS]
+//
+// Serial output goes to stdout; the run summary (simulated and wall time,
+// panel traffic, heap peaks) goes to stderr. --ms sets how much simulated
+// time to run (default 60 s); --ppm saves the last panel image. Anything
+// after "--" is left to the program through NativeHost::argc()/argv().
+#include <Arduino.h>
+#include <chrono>
+#include "native_host.h"
+
+namespace {
+bool stopRequested = false;
+int exitStatus = 0;
+uint32_t passes = 0;
+int programArgc = 0;
+char** programArgv = nullptr;
+}
+
+namespace NativeHost {
+
+void stop(int exitCode) {
+  stopRequested = true;
+  exitStatus = exitCode;
+}
+
+bool stopped() { return stopRequested; }
+uint32_t loopPasses() { return passes; }
+int argc() { return programArgc; }
+char** argv() { return programArgv; }
+
+}  // namespace NativeHost
+
+int main(int argc, char** argv) {
+  uint32_t runMs = 60000;
+  const char* ppmPath = nullptr;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--ms") && i + 1 < argc) {
+      runMs = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+    } else if (!strcmp(argv[i], "--ppm") && i + 1 < argc) {
+      ppmPath = argv[++i];
+    } else if (!strcmp(argv[i], "--")) {
+      programArgc = argc - i - 1;
+      programArgv = argv + i + 1;
+      break;
+    } else {
+      fprintf(stderr, "usage: %s [--ms N] [--ppm FILE] [-- ARGS]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  auto wallStart = std::chrono::steady_clock::now();
+  setup();
+  while (!stopRequested && millis() < runMs) {
+    loop();
+    ++passes;
+  }
+  fflush(stdout);
+  long wallMs = static_cast<long>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - wallStart).count());
+
+  NativeHost::HeapUse heap = NativeHost::heapUse();
+  fprintf(stderr, "[native] %lu ms simulated in %ld ms, %lu loop passes\n", static_cast<unsigned long>(millis()),
+          wallMs, static_cast<unsigned long>(passes));
+  fprintf(stderr, "[native] panel: %lu transfers, %llu pixels\n", static_cast<unsigned long>(NativeHost::panelWrites()),
+          static_cast<unsigned long long>(NativeHost::panelPixels()));
+  fprintf(stderr, "[native] heap peak: internal %lu, PSRAM %lu bytes; %lu allocations, %lu over budget\n",
+          static_cast<unsigned long>(heap.internalPeak), static_cast<unsigned long>(heap.spiramPeak),
+          static_cast<unsigned long>(heap.allocations), static_cast<unsigned long>(heap.failures));
+  fprintf(stderr, "[native] audio: %llu bytes\n", static_cast<unsigned long long>(NativeHost::audioBytes()));
+
+  if (ppmPath && !NativeHost::writePpm(ppmPath)) {
+    fprintf(stderr, "[native] cannot write %s\n", ppmPath);
+    return 1;
+  }
+  return exitStatus;
+}
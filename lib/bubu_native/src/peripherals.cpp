@@ -0,0 +1,142 @@
+// Native ADC, I2S and flash partitions.
+#include <driver/adc.h>
+#include <driver/i2s.h>
+#include <esp_adc_cal.h>
+#include <esp_partition.h>
+#include <stdlib.h>
+#include <string.h>
+#include "native_host.h"
+
+namespace {
+
+constexpr uint32_t ADC_FULL_SCALE_MV = 3100;  // 12 dB attenuation
+constexpr uint32_t ADC_MAX_RAW = 4095;
+uint32_t batteryMv = 3900;
+
+uint64_t audio = 0;
+bool i2sInstalled[2];
+
+// Partitions of default_16MB.csv the firmware opens.
+struct Partition {
+  esp_partition_t info;
+  uint8_t* data;
+};
+Partition partitions[] = {
+  {{ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, 0xD10000, 0x2F0000, 4096, "spiffs"}, nullptr},
+};
+
+Partition* owner(const esp_partition_t* part) {
+  for (Partition& p : partitions) {
+    if (&p.info == part) return &p;
+  }
+  return nullptr;
+}
+
+uint8_t* dataOf(Partition& p) {
+  if (!p.data) {
+    p.data = static_cast<uint8_t*>(malloc(p.info.size));
+    if (p.data) memset(p.data, 0xFF, p.info.size);
+  }
+  return p.data;
+}
+
+bool inRange(const esp_partition_t* part, size_t offset, size_t size) {
+  return offset <= part->size && size <= part->size - offset;
+}
+
+}  // namespace
+
+// --- ADC ---
+
+esp_err_t adc1_config_width(adc_bits_width_t) { return ESP_OK; }
+esp_err_t adc1_config_channel_atten(adc1_channel_t, adc_atten_t) { return ESP_OK; }
+
+int adc1_get_raw(adc1_channel_t) {
+  uint32_t pinMv = batteryMv / 2;
+  uint32_t raw = pinMv * ADC_MAX_RAW / ADC_FULL_SCALE_MV;
+  return static_cast<int>(raw > ADC_MAX_RAW ? ADC_MAX_RAW : raw);
+}
+
+esp_adc_cal_value_t esp_adc_cal_characterize(adc_unit_t unit, adc_atten_t atten, adc_bits_width_t width,
+                                             uint32_t defaultVref, esp_adc_cal_characteristics_t* chars) {
+  if (chars) *chars = esp_adc_cal_characteristics_t{unit, atten, width, defaultVref};
+  return ESP_ADC_CAL_VAL_DEFAULT_VREF;
+}
+
+uint32_t esp_adc_cal_raw_to_voltage(uint32_t raw, const esp_adc_cal_characteristics_t*) {
+  return raw * ADC_FULL_SCALE_MV / ADC_MAX_RAW;
+}
+
+// --- I2S ---
+
+esp_err_t i2s_driver_install(i2s_port_t port, const i2s_config_t*, int, void*) {
+  if (port > I2S_NUM_1 || i2sInstalled[port]) return ESP_FAIL;
+  i2sInstalled[port] = true;
+  return ESP_OK;
+}
+
+esp_err_t i2s_driver_uninstall(i2s_port_t port) {
+  if (port > I2S_NUM_1 || !i2sInstalled[port]) return ESP_FAIL;
+  i2sInstalled[port] = false;
+  return ESP_OK;
+}
+
+esp_err_t i2s_set_pin(i2s_port_t port, const i2s_pin_config_t*) {
+  return port <= I2S_NUM_1 && i2sInstalled[port] ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t i2s_zero_dma_buffer(i2s_port_t port) {
+  return port <= I2S_NUM_1 && i2sInstalled[port] ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t i2s_write(i2s_port_t port, const void*, size_t size, size_t* written, TickType_t) {
+  if (port > I2S_NUM_1 || !i2sInstalled[port]) return ESP_FAIL;
+  audio += size;
+  if (written) *written = size;
+  return ESP_OK;
+}
+
+// --- partitions ---
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char* label) {
+  for (Partition& p : partitions) {
+    if (p.info.type == type && p.info.subtype == subtype && (!label || !strcmp(label, p.info.label))) {
+      return dataOf(p) ? &p.info : nullptr;
+    }
+  }
+  return nullptr;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t* part, size_t offset, void* dst, size_t size) {
+  Partition* p = owner(part);
+  if (!p || !inRange(part, offset, size)) return ESP_ERR_INVALID_SIZE;
+  memcpy(dst, dataOf(*p) + offset, size);
+  return ESP_OK;
+}
+
+// NOR flash: programming only clears bits.
+esp_err_t esp_partition_write(const esp_partition_t* part, size_t offset, const void* src, size_t size) {
+  Partition* p = owner(part);
+  if (!p || !inRange(part, offset, size)) return ESP_ERR_INVALID_SIZE;
+  uint8_t* d = dataOf(*p) + offset;
+  const uint8_t* s = static_cast<const uint8_t*>(src);
+  for (size_t i = 0; i < size; ++i) d[i] &= s[i];
+  return ESP_OK;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t* part, size_t offset, size_t size) {
+  Partition* p = owner(part);
+  if (!p || !inRange(part, offset, size) || offset % part->erase_size || size % part->erase_size) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  memset(dataOf(*p) + offset, 0xFF, size);
+  return ESP_OK;
+}
+
+namespace NativeHost {
+
+void setBatteryMv(uint32_t vbatMv) { batteryMv = vbatMv; }
+uint64_t audioBytes() { return audio; }
+
+}  // namespace NativeHost
@@ -0,0 +1,69 @@
+// Native I2C bus: transactions go to attached device models.
+#include <Wire.h>
+
+TwoWire Wire;
+
+namespace {
+NativeWire::Device* devices[128];
+}
+
+namespace NativeWire {
+
+void attach(uint8_t address, Device* device) {
+  if (address < 128) devices[address] = device;
+}
+
+}  // namespace NativeWire
+
+bool TwoWire::begin(int, int, uint32_t) {
+  return true;
+}
+
+bool TwoWire::setClock(uint32_t) {
+  return true;
+}
+
+void TwoWire::beginTransmission(uint16_t address) {
+  txAddress_ = address;
+  txLen_ = 0;
+}
+
+uint8_t TwoWire::endTransmission(bool) {
+  NativeWire::Device* dev = txAddress_ < 128 ? devices[txAddress_] : nullptr;
+  bool acked = dev && dev->write(txBuf_, txLen_);
+  txLen_ = 0;
+  return acked ? 0 : 2;
+}
+
+size_t TwoWire::requestFrom(uint16_t address, size_t size, bool) {
+  rxLen_ = rxPos_ = 0;
+  NativeWire::Device* dev = address < 128 ? devices[address] : nullptr;
+  if (!dev) return 0;
+  if (size > BUFFER_SIZE) size = BUFFER_SIZE;
+  rxLen_ = dev->read(rxBuf_, size);
+  return rxLen_;
+}
+
+size_t TwoWire::write(uint8_t data) {
+  if (txLen_ >= BUFFER_SIZE) return 0;
+  txBuf_[txLen_++] = data;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t len) {
+  size_t n = 0;
+  while (n < len && write(data[n])) ++n;
+  return n;
+}
+
+int TwoWire::available() {
+  return static_cast<int>(rxLen_ - rxPos_);
+}
+
+int TwoWire::read() {
+  return rxPos_ < rxLen_ ? rxBuf_[rxPos_++] : -1;
+}
+
+int TwoWire::peek() {
+  return rxPos_ < rxLen_ ? rxBuf_[rxPos_] : -1;
+}
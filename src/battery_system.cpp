@@ -1,4 +1,5 @@
 #include "battery_system.h"
+#include "bubu_clock.h"
 #include "tca6408.h"
 #include "logger.h"
 
@@ -103,7 +104,7 @@ void begin() {
 }
 
 void update() {
-  uint32_t now = millis();
+  uint32_t now = BubuClock::nowMs();
   bool usbPresent = false;
   uint8_t usbInputs = 0;
   bool usbValid = readUsbPresent(usbPresent, usbInputs);
@@ -125,11 +126,11 @@ void update() {
   if (USB_DETECT_LOG) {
     if (!usbValid) {
       if (lastUsbValid) {
-        BatteryLog::println("[Battery] TCA6408 read failed");
+        LOG_WARN(BatteryLog, "[Battery] TCA6408 read failed\n");
       }
     } else if (!lastUsbInputsValid || usbInputs != lastUsbInputs) {
-      BatteryLog::printf("[Battery] TCA inputs=0x%02X usbPresent=%d\n",
-                         usbInputs, usbPresent ? 1 : 0);
+      LOG_INFO(BatteryLog, "[Battery] TCA inputs=0x%02X usbPresent=%d\n",
+                           usbInputs, usbPresent ? 1 : 0);
       lastUsbInputs = usbInputs;
       lastUsbInputsValid = true;
     }
@@ -236,13 +237,13 @@ void update() {
   vbatPrevValid = true;
 
   if (BATTERY_STATUS_LOG) {
-    BatteryLog::printf("[Battery] vbat=%.3fV percent=%u state=%d usb=%d valid=%d inputs=0x%02X\n",
-                       static_cast<double>(vbatFiltered),
-                       status.percent,
-                       static_cast<int>(status.state),
-                       usbPresent ? 1 : 0,
-                       usbValid ? 1 : 0,
-                       usbInputs);
+    LOG_INFO(BatteryLog, "[Battery] vbat=%.3fV percent=%u state=%d usb=%d valid=%d inputs=0x%02X\n",
+                         static_cast<double>(vbatFiltered),
+                         status.percent,
+                         static_cast<int>(status.state),
+                         usbPresent ? 1 : 0,
+                         usbValid ? 1 : 0,
+                         usbInputs);
   }
 }
 
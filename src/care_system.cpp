@@ -1,5 +1,8 @@
 #include "care_system.h"
-#include "level_system.h"
+#include "bubu_clock.h"
+#include "event_bus.h"
+#include "persist_store.h"
+#include "stat_log/stat_log.h"
 #include <Preferences.h>
 
 // 0–100 range
@@ -15,7 +18,6 @@ static const uint8_t HUNGER_DECAY_MIN      = 6;   // -1 / 6 min
 static const uint8_t MOOD_DECAY_MIN        = 8;   // -1 / 8 min
 static const uint8_t ENERGY_DECAY_MIN      = 5;   // -1 / 5 min
 static const uint8_t CLEANLINESS_DECAY_MIN = 10;  // -1 / 10 min
-static const uint32_t SAVE_INTERVAL_MS = 10UL * 60UL * 1000UL;
 static const int DEFAULT_STAT_VALUE = 30;
 
 // We tick every 60s and accumulate minutes
@@ -33,10 +35,16 @@ namespace CareSystem {
   static uint32_t moodAccMin     = 0;
   static uint32_t energyAccMin   = 0;
   static uint32_t cleanAccMin    = 0;
-  static uint32_t lastSaveMs     = 0;
   static bool decaySuspended     = false;
-  static Preferences prefs;
-  static bool prefsReady         = false;
+  static uint32_t statsVersion   = 0;
+
+  struct SavedStats {
+    uint8_t hunger;
+    uint8_t mood;
+    uint8_t energy;
+    uint8_t cleanliness;
+  };
+  static const uint8_t STATS_VERSION = 1;
 
   static int clampStat(int v) {
     if (v < STAT_MIN) return STAT_MIN;
@@ -44,14 +52,25 @@ namespace CareSystem {
     return v;
   }
 
-  static void applySnapshot(bool hasSnapshot) {
-    if (hasSnapshot) {
-      hunger      = prefs.getInt("h", DEFAULT_STAT_VALUE);
-      mood        = prefs.getInt("m", DEFAULT_STAT_VALUE);
-      energy      = prefs.getInt("e", DEFAULT_STAT_VALUE);
-      cleanliness = prefs.getInt("c", DEFAULT_STAT_VALUE);
+  static void loadSnapshot() {
+    SavedStats saved;
+    if (PersistStore::read(PersistStore::Slot::CARE, STATS_VERSION, &saved, sizeof(saved))) {
+      hunger      = saved.hunger;
+      mood        = saved.mood;
+      energy      = saved.energy;
+      cleanliness = saved.cleanliness;
     } else {
-      hunger = mood = energy = cleanliness = DEFAULT_STAT_VALUE;
+      // Older firmware kept the stats in their own namespace
+      Preferences prefs;
+      if (prefs.begin("care_stats", true) && prefs.getBool("has", false)) {
+        hunger      = prefs.getInt("h", DEFAULT_STAT_VALUE);
+        mood        = prefs.getInt("m", DEFAULT_STAT_VALUE);
+        energy      = prefs.getInt("e", DEFAULT_STAT_VALUE);
+        cleanliness = prefs.getInt("c", DEFAULT_STAT_VALUE);
+      } else {
+        hunger = mood = energy = cleanliness = DEFAULT_STAT_VALUE;
+      }
+      prefs.end();
     }
     hunger      = clampStat(hunger);
     mood        = clampStat(mood);
@@ -59,17 +78,19 @@ namespace CareSystem {
     cleanliness = clampStat(cleanliness);
   }
 
+  // Hands the current stats to the store; it only writes them out when they
+  // changed, on its own schedule.
   static void saveSnapshot() {
-    if (!prefsReady) return;
-    prefs.putBool("has", true);
-    prefs.putInt("h", hunger);
-    prefs.putInt("m", mood);
-    prefs.putInt("e", energy);
-    prefs.putInt("c", cleanliness);
+    SavedStats saved = {
+      static_cast<uint8_t>(hunger), static_cast<uint8_t>(mood),
+      static_cast<uint8_t>(energy), static_cast<uint8_t>(cleanliness)
+    };
+    PersistStore::write(PersistStore::Slot::CARE, STATS_VERSION, &saved, sizeof(saved));
   }
 
   static void applyDecay(uint32_t minutes) {
     if (minutes == 0) return;
+    int before[4] = {hunger, mood, energy, cleanliness};
 
     hungerAccMin   += minutes;
     moodAccMin     += minutes;
@@ -108,34 +129,37 @@ namespace CareSystem {
     mood        = clampStat(mood);
     energy      = clampStat(energy);
     cleanliness = clampStat(cleanliness);
+    if (before[0] != hunger || before[1] != mood || before[2] != energy || before[3] != cleanliness) ++statsVersion;
   }
 
-  void begin() {
-    prefsReady = prefs.begin("care_stats", false);
-    if (prefsReady) {
-      bool hasSnapshot = prefs.getBool("has", false);
-      applySnapshot(hasSnapshot);
-      if (!hasSnapshot) {
-        saveSnapshot();
-      }
-    } else {
-      hunger = mood = energy = cleanliness = DEFAULT_STAT_VALUE;
+  static void onStatDelta(const EventBus::StatDelta& e, void*) {
+    switch (e.stat) {
+      case STAT_HUNGER:      addHunger(e.delta); break;
+      case STAT_MOOD:        addMood(e.delta); break;
+      case STAT_ENERGY:      addEnergy(e.delta); break;
+      case STAT_CLEANLINESS: addCleanliness(e.delta); break;
     }
+  }
 
-    lastDecayMs  = millis();
+  void begin() {
+    loadSnapshot();
+    ++statsVersion;
+    saveSnapshot();
+    EventBus::subscribe(onStatDelta);
+
+    lastDecayMs  = BubuClock::nowMs();
     hungerAccMin = moodAccMin = energyAccMin = cleanAccMin = 0;
-    lastSaveMs = lastDecayMs;
   }
 
   void update() {
-    uint32_t now = millis();
+    uint32_t now = BubuClock::nowMs();
     if (lastDecayMs == 0) {
       lastDecayMs = now;
       return;
     }
     if (decaySuspended) {
       lastDecayMs = now;
-      lastSaveMs = now;
+      saveSnapshot();
       return;
     }
 
@@ -146,55 +170,63 @@ namespace CareSystem {
       applyDecay(minutes);
     }
 
-    if (prefsReady && lastSaveMs != 0 && (now - lastSaveMs) >= SAVE_INTERVAL_MS) {
-      saveSnapshot();
-      lastSaveMs = now;
-    }
+    saveSnapshot();
   }
 
   void setDecaySuspended(bool suspended) {
     if (decaySuspended == suspended) return;
     decaySuspended = suspended;
-    uint32_t now = millis();
+    uint32_t now = BubuClock::nowMs();
     lastDecayMs = now;
-    lastSaveMs = now;
+  }
+
+  static void logCare(StatLog::Field field, int recovered) {
+    StatLog::recordEvent(StatLog::EventCode::CARE, (static_cast<int32_t>(field) << 8) | recovered);
   }
 
   // --- modifiers ---
   void addHunger(int v) {
     int oldValue = hunger;
     hunger = clampStat(hunger + v);
+    if (hunger != oldValue) ++statsVersion;
     if (v > 0 && oldValue < STAT_MAX) {
       int recovered = hunger - oldValue;
+      logCare(StatLog::HUNGER, recovered);
       int xp = recovered / 10;
-      if (xp > 0) LevelSystem::addXP(xp);
+      if (xp > 0) EventBus::publish(EventBus::XpEarned{static_cast<int16_t>(xp)});
     }
   }
   void addMood(int v) {
     int oldValue = mood;
     mood = clampStat(mood + v);
+    if (mood != oldValue) ++statsVersion;
     if (v > 0 && oldValue < STAT_MAX) {
       int recovered = mood - oldValue;
+      logCare(StatLog::MOOD, recovered);
       int xp = recovered / 10;
-      if (xp > 0) LevelSystem::addXP(xp);
+      if (xp > 0) EventBus::publish(EventBus::XpEarned{static_cast<int16_t>(xp)});
     }
   }
   void addEnergy(int v) {
     int oldValue = energy;
     energy = clampStat(energy + v);
+    if (energy != oldValue) ++statsVersion;
     if (v > 0 && oldValue < STAT_MAX) {
       int recovered = energy - oldValue;
+      logCare(StatLog::ENERGY, recovered);
       int xp = recovered / 10;
-      if (xp > 0) LevelSystem::addXP(xp);
+      if (xp > 0) EventBus::publish(EventBus::XpEarned{static_cast<int16_t>(xp)});
     }
   }
   void addCleanliness(int v) {
     int oldValue = cleanliness;
     cleanliness = clampStat(cleanliness + v);
+    if (cleanliness != oldValue) ++statsVersion;
     if (v > 0 && oldValue < STAT_MAX) {
       int recovered = cleanliness - oldValue;
+      logCare(StatLog::CLEANLINESS, recovered);
       int xp = recovered / 10;
-      if (xp > 0) LevelSystem::addXP(xp);
+      if (xp > 0) EventBus::publish(EventBus::XpEarned{static_cast<int16_t>(xp)});
     }
   }
 
@@ -203,6 +235,7 @@ namespace CareSystem {
   int getMood()        { return mood; }
   int getEnergy()      { return energy; }
   int getCleanliness() { return cleanliness; }
+  uint32_t version()   { return statsVersion; }
 
   // --- attention flags ---
   bool needsAttention() {
@@ -2,6 +2,7 @@
 // Includes & Forward Declarations
 // =====================================================
 #include "display_system.h"
+#include "bubu_clock.h"
 #include "lgfx_setup.hpp"
 #include "board_pins.h"
 #include "touch_system.h"
@@ -12,6 +13,11 @@
 #include "battery_system.h"
 #include "sub_state_system.h"
 #include "sound/sound_system.h"
+#include "flight_recorder.h"
+#include "persist_store.h"
+#include "stat_log/stat_log.h"
+#include "event_bus.h"
+#include "gesture_table.h"
 
 #include <lvgl.h>
 #include <esp_random.h>
@@ -111,8 +117,6 @@ static constexpr uint8_t  GIGGLE_JITTER_AMP = 6;
 // --- Idle Jitter State tuning ---
 static constexpr uint32_t JITTER_DURATION_MS = 420;
 static constexpr uint8_t  JITTER_AMP_PX      = 5;
-// Logging toggles
-static constexpr bool IDLE_LOGS = false;
 static constexpr uint32_t EYE_COLOR_FADE_MS = 500;
 
 // Clean animation tuning
@@ -160,7 +164,7 @@ static inline void GlobalMotion_setOffset(float x, float y) {
 static inline void GlobalMotion_kickJitter(uint8_t amp, uint16_t decayMs) {
   gMotion.jitterAmp = amp;
   gMotion.jitterDecay = decayMs;
-  gMotion.jitterUntil = millis() + decayMs;
+  gMotion.jitterUntil = BubuClock::nowMs() + decayMs;
   // seed jitter immediately
   gMotion.jitterX = (int16_t)random(-amp, amp + 1);
   gMotion.jitterY = (int16_t)random(-amp, amp + 1);
@@ -325,6 +329,42 @@ struct TouchRuntime {
 };
 static TouchRuntime touchState = {false, false};
 
+// Menu and game state as last published on the EventBus, instead of asking
+// MenuSystem and EyeGame about every panel each frame.
+struct LayerState {
+  MenuState menu;
+  bool gameRunning;
+};
+static LayerState layers = {MENU_CLOSED, false};
+
+static void Layers_onMenu(const EventBus::MenuChanged& e, void*) {
+  layers.menu = static_cast<MenuState>(e.to);
+}
+
+static void Layers_onGame(const EventBus::GameChanged& e, void*) {
+  layers.gameRunning = e.running;
+}
+
+// Menu panels that suspend the eyes (Layer 0).
+static bool Layers_panelOpen() {
+  switch (layers.menu) {
+    case MENU_OPEN:
+    case MENU_CONNECT_OPEN:
+    case MENU_MESSAGE_OPEN:
+    case MENU_BATTERY_OPEN:
+    case MENU_STATS_OPEN:
+    case MENU_OPTIONS_OPEN:
+    case MENU_GAMES_OPEN:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static bool Layers_gameActive() {
+  return layers.gameRunning || layers.menu == MENU_GAME_ACTIVE;
+}
+
 struct RainDrop {
   float x;
   float y;
@@ -422,9 +462,8 @@ struct ClockRuntime {
   uint32_t storedMsRef;
 };
 static ClockRuntime clockRt = {nullptr, nullptr, 0, 0, IdleVisualState::Eyes, false, 0, 0};
-static Preferences clockPrefs;
-static Preferences hatchPrefs;
-static bool hatchPrefsReady = false;
+static const uint8_t CLOCK_VERSION = 1;  // blob: uint64_t epoch
+static const uint8_t HATCH_VERSION = 1;
 
 struct IdleLookRuntime {
   bool active;
@@ -536,7 +575,7 @@ static inline bool Emotion_isActive() {
   if (emotionState.happyActive || emotionState.excitedActive) {
     return true;
   }
-  uint32_t now = millis();
+  uint32_t now = BubuClock::nowMs();
   if (emotionState.angryEndMs > 0 && now < emotionState.angryEndMs) return true;
   if (emotionState.tiredEndMs > 0 && now < emotionState.tiredEndMs) return true;
   if (emotionState.worriedEndMs > 0 && now < emotionState.worriedEndMs) return true;
@@ -633,14 +672,12 @@ static void IdleLook_pickNewDestination() {
     }
     SoundSystem::eyeSwoosh(strength);
   }
-  if (IDLE_LOGS) {
-    DisplayLog::printf("[IdleLook] New destination picked: dx=%d dy=%d\n",
-                       idleLook.destX,
-                       idleLook.destY);
-    DisplayLog::printf("[IdleLook] Speed=%s\n",
-      idleMoveSpeed == IdleMoveSpeed::Slow   ? "SLOW" :
-      idleMoveSpeed == IdleMoveSpeed::Fast   ? "FAST" : "NORMAL");
-  }
+  LOG_DEBUG(DisplayLog, "[IdleLook] New destination picked: dx=%d dy=%d\n",
+                        idleLook.destX,
+                        idleLook.destY);
+  LOG_DEBUG(DisplayLog, "[IdleLook] Speed=%s\n",
+    idleMoveSpeed == IdleMoveSpeed::Slow   ? "SLOW" :
+    idleMoveSpeed == IdleMoveSpeed::Fast   ? "FAST" : "NORMAL");
   idleLook.active = true;
 }
 
@@ -654,24 +691,19 @@ static void IdleLook_update(uint32_t nowMs) {
   if (idleState.active) {
     return;  // state owns time, movement must stop
   }
-  bool menuOpen = MenuSystem::isOpen() || MenuSystem::isFeeding() ||
-                  MenuSystem::isConnectOpen() || MenuSystem::isMessageOpen() ||
-                  MenuSystem::isBatteryOpen() || MenuSystem::isStatsOpen() ||
-                  MenuSystem::isOptionsOpen() || MenuSystem::isGamesOpen();
-  bool gameActive = EyeGame::isRunning() || MenuSystem::isGameActive();
+  bool menuOpen = Layers_panelOpen() || layers.menu == MENU_FEEDING;
+  bool gameActive = Layers_gameActive();
   bool clockVisible = (clockRt.state == IdleVisualState::Clock) && !display.canvasHidden;
   bool blocked = menuOpen || gameActive || clockVisible || eye.popInProgress || sleepAnim.active;
 
   // If blocked, DO NOT move targets — but DO allow timing to continue
   if (blocked) {
-    if (IDLE_LOGS) {
-      DisplayLog::printf("[IdleLook] BLOCKED: menu=%d game=%d clockVisible=%d blink=%d pop=%d\n",
-                         menuOpen,
-                         gameActive,
-                         clockVisible,
-                         eye.blinkInProgress,
-                         eye.popInProgress);
-    }
+    LOG_DEBUG(DisplayLog, "[IdleLook] BLOCKED: menu=%d game=%d clockVisible=%d blink=%d pop=%d\n",
+                          menuOpen,
+                          gameActive,
+                          clockVisible,
+                          eye.blinkInProgress,
+                          eye.popInProgress);
     idleLook.active = false;
     if (idleLookNextAt == 0) {
       idleLookNextAt = now + static_cast<uint32_t>(random(2000, 4001));
@@ -695,11 +727,9 @@ static void IdleLook_update(uint32_t nowMs) {
   }
 
   if (IdleLook_reachedDestination()) {
-    if (IDLE_LOGS) {
-      DisplayLog::printf("[IdleLook] Destination reached: offX=%d offY=%d\n",
-                         gMotion.offX,
-                         gMotion.offY);
-    }
+    LOG_DEBUG(DisplayLog, "[IdleLook] Destination reached: offX=%d offY=%d\n",
+                          gMotion.offX,
+                          gMotion.offY);
     idleLook.active = false;
     idleLookNextAt = now + static_cast<uint32_t>(random(2000, 4001));
 
@@ -776,9 +806,7 @@ static void Blink_start(uint32_t nowMs, bool left, bool right) {
   blinkRt.startMs = nowMs;
   eye.blinkInProgress = true;
   blinkSoundPlayed = false;
-  if (IDLE_LOGS) {
-    DisplayLog::printf("[Blink] Start: left=%d right=%d\n", left ? 1 : 0, right ? 1 : 0);
-  }
+  LOG_DEBUG(DisplayLog, "[Blink] Start: left=%d right=%d\n", left ? 1 : 0, right ? 1 : 0);
 }
 
 static void Wink_start(uint32_t nowMs, bool leftEye) {
@@ -872,10 +900,10 @@ static void Display_initLvglCanvas() {
     lvglBuf = static_cast<lv_color_t*>(
         heap_caps_malloc(bufBytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
     if (lvglBuf) {
-      DisplayLog::printf("[Display] LVGL buffer allocated in PSRAM (%u bytes)\n",
-                    static_cast<unsigned>(bufBytes));
+      LOG_INFO(DisplayLog, "[Display] LVGL buffer allocated in PSRAM (%u bytes)\n",
+                           static_cast<unsigned>(bufBytes));
     } else {
-      DisplayLog::println("[Display] FATAL: PSRAM alloc for LVGL buffer failed");
+      LOG_ERROR(DisplayLog, "[Display] FATAL: PSRAM alloc for LVGL buffer failed\n");
       while (true) { delay(1000); }
     }
   }
@@ -960,22 +988,27 @@ static void Eyes_fadeTo(uint8_t targetOpa) {
 }
 
 static void Clock_loadStored() {
-  if (!clockPrefs.begin("clock", true)) return;
-  clockRt.storedEpoch = clockPrefs.getULong64("epoch", 0);
-  clockRt.storedMsRef = clockPrefs.getUInt("msref", 0);
-  clockPrefs.end();
+  uint64_t epoch;
+  if (PersistStore::read(PersistStore::Slot::CLOCK, CLOCK_VERSION, &epoch, sizeof(epoch))) {
+    clockRt.storedEpoch = epoch;
+  } else {
+    // Older firmware kept the clock in its own namespace
+    Preferences clockPrefs;
+    if (!clockPrefs.begin("clock", true)) return;
+    clockRt.storedEpoch = clockPrefs.getULong64("epoch", 0);
+    clockPrefs.end();
+  }
   if (clockRt.storedEpoch > 0) {
     clockRt.timeValid = true;
     // Use current uptime as reference so stored epoch advances correctly after reboot
-    clockRt.storedMsRef = millis();
+    clockRt.storedMsRef = BubuClock::nowMs();
   }
 }
 
-static void Clock_store(time_t epoch, uint32_t msRef) {
-  if (!clockPrefs.begin("clock", false)) return;
-  clockPrefs.putULong64("epoch", (uint64_t)epoch);
-  clockPrefs.putUInt("msref", msRef);
-  clockPrefs.end();
+// Only the epoch is kept: after a reboot it is re-anchored to millis().
+static void Clock_store(time_t epoch) {
+  uint64_t stored = (uint64_t)epoch;
+  PersistStore::write(PersistStore::Slot::CLOCK, CLOCK_VERSION, &stored, sizeof(stored));
 }
 
 static time_t Clock_now(uint32_t nowMs) {
@@ -989,7 +1022,7 @@ static time_t Clock_now(uint32_t nowMs) {
       clockRt.timeValid = true;
       clockRt.storedEpoch = (uint64_t)sysNow;
       clockRt.storedMsRef = nowMs;
-      Clock_store(sysNow, nowMs);
+      Clock_store(sysNow);
       return sysNow;
     }
   }
@@ -1011,13 +1044,7 @@ static void Clock_tryNtpSync(uint32_t nowMs) {
   configTzTime("ICT-7", "pool.ntp.org", "time.nist.gov");
 }
 
-static void Clock_updateLabels(uint32_t nowMs) {
-  if (!clockRt.timeLabel || !clockRt.dateLabel) return;
-  if (nowMs - clockRt.lastClockUpdateMs < CLOCK_REFRESH_MS) return;
-  clockRt.lastClockUpdateMs = nowMs;
-
-  time_t t = Clock_now(nowMs);
-  if (t == 0) return;
+static void Clock_setLabels(time_t t) {
   struct tm tmInfo;
   localtime_r(&t, &tmInfo);
 
@@ -1030,6 +1057,16 @@ static void Clock_updateLabels(uint32_t nowMs) {
   lv_label_set_text(clockRt.dateLabel, dbuf);
 }
 
+static void Clock_updateLabels(uint32_t nowMs) {
+  if (!clockRt.timeLabel || !clockRt.dateLabel) return;
+  if (nowMs - clockRt.lastClockUpdateMs < CLOCK_REFRESH_MS) return;
+  clockRt.lastClockUpdateMs = nowMs;
+
+  time_t t = Clock_now(nowMs);
+  if (t == 0) return;
+  Clock_setLabels(t);
+}
+
 static void Clock_show() {
   Clock_fadeTo(LV_OPA_COVER);
   Eyes_fadeTo(LV_OPA_TRANSP);
@@ -1065,11 +1102,11 @@ static void Display_setCanvasVisible(bool visible) {
   if (visible && display.canvasHidden) {
     lv_obj_clear_flag(lvCanvas, LV_OBJ_FLAG_HIDDEN);
     display.canvasHidden = false;
-    DisplayLog::println("[Display] Canvas visible (eyes layer)");
+    LOG_DEBUG(DisplayLog, "[Display] Canvas visible (eyes layer)\n");
   } else if (!visible && !display.canvasHidden) {
     lv_obj_add_flag(lvCanvas, LV_OBJ_FLAG_HIDDEN);
     display.canvasHidden = true;
-    DisplayLog::println("[Display] Canvas hidden (overlay active)");
+    LOG_DEBUG(DisplayLog, "[Display] Canvas hidden (overlay active)\n");
   }
 }
 
@@ -1090,13 +1127,13 @@ static void Display_calculateEyeBoxes() {
   rightEyeBox.w = EYE_SIZE;
   rightEyeBox.h = EYE_SIZE;
   
-  DisplayLog::printf("[Eyes] Screen center: (%d, %d)\n", cx, cy);
-  DisplayLog::printf("[Eyes] Left: x=%d, y=%d, w=%d, h=%d (center: %d, %d)\n", 
-                leftEyeBox.x, leftEyeBox.y, leftEyeBox.w, leftEyeBox.h,
-                leftEyeBox.x + leftEyeBox.w/2, leftEyeBox.y + leftEyeBox.h/2);
-  DisplayLog::printf("[Eyes] Right: x=%d, y=%d, w=%d, h=%d (center: %d, %d)\n", 
-                rightEyeBox.x, rightEyeBox.y, rightEyeBox.w, rightEyeBox.h,
-                rightEyeBox.x + rightEyeBox.w/2, rightEyeBox.y + rightEyeBox.h/2);
+  LOG_INFO(DisplayLog, "[Eyes] Screen center: (%d, %d)\n", cx, cy);
+  LOG_INFO(DisplayLog, "[Eyes] Left: x=%d, y=%d, w=%d, h=%d (center: %d, %d)\n", 
+                       leftEyeBox.x, leftEyeBox.y, leftEyeBox.w, leftEyeBox.h,
+                       leftEyeBox.x + leftEyeBox.w/2, leftEyeBox.y + leftEyeBox.h/2);
+  LOG_INFO(DisplayLog, "[Eyes] Right: x=%d, y=%d, w=%d, h=%d (center: %d, %d)\n", 
+                       rightEyeBox.x, rightEyeBox.y, rightEyeBox.w, rightEyeBox.h,
+                       rightEyeBox.x + rightEyeBox.w/2, rightEyeBox.y + rightEyeBox.h/2);
 }
 
 // =====================================================
@@ -1531,9 +1568,10 @@ static void Hatch_start(uint32_t nowMs) {
 
 static void Hatch_finish(uint32_t nowMs) {
   hatch.active = false;
-  if (hatchPrefsReady) {
-    hatchPrefs.putBool("hatched", true);
-  }
+  uint8_t hatched = 1;
+  PersistStore::write(PersistStore::Slot::HATCH, HATCH_VERSION, &hatched, sizeof(hatched));
+  PersistStore::commit();  // a lost flag would replay the hatch on the next boot
+  StatLog::recordEvent(StatLog::EventCode::HATCHED);
   clockRt.lastTouchMs = nowMs;
   EyeRenderer_drawFrame(0, 1.0f);
 }
@@ -1999,7 +2037,7 @@ static void EyeRenderer_drawFrame(int16_t topOffset, float scale, uint8_t blinkM
   lv_canvas_init_layer(lvCanvas, &layer);
 
   if (cleanAnim.active) {
-    Clean_updateRain(millis());
+    Clean_updateRain(BubuClock::nowMs());
     lv_draw_rect_dsc_t rain;
     lv_draw_rect_dsc_init(&rain);
     rain.bg_color = lv_color_hex(CLEAN_RAIN_COLOR);
@@ -2078,7 +2116,7 @@ static void EyeRenderer_drawFrame(int16_t topOffset, float scale, uint8_t blinkM
           lv_draw_triangle(&layer, &tri);
         };
 
-        uint32_t triNow = millis();
+        uint32_t triNow = BubuClock::nowMs();
         const bool angryActive = (emotionState.angryEndMs > 0 && triNow < emotionState.angryEndMs);
         const bool tiredActive = (emotionState.tiredEndMs > 0 && triNow < emotionState.tiredEndMs);
         const bool worriedActive = (emotionState.worriedEndMs > 0 && triNow < emotionState.worriedEndMs);
@@ -2291,7 +2329,7 @@ static void EyeRenderer_drawFrame(int16_t topOffset, float scale, uint8_t blinkM
   }
   */
   if (sleepAnim.active) {
-    Sleep_drawZs(&layer, millis());
+    Sleep_drawZs(&layer, BubuClock::nowMs());
   }
   lv_canvas_finish_layer(lvCanvas, &layer);
 }
@@ -2340,35 +2378,35 @@ static void Emotion_triggerNow() {
 
 
 static void Emotion_scheduleNextPick() {
-  emotionState.nextEmotionPickMs = millis() + static_cast<uint32_t>(random(7000, 15001));  // 7-15s
+  emotionState.nextEmotionPickMs = BubuClock::nowMs() + static_cast<uint32_t>(random(7000, 15001));  // 7-15s
 }
 
 
 
 static bool Touch_isTapOnEyes(const TouchPoint& pt) {
-  DisplayLog::printf("[HitTest] Touch at x=%u, y=%u\n", pt.x, pt.y);
-  DisplayLog::printf("[HitTest] Left eye box: x=%d-%d, y=%d-%d\n", 
-                leftEyeBox.x, leftEyeBox.x + leftEyeBox.w,
-                leftEyeBox.y, leftEyeBox.y + leftEyeBox.h);
-  DisplayLog::printf("[HitTest] Right eye box: x=%d-%d, y=%d-%d\n", 
-                rightEyeBox.x, rightEyeBox.x + rightEyeBox.w,
-                rightEyeBox.y, rightEyeBox.y + rightEyeBox.h);
+  LOG_DEBUG(DisplayLog, "[HitTest] Touch at x=%u, y=%u\n", pt.x, pt.y);
+  LOG_DEBUG(DisplayLog, "[HitTest] Left eye box: x=%d-%d, y=%d-%d\n", 
+                        leftEyeBox.x, leftEyeBox.x + leftEyeBox.w,
+                        leftEyeBox.y, leftEyeBox.y + leftEyeBox.h);
+  LOG_DEBUG(DisplayLog, "[HitTest] Right eye box: x=%d-%d, y=%d-%d\n", 
+                        rightEyeBox.x, rightEyeBox.x + rightEyeBox.w,
+                        rightEyeBox.y, rightEyeBox.y + rightEyeBox.h);
   
   // Check left eye
   if (pt.x >= leftEyeBox.x && pt.x <= leftEyeBox.x + leftEyeBox.w &&
       pt.y >= leftEyeBox.y && pt.y <= leftEyeBox.y + leftEyeBox.h) {
-    DisplayLog::println(">>> LEFT EYE HIT! <<<");
+    LOG_DEBUG(DisplayLog, ">>> LEFT EYE HIT! <<<\n");
     return true;
   }
   
   // Check right eye
   if (pt.x >= rightEyeBox.x && pt.x <= rightEyeBox.x + rightEyeBox.w &&
       pt.y >= rightEyeBox.y && pt.y <= rightEyeBox.y + rightEyeBox.h) {
-    DisplayLog::println(">>> RIGHT EYE HIT! <<<");
+    LOG_DEBUG(DisplayLog, ">>> RIGHT EYE HIT! <<<\n");
     return true;
   }
   
-  DisplayLog::println(">>> MISS - Outside eyes <<<");
+  LOG_DEBUG(DisplayLog, ">>> MISS - Outside eyes <<<\n");
   return false;
 }
 
@@ -2410,7 +2448,7 @@ void DisplaySystem_begin() {
   Display_backlightInit();
 
   Display_initLvglCanvas();
-  display.lastLvglTickMs = millis();
+  display.lastLvglTickMs = BubuClock::nowMs();
   Display_calculateEyeBoxes();
 
   // ---------------------------------------------------
@@ -2456,23 +2494,30 @@ void DisplaySystem_begin() {
   Clock_createLabels();
   Clock_setOpacity(LV_OPA_TRANSP);
   lv_obj_set_style_opa(lvCanvas, LV_OPA_COVER, 0);
-  clockRt.lastTouchMs = millis();
+  clockRt.lastTouchMs = BubuClock::nowMs();
   Clock_loadStored();
   
   TouchSystem::begin();
+  EventBus::subscribe(Layers_onMenu);
+  EventBus::subscribe(Layers_onGame);
   MenuSystem::begin();
   randomSeed(esp_random());
   SubStateSystem::begin();
-  hatchPrefsReady = hatchPrefs.begin("bubu", false);
-  bool alreadyHatched = false;
-  if (hatchPrefsReady) {
-    if (HATCH_FORCE_RESET_ON_BOOT) {
-      hatchPrefs.putBool("hatched", false);
+  uint8_t hatched = 0;
+  if (HATCH_FORCE_RESET_ON_BOOT) {
+    PersistStore::write(PersistStore::Slot::HATCH, HATCH_VERSION, &hatched, sizeof(hatched));
+  } else if (!PersistStore::read(PersistStore::Slot::HATCH, HATCH_VERSION, &hatched, sizeof(hatched))) {
+    // Older firmware kept the flag in its own namespace
+    Preferences hatchPrefs;
+    if (hatchPrefs.begin("bubu", true)) {
+      hatched = hatchPrefs.getBool("hatched", false);
+      hatchPrefs.end();
     }
-    alreadyHatched = hatchPrefs.getBool("hatched", false);
+    if (hatched) PersistStore::write(PersistStore::Slot::HATCH, HATCH_VERSION, &hatched, sizeof(hatched));
   }
+  bool alreadyHatched = hatched != 0;
   if (!alreadyHatched) {
-    Hatch_start(millis());
+    Hatch_start(BubuClock::nowMs());
   } else {
     hatch.active = false;
   }
@@ -2482,25 +2527,28 @@ void DisplaySystem_begin() {
   g_visualObjects[(int)ObjId::RightEye].scaleY = eye.scale;
 
   if (hatch.active) {
-    Hatch_render(millis());
+    Hatch_render(BubuClock::nowMs());
   } else {
     EyeRenderer_drawFrame(0);
   }
 
   
-  DisplayLog::println("==========================================");
-  DisplayLog::println("🤖 Robot ready! Touch the eyes to pop! 🤖");
-  DisplayLog::println("   Tap anywhere else to open menu");
-  DisplayLog::println("==========================================");
+  LOG_INFO(DisplayLog, "==========================================\n");
+  LOG_INFO(DisplayLog, "🤖 Robot ready! Touch the eyes to pop! 🤖\n");
+  LOG_INFO(DisplayLog, "   Tap anywhere else to open menu\n");
+  LOG_INFO(DisplayLog, "==========================================\n");
 }
 
 // Forward declarations for game/idle helpers
 static void updateGameEyes(bool gameRunning);
 static void updateIdleBlinkAndEmotion(bool higherLayerActive, bool gameRunning);
 
+// Display-side parts of the gesture actions (GestureTable::run)
+static const GestureTable::Hooks GESTURE_HOOKS = {Touch_isTapOnEyes, Clean_start, Emotion_triggerTest};
+
 void DisplaySystem_update() {
   // Keep LVGL tick running so LVGL timers/invalidations advance
-  uint32_t nowMs = millis();
+  uint32_t nowMs = BubuClock::nowMs();
   Clean_update(nowMs);
   Sleep_update(nowMs);
   EyeColor_update(nowMs);
@@ -2522,20 +2570,14 @@ void DisplaySystem_update() {
     return;
   }
   MenuSystem::render();
-  static bool prevGameRunning = false;
-  bool gameRunning = EyeGame::isRunning();
-  if (prevGameRunning && !gameRunning) {
-    MenuSystem::handleGameFinished();
-  }
-  prevGameRunning = gameRunning;
+  // render() may end the feed animation; take that transition (and a game
+  // that ended in EyeGame::update()) into this frame's layer state.
+  EventBus::dispatch();
 
   // Suspend eyes (Layer 0) whenever higher layers are active
-  bool gameActive = MenuSystem::isGameActive() || EyeGame::isRunning();
-  bool feedActive = MenuSystem::isFeeding();
-  bool higherLayerActive = MenuSystem::isOpen() || MenuSystem::isConnectOpen() ||
-                           MenuSystem::isMessageOpen() || MenuSystem::isBatteryOpen() ||
-                           MenuSystem::isStatsOpen() || MenuSystem::isOptionsOpen() ||
-                           MenuSystem::isGamesOpen();
+  bool gameActive = Layers_gameActive();
+  bool feedActive = layers.menu == MENU_FEEDING;
+  bool higherLayerActive = Layers_panelOpen();
   static bool feedWasActive = false;
   if (feedActive && !feedWasActive) {
     Feed_start(nowMs);
@@ -2556,12 +2598,12 @@ void DisplaySystem_update() {
       !emotionState.excitedActive &&
       !emotionState.happyActive) {
     static uint32_t lastIdleLogMs = 0;
-    if (IDLE_LOGS && millis() - lastIdleLogMs > 1000) {
-      DisplayLog::printf("[IdleLook] Render tick: offX=%.2f offY=%.2f active=%d\n",
-                         static_cast<double>(gMotion.offX),
-                         static_cast<double>(gMotion.offY),
-                         idleLook.active ? 1 : 0);
-      lastIdleLogMs = millis();
+    if (DisplayLog::enabled(LogLevel::TRACE) && BubuClock::nowMs() - lastIdleLogMs > 1000) {
+      LOG_TRACE(DisplayLog, "[IdleLook] Render tick: offX=%.2f offY=%.2f active=%d\n",
+                            static_cast<double>(gMotion.offX),
+                            static_cast<double>(gMotion.offY),
+                            idleLook.active ? 1 : 0);
+      lastIdleLogMs = BubuClock::nowMs();
     }
     uint8_t blinkMask = 0;
     if (eye.blinkInProgress) {
@@ -2595,20 +2637,20 @@ void DisplaySystem_update() {
     if (!TouchSystem::isTouchPressed()) {
       touchState.blockGesturesUntilLift = false;
       touchState.suppressMenuOpenUntilLift = false;
-      DisplayLog::println("[Touch] Gesture block cleared after release");
+      LOG_DEBUG(DisplayLog, "[Touch] Gesture block cleared after release\n");
     }
     if (TouchSystem::available()) {
       TouchSystem::get();  // drop stale while blocked
-      DisplayLog::println("[Touch] Dropped gesture while blocked");
+      LOG_DEBUG(DisplayLog, "[Touch] Dropped gesture while blocked\n");
     }
   } else if (TouchSystem::available()) {
-    DisplayLog::println(">>> TOUCH EVENT AVAILABLE <<<");
+    LOG_DEBUG(DisplayLog, ">>> TOUCH EVENT AVAILABLE <<<\n");
     TouchPoint touch = TouchSystem::get();
-    DisplayLog::printf(">>> Touch details: x=%u, y=%u, gesture=%d <<<\n", touch.x, touch.y, touch.gesture);
+    LOG_DEBUG(DisplayLog, ">>> Touch details: x=%u, y=%u, gesture=%d <<<\n", touch.x, touch.y, touch.gesture);
     clockRt.lastTouchMs = nowMs;
 
     if (cleanAnim.active) {
-      DisplayLog::println("[Clean] Touch ignored during clean animation");
+      LOG_DEBUG(DisplayLog, "[Clean] Touch ignored during clean animation\n");
       return;
     }
     if (sleepAnim.active) {
@@ -2619,7 +2661,7 @@ void DisplaySystem_update() {
       return;
     }
     if (MenuSystem::isFeeding()) {
-      DisplayLog::println("[Feed] Touch ignored during feed animation");
+      LOG_DEBUG(DisplayLog, "[Feed] Touch ignored during feed animation\n");
       return;
     }
 
@@ -2634,229 +2676,26 @@ void DisplaySystem_update() {
     // Treat TOUCH_NONE as release marker to clear any blocks
     if (touch.gesture == TOUCH_NONE) {
       if (TouchSystem::isTouchPressed()) {
-        DisplayLog::println("[Touch] Release marker ignored while finger still down");
+        LOG_DEBUG(DisplayLog, "[Touch] Release marker ignored while finger still down\n");
         return;
       }
-      DisplayLog::println("[Touch] Release marker received, clearing blocks");
+      LOG_DEBUG(DisplayLog, "[Touch] Release marker received, clearing blocks\n");
       touchState.blockGesturesUntilLift = false;
       touchState.suppressMenuOpenUntilLift = false;
       return;
     }
 
-    if (EyeGame::isRunning()) {
-      DisplayLog::println("[Processing] Game is ACTIVE (Layer 5)");
-      switch (touch.gesture) {
-        case TOUCH_TAP:
-            EyeGame::handleTap(touch.x, touch.y);
-            touchState.blockGesturesUntilLift = true;
-            break;
-        case TOUCH_LONG_PRESS:
-          // Long press anywhere exits game back to games menu
-          if (!Touch_isTapOnEyes(touch)) {
-            DisplayLog::println("[Layer 5] LONG_PRESS off eyes -> exit to games menu");
-            EyeGame::stop();
-            MenuSystem::handleGameFinished();
-            touchState.blockGesturesUntilLift = true;
-            break;
-          }
-          DisplayLog::println("[Layer 5] LONG_PRESS on eyes ignored");
-          break;
-        default:
-          break;
-      }
-    } else if (MenuSystem::isOptionsOpen()) {
-      DisplayLog::println("[Processing] Options is OPEN (Layer 3)");
-      switch (touch.gesture) {
-        case TOUCH_TAP:
-          DisplayLog::println("[Layer 3] Action: ACTIVATE OPTION");
-          MenuSystem::activateCurrentOption();
-          touchState.blockGesturesUntilLift = true;
-          break;
-        case TOUCH_LONG_PRESS:
-          DisplayLog::println("[Layer 3] Action: BACK to stats (Layer 2)");
-          MenuSystem::closeOptionsToStats();
-          touchState.blockGesturesUntilLift = true;
-          break;
-        case TOUCH_SWIPE_UP:
-        case TOUCH_SWIPE_LEFT:
-          DisplayLog::println("[Layer 3] Action: OPTIONS PREV");
-          MenuSystem::selectOptionsPrev();
-          break;
-        case TOUCH_SWIPE_DOWN:
-        case TOUCH_SWIPE_RIGHT:
-          DisplayLog::println("[Layer 3] Action: OPTIONS NEXT");
-          MenuSystem::selectOptionsNext();
-          break;
-        default:
-          break;
-      }
-    } else if (MenuSystem::isGamesOpen()) {
-      DisplayLog::println("[Processing] Games menu is OPEN (Layer 4)");
-      switch (touch.gesture) {
-        case TOUCH_TAP:
-          DisplayLog::println("[Layer 4] Action: START Tap the Greens");
-          MenuSystem::startTapTheGreens();
-          touchState.blockGesturesUntilLift = true;
-          break;
-        case TOUCH_LONG_PRESS:
-          DisplayLog::println("[Layer 4] Action: BACK to stats (Layer 2)");
-          MenuSystem::closeGamesToStats();
-          touchState.blockGesturesUntilLift = true;
-          break;
-        default:
-          break;
-      }
-    } else if (MenuSystem::isConnectOpen()) {
-      DisplayLog::println("[Processing] Connect is OPEN (Layer 2)");
-      switch (touch.gesture) {
-        case TOUCH_TAP:
-          if (MenuSystem::handleConnectTap(touch.x, touch.y)) {
-            touchState.blockGesturesUntilLift = true;
-          }
-          break;
-        case TOUCH_LONG_PRESS:
-          DisplayLog::println("[Layer 2] Action: EXIT to menu (Layer 1)");
-          MenuSystem::closeConnectToMenu();
-          touchState.blockGesturesUntilLift = true;
-          break;
-        default:
-          break;
-      }
-    } else if (MenuSystem::isMessageOpen()) {
-      DisplayLog::println("[Processing] Message is OPEN (Layer 2)");
-      switch (touch.gesture) {
-        case TOUCH_LONG_PRESS:
-          DisplayLog::println("[Layer 2] Action: EXIT to menu (Layer 1)");
-          MenuSystem::closeMessageToMenu();
-          touchState.blockGesturesUntilLift = true;
-          break;
-        default:
-          break;
-      }
-    } else if (MenuSystem::isStatsOpen()) {
-      DisplayLog::println("[Processing] Stats is OPEN (Layer 2)");
-      switch (touch.gesture) {
-        case TOUCH_SWIPE_UP:
-        case TOUCH_SWIPE_LEFT:
-          DisplayLog::println("[Layer 2] Action: STAT PREV");
-          MenuSystem::statsPrev();
-          break;
-        case TOUCH_SWIPE_DOWN:
-        case TOUCH_SWIPE_RIGHT:
-          DisplayLog::println("[Layer 2] Action: STAT NEXT");
-          MenuSystem::statsNext();
-          break;
-        case TOUCH_TAP:
-          if (MenuSystem::getCurrentStatIndex() == 3 &&
-              MenuSystem::isTapOnStatsTitle(touch.x, touch.y)) {
-            DisplayLog::println("[Layer 2] Action: CLEAN animation");
-            Clean_start(nowMs);
-            MenuSystem::close();
-            touchState.blockGesturesUntilLift = true;
-            break;
-          }
-          if (MenuSystem::getCurrentStatIndex() == 1) {
-            DisplayLog::println("[Layer 2] Action: OPEN games (Layer 4)");
-            MenuSystem::openGamesMenu();
-          } else {
-            DisplayLog::println("[Layer 2] Action: OPEN options (Layer 3)");
-            MenuSystem::openOptionsForCurrentStat();
-          }
-          touchState.blockGesturesUntilLift = true;
-          break;
-        case TOUCH_LONG_PRESS:
-          DisplayLog::println("[Layer 2] Action: EXIT to menu (Layer 1)");
-          MenuSystem::closeStatsToMenu();
-          touchState.blockGesturesUntilLift = true;  // Block until finger lifts
-          break;
-        default:
-          break;
-      }
-    } else if (MenuSystem::isBatteryOpen()) {
-      DisplayLog::println("[Processing] Battery is OPEN (Layer 2)");
-      switch (touch.gesture) {
-        case TOUCH_TAP:
-        case TOUCH_LONG_PRESS:
-          DisplayLog::println("[Layer 2] Action: EXIT to menu (Layer 1)");
-          MenuSystem::closeBatteryToMenu();
-          touchState.blockGesturesUntilLift = true;
-          break;
-        default:
-          break;
-      }
-    } else if (MenuSystem::isLevelOpen()) {
-      DisplayLog::println("[Processing] Level is OPEN (Layer 2)");
-      switch (touch.gesture) {
-        case TOUCH_TAP:
-        case TOUCH_LONG_PRESS:
-          DisplayLog::println("[Layer 2] Action: EXIT to menu (Layer 1)");
-          MenuSystem::closeLevelToMenu();
-          touchState.blockGesturesUntilLift = true;
-          break;
-        default:
-          break;
-      }
-    } else if (MenuSystem::isOpen()) {
-      DisplayLog::println("[Processing] Menu is OPEN (Layer 1)");
-      switch (touch.gesture) {
-        case TOUCH_TAP:
-          if (MenuSystem::isTapOnSelected(touch.x, touch.y)) {
-            DisplayLog::println("[Layer 1] Action: ENTER (hit selected)");
-            MenuSystem::activateSelected();
-            if (MenuSystem::isStatsOpen() || MenuSystem::isConnectOpen() ||
-                MenuSystem::isMessageOpen()) {
-              touchState.blockGesturesUntilLift = true;
-            }
-          } else {
-            DisplayLog::println("[Layer 1] TAP ignored (not on selected item)");
-          }
-          break;
-          
-        case TOUCH_SWIPE_UP:
-        case TOUCH_SWIPE_LEFT:
-          DisplayLog::println("[Layer 1] Action: SELECT PREV");
-          MenuSystem::selectPrev();
-          break;
-          
-        case TOUCH_SWIPE_DOWN:
-        case TOUCH_SWIPE_RIGHT:
-          DisplayLog::println("[Layer 1] Action: SELECT NEXT");
-          MenuSystem::selectNext();
-          break;
-          
-        case TOUCH_LONG_PRESS:
-          DisplayLog::println("[Layer 1] Action: EXIT to Layer 0");
-          MenuSystem::close();
-          touchState.blockGesturesUntilLift = true;  // Block until finger lifts
-          break;
-          
-        default:
-          break;
-      }
-    } else {
-      DisplayLog::println("[Processing] Menu is CLOSED (Layer 0)");
-      switch (touch.gesture) {
-        case TOUCH_TAP:
-          DisplayLog::println("[Layer 0] Gesture: TAP");
-          if (Touch_isTapOnEyes(touch)) {
-            DisplayLog::println("[Layer 0] -> Eyes hit, triggering test emotion");
-            Emotion_triggerTest(nowMs);
-          } else {
-            DisplayLog::println("[Layer 0] -> Eyes missed, opening menu!");
-            MenuSystem::open();
-            touchState.blockGesturesUntilLift = true;  // Block until finger lifts after opening
-          }
-          break;
-        default:
-          DisplayLog::printf("[Layer 0] Gesture %d ignored on closed menu\n", touch.gesture);
-          break;
-      }
+    MenuState layer = GestureTable::layerFor(MenuSystem::getState(), EyeGame::isRunning());
+    GestureTable::Action action = GestureTable::lookup(layer, touch.gesture);
+    LOG_DEBUG(DisplayLog, "[Touch] layer %d gesture %d -> %s\n", layer, touch.gesture, GestureTable::actionName(action));
+    if (GestureTable::run(action, touch, nowMs, GESTURE_HOOKS)) {
+      touchState.blockGesturesUntilLift = true;
     }
   }
   // If we suppressed menu reopening after a hold, clear once finger lifts
   if (touchState.suppressMenuOpenUntilLift && !TouchSystem::isTouchPressed()) {
     touchState.suppressMenuOpenUntilLift = false;
-    DisplayLog::println("[Touch] Suppression cleared after release");
+    LOG_DEBUG(DisplayLog, "[Touch] Suppression cleared after release\n");
   }
   
   // Always update LVGL (for menu animations)
@@ -2891,7 +2730,7 @@ void DisplaySystem_update() {
         GlobalMotion_kickJitter(JITTER_AMP_PX, JITTER_DURATION_MS);
         // Soft noise burst for jitter states
         SoundSystem::eyeJitter(0.5f);
-        if (IDLE_LOGS) DisplayLog::println("[IdleState] JITTER start");
+        LOG_DEBUG(DisplayLog, "[IdleState] JITTER start\n");
       }
       if (nowMs - idleState.startMs >= idleState.durationMs) {
         idleState.active = false;
@@ -2997,7 +2836,7 @@ void DisplaySystem_update() {
       if (idleState.startMs == nowMs) {
         eye.topOffset = GIGGLE_OFFSET_PX;
         GlobalMotion_kickJitter(GIGGLE_JITTER_AMP, GIGGLE_DURATION_MS);
-        if (IDLE_LOGS) DisplayLog::println("[IdleState] GIGGLE start");
+        LOG_DEBUG(DisplayLog, "[IdleState] GIGGLE start\n");
       }
       // Force Y-only jitter
       gMotion.jitterX = 0;
@@ -3046,7 +2885,7 @@ static void updateGameEyes(bool gameRunning) {
 
   uint16_t left = EyeGame::getLeftColor565();
   uint16_t right = EyeGame::getRightColor565();
-  uint32_t now = millis();
+  uint32_t now = BubuClock::nowMs();
   bool colorChanged = !prevGameRunning || left != lastLeftColor || right != lastRightColor;
   bool refreshDue = (nextRefreshMs == 0) || (now >= nextRefreshMs);
 
@@ -3074,7 +2913,7 @@ static void updateIdleBlinkAndEmotion(bool higherLayerActive, bool gameRunning)
 
   // Update eye animations when fully in Layer 0
   if (!higherLayerActive && !gameRunning) {
-    uint32_t nowBlink = millis();
+    uint32_t nowBlink = BubuClock::nowMs();
 
     if ((emotionState.currentEmotion == EYE_EMO_ANGRY1 ||
          emotionState.currentEmotion == EYE_EMO_ANGRY2 ||
@@ -3178,7 +3017,8 @@ void DisplaySystem_setEmotion(EyeEmotion emo) {
   if (emo == EYE_EMO_EXCITED) {
     emo = EYE_EMO_IDLE;
   }
-  uint32_t now = millis();
+  FlightRecorder::record(FlightRecorder::Event::EMOTION, static_cast<uint8_t>(emo));
+  uint32_t now = BubuClock::nowMs();
   emotionState.excitedActive = false;
   emotionState.happyActive = false;
   if (emo == EYE_EMO_ANGRY1 || emo == EYE_EMO_ANGRY2 || emo == EYE_EMO_ANGRY3) {
@@ -3242,7 +3082,7 @@ void DisplaySystem_setEmotion(EyeEmotion emo) {
 }
 
 void DisplaySystem_startExcitedNow() { DisplaySystem_setEmotion(EYE_EMO_EXCITED); }
-void DisplaySystem_startSleep() { Sleep_start(millis()); }
+void DisplaySystem_startSleep() { Sleep_start(BubuClock::nowMs()); }
 bool DisplaySystem_isHatching() { return hatch.active; }
 
 // =====================================================
@@ -3300,3 +3140,123 @@ static void ReturnVisualToNeutral() {
   gMotion.targetOffX = 0;
   gMotion.targetOffY = 0;
 }
+
+#ifdef BUBU_FRAME_SCENES
+// =====================================================
+// Scripted Scenes (golden-frame harness only)
+// =====================================================
+// A scene is a state as of "now" with the clock held still: animations are
+// started that far in the past instead of being stepped there, so the same
+// calls give the same frame whatever ran before.
+static constexpr uint32_t SCENE_STEP_MS = 5;  // main.cpp's frame period
+
+void DisplaySystem_sceneReset(unsigned long seed) {
+  MenuSystem::close();
+  EventBus::dispatch();
+  hatch = {};
+  cleanAnim.active = false;
+  cleanAnim.lastUpdateMs = 0;
+  sleepAnim.active = false;
+  for (auto& z : sleepAnim.zs) {
+    z.active = false;
+  }
+  idleState.type = IdleStateType::None;
+  idleState.active = false;
+  idleLook.active = false;
+  idleMoveSpeed = IdleMoveSpeed::Normal;
+  blinkRt.active = false;
+  eye = {0, 1.0f, false, false, false, 0, 0, 0, 0};
+  gMotion = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+  for (int i = 0; i < (int)ObjId::COUNT; ++i) {
+    auto& o = g_visualObjects[i];
+    o.offsetX = 0;
+    o.offsetY = 0;
+    o.scaleX = 1.0f;
+    o.scaleY = 1.0f;
+  }
+  ReturnVisualToNeutral();
+  DisplaySystem_setEmotion(EYE_EMO_IDLE);
+  Clock_hide();
+  Display_setCanvasVisible(true);
+  Display_setBacklight(BACKLIGHT_FULL);
+  randomSeed(seed);
+}
+
+void DisplaySystem_sceneEmotion(EyeEmotion emotion) {
+  DisplaySystem_setEmotion(emotion);
+}
+
+void DisplaySystem_sceneBlink(uint32_t msIntoBlink, bool left, bool right) {
+  uint32_t nowMs = BubuClock::nowMs();
+  Blink_start(nowMs - msIntoBlink, left, right);
+  Blink_update(nowMs);
+}
+
+void DisplaySystem_scenePop(uint8_t frame) {
+  eye.scale = POP_SCALES[frame % POP_FRAME_COUNT];
+}
+
+void DisplaySystem_sceneHatch(uint8_t phase, uint32_t msIntoPhase) {
+  uint32_t nowMs = BubuClock::nowMs();
+  hatch.active = true;
+  hatch.posX = SCREEN_WIDTH / 2.0f;
+  hatch.posY = SCREEN_HEIGHT / 2.0f;
+  Hatch_enterPhase(phase, nowMs - msIntoPhase);
+}
+
+void DisplaySystem_sceneRain(uint32_t msIntoClean) {
+  Clean_start(BubuClock::nowMs() - msIntoClean);
+  // Clean_start() queues the happy bounce that update() would play
+  idleState.active = false;
+  idleState.type = IdleStateType::None;
+}
+
+void DisplaySystem_sceneSleep(uint32_t msIntoSleep) {
+  uint32_t nowMs = BubuClock::nowMs();
+  uint32_t startMs = nowMs - msIntoSleep;
+  Sleep_start(startMs);
+  // Z spawns and drift at the frame rate, as update() would have run them
+  for (uint32_t t = startMs; nowMs - t >= SCENE_STEP_MS; t += SCENE_STEP_MS) {
+    Sleep_update(t);
+  }
+  Sleep_update(nowMs);
+}
+
+void DisplaySystem_sceneClock(time_t epoch) {
+  Clock_ensureTz();
+  Clock_setLabels(epoch);
+  Clock_show();
+}
+
+void DisplaySystem_sceneRender() {
+  uint32_t nowMs = BubuClock::nowMs();
+  uint32_t elapsed = nowMs - display.lastLvglTickMs;
+  if (elapsed > 0) {
+    lv_tick_inc(elapsed);
+    display.lastLvglTickMs = nowMs;
+  }
+  MenuSystem::render();
+  EventBus::dispatch();
+  eyeColor.lastUpdateMs = 0;  // settled colour, not mid-fade
+  EyeColor_update(nowMs);
+
+  bool layerVisible = Layers_gameActive() || !Layers_panelOpen();
+  Display_setCanvasVisible(layerVisible);
+  if (!layerVisible) {
+    Clock_setOpacity(LV_OPA_TRANSP);
+    lv_obj_set_style_opa(lvCanvas, LV_OPA_TRANSP, 0);
+  } else if (hatch.active) {
+    Hatch_render(nowMs);
+  } else if (clockRt.state == IdleVisualState::Eyes) {
+    uint8_t blinkMask = 0;
+    if (eye.blinkInProgress) {
+      if (blinkRt.left) blinkMask |= BLINK_LEFT_MASK;
+      if (blinkRt.right) blinkMask |= BLINK_RIGHT_MASK;
+    }
+    EyeRenderer_drawFrame(eye.topOffset, eye.scale, blinkMask);
+  }
+  lv_timer_handler();
+  lv_obj_invalidate(lv_screen_active());
+  lv_refr_now(lvglDisplay);
+}
+#endif
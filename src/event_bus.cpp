@@ -0,0 +1,110 @@
+#include "event_bus.h"
+
+#include <freertos/FreeRTOS.h>
+
+namespace EventBus {
+
+namespace {
+
+// Bounds one dispatch() when handlers keep publishing to each other.
+constexpr size_t MAX_EVENTS_PER_DISPATCH = QUEUE_CAPACITY * 4;
+
+struct Subscriber {
+  Mask filter;
+  void (*thunk)(const Event&, detail::ErasedFn, void*);
+  detail::ErasedFn fn;
+  void* ctx;
+};
+
+Event ring[QUEUE_CAPACITY];
+uint32_t head = 0;  // next write
+uint32_t tail = 0;  // next read
+Subscriber subscribers[MAX_SUBSCRIBERS];
+size_t subscriberCount = 0;
+Stats counters = {};
+portMUX_TYPE busMux = portMUX_INITIALIZER_UNLOCKED;
+
+void rawThunk(const Event& e, detail::ErasedFn fn, void* ctx) {
+  reinterpret_cast<Handler>(fn)(e, ctx);
+}
+
+bool take(Event& out) {
+  bool got = false;
+  portENTER_CRITICAL(&busMux);
+  if (tail != head) {
+    out = ring[tail % QUEUE_CAPACITY];
+    ++tail;
+    got = true;
+  }
+  portEXIT_CRITICAL(&busMux);
+  return got;
+}
+
+}  // namespace
+
+namespace detail {
+
+bool subscribeTyped(Mask filter, void (*thunk)(const Event&, ErasedFn, void*), ErasedFn fn, void* ctx) {
+  if (subscriberCount >= MAX_SUBSCRIBERS || !fn || !filter) return false;
+  subscribers[subscriberCount++] = {filter, thunk, fn, ctx};
+  return true;
+}
+
+}  // namespace detail
+
+bool subscribe(Mask filter, Handler fn, void* ctx) {
+  return detail::subscribeTyped(filter, rawThunk, reinterpret_cast<detail::ErasedFn>(fn), ctx);
+}
+
+bool post(EventId id, const void* payload, size_t len) {
+  if (len > PAYLOAD_SIZE) return false;
+  bool queued = false;
+  portENTER_CRITICAL(&busMux);
+  uint32_t depth = head - tail;
+  if (depth < QUEUE_CAPACITY) {
+    Event& e = ring[head % QUEUE_CAPACITY];
+    e.id = id;
+    memcpy(e.payload, payload, len);
+    ++head;
+    ++counters.published;
+    if (depth + 1 > counters.peakDepth) counters.peakDepth = depth + 1;
+    queued = true;
+  } else {
+    ++counters.dropped;
+  }
+  portEXIT_CRITICAL(&busMux);
+  return queued;
+}
+
+size_t dispatch() {
+  size_t taken = 0;
+  Event e;
+  while (taken < MAX_EVENTS_PER_DISPATCH && take(e)) {
+    ++taken;
+    Mask m = bit(e.id);
+    for (size_t i = 0; i < subscriberCount; ++i) {
+      const Subscriber& s = subscribers[i];
+      if (!(s.filter & m)) continue;
+      s.thunk(e, s.fn, s.ctx);
+      ++counters.delivered;
+    }
+  }
+  return taken;
+}
+
+Stats stats() {
+  portENTER_CRITICAL(&busMux);
+  Stats s = counters;
+  portEXIT_CRITICAL(&busMux);
+  return s;
+}
+
+void reset() {
+  portENTER_CRITICAL(&busMux);
+  head = tail = 0;
+  counters = {};
+  portEXIT_CRITICAL(&busMux);
+  subscriberCount = 0;
+}
+
+}  // namespace EventBus
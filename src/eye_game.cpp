@@ -1,4 +1,6 @@
 #include "eye_game.h"
+#include "bubu_clock.h"
+#include "event_bus.h"
 
 #include <Arduino.h>
 #include <math.h>
@@ -65,16 +67,19 @@ void refreshColor565(uint32_t nowMs) {
   state.rightColor565 = colorFromType(state.rightColor);
 }
 
+// CareSystem applies stat changes on the next EventBus::dispatch().
+void publishStatDelta(CareSystem::StatId stat, int delta) {
+  EventBus::publish(EventBus::StatDelta{static_cast<uint8_t>(stat), static_cast<int16_t>(delta)});
+}
+
+void publishRunning() {
+  EventBus::publish(EventBus::GameChanged{state.running, static_cast<uint8_t>(state.lastResult), state.score});
+}
+
 void applyReward() {
   int reward = static_cast<int>(state.score) * static_cast<int>(state.cfg.rewardPerHit);
   if (reward == 0) return;
-
-  switch (state.rewardStat) {
-    case CareSystem::STAT_HUNGER:      CareSystem::addHunger(reward); break;
-    case CareSystem::STAT_MOOD:        CareSystem::addMood(reward); break;
-    case CareSystem::STAT_ENERGY:      CareSystem::addEnergy(reward); break;
-    case CareSystem::STAT_CLEANLINESS: CareSystem::addCleanliness(reward); break;
-  }
+  publishStatDelta(state.rewardStat, reward);
 }
 
 void finishGame(GameResult result) {
@@ -84,21 +89,22 @@ void finishGame(GameResult result) {
   if (result == GAME_FINISH_NORMAL) {
     applyReward();
   }
+  publishRunning();
 }
 
 void applyWrongTapPenalty() {
-  CareSystem::addMood(state.cfg.wrongTapMoodDelta);
-  CareSystem::addEnergy(state.cfg.wrongTapEnergyDelta);
+  publishStatDelta(CareSystem::STAT_MOOD, state.cfg.wrongTapMoodDelta);
+  publishStatDelta(CareSystem::STAT_ENERGY, state.cfg.wrongTapEnergyDelta);
 }
 
 void scheduleNextChange() {
   // Change eye colors every 1-2 seconds; plasma removed.
   uint32_t interval = static_cast<uint32_t>(random(1000, 2001));
-  state.nextChangeMs = millis() + interval;
+  state.nextChangeMs = BubuClock::nowMs() + interval;
 
   state.leftColor = randomColorType();
   state.rightColor = randomColorType();
-  refreshColor565(millis());
+  refreshColor565(BubuClock::nowMs());
   state.rounds++;
 
   if (state.rounds >= state.cfg.maxRounds) {
@@ -118,6 +124,7 @@ void start(CareSystem::StatId rewardStat) {
   state.rounds = 0;
   state.score = 0;
   state.lastResult = GAME_NONE;
+  publishRunning();
   scheduleNextChange();
 }
 
@@ -127,12 +134,13 @@ void stop() {
   applyReward();
   state.running = false;
   state.lastResult = GAME_FINISH_NORMAL;
+  publishRunning();
 }
 
 void update() {
   if (!state.running) return;
 
-  if (millis() >= state.nextChangeMs) {
+  if (BubuClock::nowMs() >= state.nextChangeMs) {
     scheduleNextChange();
   }
 }
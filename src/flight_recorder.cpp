@@ -0,0 +1,274 @@
+#include "flight_recorder.h"
+
+#include <esp_attr.h>
+#include <esp_heap_caps.h>
+#include <esp_system.h>
+#include <freertos/FreeRTOS.h>
+#include <stdio.h>
+#include <string.h>
+#include "display_system.h"
+#include "menu_system.h"
+#include "heap_telemetry.h"
+#include "ota/ota_manager.h"
+#include "logger.h"
+DEFINE_MODULE_LOGGER(FlightLog)
+
+namespace {
+
+using FlightRecorder::Event;
+
+struct Entry {
+  uint32_t ms;  // millis() of the boot that recorded it
+  uint8_t type;
+  uint8_t a;
+  uint16_t b;
+  uint32_t c;
+};
+static_assert(sizeof(Entry) == 12, "keep entries packed, the ring is sized in them");
+
+// Bump the low byte whenever Entry or Event changes meaning: the previous
+// image's ring is read by the next one (e.g. after a rollback).
+constexpr uint32_t MAGIC = 0x46520001;  // 'FR' v1
+
+struct Ring {
+  uint32_t magic;
+  uint32_t boots;  // boots since the last power-on
+  uint32_t head;   // events ever recorded this boot; the entry is written first
+  Entry entries[FlightRecorder::CAPACITY];
+};
+
+RTC_NOINIT_ATTR Ring rtcRing;
+portMUX_TYPE ringMux = portMUX_INITIALIZER_UNLOCKED;
+bool started = false;
+
+// Previous boot, copied out of RTC memory by begin().
+Entry* lastEntries = nullptr;
+uint16_t lastCount = 0;
+uint32_t lastBoot = 0;
+esp_reset_reason_t lastReason = ESP_RST_UNKNOWN;  // how that boot ended
+bool crashReport = false;
+
+// noteLoopTick() window
+uint32_t lastTickMs = 0;
+uint32_t windowStartMs = 0;
+uint32_t windowMaxMs = 0;
+uint32_t windowTicks = 0;
+
+const char* const MENU_NAMES[] = {
+  "CLOSED", "OPEN", "FEEDING", "BATTERY", "CONNECT", "MESSAGE",
+  "STATS", "OPTIONS", "GAMES", "GAME_ACTIVE", "LEVEL"
+};
+static_assert(sizeof(MENU_NAMES) / sizeof(MENU_NAMES[0]) == MENU_STATE_COUNT, "MenuState names");
+
+const char* const EMOTION_NAMES[] = {
+  "IDLE", "CURIOUS", "ANGRY1", "LOVE", "TIRED", "EXCITED", "ANGRY2", "ANGRY3",
+  "WORRIED1", "CURIOUS1", "CURIOUS2", "SAD1", "SAD2", "HAPPY1", "HAPPY2"
+};
+static_assert(sizeof(EMOTION_NAMES) / sizeof(EMOTION_NAMES[0]) == EYE_EMO_COUNT, "EyeEmotion names");
+
+const char* const WIFI_NAMES[] = {"OFF", "PROVISIONING", "CONNECTING", "CONNECTED", "FAILED"};
+
+const char* const SUBSTATE_FLAGS[] = {"irritable", "sluggish", "withdrawn", "uncomfortable", "depressed"};
+
+template <size_t N>
+const char* nameOf(const char* const (&names)[N], uint8_t i) {
+  return i < N ? names[i] : "?";
+}
+
+const char* resetReasonToStr(esp_reset_reason_t r) {
+  switch (r) {
+    case ESP_RST_POWERON: return "POWERON";
+    case ESP_RST_EXT: return "EXT";
+    case ESP_RST_SW: return "SW";
+    case ESP_RST_PANIC: return "PANIC";
+    case ESP_RST_INT_WDT: return "INT_WDT";
+    case ESP_RST_TASK_WDT: return "TASK_WDT";
+    case ESP_RST_WDT: return "WDT";
+    case ESP_RST_DEEPSLEEP: return "DEEPSLEEP";
+    case ESP_RST_BROWNOUT: return "BROWNOUT";
+    case ESP_RST_SDIO: return "SDIO";
+    default: return "UNKNOWN";
+  }
+}
+
+bool isCrash(esp_reset_reason_t r) {
+  return r == ESP_RST_PANIC || r == ESP_RST_INT_WDT || r == ESP_RST_TASK_WDT ||
+         r == ESP_RST_WDT || r == ESP_RST_BROWNOUT;
+}
+
+// One event as "   12.345 MENU STATS"; returns the length written.
+int formatEntry(const Entry& e, char* out, size_t cap) {
+  int n = snprintf(out, cap, "%6lu.%03lu ", static_cast<unsigned long>(e.ms / 1000),
+                   static_cast<unsigned long>(e.ms % 1000));
+  if (n < 0 || static_cast<size_t>(n) >= cap) return n;
+  char* p = out + n;
+  size_t room = cap - n;
+  int m;
+  switch (static_cast<Event>(e.type)) {
+    case Event::BOOT:
+      m = snprintf(p, room, "BOOT #%lu reset=%s", static_cast<unsigned long>(e.c),
+                   resetReasonToStr(static_cast<esp_reset_reason_t>(e.a)));
+      break;
+    case Event::MENU:
+      m = snprintf(p, room, "MENU %s", nameOf(MENU_NAMES, e.a));
+      break;
+    case Event::EMOTION:
+      m = snprintf(p, room, "EMOTION %s", nameOf(EMOTION_NAMES, e.a));
+      break;
+    case Event::SUBSTATE: {
+      m = snprintf(p, room, "SUBSTATE");
+      for (uint8_t i = 0; i < 5 && m > 0 && static_cast<size_t>(m) < room; ++i) {
+        if (e.a & (1u << i)) m += snprintf(p + m, room - m, " %s", SUBSTATE_FLAGS[i]);
+      }
+      if (!e.a && m > 0 && static_cast<size_t>(m) < room) m += snprintf(p + m, room - m, " none");
+      break;
+    }
+    case Event::WIFI:
+      m = snprintf(p, room, "WIFI %s", nameOf(WIFI_NAMES, e.a));
+      break;
+    case Event::OTA:
+      m = snprintf(p, room, "OTA %s", BubuOTA::phaseToStr(static_cast<BubuOTA::Phase>(e.a)));
+      break;
+    case Event::FRAME:
+      m = snprintf(p, room, "FRAME max=%u ms avg=%lu ms", e.b,
+                   static_cast<unsigned long>(e.c ? FlightRecorder::HEALTH_PERIOD_MS / e.c : 0));
+      break;
+    case Event::STALL:
+      m = snprintf(p, room, "STALL %u ms", e.b);
+      break;
+    case Event::HEAP:
+      m = snprintf(p, room, "HEAP free=%lu block=%uK psram=%u%%",
+                   static_cast<unsigned long>(e.c), e.b, e.a);
+      break;
+    case Event::HEAP_WARN:
+      m = snprintf(p, room, "HEAP_WARN %s %s (%lu)",
+                   HeapTelemetry::warningToStr(static_cast<HeapTelemetry::Warning>(e.a)),
+                   e.b ? "raised" : "cleared", static_cast<unsigned long>(e.c));
+      break;
+    default:
+      m = snprintf(p, room, "? type=%u a=%u b=%u c=%lu", e.type, e.a, e.b,
+                   static_cast<unsigned long>(e.c));
+      break;
+  }
+  return m < 0 ? m : n + m;
+}
+
+// Copies the previous boot's events, oldest first, out of RTC memory.
+void keepPreviousBoot(esp_reset_reason_t reason) {
+  uint32_t head = rtcRing.head;
+  uint16_t count = head < FlightRecorder::CAPACITY ? head : FlightRecorder::CAPACITY;
+  lastBoot = rtcRing.boots;
+  lastReason = reason;
+  if (!count) return;
+  lastEntries = static_cast<Entry*>(heap_caps_malloc(count * sizeof(Entry), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+  if (!lastEntries) lastEntries = static_cast<Entry*>(malloc(count * sizeof(Entry)));
+  if (!lastEntries) return;
+  for (uint16_t i = 0; i < count; ++i) {
+    lastEntries[i] = rtcRing.entries[(head - count + i) % FlightRecorder::CAPACITY];
+  }
+  lastCount = count;
+}
+
+void dumpPreviousBoot() {
+  bool crash = isCrash(lastReason);
+  if (crash) {
+    LOG_WARN(FlightLog, "[FR] Boot #%lu ended with %s; last %u events:\n",
+                        static_cast<unsigned long>(lastBoot), resetReasonToStr(lastReason), lastCount);
+  } else {
+    LOG_INFO(FlightLog, "[FR] Boot #%lu ended with %s (%u events)\n",
+                        static_cast<unsigned long>(lastBoot), resetReasonToStr(lastReason), lastCount);
+  }
+  char line[96];
+  for (uint16_t i = 0; i < lastCount; ++i) {
+    if (formatEntry(lastEntries[i], line, sizeof(line)) <= 0) continue;
+    if (crash) {
+      LOG_WARN(FlightLog, "[FR] %s\n", line);
+    } else {
+      LOG_DEBUG(FlightLog, "[FR] %s\n", line);
+    }
+  }
+}
+
+}  // namespace
+
+namespace FlightRecorder {
+
+void begin() {
+  if (started) return;
+  esp_reset_reason_t reason = esp_reset_reason();
+  // Power-on leaves RTC memory random; anything else keeps the last boot's ring.
+  bool valid = rtcRing.magic == MAGIC && reason != ESP_RST_POWERON;
+  if (valid) {
+    keepPreviousBoot(reason);
+    crashReport = lastCount > 0 && isCrash(reason);
+    dumpPreviousBoot();
+    if (!crashReport) clearCrashReport();
+  }
+  portENTER_CRITICAL(&ringMux);
+  rtcRing.boots = valid ? rtcRing.boots + 1 : 1;
+  rtcRing.head = 0;
+  rtcRing.magic = MAGIC;
+  portEXIT_CRITICAL(&ringMux);
+  started = true;
+  record(Event::BOOT, static_cast<uint8_t>(reason), 0, rtcRing.boots);
+}
+
+void record(Event type, uint8_t a, uint16_t b, uint32_t c) {
+  if (!started) return;
+  Entry e = {static_cast<uint32_t>(millis()), static_cast<uint8_t>(type), a, b, c};
+  portENTER_CRITICAL(&ringMux);
+  uint32_t head = rtcRing.head;
+  rtcRing.entries[head % CAPACITY] = e;
+  rtcRing.head = head + 1;  // after the entry: a reset in between loses only this event
+  portEXIT_CRITICAL(&ringMux);
+}
+
+void noteLoopTick(uint32_t nowMs) {
+  if (lastTickMs == 0) {
+    lastTickMs = windowStartMs = nowMs;
+    return;
+  }
+  uint32_t gap = nowMs - lastTickMs;
+  lastTickMs = nowMs;
+  ++windowTicks;
+  if (gap > windowMaxMs) windowMaxMs = gap;
+  if (gap >= STALL_MS) record(Event::STALL, 0, gap > 0xFFFF ? 0xFFFF : gap);
+  if (nowMs - windowStartMs < HEALTH_PERIOD_MS) return;
+
+  record(Event::FRAME, 0, windowMaxMs > 0xFFFF ? 0xFFFF : windowMaxMs, windowTicks);
+  windowStartMs = nowMs;
+  windowMaxMs = 0;
+  windowTicks = 0;
+}
+
+bool hasCrashReport() {
+  return crashReport;
+}
+
+size_t formatCrashReport(char* out, size_t cap) {
+  if (!crashReport || !cap) return 0;
+  int n = snprintf(out, cap, "boot=%lu reset=%s events=%u\n", static_cast<unsigned long>(lastBoot),
+                   resetReasonToStr(lastReason), lastCount);
+  if (n < 0 || static_cast<size_t>(n) >= cap) {  // keep whole lines only, the header too
+    out[0] = '\0';
+    return 0;
+  }
+  size_t len = n;
+  for (uint16_t i = 0; i < lastCount && len + 1 < cap; ++i) {
+    int m = formatEntry(lastEntries[i], out + len, cap - len);
+    if (m < 0 || len + m + 1 >= cap) break;  // keep whole lines only
+    len += m;
+    out[len++] = '\n';
+  }
+  out[len] = '\0';
+  return len;
+}
+
+void clearCrashReport() {
+  crashReport = false;
+  free(lastEntries);  // heap_caps_malloc memory is released with free() too
+  lastEntries = nullptr;
+  lastCount = 0;
+}
+
+}  // namespace FlightRecorder
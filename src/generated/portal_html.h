@@ -0,0 +1,223 @@
+#pragma once
+// Generated by tools/embed_portal.py from portal.html; do not edit.
+// 11453 bytes -> 9177 minified -> 3370 gzip
+#include <Arduino.h>
+
+namespace PortalAsset {
+  constexpr size_t GZ_LEN = 3370;
+  constexpr size_t RAW_LEN = 9177;
+  constexpr const char* ETAG = "\"e9beb32ef9c50207\"";
+  static const uint8_t GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x5a, 0xff, 0x57, 0xe3, 0x36,
+    0x12, 0xff, 0x7d, 0xff, 0x0a, 0x91, 0xed, 0x36, 0x76, 0x71, 0x8c, 0x13, 0xbe, 0x2c, 0xd8, 0x40,
+    0x8f, 0x40, 0xe8, 0xe6, 0xca, 0x12, 0x1e, 0x09, 0xc7, 0xed, 0xeb, 0xdb, 0xb7, 0xab, 0xc4, 0x0a,
+    0x71, 0x71, 0xec, 0x54, 0x56, 0x08, 0x69, 0x9a, 0xff, 0xfd, 0x66, 0x24, 0xd9, 0xb1, 0x13, 0x43,
+    0xf7, 0xf6, 0xde, 0xfd, 0xd0, 0x8d, 0x35, 0x1a, 0x8d, 0x46, 0x33, 0x9f, 0x19, 0xcd, 0x88, 0x1e,
+    0x6f, 0x5d, 0x74, 0xce, 0x7b, 0x9f, 0x6e, 0x5a, 0x64, 0x24, 0xc6, 0xe1, 0xe9, 0x31, 0xfe, 0x4b,
+    0x42, 0x1a, 0x3d, 0x9c, 0x54, 0x58, 0x54, 0x81, 0x31, 0xa3, 0xfe, 0xe9, 0xf1, 0x98, 0x09, 0x4a,
+    0x06, 0x23, 0xca, 0x13, 0x26, 0x4e, 0x2a, 0x77, 0xbd, 0xcb, 0xda, 0x61, 0x45, 0x53, 0x23, 0x3a,
+    0x66, 0x27, 0x95, 0xa7, 0x80, 0xcd, 0x26, 0x31, 0x17, 0x15, 0x32, 0x88, 0x23, 0xc1, 0x22, 0xe0,
+    0x9a, 0x05, 0xbe, 0x18, 0x9d, 0xf8, 0xec, 0x29, 0x18, 0xb0, 0x9a, 0x1c, 0x58, 0x24, 0x88, 0x02,
+    0x11, 0xd0, 0xb0, 0x96, 0x0c, 0x68, 0xc8, 0x4e, 0xea, 0xb6, 0x03, 0x52, 0x44, 0x20, 0x42, 0x76,
+    0xda, 0xbc, 0x6b, 0xde, 0x91, 0x2e, 0x13, 0xd3, 0xc9, 0xf1, 0x8e, 0xa2, 0x1c, 0x27, 0x62, 0x0e,
+    0x3f, 0x2e, 0x8f, 0x63, 0xb1, 0xa8, 0xd5, 0xd8, 0x5c, 0x4b, 0x71, 0x0f, 0xf6, 0x26, 0xcf, 0x9e,
+    0x22, 0x8c, 0x58, 0xf0, 0x30, 0x12, 0x79, 0xca, 0x03, 0x9d, 0xb8, 0x8d, 0x86, 0x1c, 0x0a, 0xf6,
+    0x2c, 0x6a, 0x83, 0x38, 0x8c, 0xb9, 0xfb, 0x76, 0x38, 0x1c, 0x02, 0xa5, 0xff, 0xe0, 0xbe, 0x75,
+    0x1c, 0x67, 0xf9, 0xd3, 0xa2, 0x1f, 0x3f, 0xd7, 0x92, 0xe0, 0xcf, 0x20, 0x7a, 0x70, 0xfb, 0x31,
+    0xf7, 0x19, 0xaf, 0x01, 0x65, 0xd9, 0x8f, 0xfd, 0xf9, 0x62, 0x4c, 0xf9, 0x43, 0x10, 0xb9, 0x8e,
+    0xa7, 0x76, 0xab, 0x3b, 0xce, 0xd3, 0xcc, 0xd3, 0x1b, 0xe1, 0x60, 0xe4, 0xf5, 0xe9, 0xe0, 0xf1,
+    0x81, 0xc7, 0xd3, 0xc8, 0x77, 0x9f, 0x28, 0x37, 0x50, 0xae, 0xe9, 0xa9, 0x8d, 0xd4, 0x78, 0xb5,
+    0xb3, 0xe9, 0x0d, 0xc1, 0x1e, 0xb5, 0x21, 0x1d, 0x07, 0xe1, 0xdc, 0xad, 0xb4, 0xc1, 0x36, 0xbc,
+    0x62, 0x55, 0x3e, 0xb0, 0xf0, 0x89, 0x89, 0x60, 0x40, 0xc9, 0x35, 0x9b, 0xb2, 0x8a, 0x75, 0xc6,
+    0xc1, 0x2a, 0x56, 0x42, 0xa3, 0xa4, 0x96, 0x30, 0x1e, 0x0c, 0xbd, 0xf8, 0x89, 0xf1, 0x61, 0x18,
+    0xcf, 0xdc, 0x51, 0xe0, 0xfb, 0x2c, 0xf2, 0xfc, 0x20, 0x99, 0x84, 0x74, 0xee, 0x0e, 0x43, 0xf6,
+    0xec, 0xd1, 0x30, 0x78, 0x88, 0x6a, 0x81, 0x60, 0xe3, 0xc4, 0x1d, 0x30, 0x14, 0xe9, 0xfd, 0x3e,
+    0x4d, 0x44, 0x30, 0x9c, 0xd7, 0xb4, 0xf5, 0x53, 0xf2, 0x24, 0x4e, 0xc0, 0xe0, 0x71, 0xe4, 0x72,
+    0x16, 0x52, 0x11, 0x3c, 0xb1, 0xa5, 0x0d, 0x52, 0x18, 0x5f, 0x64, 0x13, 0xb4, 0x9f, 0xc4, 0xe1,
+    0x54, 0x30, 0x2f, 0x88, 0xc0, 0xb7, 0x70, 0xea, 0xef, 0xde, 0x29, 0xc0, 0xdf, 0x1a, 0x7b, 0x82,
+    0x71, 0xe2, 0x46, 0x71, 0xc4, 0x96, 0x6f, 0xc7, 0x2c, 0x49, 0xe8, 0x03, 0x2b, 0xd9, 0x4d, 0xc4,
+    0x13, 0x77, 0xb7, 0xf1, 0x4e, 0xdb, 0xf8, 0xc8, 0x79, 0xe7, 0x8d, 0xe9, 0xb3, 0xf6, 0xef, 0x6e,
+    0xc3, 0x01, 0xff, 0x49, 0x1b, 0xca, 0xfd, 0xd3, 0x2d, 0xa4, 0x25, 0xc1, 0x69, 0xcc, 0xad, 0x1f,
+    0x02, 0x43, 0xc8, 0x04, 0x6e, 0x98, 0x4c, 0xe8, 0x00, 0xdd, 0xe8, 0xd8, 0xfb, 0x40, 0x8c, 0x71,
+    0x24, 0xe6, 0x70, 0x0e, 0xc1, 0xc1, 0x9a, 0x6a, 0x57, 0x4d, 0x24, 0x39, 0xe7, 0x0c, 0xa9, 0xcf,
+    0x4c, 0x12, 0x06, 0x11, 0xa3, 0xdc, 0xfb, 0xb3, 0x16, 0x44, 0x3e, 0x7b, 0x76, 0x77, 0xcb, 0x4f,
+    0x01, 0xb0, 0x4a, 0x16, 0x88, 0x2b, 0xb5, 0x5e, 0xa3, 0xcc, 0xcc, 0x96, 0x35, 0xbe, 0x65, 0x57,
+    0x14, 0x52, 0xd8, 0x75, 0x69, 0x03, 0x69, 0xa1, 0x4e, 0xbc, 0x12, 0x2c, 0xc7, 0x66, 0x0a, 0xb7,
+    0x15, 0x5d, 0x11, 0xcc, 0x3c, 0xf4, 0x24, 0xa6, 0x35, 0x78, 0x39, 0xf5, 0x83, 0x69, 0xe2, 0xd6,
+    0x0f, 0xd0, 0x70, 0xa8, 0xc2, 0x30, 0xe6, 0xe3, 0x5a, 0xcc, 0x03, 0x44, 0xb2, 0x32, 0xdf, 0xd2,
+    0xee, 0xc3, 0xc6, 0x8f, 0x0b, 0x1a, 0x05, 0x63, 0x2a, 0x15, 0x94, 0x63, 0xad, 0x9e, 0xfc, 0xae,
+    0xf9, 0x53, 0x2e, 0xa7, 0x4c, 0xc2, 0x68, 0xc2, 0xe0, 0x78, 0xb5, 0x78, 0x2a, 0x08, 0xc8, 0x9a,
+    0x51, 0xee, 0x27, 0xcb, 0x7f, 0x3c, 0xb2, 0xf9, 0x90, 0x43, 0xbc, 0x27, 0x44, 0xc9, 0x72, 0xde,
+    0x2d, 0xb2, 0xdd, 0x5c, 0x19, 0xd3, 0x9f, 0x8c, 0xba, 0xb9, 0xdc, 0xdb, 0x2f, 0xa1, 0x3b, 0xb6,
+    0x73, 0x68, 0x2e, 0x21, 0x80, 0xca, 0xd7, 0x2c, 0xdf, 0xf6, 0xa7, 0xfd, 0x7e, 0x08, 0x96, 0x7e,
+    0x19, 0x9a, 0xa9, 0xc1, 0xeb, 0xa5, 0x7e, 0xb2, 0x95, 0x80, 0x92, 0xf5, 0xb9, 0x1c, 0x50, 0xb4,
+    0xd7, 0x3e, 0xe0, 0xee, 0x3b, 0xf1, 0xbe, 0x09, 0xcf, 0x09, 0xf5, 0x7d, 0x04, 0x22, 0xfa, 0x20,
+    0x07, 0xd5, 0xc6, 0x26, 0x2a, 0xe5, 0xd1, 0xe5, 0x17, 0x04, 0x25, 0x9a, 0xc6, 0x5c, 0x3f, 0x10,
+    0x9d, 0x8a, 0x78, 0x3d, 0x07, 0xa4, 0x07, 0x74, 0x5d, 0x3a, 0x04, 0xd6, 0x45, 0xaa, 0x50, 0xa5,
+    0xe2, 0x6d, 0x1e, 0x59, 0xe1, 0xea, 0x10, 0xce, 0xa7, 0xa1, 0x84, 0x9f, 0x79, 0xf0, 0x40, 0x1a,
+    0x2c, 0x31, 0x06, 0x86, 0x65, 0x1d, 0x7e, 0x43, 0x36, 0x14, 0xf2, 0x23, 0x33, 0x79, 0xba, 0x3b,
+    0x81, 0x78, 0x8b, 0x16, 0x1b, 0x79, 0x65, 0x15, 0x0c, 0x29, 0xa3, 0x9d, 0x8c, 0xe2, 0x59, 0x1e,
+    0x6d, 0x92, 0x7a, 0x09, 0x11, 0xd0, 0x8e, 0x52, 0xd0, 0x49, 0x92, 0x8e, 0x0a, 0x44, 0x5c, 0x06,
+    0x35, 0x4b, 0x73, 0x87, 0x31, 0x15, 0x6b, 0xcc, 0x48, 0x2a, 0xe2, 0x33, 0x88, 0x86, 0x78, 0xaf,
+    0x30, 0x42, 0x43, 0xb0, 0x4b, 0x04, 0x26, 0xcd, 0x74, 0x88, 0x62, 0xc9, 0xff, 0xbd, 0x6a, 0x90,
+    0xad, 0x60, 0x8c, 0xb7, 0x1a, 0x8d, 0x44, 0x26, 0xd2, 0x0f, 0xc6, 0x8b, 0xcc, 0x9f, 0xf6, 0x6e,
+    0x19, 0x4b, 0xc2, 0x42, 0x36, 0x10, 0xcc, 0x5f, 0xe4, 0xb2, 0x41, 0xe6, 0x78, 0xb2, 0xeb, 0x38,
+    0xe3, 0x44, 0xee, 0x63, 0xa5, 0x29, 0xa2, 0x21, 0x49, 0x3a, 0x1b, 0x95, 0x40, 0xc4, 0xa8, 0x81,
+    0x73, 0x2c, 0xfc, 0xc7, 0x24, 0x32, 0x64, 0x20, 0x62, 0x94, 0x8f, 0x80, 0x94, 0xd3, 0x40, 0xfa,
+    0x6f, 0x8d, 0x94, 0x3a, 0x66, 0x2f, 0x53, 0x6f, 0x32, 0x0d, 0x13, 0x00, 0xea, 0x86, 0x51, 0x6e,
+    0x80, 0xce, 0xb4, 0x4d, 0x00, 0x5c, 0x11, 0x9c, 0xa1, 0x86, 0xbc, 0xac, 0xdc, 0xdc, 0x85, 0x74,
+    0x90, 0xb3, 0xea, 0x62, 0xc8, 0xe3, 0x9c, 0x89, 0x96, 0x22, 0xce, 0x06, 0xf5, 0x65, 0xc9, 0x22,
+    0xe9, 0x20, 0xb9, 0xe6, 0x85, 0xe0, 0x40, 0x09, 0xa5, 0x53, 0xb5, 0x3a, 0x5c, 0x14, 0x66, 0x89,
+    0x4c, 0x79, 0x92, 0x62, 0x76, 0x7a, 0xd5, 0x96, 0xcb, 0xfd, 0x6f, 0xe6, 0xb5, 0xeb, 0xfb, 0x1b,
+    0x59, 0xec, 0x75, 0xd9, 0xcb, 0xb7, 0xc8, 0xf4, 0xc2, 0x1d, 0x78, 0xb0, 0xff, 0x2e, 0x17, 0xab,
+    0xeb, 0x77, 0x60, 0x21, 0x37, 0xe1, 0x3f, 0x35, 0x3f, 0xe0, 0xe0, 0x16, 0x14, 0x03, 0x49, 0x6d,
+    0x3a, 0x8e, 0x3c, 0xbc, 0x97, 0xd0, 0x0c, 0xb9, 0x1c, 0x53, 0x92, 0x1c, 0xcb, 0xee, 0xa5, 0x15,
+    0x0e, 0x73, 0x18, 0x91, 0xba, 0xaa, 0xd0, 0xcd, 0x9c, 0x56, 0x96, 0x9c, 0x96, 0x41, 0x34, 0x99,
+    0x0a, 0x08, 0x53, 0x21, 0xe2, 0x68, 0x91, 0x55, 0x4a, 0xef, 0xb2, 0x2c, 0x88, 0x3a, 0x11, 0x99,
+    0xfc, 0x54, 0x96, 0x71, 0xeb, 0x30, 0x86, 0x83, 0x07, 0x3e, 0xe1, 0x0f, 0x7d, 0x6a, 0x34, 0xf6,
+    0xf7, 0xad, 0xf4, 0x3f, 0x08, 0xa3, 0xc2, 0xcd, 0x56, 0xc2, 0xe0, 0x1c, 0x98, 0x2f, 0xa7, 0xf1,
+    0xb5, 0x8c, 0x0b, 0xc5, 0xe0, 0x52, 0x2b, 0xf6, 0x2d, 0x7b, 0xef, 0xff, 0xdd, 0xde, 0xf5, 0x86,
+    0xb9, 0x7c, 0x9b, 0x4c, 0x07, 0x03, 0xa8, 0x66, 0x7a, 0x90, 0xf6, 0x5f, 0x70, 0x65, 0xfd, 0xf0,
+    0xff, 0x59, 0xce, 0xbc, 0x5e, 0xa3, 0xe4, 0x22, 0x00, 0x0b, 0x8d, 0x9b, 0x78, 0x52, 0x72, 0x37,
+    0x6f, 0x02, 0x3d, 0xc3, 0x74, 0xf9, 0xc5, 0x2c, 0xd1, 0x7b, 0xbc, 0xa3, 0xea, 0xf0, 0xe3, 0x1d,
+    0xd5, 0x0a, 0x60, 0x8d, 0x7c, 0x7a, 0xec, 0x07, 0x4f, 0x24, 0xf0, 0x4f, 0x2a, 0xba, 0xc2, 0xab,
+    0x9c, 0x7e, 0x68, 0x5d, 0x5d, 0x75, 0xb6, 0xc8, 0xd9, 0x6d, 0x8b, 0x7c, 0xea, 0xdc, 0x91, 0x5f,
+    0x3a, 0xed, 0xeb, 0x5f, 0x48, 0xaf, 0x43, 0xba, 0x1f, 0x3a, 0xf7, 0xe4, 0x63, 0x8b, 0xf4, 0x3e,
+    0xb4, 0xc8, 0x7d, 0xe7, 0xf6, 0xea, 0xe2, 0xe7, 0xe3, 0x1d, 0x58, 0xbc, 0x92, 0x80, 0xfa, 0x42,
+    0xd7, 0x10, 0xd2, 0x24, 0x39, 0xa9, 0xc8, 0xe2, 0xb4, 0xa2, 0x26, 0x35, 0x09, 0xe6, 0x81, 0xb0,
+    0x5a, 0x53, 0x42, 0x2e, 0x0a, 0xd4, 0x75, 0x44, 0x65, 0x9d, 0x8e, 0xe7, 0x02, 0xa2, 0x04, 0xae,
+    0x24, 0x4c, 0x40, 0xd0, 0x0c, 0x00, 0x52, 0x21, 0x62, 0x3e, 0x61, 0xf9, 0x31, 0x04, 0xdd, 0x80,
+    0x8d, 0xe2, 0x10, 0xb0, 0x73, 0x52, 0xb9, 0xd1, 0x64, 0x62, 0x84, 0x8c, 0x3e, 0x31, 0x28, 0x7d,
+    0x28, 0x94, 0x4d, 0xc1, 0x90, 0xc4, 0x13, 0x16, 0x99, 0x20, 0x51, 0x61, 0x4d, 0x8a, 0xd4, 0x69,
+    0xb3, 0x29, 0xa2, 0x54, 0xa8, 0x9a, 0xac, 0x9c, 0x9e, 0xab, 0x99, 0xe3, 0x1d, 0x45, 0x58, 0x57,
+    0x2e, 0x07, 0xaf, 0xca, 0xe9, 0x7d, 0xe7, 0x7e, 0x0b, 0x0c, 0x76, 0x76, 0xfd, 0x6b, 0x77, 0x4b,
+    0xf3, 0x25, 0x03, 0x1e, 0x4c, 0xc4, 0x29, 0xc8, 0x4f, 0x04, 0xe9, 0xb5, 0x3f, 0xa2, 0x75, 0x4f,
+    0xc8, 0xa2, 0xf5, 0xa9, 0xd5, 0xfd, 0x72, 0x79, 0x76, 0xd1, 0xfa, 0xd2, 0xbe, 0x76, 0xc9, 0xa1,
+    0xe3, 0x58, 0xcd, 0xab, 0xf6, 0xf5, 0xaf, 0x5f, 0x2e, 0xee, 0x6e, 0xcf, 0x7a, 0xed, 0x0e, 0xd0,
+    0xea, 0x07, 0x29, 0xed, 0x97, 0xb3, 0x1b, 0x97, 0x34, 0x1a, 0x8e, 0xd5, 0x6b, 0xfd, 0xbb, 0xb7,
+    0x5a, 0xf4, 0x1e, 0x17, 0xdd, 0x35, 0x9b, 0x57, 0xad, 0x15, 0xed, 0x20, 0x47, 0xbb, 0xea, 0x9c,
+    0xf5, 0xbe, 0xdc, 0xb4, 0x6e, 0xdb, 0x9d, 0x0b, 0x39, 0xe1, 0x58, 0xe7, 0x9d, 0xeb, 0xeb, 0xd6,
+    0x39, 0x10, 0xef, 0xae, 0xba, 0xad, 0x6c, 0xea, 0xc8, 0x71, 0xde, 0x2c, 0x3d, 0xa5, 0xe0, 0x79,
+    0xe7, 0xaa, 0x73, 0xdb, 0x05, 0x05, 0x7f, 0xab, 0xbc, 0xbd, 0xbc, 0x3c, 0x68, 0x1e, 0x34, 0x2b,
+    0x16, 0xc1, 0xcf, 0x8b, 0xa3, 0xdd, 0x0b, 0xf9, 0x79, 0xd0, 0x3c, 0x6f, 0xbe, 0x7f, 0x2f, 0x3f,
+    0xf7, 0x2e, 0x8e, 0x0e, 0x2e, 0x2f, 0xe5, 0xe7, 0xd1, 0xc5, 0x5e, 0xeb, 0x42, 0x31, 0x5c, 0x36,
+    0x0e, 0xf7, 0x0e, 0x1b, 0xea, 0xf3, 0x7d, 0xf3, 0xd0, 0xa9, 0xcb, 0xcf, 0xdd, 0xb3, 0xa6, 0x03,
+    0xbc, 0x9f, 0x3d, 0x3f, 0x1e, 0x4c, 0xc7, 0x80, 0x7f, 0x3b, 0xfd, 0x68, 0x85, 0x4c, 0x8e, 0x25,
+    0x58, 0xe1, 0x06, 0x16, 0x37, 0x1c, 0xfc, 0xc3, 0xc5, 0xdc, 0xa8, 0xe6, 0x8a, 0xef, 0xaa, 0xa5,
+    0x8d, 0x67, 0xe7, 0x2d, 0x47, 0xb6, 0x49, 0x75, 0x9c, 0x54, 0xcd, 0xff, 0x52, 0x6a, 0xb1, 0x66,
+    0x5e, 0x89, 0x2e, 0xba, 0xe0, 0x3b, 0x85, 0x67, 0x5d, 0xca, 0x4a, 0x6e, 0xde, 0x6f, 0xdf, 0xab,
+    0xf2, 0xaa, 0xd4, 0xc9, 0xe9, 0x5b, 0xf0, 0xfe, 0xff, 0x28, 0x19, 0x6f, 0xf3, 0x4d, 0xd1, 0x39,
+    0x10, 0x7d, 0xa7, 0xfc, 0x42, 0x41, 0xb2, 0xda, 0xa0, 0x0c, 0x8b, 0xd9, 0x0e, 0x0a, 0x8c, 0xdd,
+    0xde, 0x59, 0xaf, 0x85, 0x60, 0x5c, 0xb4, 0xaf, 0x7b, 0xb7, 0x1d, 0x97, 0x54, 0xe5, 0x6f, 0xd5,
+    0x92, 0x10, 0xf8, 0x57, 0xbb, 0xdb, 0x06, 0x15, 0x81, 0x9a, 0x1f, 0x56, 0x55, 0x90, 0xac, 0x26,
+    0xf3, 0xc3, 0xaa, 0x75, 0xdf, 0xbe, 0x6c, 0x7f, 0xe9, 0xb6, 0xae, 0x60, 0x67, 0x19, 0x64, 0xd5,
+    0x22, 0xa1, 0x6a, 0xdd, 0x9c, 0x75, 0xbb, 0x90, 0xed, 0x2e, 0xc0, 0x9e, 0x37, 0x77, 0x3d, 0x60,
+    0x28, 0x12, 0xaa, 0x69, 0x0c, 0xc1, 0x11, 0x60, 0x72, 0x35, 0xa8, 0x5a, 0xdd, 0xbb, 0xf3, 0xf3,
+    0x56, 0xb7, 0x0b, 0x54, 0xfd, 0x55, 0x85, 0xa8, 0x82, 0xbb, 0x81, 0x24, 0x02, 0x0a, 0x0c, 0x38,
+    0x85, 0x3a, 0x8e, 0x2d, 0xcf, 0x60, 0xe9, 0x7a, 0x27, 0xc1, 0x50, 0xfb, 0x6c, 0x91, 0xb4, 0xf0,
+    0x6c, 0xaa, 0x52, 0xfd, 0x84, 0x44, 0xd3, 0x30, 0xd4, 0x66, 0xc0, 0x18, 0x68, 0x85, 0x40, 0xcb,
+    0xec, 0xfe, 0xc0, 0x52, 0x93, 0x37, 0xe7, 0x6d, 0xdf, 0xa8, 0x22, 0x47, 0xd5, 0xb4, 0x74, 0x4a,
+    0x7f, 0x9d, 0x57, 0x33, 0x01, 0xbb, 0xd6, 0xe0, 0x75, 0x76, 0xcd, 0x04, 0xec, 0x98, 0x85, 0x5f,
+    0xe7, 0x45, 0x0e, 0x60, 0x4c, 0xb3, 0xf1, 0xeb, 0xcc, 0x29, 0x17, 0x2c, 0x58, 0xe5, 0xde, 0xd7,
+    0x16, 0xac, 0xb8, 0x60, 0x49, 0x2e, 0xeb, 0xbe, 0xbe, 0x4d, 0x8e, 0x31, 0xc3, 0x15, 0x00, 0xb4,
+    0xab, 0x7d, 0x02, 0xf6, 0x3f, 0x25, 0xd8, 0x90, 0x41, 0x39, 0xc0, 0xec, 0x30, 0x7e, 0x30, 0xaa,
+    0x6a, 0xaa, 0x76, 0x0a, 0x50, 0x4d, 0x4c, 0x2f, 0x75, 0x5e, 0xe2, 0xa5, 0x29, 0x72, 0x46, 0x03,
+    0x01, 0x84, 0xb1, 0x5c, 0x1a, 0xb1, 0x19, 0x01, 0xb0, 0x8f, 0x83, 0x84, 0x19, 0x1c, 0x09, 0x20,
+    0xbb, 0x17, 0x8c, 0x19, 0x94, 0xdb, 0x06, 0xb7, 0x80, 0xc9, 0x34, 0x3d, 0x9a, 0xcc, 0xa3, 0x01,
+    0x19, 0x4e, 0x23, 0x59, 0xfe, 0x11, 0x3e, 0x8d, 0xda, 0x91, 0xe0, 0xb1, 0x61, 0x92, 0x45, 0xaa,
+    0x89, 0x91, 0xc7, 0x86, 0xe9, 0x29, 0x8f, 0xeb, 0x70, 0x4a, 0xab, 0xbe, 0x13, 0x52, 0xad, 0x57,
+    0x3d, 0x2a, 0xb7, 0xc7, 0x7f, 0x8c, 0x92, 0x7c, 0x08, 0xfa, 0xae, 0x49, 0xcc, 0xc7, 0x86, 0xa9,
+    0x57, 0xfb, 0x71, 0x13, 0x13, 0x60, 0x97, 0xfd, 0x31, 0x65, 0xd1, 0x80, 0x19, 0x0d, 0xd3, 0xcb,
+    0xa0, 0xf3, 0x8d, 0x9b, 0xe6, 0x33, 0xda, 0xe6, 0xa6, 0xf9, 0x98, 0x4b, 0x37, 0x05, 0x43, 0x72,
+    0x71, 0x1f, 0x0c, 0x83, 0xae, 0x84, 0x3a, 0x58, 0xc2, 0x30, 0xbd, 0xe5, 0x9b, 0x35, 0xe3, 0xac,
+    0xab, 0x36, 0x30, 0x95, 0x77, 0x54, 0x14, 0x60, 0xb0, 0xd8, 0x76, 0x96, 0x76, 0x6c, 0x60, 0xe2,
+    0x73, 0x25, 0x2f, 0xe6, 0x67, 0x61, 0x68, 0x54, 0xf1, 0x69, 0xa6, 0x6a, 0x7e, 0x86, 0x12, 0x8d,
+    0xe3, 0xad, 0x0f, 0xe5, 0x02, 0xac, 0x71, 0x3c, 0xf8, 0x39, 0x26, 0x03, 0xf8, 0xd9, 0xde, 0x06,
+    0x81, 0x28, 0xca, 0x06, 0x8e, 0x16, 0x1d, 0x8c, 0x0c, 0x26, 0x11, 0xc0, 0x6c, 0x59, 0x9d, 0x5c,
+    0x05, 0x89, 0xb0, 0x39, 0x1b, 0x43, 0x03, 0x0f, 0xd0, 0x47, 0x4d, 0x00, 0x34, 0x4f, 0x31, 0x94,
+    0x9f, 0x60, 0x92, 0xe1, 0x10, 0xce, 0x79, 0x8f, 0x95, 0xa1, 0x97, 0x67, 0x87, 0xb2, 0x79, 0xc5,
+    0xbb, 0x34, 0x4b, 0x8c, 0xb5, 0x71, 0xad, 0x14, 0xe8, 0x70, 0xbb, 0xa3, 0x21, 0x96, 0x6f, 0xd4,
+    0x39, 0xc7, 0x74, 0x72, 0x9b, 0x24, 0x41, 0x2f, 0xee, 0x42, 0x81, 0x09, 0xca, 0xf3, 0x0c, 0xa1,
+    0x30, 0x17, 0x60, 0x84, 0xd4, 0x8e, 0x1c, 0x40, 0x16, 0x7d, 0xc6, 0xcf, 0x5d, 0xc7, 0x1a, 0x20,
+    0xfe, 0x3f, 0x52, 0x31, 0xb2, 0x81, 0x66, 0x00, 0x8b, 0xa5, 0x47, 0x41, 0x64, 0x00, 0xc5, 0x02,
+    0x09, 0x7f, 0xfd, 0x45, 0x6a, 0x87, 0x8e, 0x69, 0x5a, 0x08, 0x5c, 0x03, 0x16, 0xd4, 0x50, 0x94,
+    0x49, 0x76, 0x08, 0x72, 0xe8, 0x91, 0xc7, 0x99, 0x98, 0xf2, 0x88, 0x40, 0x3d, 0x09, 0x2a, 0x0a,
+    0xf2, 0x13, 0x31, 0xa0, 0xbb, 0x85, 0x49, 0x20, 0x80, 0x82, 0xeb, 0x30, 0x1e, 0x32, 0x31, 0x18,
+    0x5d, 0x33, 0x01, 0x31, 0xfc, 0x98, 0x20, 0x96, 0x05, 0x9f, 0xa7, 0x7a, 0x82, 0xce, 0x44, 0x99,
+    0x41, 0x72, 0x19, 0xd5, 0x1d, 0xa8, 0x4a, 0x21, 0x6c, 0x3d, 0xa8, 0xbd, 0x8c, 0x2d, 0x6e, 0xc7,
+    0x8f, 0x26, 0x11, 0x23, 0x1e, 0xcf, 0x64, 0xfc, 0xb4, 0x38, 0x8f, 0x39, 0x44, 0x2a, 0xb0, 0x90,
+    0x21, 0x0d, 0x42, 0xe6, 0x67, 0x91, 0xea, 0x67, 0x82, 0xb8, 0xfd, 0x7b, 0x22, 0x21, 0xa3, 0xb5,
+    0x3c, 0xe3, 0x9c, 0xce, 0xed, 0x20, 0x91, 0xbf, 0x86, 0x6f, 0x92, 0x9f, 0x81, 0xd9, 0x85, 0x5c,
+    0xea, 0x2d, 0xc9, 0x80, 0xc2, 0xa6, 0xc4, 0x60, 0xe6, 0x2a, 0xb2, 0x67, 0x94, 0x47, 0x10, 0xda,
+    0xb9, 0x2d, 0x2c, 0xc2, 0x32, 0x61, 0xb8, 0x0a, 0x1c, 0x90, 0x9d, 0x4d, 0x56, 0x91, 0x2a, 0x15,
+    0x27, 0x46, 0xc4, 0x44, 0x02, 0x92, 0xf2, 0xf9, 0xda, 0xcb, 0x52, 0xa7, 0x1d, 0x40, 0x52, 0xe2,
+    0x1f, 0x7a, 0x1f, 0xaf, 0x30, 0x54, 0xaa, 0x69, 0x8a, 0x80, 0x81, 0x9c, 0xb8, 0x57, 0x8f, 0xe7,
+    0xa3, 0x74, 0xfc, 0x41, 0x3e, 0xe9, 0x58, 0x44, 0xd0, 0x47, 0x16, 0x29, 0x51, 0x6a, 0x05, 0x95,
+    0x20, 0x83, 0x9b, 0x8e, 0x3c, 0xd7, 0x5d, 0x58, 0xbf, 0x43, 0x1a, 0x68, 0xf9, 0x3d, 0xf0, 0xf4,
+    0x73, 0x23, 0x25, 0x6c, 0x2b, 0xc2, 0x1c, 0x38, 0x46, 0xe0, 0x1e, 0xe8, 0x6f, 0x0e, 0x61, 0xd4,
+    0x48, 0x47, 0xef, 0xc9, 0xd2, 0x43, 0x65, 0xed, 0x24, 0x0c, 0x20, 0x74, 0x80, 0xf3, 0xd0, 0xcc,
+    0x60, 0x8e, 0xc7, 0xb0, 0xa0, 0x60, 0x7d, 0x36, 0x73, 0x78, 0x4a, 0x14, 0xc4, 0x0a, 0x90, 0x43,
+    0x46, 0x9b, 0xc3, 0xd0, 0x04, 0xe4, 0xc8, 0x2e, 0x0d, 0xb3, 0x1f, 0x32, 0x82, 0x0a, 0x88, 0x3b,
+    0x7c, 0x63, 0x07, 0x52, 0xc3, 0x91, 0x97, 0x1b, 0xa2, 0x10, 0x75, 0x92, 0x61, 0x86, 0xee, 0x85,
+    0x2d, 0xc8, 0xc9, 0x09, 0x8c, 0xc0, 0x66, 0x38, 0x29, 0x55, 0xf7, 0x70, 0x5e, 0x69, 0xb9, 0xbf,
+    0x0f, 0x1e, 0x62, 0xf8, 0x5e, 0xb1, 0xc0, 0xf5, 0x82, 0x07, 0xd2, 0xa8, 0x0e, 0x54, 0x15, 0x6a,
+    0x81, 0xde, 0x61, 0x3b, 0xdd, 0x7d, 0x5b, 0xc1, 0x19, 0x1a, 0x1c, 0x3f, 0x1e, 0x03, 0xd0, 0x00,
+    0x97, 0x33, 0xb0, 0x4d, 0x03, 0x3f, 0xd6, 0x78, 0x21, 0xd9, 0xce, 0xbf, 0x4d, 0xc2, 0xe8, 0x65,
+    0x09, 0x52, 0xa3, 0xed, 0x6d, 0xd0, 0x72, 0x36, 0x02, 0xa4, 0x10, 0x43, 0xa9, 0x78, 0x0c, 0x27,
+    0x26, 0x3f, 0xfe, 0x48, 0x0c, 0xe3, 0x99, 0x9c, 0x2a, 0x7f, 0xd9, 0xcf, 0x75, 0xa4, 0x3c, 0xc3,
+    0x9c, 0x1e, 0x37, 0x70, 0x3c, 0xcf, 0xe6, 0xe7, 0x75, 0x35, 0x4e, 0xe7, 0xe7, 0x0d, 0x13, 0x62,
+    0xf1, 0x8d, 0xf4, 0xbe, 0x9d, 0xc4, 0x63, 0x66, 0x4c, 0x72, 0xde, 0x40, 0xc3, 0x91, 0x89, 0x8d,
+    0xf1, 0x08, 0x51, 0xeb, 0xcf, 0xe5, 0x68, 0x0e, 0xa3, 0x39, 0x8c, 0x20, 0xd3, 0xa4, 0x61, 0x9e,
+    0xfc, 0xc1, 0x85, 0x01, 0xcc, 0x3f, 0xe1, 0x8a, 0x6d, 0x64, 0x84, 0xaf, 0x79, 0x06, 0x66, 0xc9,
+    0x7a, 0x4c, 0x8c, 0x89, 0xcd, 0xf3, 0x26, 0x80, 0x5e, 0x18, 0xb2, 0x93, 0x89, 0xa9, 0x46, 0xed,
+    0x3f, 0x99, 0x26, 0x23, 0x63, 0x81, 0x5b, 0x81, 0x7c, 0xee, 0xa6, 0x9c, 0xcb, 0x2c, 0xf6, 0xa0,
+    0xc1, 0xc9, 0x5d, 0xac, 0x03, 0xce, 0x20, 0xc3, 0xeb, 0xbb, 0xd5, 0xa8, 0xc2, 0x2c, 0x56, 0x82,
+    0xc1, 0x93, 0xca, 0x84, 0xd7, 0xd0, 0xc1, 0x62, 0x04, 0xa8, 0xc0, 0xa8, 0xae, 0x23, 0x21, 0xe3,
+    0x5b, 0x65, 0x4c, 0xfd, 0xc0, 0xa7, 0x85, 0xa8, 0x5b, 0x67, 0xd5, 0xcd, 0x83, 0x2c, 0xd5, 0x8a,
+    0xfc, 0x86, 0x52, 0xde, 0xe9, 0x81, 0x1d, 0xb2, 0xe8, 0x41, 0x8c, 0x3e, 0xe7, 0x96, 0xc8, 0x4e,
+    0x1d, 0xb8, 0xbf, 0xfe, 0xb0, 0x40, 0x90, 0x2e, 0x27, 0xcf, 0x5f, 0x73, 0xb3, 0xea, 0x09, 0xf5,
+    0xc5, 0x69, 0x7c, 0x88, 0x53, 0x93, 0x68, 0x74, 0x65, 0x80, 0x35, 0x16, 0x11, 0x4f, 0x14, 0xc7,
+    0xbc, 0xc8, 0xa1, 0x6c, 0x14, 0xd2, 0x3e, 0x0b, 0x5f, 0xb1, 0x12, 0x3e, 0xb9, 0xc2, 0x09, 0x25,
+    0x9b, 0x8d, 0x8d, 0xc1, 0xb9, 0x7a, 0xfa, 0xc5, 0x02, 0x0f, 0xc2, 0x0c, 0xa2, 0xcc, 0xc7, 0xe4,
+    0x5c, 0x35, 0xd4, 0x43, 0xb1, 0x59, 0x95, 0x3b, 0xd3, 0x09, 0xf4, 0xa7, 0xfe, 0x39, 0xa0, 0xcf,
+    0x37, 0xe4, 0x52, 0x65, 0x23, 0x9f, 0x0a, 0x9a, 0xa4, 0xab, 0xd6, 0x04, 0x54, 0x0b, 0x1c, 0x18,
+    0xbe, 0x9a, 0x43, 0x7e, 0x2a, 0x8e, 0x55, 0xd2, 0xca, 0x6f, 0x00, 0xeb, 0xcc, 0x74, 0x4a, 0x61,
+    0x42, 0x52, 0x96, 0x08, 0x94, 0x2c, 0x21, 0xe2, 0xb3, 0x52, 0x9a, 0x0f, 0x57, 0xb9, 0x30, 0x4b,
+    0x2e, 0x7d, 0x89, 0xe2, 0xfe, 0xba, 0x8b, 0x71, 0x15, 0x9c, 0xbe, 0x8f, 0xa3, 0x16, 0xbe, 0x79,
+    0xe0, 0x14, 0x83, 0x34, 0x08, 0xc5, 0x1c, 0xa4, 0xa8, 0x47, 0xc8, 0xc1, 0x86, 0x4c, 0x47, 0x23,
+    0x88, 0xcc, 0x50, 0x27, 0x5c, 0x75, 0x9d, 0x1b, 0x7d, 0x53, 0xeb, 0xb0, 0x76, 0xed, 0x94, 0x95,
+    0x11, 0x9b, 0x75, 0x54, 0xb1, 0xaa, 0x4f, 0x11, 0x8d, 0xc9, 0xb1, 0x78, 0x33, 0xad, 0xee, 0x2f,
+    0x9d, 0x39, 0x63, 0x08, 0x2d, 0x83, 0x42, 0x75, 0x2e, 0xf5, 0x32, 0xfa, 0x99, 0xfd, 0x6a, 0x47,
+    0x47, 0x47, 0x26, 0x40, 0xc0, 0xa0, 0x45, 0x92, 0xe9, 0x6d, 0x5c, 0x16, 0xf9, 0xfc, 0xab, 0xae,
+    0xbc, 0xd4, 0x5e, 0x0a, 0xbe, 0x90, 0x1e, 0x9c, 0xac, 0xac, 0x01, 0xd3, 0xa5, 0xad, 0xc0, 0x6f,
+    0x4e, 0x7a, 0x1b, 0xe0, 0x4b, 0x21, 0xd2, 0xb1, 0x9a, 0x6d, 0x62, 0x38, 0x04, 0xd1, 0xc3, 0x79,
+    0x18, 0x80, 0x05, 0x6f, 0xd1, 0x36, 0x68, 0xd2, 0x22, 0x80, 0x07, 0x34, 0x1c, 0x18, 0xf8, 0x7c,
+    0x5c, 0x23, 0x3f, 0x2c, 0x70, 0xb5, 0x8e, 0x0b, 0x48, 0xbd, 0x80, 0x56, 0xf3, 0x6b, 0xb6, 0x40,
+    0xc3, 0x59, 0xf1, 0xef, 0xe7, 0xf8, 0x75, 0xa4, 0xe4, 0x16, 0xbc, 0xe4, 0x4c, 0x55, 0x1e, 0xbd,
+    0xea, 0xcf, 0x85, 0xf4, 0x5c, 0x01, 0x34, 0x79, 0x34, 0x95, 0xb8, 0x1b, 0x30, 0x4e, 0x16, 0x68,
+    0x2a, 0x55, 0x6f, 0x6f, 0x9d, 0x64, 0xed, 0x52, 0xd1, 0x95, 0x98, 0x4f, 0x37, 0x58, 0x8a, 0x2d,
+    0x9a, 0x49, 0x54, 0x22, 0xf4, 0x36, 0x7a, 0x2a, 0x16, 0x6e, 0x54, 0xaa, 0x6b, 0x4b, 0xbd, 0x72,
+    0x64, 0x4b, 0x1f, 0xca, 0x1d, 0x51, 0xcf, 0x0d, 0xd3, 0xf8, 0xc1, 0x58, 0x95, 0x7e, 0x10, 0xe4,
+    0xeb, 0x56, 0xd3, 0x3a, 0x54, 0xf1, 0xcf, 0xc9, 0xd8, 0x3f, 0xbd, 0x60, 0xd6, 0x55, 0xcf, 0x04,
+    0x5b, 0x0f, 0xa6, 0x49, 0x59, 0x6d, 0xac, 0xcc, 0xa6, 0x9f, 0xa3, 0x0c, 0x6d, 0xaf, 0xad, 0xe2,
+    0x29, 0x73, 0x87, 0x2f, 0x1e, 0x74, 0xd5, 0xa9, 0x9a, 0x6b, 0x86, 0x59, 0xd7, 0x48, 0xff, 0x91,
+    0x41, 0xd5, 0x60, 0xba, 0xe3, 0xb2, 0xe1, 0x52, 0xa1, 0xc0, 0x8b, 0x79, 0x47, 0xf0, 0x29, 0xd3,
+    0x38, 0x9d, 0xd0, 0x39, 0xe4, 0x70, 0x55, 0xb7, 0x60, 0x2a, 0x72, 0xd7, 0xfa, 0xd8, 0x42, 0xca,
+    0xb2, 0x08, 0x1e, 0xd2, 0x25, 0xb9, 0xa3, 0x3e, 0xd1, 0x70, 0xca, 0x54, 0x76, 0x82, 0xda, 0x25,
+    0x5f, 0x40, 0xb2, 0x64, 0xb3, 0x84, 0xa4, 0x4f, 0xf8, 0x7c, 0xb0, 0x18, 0x33, 0x31, 0x8a, 0x7d,
+    0xec, 0xcc, 0x3b, 0x5d, 0xe8, 0xc7, 0xf1, 0x6d, 0x93, 0x71, 0x90, 0xbb, 0x80, 0x76, 0x5c, 0x65,
+    0xd7, 0x5a, 0x6f, 0x3e, 0x61, 0x55, 0xe0, 0x80, 0x3c, 0x07, 0xb8, 0x94, 0x8f, 0x3c, 0x3b, 0x58,
+    0x3e, 0xc2, 0x2e, 0x16, 0xbe, 0x82, 0xba, 0xe4, 0x9f, 0xdd, 0xce, 0x35, 0x84, 0x04, 0x87, 0x83,
+    0x06, 0xc3, 0xb9, 0xa1, 0x0f, 0x62, 0xbe, 0x59, 0xa6, 0x35, 0x2a, 0x60, 0xa0, 0xb4, 0x4a, 0xd5,
+    0x36, 0x59, 0x15, 0xaa, 0xba, 0xbb, 0x01, 0x37, 0x76, 0x55, 0xab, 0x89, 0xae, 0x7b, 0xb9, 0x04,
+    0x3d, 0x2f, 0xae, 0x97, 0x55, 0x68, 0xb9, 0x9d, 0x87, 0x14, 0x8a, 0xa4, 0x97, 0x7d, 0x95, 0x76,
+    0x29, 0x2b, 0x77, 0xfd, 0x1d, 0xb6, 0xb1, 0xc4, 0x5d, 0xcf, 0xa6, 0x79, 0xb5, 0x37, 0xd3, 0xa8,
+    0x7e, 0xc8, 0x78, 0x21, 0x2c, 0xfa, 0x9b, 0xbd, 0xa2, 0x53, 0x86, 0xf3, 0x54, 0x53, 0x0d, 0xf5,
+    0x42, 0x73, 0x9b, 0xfd, 0x25, 0x0b, 0xb3, 0x92, 0x7e, 0x00, 0x27, 0x7b, 0xd9, 0xdf, 0x37, 0xbe,
+    0xe6, 0xbb, 0xa9, 0x3d, 0xec, 0x43, 0x5e, 0x5c, 0x0d, 0x17, 0xdc, 0x2b, 0x4d, 0xac, 0x53, 0x68,
+    0x62, 0x1b, 0x28, 0xa9, 0xf0, 0x84, 0x50, 0xda, 0xf6, 0xca, 0x96, 0x2c, 0xf5, 0xcc, 0xcb, 0x77,
+    0x58, 0x21, 0x2e, 0x4d, 0x6f, 0x16, 0x40, 0x99, 0x39, 0x2b, 0xe1, 0x47, 0x84, 0x01, 0x7b, 0xda,
+    0xff, 0x9b, 0xde, 0xf1, 0x8e, 0x7e, 0x1c, 0x3e, 0xde, 0x51, 0x6f, 0xf3, 0x3b, 0xf2, 0xff, 0xe4,
+    0xf9, 0x0f, 0xde, 0x5f, 0xa9, 0x9d, 0xd9, 0x23, 0x00, 0x00,
+  };
+}
@@ -0,0 +1,121 @@
+#include "gesture_table.h"
+
+#include "eye_game.h"
+#include "logger.h"
+DEFINE_MODULE_LOGGER(DisplayLog)
+
+namespace GestureTable {
+
+bool run(Action action, const TouchPoint& touch, uint32_t nowMs, const Hooks& hooks) {
+  switch (action) {
+    // Layer 5: game
+    case Action::GAME_TAP:
+      EyeGame::handleTap(touch.x, touch.y);
+      return true;
+    case Action::GAME_EXIT:
+      // Long press anywhere but the eyes exits back to the games menu
+      if (hooks.tapOnEyes(touch)) {
+        LOG_DEBUG(DisplayLog, "[Layer 5] LONG_PRESS on eyes ignored\n");
+        return false;
+      }
+      LOG_DEBUG(DisplayLog, "[Layer 5] LONG_PRESS off eyes -> exit to games menu\n");
+      EyeGame::stop();
+      MenuSystem::handleGameFinished();
+      return true;
+
+    // Layer 4: games menu
+    case Action::GAMES_START:
+      MenuSystem::startTapTheGreens();
+      return true;
+    case Action::GAMES_BACK:
+      MenuSystem::closeGamesToStats();
+      return true;
+
+    // Layer 3: options
+    case Action::OPTION_ACTIVATE:
+      MenuSystem::activateCurrentOption();
+      return true;
+    case Action::OPTIONS_BACK:
+      MenuSystem::closeOptionsToStats();
+      return true;
+    case Action::OPTIONS_PREV:
+      MenuSystem::selectOptionsPrev();
+      return false;
+    case Action::OPTIONS_NEXT:
+      MenuSystem::selectOptionsNext();
+      return false;
+
+    // Layer 2: connect, message, stats, battery, level
+    case Action::CONNECT_TAP:
+      return MenuSystem::handleConnectTap(touch.x, touch.y);
+    case Action::CONNECT_EXIT:
+      MenuSystem::closeConnectToMenu();
+      return true;
+    case Action::MESSAGE_EXIT:
+      MenuSystem::closeMessageToMenu();
+      return true;
+    case Action::STATS_PREV:
+      MenuSystem::statsPrev();
+      return false;
+    case Action::STATS_NEXT:
+      MenuSystem::statsNext();
+      return false;
+    case Action::STATS_ENTER:
+      if (MenuSystem::getCurrentStatIndex() == 3 && MenuSystem::isTapOnStatsTitle(touch.x, touch.y)) {
+        LOG_DEBUG(DisplayLog, "[Layer 2] Action: CLEAN animation\n");
+        hooks.startClean(nowMs);
+        MenuSystem::close();
+      } else if (MenuSystem::getCurrentStatIndex() == 1) {
+        MenuSystem::openGamesMenu();
+      } else {
+        MenuSystem::openOptionsForCurrentStat();
+      }
+      return true;
+    case Action::STATS_EXIT:
+      MenuSystem::closeStatsToMenu();
+      return true;
+    case Action::BATTERY_EXIT:
+      MenuSystem::closeBatteryToMenu();
+      return true;
+    case Action::LEVEL_EXIT:
+      MenuSystem::closeLevelToMenu();
+      return true;
+
+    // Layer 1: menu
+    case Action::MENU_ENTER:
+      if (!MenuSystem::isTapOnSelected(touch.x, touch.y)) {
+        LOG_DEBUG(DisplayLog, "[Layer 1] TAP ignored (not on selected item)\n");
+        return false;
+      }
+      MenuSystem::activateSelected();
+      return MenuSystem::isStatsOpen() || MenuSystem::isConnectOpen() || MenuSystem::isMessageOpen();
+    case Action::MENU_PREV:
+      MenuSystem::selectPrev();
+      return false;
+    case Action::MENU_NEXT:
+      MenuSystem::selectNext();
+      return false;
+    case Action::MENU_EXIT:
+      MenuSystem::close();
+      return true;
+
+    // Layer 0: eyes
+    case Action::IDLE_TAP:
+      if (hooks.tapOnEyes(touch)) {
+        LOG_DEBUG(DisplayLog, "[Layer 0] -> Eyes hit, triggering test emotion\n");
+        hooks.triggerTestEmotion(nowMs);
+        return false;
+      }
+      LOG_DEBUG(DisplayLog, "[Layer 0] -> Eyes missed, opening menu!\n");
+      MenuSystem::open();
+      return true;
+
+    case Action::UNSET:
+    case Action::IGNORE:
+    case Action::COUNT:
+      break;
+  }
+  return false;
+}
+
+}  // namespace GestureTable
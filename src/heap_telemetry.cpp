@@ -0,0 +1,243 @@
+#include "heap_telemetry.h"
+
+#include <esp_heap_caps.h>
+#include <lvgl.h>
+#include "flight_recorder.h"
+#include "lvgl_mem/tiered_alloc.h"
+#include "logger.h"
+DEFINE_MODULE_LOGGER(HeapLog)
+
+namespace {
+
+using HeapTelemetry::Sample;
+using HeapTelemetry::Warning;
+
+struct Ring {
+  Sample* buf;
+  uint16_t cap;
+  uint16_t count;
+  uint16_t next;
+
+  void push(const Sample& s) {
+    if (!buf) return;
+    buf[next] = s;
+    next = (next + 1) % cap;
+    if (count < cap) ++count;
+  }
+  bool get(size_t age, Sample& out) const {
+    if (!buf || age >= count) return false;
+    out = buf[(next + cap - 1 - age) % cap];
+    return true;
+  }
+};
+
+Ring recent = {nullptr, HeapTelemetry::RECENT_SAMPLES, 0, 0};
+Ring history = {nullptr, HeapTelemetry::HISTORY_SAMPLES, 0, 0};
+Sample worst;            // worst values since the last history entry
+uint16_t worstCount = 0;
+uint32_t lastSampleMs = 0;
+uint32_t spiramTotal = 0;
+uint8_t active = 0;      // warning bits
+
+// Only LVGL's builtin pool can run out or fragment on its own; the tiered
+// allocator spills into PSRAM and is covered by the SPIRAM rules.
+constexpr bool LV_POOL_FIXED = LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN;
+
+// value < raise starts a "below" warning, value >= clear ends it; the other
+// way round for "above" warnings.
+struct Rule {
+  Warning warning;
+  bool below;
+  uint32_t raise;
+  uint32_t clear;
+  uint32_t (*value)(const Sample&);
+};
+
+const Rule RULES[] = {
+  {Warning::INTERNAL_LOW, true, HeapTelemetry::INTERNAL_FREE_MIN,
+   HeapTelemetry::INTERNAL_FREE_MIN * 5 / 4, [](const Sample& s) { return s.internal.free; }},
+  {Warning::INTERNAL_FRAGMENTED, true, HeapTelemetry::INTERNAL_BLOCK_MIN,
+   HeapTelemetry::INTERNAL_BLOCK_MIN * 5 / 4, [](const Sample& s) { return s.internal.largest; }},
+  {Warning::DMA_FRAGMENTED, true, HeapTelemetry::DMA_BLOCK_MIN,
+   HeapTelemetry::DMA_BLOCK_MIN * 5 / 4, [](const Sample& s) { return s.dma.largest; }},
+  {Warning::SPIRAM_LOW, true, HeapTelemetry::SPIRAM_FREE_MIN,
+   HeapTelemetry::SPIRAM_FREE_MIN * 5 / 4, [](const Sample& s) { return s.spiram.free; }},
+  {Warning::LVGL_LOW, true, HeapTelemetry::LVGL_FREE_MIN,
+   HeapTelemetry::LVGL_FREE_MIN * 5 / 4, [](const Sample& s) { return s.lvFree; }},
+  {Warning::LVGL_FRAGMENTED, false, HeapTelemetry::LVGL_FRAG_MAX_PCT,
+   HeapTelemetry::LVGL_FRAG_MAX_PCT * 3 / 4, [](const Sample& s) { return static_cast<uint32_t>(s.lvFragPct); }},
+};
+static_assert(sizeof(RULES) / sizeof(RULES[0]) == static_cast<size_t>(Warning::COUNT), "one rule per warning");
+
+HeapTelemetry::CapStats readCap(uint32_t caps) {
+  return {static_cast<uint32_t>(heap_caps_get_free_size(caps)),
+          static_cast<uint32_t>(heap_caps_get_minimum_free_size(caps)),
+          static_cast<uint32_t>(heap_caps_get_largest_free_block(caps))};
+}
+
+void keepWorst(HeapTelemetry::CapStats& w, const HeapTelemetry::CapStats& s) {
+  if (s.free < w.free) w.free = s.free;
+  if (s.minFree < w.minFree) w.minFree = s.minFree;
+  if (s.largest < w.largest) w.largest = s.largest;
+}
+
+void foldIntoHistory(const Sample& s) {
+  if (worstCount == 0) {
+    worst = s;
+  } else {
+    keepWorst(worst.internal, s.internal);
+    keepWorst(worst.dma, s.dma);
+    keepWorst(worst.spiram, s.spiram);
+    if (s.lvTotal) {
+      if (s.lvFree < worst.lvFree) worst.lvFree = s.lvFree;
+      if (s.lvBiggest < worst.lvBiggest) worst.lvBiggest = s.lvBiggest;
+      if (s.lvMaxUsed > worst.lvMaxUsed) worst.lvMaxUsed = s.lvMaxUsed;
+      if (s.lvUsedPct > worst.lvUsedPct) worst.lvUsedPct = s.lvUsedPct;
+      if (s.lvFragPct > worst.lvFragPct) worst.lvFragPct = s.lvFragPct;
+    }
+    worst.ms = s.ms;
+  }
+  if (++worstCount < HeapTelemetry::HISTORY_EVERY) return;
+  history.push(worst);
+  worstCount = 0;
+}
+
+void checkThresholds(const Sample& s) {
+  for (const Rule& r : RULES) {
+    bool lv = r.warning == Warning::LVGL_LOW || r.warning == Warning::LVGL_FRAGMENTED;
+    if (lv && (!LV_POOL_FIXED || !s.lvTotal)) continue;
+    uint8_t bit = 1u << static_cast<uint8_t>(r.warning);
+    uint32_t v = r.value(s);
+    bool on = active & bit;
+    bool raise = r.below ? v < r.raise : v > r.raise;
+    bool clear = r.below ? v >= r.clear : v <= r.clear;
+    if (!on && raise) {
+      active |= bit;
+      LOG_WARN(HeapLog, "[Heap] %s: %lu (limit %lu)\n", HeapTelemetry::warningToStr(r.warning),
+                        static_cast<unsigned long>(v), static_cast<unsigned long>(r.raise));
+      FlightRecorder::record(FlightRecorder::Event::HEAP_WARN, static_cast<uint8_t>(r.warning), 1, v);
+    } else if (on && clear) {
+      active &= ~bit;
+      LOG_INFO(HeapLog, "[Heap] %s cleared: %lu\n", HeapTelemetry::warningToStr(r.warning),
+                        static_cast<unsigned long>(v));
+      FlightRecorder::record(FlightRecorder::Event::HEAP_WARN, static_cast<uint8_t>(r.warning), 0, v);
+    }
+  }
+}
+
+uint8_t fragPct(const HeapTelemetry::CapStats& c) {
+  return c.free ? static_cast<uint8_t>(100 - static_cast<uint64_t>(c.largest) * 100 / c.free) : 0;
+}
+
+void logCap(const char* name, const HeapTelemetry::CapStats& c) {
+  LOG_INFO(HeapLog, "%-8s free %7lu  min %7lu  largest %7lu  frag %3u%%\n", name,
+                    static_cast<unsigned long>(c.free), static_cast<unsigned long>(c.minFree),
+                    static_cast<unsigned long>(c.largest), fragPct(c));
+}
+
+}  // namespace
+
+namespace HeapTelemetry {
+
+void begin() {
+  if (recent.buf) return;
+  spiramTotal = heap_caps_get_total_size(MALLOC_CAP_SPIRAM);
+  recent.buf = static_cast<Sample*>(
+      heap_caps_calloc(RECENT_SAMPLES, sizeof(Sample), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+  history.buf = static_cast<Sample*>(
+      heap_caps_calloc(HISTORY_SAMPLES, sizeof(Sample), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+  if (!recent.buf || !history.buf) {
+    LOG_WARN(HeapLog, "[Heap] No PSRAM for telemetry rings; thresholds only\n");
+  }
+}
+
+Sample sampleNow() {
+  Sample s = {};
+  s.ms = millis();
+  s.internal = readCap(MALLOC_CAP_INTERNAL);
+  s.dma = readCap(MALLOC_CAP_DMA);
+  s.spiram = readCap(MALLOC_CAP_SPIRAM);
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN || LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+  if (lv_is_initialized()) {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    s.lvTotal = mon.total_size;
+    s.lvFree = mon.free_size;
+    s.lvBiggest = mon.free_biggest_size;
+    s.lvMaxUsed = mon.max_used;
+    s.lvUsedPct = mon.used_pct;
+    s.lvFragPct = mon.frag_pct;
+  }
+#endif
+  return s;
+}
+
+void update(uint32_t nowMs) {
+  if (nowMs - lastSampleMs < SAMPLE_PERIOD_MS) return;
+  lastSampleMs = nowMs;
+  Sample s = sampleNow();
+  recent.push(s);
+  foldIntoHistory(s);
+  checkThresholds(s);
+
+  uint8_t psramPct = spiramTotal ? static_cast<uint8_t>(static_cast<uint64_t>(s.spiram.free) * 100 / spiramTotal) : 0;
+  uint32_t largestKb = s.internal.largest / 1024;
+  FlightRecorder::record(FlightRecorder::Event::HEAP, psramPct,
+                         largestKb > 0xFFFF ? 0xFFFF : largestKb, s.internal.free);
+}
+
+size_t count(Window w) {
+  return w == Window::RECENT ? recent.count : history.count;
+}
+
+bool get(Window w, size_t age, Sample& out) {
+  return (w == Window::RECENT ? recent : history).get(age, out);
+}
+
+uint8_t warnings() {
+  return active;
+}
+
+const char* warningToStr(Warning w) {
+  switch (w) {
+    case Warning::INTERNAL_LOW: return "INTERNAL_LOW";
+    case Warning::INTERNAL_FRAGMENTED: return "INTERNAL_FRAGMENTED";
+    case Warning::DMA_FRAGMENTED: return "DMA_FRAGMENTED";
+    case Warning::SPIRAM_LOW: return "SPIRAM_LOW";
+    case Warning::LVGL_LOW: return "LVGL_LOW";
+    case Warning::LVGL_FRAGMENTED: return "LVGL_FRAGMENTED";
+    default: return "?";
+  }
+}
+
+void logReport(const char* label) {
+  Sample s = sampleNow();
+  LOG_INFO(HeapLog, "------ Memory Report ------\n");
+  if (label) LOG_INFO(HeapLog, "Label: %s\n", label);
+  logCap("internal", s.internal);
+  logCap("dma", s.dma);
+  logCap("spiram", s.spiram);
+  if (s.lvTotal) {
+    LOG_INFO(HeapLog, "lvgl     free %7lu  max used %7lu  biggest %7lu  frag %3u%%\n",
+                      static_cast<unsigned long>(s.lvFree), static_cast<unsigned long>(s.lvMaxUsed),
+                      static_cast<unsigned long>(s.lvBiggest), s.lvFragPct);
+  }
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+  TieredAlloc::logReport();
+#endif
+  for (uint8_t i = 0; i < static_cast<uint8_t>(Warning::COUNT); ++i) {
+    if (active & (1u << i)) LOG_WARN(HeapLog, "warning  %s\n", warningToStr(static_cast<Warning>(i)));
+  }
+  Sample oldest;
+  if (history.get(history.count - 1, oldest) && history.count > 1) {
+    // Worst-case values then vs now: a steady drop in "largest" is fragmentation.
+    LOG_INFO(HeapLog, "trend    %lu min: internal largest %+ld, dma largest %+ld, spiram free %+ld\n",
+                      static_cast<unsigned long>((s.ms - oldest.ms) / 60000),
+                      static_cast<long>(s.internal.largest) - static_cast<long>(oldest.internal.largest),
+                      static_cast<long>(s.dma.largest) - static_cast<long>(oldest.dma.largest),
+                      static_cast<long>(s.spiram.free) - static_cast<long>(oldest.spiram.free));
+  }
+  LOG_INFO(HeapLog, "---------------------------\n");
+}
+
+}  // namespace HeapTelemetry
@@ -1,4 +1,5 @@
 #include "imu_monitor.h"
+#include "bubu_clock.h"
 
 #include <Arduino.h>
 #include <Wire.h>
@@ -48,7 +49,6 @@ constexpr float GYR_LSB_PER_DPS = 65.5f;
 
 constexpr uint32_t SAMPLE_INTERVAL_MS = 100;
 constexpr uint32_t IMU_RETRY_INTERVAL_MS = 2000;
-constexpr bool IMU_LOG_SAMPLES = false;
 
 bool imuReady = false;
 uint8_t imuAddr = IMU_ADDR_PRIMARY;
@@ -108,13 +108,13 @@ bool imuInitQmi8658() {
       imuAddr = IMU_ADDR_ALT;
       who = altWho;
     } else {
-      ImuLog::println("[IMU] WHO_AM_I read failed");
+      LOG_ERROR(ImuLog, "[IMU] WHO_AM_I read failed\n");
       return false;
     }
   } else {
     imuAddr = IMU_ADDR_PRIMARY;
   }
-  ImuLog::printf("[IMU] WHO_AM_I=0x%02X addr=0x%02X\n", who, imuAddr);
+  LOG_INFO(ImuLog, "[IMU] WHO_AM_I=0x%02X addr=0x%02X\n", who, imuAddr);
 
   if (!i2cWriteReg(imuAddr, QMI_REG_CTRL1, QMI_ODR_104HZ | QMI_ACCEL_RANGE_4G)) return false;
   if (!i2cWriteReg(imuAddr, QMI_REG_CTRL2, QMI_ODR_104HZ | QMI_GYRO_RANGE_500DPS)) return false;
@@ -154,20 +154,20 @@ bool imuReadAccelGyro(float& ax, float& ay, float& az, float& gx, float& gy, flo
 namespace ImuMonitor {
 
 void begin() {
-  ImuLog::println("[IMU] Monitor init...");
-  lastInitAttemptMs = millis();
+  LOG_INFO(ImuLog, "[IMU] Monitor init...\n");
+  lastInitAttemptMs = BubuClock::nowMs();
   imuReady = imuInitQmi8658();
   if (!imuReady) {
-    ImuLog::println("[IMU] Init failed");
+    LOG_ERROR(ImuLog, "[IMU] Init failed\n");
   } else {
-    ImuLog::println("[IMU] Init OK");
+    LOG_INFO(ImuLog, "[IMU] Init OK\n");
   }
 
   uint8_t inputs = 0;
   if (readTcaInputs(inputs)) {
     lastTcaInputs = inputs;
   } else {
-    ImuLog::println("[TCA] Input read failed");
+    LOG_WARN(ImuLog, "[TCA] Input read failed\n");
   }
 }
 
@@ -176,7 +176,7 @@ void update(uint32_t nowMs) {
     lastInitAttemptMs = nowMs;
     imuReady = imuInitQmi8658();
     if (imuReady) {
-      ImuLog::println("[IMU] Init OK");
+      LOG_INFO(ImuLog, "[IMU] Init OK\n");
     }
   }
 
@@ -184,12 +184,10 @@ void update(uint32_t nowMs) {
     lastSampleMs = nowMs;
     float ax, ay, az, gx, gy, gz;
     if (imuReadAccelGyro(ax, ay, az, gx, gy, gz)) {
-      if (IMU_LOG_SAMPLES) {
-        ImuLog::printf("ACC: x=%.2f y=%.2f z=%.2f\n", ax, ay, az);
-        ImuLog::printf("GYR: x=%.2f y=%.2f z=%.2f\n", gx, gy, gz);
-      }
+      LOG_TRACE(ImuLog, "ACC: x=%.2f y=%.2f z=%.2f\n", ax, ay, az);
+      LOG_TRACE(ImuLog, "GYR: x=%.2f y=%.2f z=%.2f\n", gx, gy, gz);
     } else {
-      ImuLog::println("[IMU] Read failed");
+      LOG_WARN(ImuLog, "[IMU] Read failed\n");
     }
   }
 
@@ -200,16 +198,16 @@ void update(uint32_t nowMs) {
       lastTcaInputs = inputs;
       int intPin = digitalRead(PIN_TCA_INT);
       bool imuPinChanged = (changed & (1 << TCA_IMU_INT_PIN)) != 0;
-      ImuLog::printf("[INT] IMU interrupt fired via TCA6408, inputs=0x%02X changed=0x%02X IMU_PIN=%d INT_PIN=%d\n",
-                     inputs, changed, imuPinChanged ? 1 : 0, intPin);
+      LOG_INFO(ImuLog, "[INT] IMU interrupt fired via TCA6408, inputs=0x%02X changed=0x%02X IMU_PIN=%d INT_PIN=%d\n",
+                       inputs, changed, imuPinChanged ? 1 : 0, intPin);
     } else {
-      ImuLog::println("[INT] TCA input read failed");
+      LOG_WARN(ImuLog, "[INT] TCA input read failed\n");
     }
 
     if (imuReady) {
       uint8_t status = 0;
       if (i2cReadReg(imuAddr, QMI_REG_INT_STATUS, status)) {
-        ImuLog::printf("[INT] IMU INT_STATUS=0x%02X\n", status);
+        LOG_INFO(ImuLog, "[INT] IMU INT_STATUS=0x%02X\n", status);
       }
     }
   }
@@ -0,0 +1,477 @@
+#include "json_stream.h"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+int hexDigit(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+constexpr uint32_t REPLACEMENT_CHAR = 0xFFFD;
+
+}  // namespace
+
+// ---- JsonReader ----
+
+void JsonReader::begin(char* scratch, size_t scratchLen, Handler handler, void* ctx) {
+  *this = JsonReader();
+  scratch_ = scratch;
+  scratchLen_ = scratchLen;
+  handler_ = handler;
+  ctx_ = ctx;
+  if (scratch_ && scratchLen_) scratch_[0] = '\0';
+}
+
+bool JsonReader::fail() {
+  if (state_ != State::ERROR) errorOffset_ = offset_;
+  state_ = State::ERROR;
+  return false;
+}
+
+void JsonReader::emit(Event ev) {
+  if (scratch_ && scratchLen_) scratch_[len_ < scratchLen_ ? len_ : scratchLen_ - 1] = '\0';
+  if (handler_) handler_(ctx_, ev, depth_, scratch_ ? scratch_ : "", len_);
+  len_ = 0;
+}
+
+void JsonReader::append(char c) {
+  if (len_ + 1 < scratchLen_) {
+    scratch_[len_++] = c;
+  } else {
+    truncated_ = true;
+  }
+}
+
+void JsonReader::appendCodepoint(uint32_t cp) {
+  if (cp < 0x80) {
+    append(static_cast<char>(cp));
+  } else if (cp < 0x800) {
+    append(static_cast<char>(0xC0 | (cp >> 6)));
+    append(static_cast<char>(0x80 | (cp & 0x3F)));
+  } else if (cp < 0x10000) {
+    append(static_cast<char>(0xE0 | (cp >> 12)));
+    append(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+    append(static_cast<char>(0x80 | (cp & 0x3F)));
+  } else {
+    append(static_cast<char>(0xF0 | (cp >> 18)));
+    append(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+    append(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+    append(static_cast<char>(0x80 | (cp & 0x3F)));
+  }
+}
+
+bool JsonReader::push(bool object) {
+  if (depth_ >= MAX_DEPTH) return fail();
+  emit(object ? Event::BEGIN_OBJECT : Event::BEGIN_ARRAY);
+  if (object) objectBits_ |= (1u << depth_);
+  else objectBits_ &= ~(1u << depth_);
+  depth_++;
+  afterOpen_ = true;
+  state_ = object ? State::OBJECT_KEY : State::VALUE;
+  return true;
+}
+
+bool JsonReader::pop(bool object) {
+  if (depth_ == 0 || inObject() != object) return fail();
+  depth_--;
+  emit(object ? Event::END_OBJECT : Event::END_ARRAY);
+  valueDone();
+  return true;
+}
+
+void JsonReader::valueDone() {
+  afterOpen_ = false;
+  state_ = (depth_ == 0) ? State::DONE : State::AFTER_VALUE;
+}
+
+bool JsonReader::step(char c) {
+  switch (state_) {
+    case State::VALUE:
+      if (isSpace(c)) return true;
+      if (c == '{') return push(true);
+      if (c == '[') return push(false);
+      if (c == ']' && afterOpen_ && !inObject()) return pop(false);
+      if (c == '"') {
+        isKey_ = false;
+        len_ = 0;
+        truncated_ = false;
+        state_ = State::STRING;
+        return true;
+      }
+      if (c == '-' || isDigit(c)) {
+        len_ = 0;
+        truncated_ = false;
+        append(c);
+        num_ = (c == '-') ? Num::SIGN : (c == '0') ? Num::ZERO : Num::INT;
+        state_ = State::NUMBER;
+        return true;
+      }
+      if (c == 't' || c == 'f' || c == 'n') {
+        literal_ = (c == 't') ? "true" : (c == 'f') ? "false" : "null";
+        literalEvent_ = (c == 't') ? Event::TRUE_VALUE : (c == 'f') ? Event::FALSE_VALUE : Event::NULL_VALUE;
+        literalPos_ = 1;
+        state_ = State::LITERAL;
+        return true;
+      }
+      return fail();
+
+    case State::OBJECT_KEY:
+      if (isSpace(c)) return true;
+      if (c == '}' && afterOpen_) return pop(true);
+      if (c != '"') return fail();
+      isKey_ = true;
+      len_ = 0;
+      truncated_ = false;
+      state_ = State::STRING;
+      return true;
+
+    case State::COLON:
+      if (isSpace(c)) return true;
+      if (c != ':') return fail();
+      afterOpen_ = false;
+      state_ = State::VALUE;
+      return true;
+
+    case State::AFTER_VALUE:
+      if (isSpace(c)) return true;
+      if (c == ',') {
+        state_ = inObject() ? State::OBJECT_KEY : State::VALUE;
+        return true;
+      }
+      if (c == '}') return pop(true);
+      if (c == ']') return pop(false);
+      return fail();
+
+    case State::STRING:
+      if (c == '"') {
+        if (highSurrogate_) appendCodepoint(REPLACEMENT_CHAR);
+        highSurrogate_ = 0;
+        if (isKey_) {
+          emit(Event::KEY);
+          state_ = State::COLON;
+        } else {
+          emit(Event::STRING);
+          valueDone();
+        }
+        return true;
+      }
+      if (c == '\\') {
+        state_ = State::STRING_ESCAPE;
+        return true;
+      }
+      if (static_cast<uint8_t>(c) < 0x20) return fail();
+      if (highSurrogate_) {
+        appendCodepoint(REPLACEMENT_CHAR);
+        highSurrogate_ = 0;
+      }
+      append(c);
+      return true;
+
+    case State::STRING_ESCAPE: {
+      char out;
+      switch (c) {
+        case '"': out = '"'; break;
+        case '\\': out = '\\'; break;
+        case '/': out = '/'; break;
+        case 'b': out = '\b'; break;
+        case 'f': out = '\f'; break;
+        case 'n': out = '\n'; break;
+        case 'r': out = '\r'; break;
+        case 't': out = '\t'; break;
+        case 'u':
+          hexCount_ = 0;
+          hexValue_ = 0;
+          state_ = State::STRING_UNICODE;
+          return true;
+        default:
+          return fail();
+      }
+      if (highSurrogate_) {
+        appendCodepoint(REPLACEMENT_CHAR);
+        highSurrogate_ = 0;
+      }
+      append(out);
+      state_ = State::STRING;
+      return true;
+    }
+
+    case State::STRING_UNICODE: {
+      int d = hexDigit(c);
+      if (d < 0) return fail();
+      hexValue_ = (hexValue_ << 4) | static_cast<uint32_t>(d);
+      if (++hexCount_ < 4) return true;
+      state_ = State::STRING;
+      if (hexValue_ >= 0xD800 && hexValue_ <= 0xDBFF) {
+        if (highSurrogate_) appendCodepoint(REPLACEMENT_CHAR);
+        highSurrogate_ = hexValue_;
+      } else if (hexValue_ >= 0xDC00 && hexValue_ <= 0xDFFF) {
+        if (highSurrogate_) {
+          appendCodepoint(0x10000 + ((highSurrogate_ - 0xD800) << 10) + (hexValue_ - 0xDC00));
+        } else {
+          appendCodepoint(REPLACEMENT_CHAR);
+        }
+        highSurrogate_ = 0;
+      } else {
+        if (highSurrogate_) appendCodepoint(REPLACEMENT_CHAR);
+        highSurrogate_ = 0;
+        appendCodepoint(hexValue_);
+      }
+      return true;
+    }
+
+    case State::NUMBER:
+      if (numberChar(c)) {
+        append(c);
+        return true;
+      }
+      if (!numberComplete()) return fail();
+      emit(Event::NUMBER);
+      valueDone();
+      return step(c);  // the terminator belongs to the next state
+
+    case State::LITERAL:
+      if (c != literal_[literalPos_]) return fail();
+      if (literal_[++literalPos_] == '\0') {
+        len_ = 0;
+        emit(literalEvent_);
+        valueDone();
+      }
+      return true;
+
+    case State::DONE:
+      return isSpace(c) ? true : fail();
+
+    case State::ERROR:
+    default:
+      return false;
+  }
+}
+
+// Advances num_ if c continues the number; false if c ends it (or is
+// invalid there, which step() reports once it sees numberComplete()).
+bool JsonReader::numberChar(char c) {
+  switch (num_) {
+    case Num::SIGN:
+      if (!isDigit(c)) return false;
+      num_ = (c == '0') ? Num::ZERO : Num::INT;
+      return true;
+    case Num::ZERO:
+    case Num::INT:
+      if (isDigit(c) && num_ == Num::INT) return true;
+      if (c == '.') num_ = Num::FRAC_FIRST;
+      else if (c == 'e' || c == 'E') num_ = Num::EXP_FIRST;
+      else return false;
+      return true;
+    case Num::FRAC_FIRST:
+    case Num::FRAC:
+      if (isDigit(c)) {
+        num_ = Num::FRAC;
+        return true;
+      }
+      if ((c == 'e' || c == 'E') && num_ == Num::FRAC) {
+        num_ = Num::EXP_FIRST;
+        return true;
+      }
+      return false;
+    case Num::EXP_FIRST:
+      if (c == '+' || c == '-') {
+        num_ = Num::EXP_SIGN;
+        return true;
+      }
+      // fall through
+    case Num::EXP_SIGN:
+    case Num::EXP:
+      if (!isDigit(c)) return false;
+      num_ = Num::EXP;
+      return true;
+  }
+  return false;
+}
+
+bool JsonReader::feed(const char* data, size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    if (!step(data[i])) return false;
+    offset_++;
+  }
+  return state_ != State::ERROR;
+}
+
+bool JsonReader::finish() {
+  if (state_ == State::NUMBER && depth_ == 0 && numberComplete()) {
+    emit(Event::NUMBER);
+    state_ = State::DONE;
+  }
+  if (state_ == State::DONE) return true;
+  return fail();
+}
+
+// ---- JsonWriter ----
+
+JsonWriter::JsonWriter(char* buf, size_t cap) : buf_(buf), cap_(cap) {
+  if (buf_ && cap_) buf_[0] = '\0';
+}
+
+void JsonWriter::put(char c) {
+  if (len_ + 1 < cap_) {
+    buf_[len_++] = c;
+    buf_[len_] = '\0';
+  } else {
+    overflow_ = true;
+  }
+}
+
+void JsonWriter::puts(const char* s) {
+  while (*s) put(*s++);
+}
+
+void JsonWriter::putEscaped(const char* s) {
+  put('"');
+  for (; *s; ++s) {
+    char c = *s;
+    switch (c) {
+      case '"': puts("\\\""); break;
+      case '\\': puts("\\\\"); break;
+      case '\n': puts("\\n"); break;
+      case '\r': puts("\\r"); break;
+      case '\t': puts("\\t"); break;
+      case '\b': puts("\\b"); break;
+      case '\f': puts("\\f"); break;
+      default:
+        if (static_cast<uint8_t>(c) < 0x20) {
+          char esc[7];
+          snprintf(esc, sizeof(esc), "\\u%04x", static_cast<unsigned>(c));
+          puts(esc);
+        } else {
+          put(c);
+        }
+    }
+  }
+  put('"');
+}
+
+void JsonWriter::separator() {
+  if (afterKey_) {
+    afterKey_ = false;
+    return;
+  }
+  if (depth_ == 0) return;
+  uint32_t bit = 1u << (depth_ - 1);
+  if (firstBits_ & bit) {
+    firstBits_ &= ~bit;
+  } else {
+    put(',');
+  }
+}
+
+void JsonWriter::open(char c) {
+  separator();
+  put(c);
+  if (depth_ < JsonReader::MAX_DEPTH) {
+    firstBits_ |= (1u << depth_);
+    depth_++;
+  } else {
+    overflow_ = true;
+  }
+}
+
+void JsonWriter::close(char c) {
+  if (depth_ > 0) depth_--;
+  afterKey_ = false;
+  put(c);
+}
+
+JsonWriter& JsonWriter::beginObject() { open('{'); return *this; }
+JsonWriter& JsonWriter::endObject() { close('}'); return *this; }
+JsonWriter& JsonWriter::beginArray() { open('['); return *this; }
+JsonWriter& JsonWriter::endArray() { close(']'); return *this; }
+
+JsonWriter& JsonWriter::key(const char* k) {
+  separator();
+  putEscaped(k);
+  put(':');
+  afterKey_ = true;
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(const char* s) {
+  separator();
+  if (s) putEscaped(s);
+  else puts("null");
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(int32_t v) {
+  separator();
+  char num[12];
+  snprintf(num, sizeof(num), "%ld", static_cast<long>(v));
+  puts(num);
+  return *this;
+}
+
+JsonWriter& JsonWriter::value(bool v) {
+  separator();
+  puts(v ? "true" : "false");
+  return *this;
+}
+
+JsonWriter::Mark JsonWriter::mark() const {
+  Mark m;
+  m.len = len_;
+  m.firstBits = firstBits_;
+  m.depth = depth_;
+  m.afterKey = afterKey_;
+  m.overflow = overflow_;
+  return m;
+}
+
+void JsonWriter::rewind(const Mark& m) {
+  len_ = m.len;
+  if (buf_ && cap_) buf_[len_] = '\0';
+  firstBits_ = m.firstBits;
+  depth_ = m.depth;
+  afterKey_ = m.afterKey;
+  overflow_ = m.overflow;
+}
+
+// ---- JsonStringPicker ----
+
+JsonStringPicker::JsonStringPicker(JsonStringField* fields, size_t count)
+    : fields_(fields), count_(count) {
+  for (size_t i = 0; i < count_; ++i) {
+    if (fields_[i].cap) fields_[i].dst[0] = '\0';
+    fields_[i].found = false;
+    fields_[i].tooLong = false;
+  }
+  reader_.begin(scratch_, sizeof(scratch_), onToken, this);
+}
+
+void JsonStringPicker::onToken(void* ctx, JsonReader::Event ev, uint8_t depth,
+                               const char* text, size_t len) {
+  JsonStringPicker* p = static_cast<JsonStringPicker*>(ctx);
+  if (depth != 1) return;
+  if (ev == JsonReader::Event::KEY) {
+    p->pending_ = nullptr;
+    for (size_t i = 0; i < p->count_; ++i) {
+      if (strcmp(p->fields_[i].key, text) == 0) p->pending_ = &p->fields_[i];
+    }
+    return;
+  }
+  JsonStringField* f = p->pending_;
+  p->pending_ = nullptr;
+  if (!f || ev != JsonReader::Event::STRING) return;
+  f->found = true;
+  if (len >= f->cap || p->reader_.truncated()) {
+    f->tooLong = true;
+    return;
+  }
+  memcpy(f->dst, text, len + 1);
+}
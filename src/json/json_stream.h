@@ -0,0 +1,183 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Fixed-buffer JSON reader/writer: no heap, no String.
+//
+// JsonReader is push based. feed() it the body in whatever slices arrive and
+// it calls the handler once per token. String, key and number text is built
+// in the caller's scratch buffer; longer values are truncated (truncated()
+// tells which). Nesting is limited to MAX_DEPTH.
+class JsonReader {
+ public:
+  static constexpr uint8_t MAX_DEPTH = 32;
+
+  enum class Event : uint8_t {
+    BEGIN_OBJECT,
+    END_OBJECT,
+    BEGIN_ARRAY,
+    END_ARRAY,
+    KEY,
+    STRING,
+    NUMBER,
+    TRUE_VALUE,
+    FALSE_VALUE,
+    NULL_VALUE
+  };
+
+  // depth is the number of enclosing containers (0 = top level; a BEGIN_*
+  // token reports the depth outside it). text is NUL terminated and only
+  // valid during the call.
+  using Handler = void (*)(void* ctx, Event ev, uint8_t depth, const char* text, size_t len);
+
+  void begin(char* scratch, size_t scratchLen, Handler handler, void* ctx);
+
+  // Returns false once the input is malformed; later calls are ignored.
+  bool feed(const char* data, size_t len);
+  // True when exactly one complete top-level value was read.
+  bool finish();
+
+  bool failed() const { return state_ == State::ERROR; }
+  bool truncated() const { return truncated_; }  // last KEY/STRING/NUMBER was cut short
+  size_t errorOffset() const { return errorOffset_; }
+
+ private:
+  enum class State : uint8_t {
+    VALUE,
+    OBJECT_KEY,
+    COLON,
+    AFTER_VALUE,
+    STRING,
+    STRING_ESCAPE,
+    STRING_UNICODE,
+    NUMBER,
+    LITERAL,
+    DONE,
+    ERROR
+  };
+
+  // Position in the number grammar: -? (0 | [1-9][0-9]*) (.[0-9]+)? ([eE][+-]?[0-9]+)?
+  enum class Num : uint8_t { SIGN, ZERO, INT, FRAC_FIRST, FRAC, EXP_FIRST, EXP_SIGN, EXP };
+
+  bool step(char c);
+  bool numberChar(char c);
+  bool numberComplete() const { return num_ == Num::ZERO || num_ == Num::INT || num_ == Num::FRAC || num_ == Num::EXP; }
+  bool fail();
+  void emit(Event ev);
+  void append(char c);
+  void appendCodepoint(uint32_t cp);
+  bool push(bool object);
+  bool pop(bool object);
+  void valueDone();
+  bool inObject() const { return depth_ > 0 && (objectBits_ >> (depth_ - 1)) & 1u; }
+
+  char* scratch_ = nullptr;
+  size_t scratchLen_ = 0;
+  size_t len_ = 0;
+  Handler handler_ = nullptr;
+  void* ctx_ = nullptr;
+
+  State state_ = State::VALUE;
+  uint32_t objectBits_ = 0;  // bit n set: container at depth n+1 is an object
+  uint8_t depth_ = 0;
+  bool afterOpen_ = false;   // just after '{' or '[' (a close is allowed)
+  bool isKey_ = false;
+  bool truncated_ = false;
+  Num num_ = Num::SIGN;
+  uint8_t hexCount_ = 0;
+  uint32_t hexValue_ = 0;
+  uint32_t highSurrogate_ = 0;
+  const char* literal_ = nullptr;
+  uint8_t literalPos_ = 0;
+  Event literalEvent_ = Event::NULL_VALUE;
+  size_t offset_ = 0;
+  size_t errorOffset_ = 0;
+};
+
+// Appends JSON into a caller-owned buffer, always NUL terminated. If the
+// buffer fills up, ok() turns false; mark()/rewind() drop a partly written
+// element so the output stays valid.
+class JsonWriter {
+ public:
+  struct Mark {
+    size_t len;
+    uint32_t firstBits;
+    uint8_t depth;
+    bool afterKey;
+    bool overflow;
+  };
+
+  JsonWriter(char* buf, size_t cap);
+
+  JsonWriter& beginObject();
+  JsonWriter& endObject();
+  JsonWriter& beginArray();
+  JsonWriter& endArray();
+  JsonWriter& key(const char* k);
+  JsonWriter& value(const char* s);
+  JsonWriter& value(int32_t v);
+  JsonWriter& value(bool v);
+
+  JsonWriter& field(const char* k, const char* v) { return key(k).value(v); }
+  JsonWriter& field(const char* k, int32_t v) { return key(k).value(v); }
+  JsonWriter& field(const char* k, bool v) { return key(k).value(v); }
+
+  Mark mark() const;
+  void rewind(const Mark& m);
+
+  bool ok() const { return !overflow_; }
+  const char* c_str() const { return buf_; }
+  size_t length() const { return len_; }
+
+ private:
+  void separator();
+  void put(char c);
+  void puts(const char* s);
+  void putEscaped(const char* s);
+  void open(char c);
+  void close(char c);
+
+  char* buf_;
+  size_t cap_;
+  size_t len_ = 0;
+  uint32_t firstBits_ = 0;  // bit n set: container at depth n+1 has no element yet
+  uint8_t depth_ = 0;
+  bool afterKey_ = false;
+  bool overflow_ = false;
+};
+
+// Copies named top-level string members of an object into fixed buffers:
+//   JsonStringField fields[] = {{"version", ver, sizeof(ver)}, {"url", url, sizeof(url)}};
+//   JsonStringPicker picker(fields, 2);
+//   picker.feed(body, len) && picker.finish();
+// Missing members leave an empty string; values that do not fit set tooLong.
+// Values are built in SCRATCH_SIZE bytes, so a field's cap may not exceed
+// it: callers static_assert JsonStringPicker::fits(sizeof(buffer)).
+struct JsonStringField {
+  const char* key;
+  char* dst;
+  size_t cap;
+  bool found;
+  bool tooLong;
+};
+
+class JsonStringPicker {
+ public:
+  static constexpr size_t SCRATCH_SIZE = 320;  // longest value that can be picked, + NUL
+  static constexpr bool fits(size_t cap) { return cap <= SCRATCH_SIZE; }
+
+  JsonStringPicker(JsonStringField* fields, size_t count);
+
+  bool feed(const char* data, size_t len) { return reader_.feed(data, len); }
+  bool finish() { return reader_.finish(); }
+  size_t errorOffset() const { return reader_.errorOffset(); }
+
+ private:
+  static void onToken(void* ctx, JsonReader::Event ev, uint8_t depth, const char* text, size_t len);
+
+  JsonReader reader_;
+  JsonStringField* fields_;
+  size_t count_;
+  JsonStringField* pending_ = nullptr;
+  char scratch_[SCRATCH_SIZE];
+};
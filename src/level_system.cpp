@@ -1,5 +1,8 @@
 #include "level_system.h"
 #include "logger.h"
+#include "persist_store.h"
+#include "event_bus.h"
+#include "stat_log/stat_log.h"
 #include <Preferences.h>
 
 DEFINE_MODULE_LOGGER(LevelLog)
@@ -7,10 +10,16 @@ DEFINE_MODULE_LOGGER(LevelLog)
 namespace LevelSystem {
 
   // --- Private State ---
-  Preferences preferences;
-  const char* NVS_NAMESPACE = "bubu-level";
-  const char* NVS_KEY_LEVEL = "level";
-  const char* NVS_KEY_XP = "xp";
+  struct SavedState {
+    int32_t level;
+    int32_t xp;
+  };
+  const uint8_t STATE_VERSION = 1;
+
+  // Pre-PersistStore location, read once to migrate
+  const char* LEGACY_NAMESPACE = "bubu-level";
+  const char* LEGACY_KEY_LEVEL = "level";
+  const char* LEGACY_KEY_XP = "xp";
 
   int currentLevel = 1;
   int currentXP = 0;
@@ -29,14 +38,15 @@ namespace LevelSystem {
 
   void begin() {
     loadState();
-    LevelLog::printf("Level System initialized. Level: %d, XP: %d / %d\n", currentLevel, currentXP, getXPForNextLevel());
+    EventBus::subscribe<EventBus::XpEarned>([](const EventBus::XpEarned& e, void*) { addXP(e.amount); });
+    LOG_INFO(LevelLog, "Level System initialized. Level: %d, XP: %d / %d\n", currentLevel, currentXP, getXPForNextLevel());
   }
 
   void addXP(int amount) {
     if (amount <= 0) return;
 
     currentXP += amount;
-    LevelLog::printf("Gained %d XP. Total XP: %d / %d\n", amount, currentXP, getXPForNextLevel());
+    LOG_INFO(LevelLog, "Gained %d XP. Total XP: %d / %d\n", amount, currentXP, getXPForNextLevel());
     checkLevelUp();
   }
 
@@ -83,7 +93,8 @@ namespace LevelSystem {
         currentLevel++;
         currentXP -= requiredXP;
         requiredXP = getXPForNextLevel();
-        LevelLog::printf("LEVEL UP! Reached Level %d\n", currentLevel);
+        LOG_INFO(LevelLog, "LEVEL UP! Reached Level %d\n", currentLevel);
+        StatLog::recordEvent(StatLog::EventCode::LEVEL_UP, currentLevel);
       }
       saveState();
     } else {
@@ -93,19 +104,27 @@ namespace LevelSystem {
   }
 
   void saveState() {
-    preferences.begin(NVS_NAMESPACE, false);
-    preferences.putInt(NVS_KEY_LEVEL, currentLevel);
-    preferences.putInt(NVS_KEY_XP, currentXP);
-    preferences.end();
+    SavedState saved = {currentLevel, currentXP};
+    PersistStore::write(PersistStore::Slot::LEVEL, STATE_VERSION, &saved, sizeof(saved));
   }
 
   void loadState() {
-    preferences.begin(NVS_NAMESPACE, true); // Read-only to start
-    // Load level, default to 1 if not found
-    currentLevel = preferences.getInt(NVS_KEY_LEVEL, 1);
-    // Load XP, default to 0 if not found
-    currentXP = preferences.getInt(NVS_KEY_XP, 0);
-    preferences.end();
+    SavedState saved;
+    if (PersistStore::read(PersistStore::Slot::LEVEL, STATE_VERSION, &saved, sizeof(saved))) {
+      currentLevel = saved.level;
+      currentXP = saved.xp;
+      return;
+    }
+    // Defaults: level 1, 0 XP, unless an older firmware left them in NVS
+    currentLevel = 1;
+    currentXP = 0;
+    Preferences preferences;
+    if (preferences.begin(LEGACY_NAMESPACE, true)) {
+      currentLevel = preferences.getInt(LEGACY_KEY_LEVEL, 1);
+      currentXP = preferences.getInt(LEGACY_KEY_XP, 0);
+      preferences.end();
+      saveState();
+    }
   }
 
 } // namespace LevelSystem
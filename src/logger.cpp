@@ -1,25 +1,554 @@
 #include "logger.h"
 
+#include <atomic>
 #include <stdio.h>
+#include <string.h>
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// The build's level spec is checked once, here.
+static_assert(LogConfig::wellFormed(BUBU_LOG_LEVELS),
+              "BUBU_LOG_LEVELS: expected \"*=LEVEL,Module=LEVEL\" with NONE/ERROR/WARN/INFO/DEBUG/TRACE or 0-5");
+
+// Spec parser cases. Default level: "*", else INFO.
+static_assert(LogConfig::levelIn("*=WARN", "TouchLog") == LogLevel::WARN, "");
+static_assert(LogConfig::levelIn("*=2", "TouchLog") == LogLevel::WARN, "");
+static_assert(LogConfig::levelIn("TouchLog=DEBUG", "MenuLog") == LogLevel::INFO, "");
+// Per-module overrides, either side of "*", with spaces after commas.
+static_assert(LogConfig::levelIn("*=WARN,TouchLog=DEBUG", "TouchLog") == LogLevel::DEBUG, "");
+static_assert(LogConfig::levelIn("TouchLog=TRACE, *=ERROR", "TouchLog") == LogLevel::TRACE, "");
+static_assert(LogConfig::levelIn("TouchLog=TRACE, *=ERROR", "MenuLog") == LogLevel::ERROR, "");
+static_assert(LogConfig::levelIn("*=INFO, SoundLog=NONE", "SoundLog") == LogLevel::NONE, "");
+// Unknown modules and prefixes of a key do not match.
+static_assert(LogConfig::levelIn("*=WARN,TouchLog=DEBUG", "Touch") == LogLevel::WARN, "");
+static_assert(LogConfig::levelIn("*=WARN,Touch=DEBUG", "TouchLog") == LogLevel::WARN, "");
+static_assert(LogConfig::levelIn("*=WARN,FooLog=TRACE", "MenuLog") == LogLevel::WARN, "");
+// Malformed specs are rejected; a bad value alone falls back to the default.
+static_assert(LogConfig::wellFormed("*=INFO"), "");
+static_assert(LogConfig::wellFormed("*=INFO, TouchLog=5,SoundLog=NONE"), "");
+static_assert(!LogConfig::wellFormed(""), "");
+static_assert(!LogConfig::wellFormed("TouchLog"), "");
+static_assert(!LogConfig::wellFormed("TouchLog="), "");
+static_assert(!LogConfig::wellFormed("=DEBUG"), "");
+static_assert(!LogConfig::wellFormed("TouchLog=LOUD"), "");
+static_assert(!LogConfig::wellFormed("TouchLog=DEBUGX"), "");
+static_assert(!LogConfig::wellFormed("TouchLog=6"), "");
+static_assert(!LogConfig::wellFormed("TouchLog =DEBUG"), "");
+static_assert(!LogConfig::wellFormed("*=INFO,,TouchLog=DEBUG"), "");
+static_assert(!LogConfig::wellFormed("*=INFO,"), "");
+static_assert(LogConfig::levelIn("*=WARN,TouchLog=LOUD", "TouchLog") == LogLevel::WARN, "");
+
+// Deferred logging.
+// Producers never format and never touch Serial: printf() copies the format
+// pointer plus its arguments (strings by value, capped) into a record in a
+// PSRAM ring, and a low-priority task renders records to Serial later. The
+// ring is multi-producer: a slot is claimed with one CAS on `head` and
+// published by writing its header word last. A full ring drops the record
+// and counts it, so the producer cost is bounded by the format length.
+// Format strings must outlive the record (string literals).
+// With BUBU_LOG_TOKENIZED, LOG_x() records are already-encoded binary payloads
+// (include/logger.h) and the drain task only COBS-frames them.
+namespace {
+
+constexpr uint32_t RING_SIZE = 32 * 1024;  // power of two, <= 64 KB (16-bit lengths)
+constexpr uint32_t RING_MASK = RING_SIZE - 1;
+constexpr size_t RECORD_MAX = 256;         // encoded on the stack, then copied in
+constexpr size_t STRING_MAX = 64;          // per %s argument; longer ones end in CUT_MARK
+constexpr uint16_t STRING_CUT = 0x8000;    // flag in a deferred string's u16 length
+constexpr char CUT_MARK[] = "\xE2\x80\xA6";  // U+2026, as tools/log_decode.py renders it
+constexpr uint32_t DRAIN_IDLE_MS = 10;
+constexpr uint32_t FLUSH_WAIT_MS = 500;
+constexpr uint32_t DRAIN_STACK = 4096;
+constexpr UBaseType_t DRAIN_PRIORITY = 1;
+constexpr BaseType_t DRAIN_CORE = 0;       // UI loop runs on core 1
+static_assert((RING_SIZE & RING_MASK) == 0, "ring size must be a power of two");
+#ifdef BUBU_LOG_TOKENIZED
+constexpr bool TOKENIZED = true;
+#else
+constexpr bool TOKENIZED = false;
+#endif
+
+// Record: [header][body], 4-byte aligned. The header is written last; 0 means
+// "claimed but not published yet".
+enum Kind : uint8_t {
+  KIND_FORMAT = 1,  // body: fmt pointer, encoded args
+  KIND_TEXT = 2,    // body: u16 length + bytes
+  KIND_LINE = 3,    // KIND_TEXT plus a newline
+  KIND_PAD = 4,     // skip to the start of the ring
+  KIND_TOKEN = 5    // body: u16 length + tokenized frame payload
+};
+
+inline uint32_t makeHeader(Kind kind, uint32_t len) {
+  return static_cast<uint32_t>(kind) << 16 | len;
+}
+
+uint8_t* ring = nullptr;
+// Monotonic byte counters (offset = counter & RING_MASK). They live in
+// internal RAM: atomic read-modify-write does not work on PSRAM.
+std::atomic<uint32_t> head(0);
+std::atomic<uint32_t> tail(0);
+std::atomic<uint32_t> written(0);
+std::atomic<uint32_t> dropped(0);
+uint32_t highWater = 0;  // drain task only
+uint32_t droppedReported = 0;
+bool serialStarted = false;
+
+inline uint32_t align4(uint32_t n) {
+  return (n + 3u) & ~3u;
+}
+
+// ---- producer ----
+
+// Claims len bytes (multiple of 4), padding to the end of the ring if the
+// record would straddle it.
+uint8_t* reserve(uint32_t len) {
+  uint32_t h = head.load(std::memory_order_relaxed);
+  for (;;) {
+    uint32_t off = h & RING_MASK;
+    uint32_t toEnd = RING_SIZE - off;
+    uint32_t need = len <= toEnd ? len : toEnd + len;
+    if (need > RING_SIZE - (h - tail.load(std::memory_order_acquire))) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    if (head.compare_exchange_weak(h, h + need, std::memory_order_acq_rel,
+                                   std::memory_order_relaxed)) {
+      if (need == len) return ring + off;
+      __atomic_store_n(reinterpret_cast<uint32_t*>(ring + off), makeHeader(KIND_PAD, toEnd),
+                       __ATOMIC_RELEASE);
+      return ring;
+    }
+  }
+}
+
+void publish(uint8_t* rec, Kind kind, const uint8_t* body, uint32_t bodyLen) {
+  uint32_t len = align4(4 + bodyLen);
+  memcpy(rec + 4, body, bodyLen);
+  __atomic_store_n(reinterpret_cast<uint32_t*>(rec), makeHeader(kind, len), __ATOMIC_RELEASE);
+  written.fetch_add(1, std::memory_order_relaxed);
+}
+
+struct Encoder {
+  uint8_t buf[RECORD_MAX - 4];
+  size_t len = 0;
+  bool full = false;
+
+  void raw(const void* p, size_t n) {
+    if (full || len + n > sizeof(buf)) {
+      full = true;
+      return;
+    }
+    memcpy(buf + len, p, n);
+    len += n;
+  }
+  void u64(uint64_t v) { raw(&v, sizeof(v)); }
+  void f64(double v) { raw(&v, sizeof(v)); }
+  void str(const char* s) {
+    if (!s) s = "(null)";
+    size_t n = strnlen(s, STRING_MAX + 1);
+    size_t room = sizeof(buf) - len;
+    if (room < 2) {
+      full = true;
+      return;
+    }
+    bool cut = n > STRING_MAX || n > room - 2;
+    if (n > STRING_MAX) n = STRING_MAX;
+    if (n > room - 2) n = room - 2;
+    uint16_t n16 = static_cast<uint16_t>(n | (cut ? STRING_CUT : 0));
+    raw(&n16, 2);
+    raw(s, n);
+    len = align4(len) < sizeof(buf) ? align4(len) : sizeof(buf);
+  }
+};
+
+// Walks the conversions in fmt and pulls each argument with its real type.
+// Integers are stored widened to 64 bits, floating point as double.
+void encodeArgs(Encoder& e, const char* fmt, va_list args) {
+  for (const char* p = fmt; *p && !e.full; ++p) {
+    if (*p != '%') continue;
+    ++p;
+    if (*p == '%') continue;
+    while (*p && strchr("-+ #0", *p)) ++p;
+    if (*p == '*') {
+      e.u64(static_cast<uint64_t>(va_arg(args, int)));
+      ++p;
+    }
+    while (*p >= '0' && *p <= '9') ++p;
+    if (*p == '.') {
+      ++p;
+      if (*p == '*') {
+        e.u64(static_cast<uint64_t>(va_arg(args, int)));
+        ++p;
+      }
+      while (*p >= '0' && *p <= '9') ++p;
+    }
+    int longs = 0;
+    bool wide = false;  // z, j, t
+    while (*p && strchr("hlLzjt", *p)) {
+      if (*p == 'l') ++longs;
+      if (*p == 'z' || *p == 'j' || *p == 't') wide = true;
+      ++p;
+    }
+    switch (*p) {
+      case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+        if (longs >= 2) {
+          e.u64(static_cast<uint64_t>(va_arg(args, long long)));
+        } else if (longs == 1) {
+          e.u64(static_cast<uint64_t>(va_arg(args, long)));
+        } else if (wide) {
+          e.u64(static_cast<uint64_t>(va_arg(args, intmax_t)));
+        } else {
+          e.u64(static_cast<uint64_t>(va_arg(args, int)));
+        }
+        break;
+      case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        e.f64(va_arg(args, double));
+        break;
+      case 's':
+        e.str(va_arg(args, const char*));
+        break;
+      case 'p':
+      case 'n':  // %n is not supported; its pointer is skipped
+        e.u64(reinterpret_cast<uintptr_t>(va_arg(args, void*)));
+        break;
+      default:
+        return;  // unknown conversion: stop, the renderer stops at the same place
+    }
+    if (!*p) return;
+  }
+}
+
+void pushBytes(const void* data, size_t n, Kind kind) {
+  Encoder e;
+  if (n > sizeof(e.buf) - 2) n = sizeof(e.buf) - 2;
+  uint16_t n16 = static_cast<uint16_t>(n);
+  e.raw(&n16, 2);
+  e.raw(data, n);
+  uint8_t* rec = reserve(align4(4 + e.len));
+  if (rec) publish(rec, kind, e.buf, e.len);
+}
+
+void pushText(const char* msg, Kind kind) {
+  pushBytes(msg, strnlen(msg, RECORD_MAX), kind);
+}
+
+// ---- consumer ----
+
+struct Out {
+  char buf[256];
+  size_t n = 0;
+
+  void flush() {
+    if (n) Serial.write(reinterpret_cast<const uint8_t*>(buf), n);
+    n = 0;
+  }
+  void put(const char* s, size_t len) {
+    while (len) {
+      size_t take = sizeof(buf) - n < len ? sizeof(buf) - n : len;
+      memcpy(buf + n, s, take);
+      n += take;
+      s += take;
+      len -= take;
+      if (n == sizeof(buf)) flush();
+    }
+  }
+  // Ends one text record or frame; in tokenized mode 0x00 delimits both.
+  void endRecord() {
+    if (TOKENIZED) put("", 1);
+  }
+  // COBS: the payload is re-coded without zero bytes, so 0x00 can end it.
+  void cobs(const uint8_t* p, size_t n) {
+    size_t i = 0;
+    for (;;) {
+      size_t run = 0;
+      while (i + run < n && p[i + run] != 0 && run < 254) ++run;
+      char code = static_cast<char>(static_cast<uint8_t>(run + 1));
+      put(&code, 1);
+      put(reinterpret_cast<const char*>(p + i), run);
+      i += run;
+      if (i >= n) break;
+      if (run < 254) ++i;  // the zero is implied by a short block
+    }
+    put("", 1);
+  }
+  template <typename T>
+  void fmt(const char* spec, T v) {
+    char tmp[96];
+    int w = snprintf(tmp, sizeof(tmp), spec, v);
+    if (w > 0) put(tmp, static_cast<size_t>(w) < sizeof(tmp) ? w : sizeof(tmp) - 1);
+  }
+};
+
+struct Decoder {
+  const uint8_t* p;
+  const uint8_t* end;
+
+  bool u64(uint64_t& v) {
+    if (end - p < 8) return false;
+    memcpy(&v, p, 8);
+    p += 8;
+    return true;
+  }
+  bool f64(double& v) {
+    if (end - p < 8) return false;
+    memcpy(&v, p, 8);
+    p += 8;
+    return true;
+  }
+  bool str(const char*& s, size_t& n, bool& cut) {
+    if (end - p < 2) return false;
+    uint16_t n16;
+    memcpy(&n16, p, 2);
+    cut = n16 & STRING_CUT;
+    n16 &= ~STRING_CUT;
+    if (static_cast<size_t>(end - p) < 2u + n16) return false;
+    s = reinterpret_cast<const char*>(p + 2);
+    n = n16;
+    p += align4(2 + n16);
+    if (p > end) p = end;
+    return true;
+  }
+};
+
+// Mirrors encodeArgs(): each conversion is re-emitted with its own spec, with
+// '*' widths substituted as numbers.
+void render(Out& out, const char* fmt, Decoder d) {
+  const char* p = fmt;
+  while (*p) {
+    const char* pct = strchr(p, '%');
+    if (!pct) {
+      out.put(p, strlen(p));
+      return;
+    }
+    out.put(p, pct - p);
+    p = pct + 1;
+    if (*p == '%') {
+      out.put("%", 1);
+      ++p;
+      continue;
+    }
+
+    char spec[24];
+    size_t sn = 0;
+    spec[sn++] = '%';
+    bool ok = true;
+    auto add = [&](char c) {
+      if (sn < sizeof(spec) - 1) spec[sn++] = c; else ok = false;
+    };
+    auto star = [&]() {
+      uint64_t v;
+      if (!d.u64(v)) { ok = false; return; }
+      char num[12];
+      int w = snprintf(num, sizeof(num), "%d", static_cast<int>(v));
+      for (int i = 0; i < w; ++i) add(num[i]);
+    };
+    while (*p && strchr("-+ #0", *p)) add(*p++);
+    if (*p == '*') { star(); ++p; }
+    while (*p >= '0' && *p <= '9') add(*p++);
+    if (*p == '.') {
+      add(*p++);
+      if (*p == '*') { star(); ++p; }
+      while (*p >= '0' && *p <= '9') add(*p++);
+    }
+    int longs = 0;
+    bool wide = false;
+    while (*p && strchr("hlLzjt", *p)) {
+      if (*p == 'l') ++longs;
+      if (*p == 'z' || *p == 'j' || *p == 't') wide = true;
+      add(*p++);
+    }
+    char conv = *p;
+    if (!conv) return;
+    ++p;
+    add(conv);
+    spec[sn] = '\0';
+    if (!ok) return;
+
+    uint64_t u;
+    double f;
+    const char* s;
+    size_t n;
+    bool cut;
+    switch (conv) {
+      case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+        if (!d.u64(u)) return;
+        if (longs >= 2) out.fmt(spec, static_cast<long long>(u));
+        else if (longs == 1) out.fmt(spec, static_cast<long>(u));
+        else if (wide) out.fmt(spec, static_cast<intmax_t>(u));
+        else out.fmt(spec, static_cast<int>(u));
+        break;
+      case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        if (!d.f64(f)) return;
+        out.fmt(spec, f);
+        break;
+      case 's': {
+        if (!d.str(s, n, cut)) return;
+        char tmp[STRING_MAX + sizeof(CUT_MARK)];
+        memcpy(tmp, s, n);
+        tmp[n] = '\0';
+        if (cut) strcat(tmp, CUT_MARK);
+        out.fmt(spec, static_cast<const char*>(tmp));
+        break;
+      }
+      case 'p':
+        if (!d.u64(u)) return;
+        out.fmt(spec, reinterpret_cast<void*>(static_cast<uintptr_t>(u)));
+        break;
+      case 'n':
+        if (!d.u64(u)) return;
+        break;
+      default:
+        return;
+    }
+  }
+}
+
+// Renders every published record; returns false if the ring was empty.
+bool drainOnce() {
+  bool any = false;
+  Out out;
+  for (;;) {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    uint32_t h = head.load(std::memory_order_acquire);
+    if (t == h) break;
+    if (h - t > highWater) highWater = h - t;
+    uint8_t* rec = ring + (t & RING_MASK);
+    uint32_t hdr = __atomic_load_n(reinterpret_cast<uint32_t*>(rec), __ATOMIC_ACQUIRE);
+    if (hdr == 0) break;  // claimed, not published yet
+    uint32_t len = hdr & 0xFFFF;
+    Kind kind = static_cast<Kind>(hdr >> 16);
+    const uint8_t* body = rec + 4;
+    if (kind == KIND_FORMAT) {
+      const char* fmt;
+      memcpy(&fmt, body, sizeof(fmt));
+      render(out, fmt, Decoder{body + sizeof(fmt), rec + len});
+      out.endRecord();
+    } else if (kind == KIND_TEXT || kind == KIND_LINE) {
+      uint16_t n;
+      memcpy(&n, body, 2);
+      out.put(reinterpret_cast<const char*>(body + 2), n);
+      if (kind == KIND_LINE) out.put("\r\n", 2);
+      out.endRecord();
+    } else if (kind == KIND_TOKEN) {
+      uint16_t n;
+      memcpy(&n, body, 2);
+      out.cobs(body + 2, n);
+    }
+    // Zero the slot so a later claim of these bytes reads as unpublished.
+    memset(rec, 0, len);
+    tail.store(t + len, std::memory_order_release);
+    any = true;
+  }
+  uint32_t drops = dropped.load(std::memory_order_relaxed);
+  if (drops != droppedReported) {
+    char msg[48];
+    int w = snprintf(msg, sizeof(msg), "[log] dropped %lu messages\r\n",
+                     static_cast<unsigned long>(drops - droppedReported));
+    out.put(msg, w);
+    out.endRecord();
+    droppedReported = drops;
+  }
+  out.flush();
+  return any;
+}
+
+void drainTask(void*) {
+  for (;;) {
+    if (!drainOnce()) vTaskDelay(pdMS_TO_TICKS(DRAIN_IDLE_MS));
+  }
+}
+
+#ifdef BUBU_LOG_BENCH
+// -DBUBU_LOG_BENCH: time a touch-event sized log line, direct vs deferred.
+void benchmark() {
+  constexpr int N = 64;
+  char buffer[512];
+  uint32_t t0 = ESP.getCycleCount();
+  for (int i = 0; i < N; ++i) {
+    snprintf(buffer, sizeof(buffer), "Touch: move x=%d y=%d dx=%d dy=%d t=%lu\n", i, 2 * i, 3, -4,
+             static_cast<unsigned long>(millis()));
+    Serial.print(buffer);
+  }
+  uint32_t direct = (ESP.getCycleCount() - t0) / N;
+  t0 = ESP.getCycleCount();
+  for (int i = 0; i < N; ++i) {
+    Logger::printf("Touch: move x=%d y=%d dx=%d dy=%d t=%lu\n", i, 2 * i, 3, -4,
+                   static_cast<unsigned long>(millis()));
+  }
+  uint32_t deferred = (ESP.getCycleCount() - t0) / N;
+  t0 = ESP.getCycleCount();
+  for (int i = 0; i < N; ++i) {
+    LOG_EMIT("Touch: move x=%d y=%d dx=%d dy=%d t=%lu\n", i, 2 * i, 3, -4,
+             static_cast<unsigned long>(millis()));
+  }
+  uint32_t emitted = (ESP.getCycleCount() - t0) / N;
+  Logger::printf("[log] bench: direct %lu, deferred %lu, LOG_EMIT (%s) %lu cycles/call\n",
+                 static_cast<unsigned long>(direct), static_cast<unsigned long>(deferred),
+                 TOKENIZED ? "tokenized" : "text", static_cast<unsigned long>(emitted));
+}
+#endif
+
+}  // namespace
 
 namespace Logger {
 
 void begin(uint32_t baud) {
-  Serial.begin(baud);
+  if (!serialStarted) {
+    Serial.begin(baud);
+    serialStarted = true;
+    // Ends whatever the boot ROM printed, so the decoder sees it as text.
+    if (TOKENIZED) Serial.write(static_cast<uint8_t>(0));
+  }
+  if (ring) return;
+  uint8_t* buf = static_cast<uint8_t*>(heap_caps_calloc(1, RING_SIZE, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+  if (!buf) return;  // stay synchronous
+  ring = buf;
+  if (xTaskCreatePinnedToCore(drainTask, "log_drain", DRAIN_STACK, nullptr, DRAIN_PRIORITY,
+                              nullptr, DRAIN_CORE) != pdPASS) {
+    ring = nullptr;
+    heap_caps_free(buf);
+    return;
+  }
+#ifdef BUBU_LOG_BENCH
+  benchmark();
+#endif
 }
 
 void print(const char* msg) {
-  Serial.print(msg);
+  if (!ring) {
+    Serial.print(msg);
+    if (TOKENIZED) Serial.write(static_cast<uint8_t>(0));
+    return;
+  }
+  pushText(msg, KIND_TEXT);
 }
 
 void println(const char* msg) {
-  Serial.println(msg);
+  if (!ring) {
+    Serial.println(msg);
+    if (TOKENIZED) Serial.write(static_cast<uint8_t>(0));
+    return;
+  }
+  pushText(msg, KIND_LINE);
 }
 
 void vprintf(const char* fmt, va_list args) {
-  char buffer[512];
-  vsnprintf(buffer, sizeof(buffer), fmt, args);
-  Serial.print(buffer);
+  if (!ring) {
+    char buffer[512];
+    vsnprintf(buffer, sizeof(buffer), fmt, args);
+    Serial.print(buffer);
+    if (TOKENIZED) Serial.write(static_cast<uint8_t>(0));
+    return;
+  }
+  Encoder e;
+  e.raw(&fmt, sizeof(fmt));
+  va_list copy;
+  va_copy(copy, args);
+  encodeArgs(e, fmt, copy);
+  va_end(copy);
+  uint8_t* rec = reserve(align4(4 + e.len));
+  if (rec) publish(rec, KIND_FORMAT, e.buf, e.len);
 }
 
 void printf(const char* fmt, ...) {
@@ -29,4 +558,86 @@ void printf(const char* fmt, ...) {
   va_end(args);
 }
 
+void writeToken(const uint8_t* payload, size_t len) {
+  if (!ring) {
+    Out out;
+    out.cobs(payload, len);
+    out.flush();
+    return;
+  }
+  pushBytes(payload, len, KIND_TOKEN);
+}
+
+void flush() {
+  if (!ring) return;
+  // The drain task is the only consumer; wait (bounded) for it to catch up.
+  for (uint32_t waited = 0; waited < FLUSH_WAIT_MS; ++waited) {
+    if (tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire)) break;
+    vTaskDelay(pdMS_TO_TICKS(1));
+  }
+}
+
+Stats stats() {
+  Stats s;
+  s.written = written.load(std::memory_order_relaxed);
+  s.dropped = dropped.load(std::memory_order_relaxed);
+  s.highWater = highWater;
+  s.deferred = ring != nullptr;
+  return s;
+}
+
 }  // namespace Logger
+
+namespace LogToken {
+
+Writer::Writer(uint32_t token) : len(sizeof(token)), full(false) {
+  memcpy(buf, &token, sizeof(token));  // little-endian on the ESP32
+}
+
+void Writer::integer(int64_t v) {
+  if (full || len + 10 > sizeof(buf)) {
+    full = true;
+    return;
+  }
+  uint64_t z = (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+  while (z >= 0x80) {
+    buf[len++] = static_cast<uint8_t>(z) | 0x80;
+    z >>= 7;
+  }
+  buf[len++] = static_cast<uint8_t>(z);
+}
+
+void Writer::real(float v) {
+  if (full || len + sizeof(v) > sizeof(buf)) {
+    full = true;
+    return;
+  }
+  memcpy(buf + len, &v, sizeof(v));
+  len += sizeof(v);
+}
+
+void Writer::str(const char* s) {
+  if (!s) s = "(null)";
+  size_t n = strnlen(s, STRING_MAX + 1);
+  if (full || len + 2 >= sizeof(buf)) {
+    full = true;
+    return;
+  }
+  bool cut = n > STRING_MAX;
+  if (cut) n = STRING_MAX;
+  if (n > sizeof(buf) - len - 2) {
+    n = sizeof(buf) - len - 2;
+    cut = true;
+    full = true;
+  }
+  uint32_t v = static_cast<uint32_t>(n << 1 | (cut ? 1 : 0));  // <= 129: one or two bytes
+  if (v >= 0x80) {
+    buf[len++] = static_cast<uint8_t>(v) | 0x80;
+    v >>= 7;
+  }
+  buf[len++] = static_cast<uint8_t>(v);
+  memcpy(buf + len, s, n);
+  len += n;
+}
+
+}  // namespace LogToken
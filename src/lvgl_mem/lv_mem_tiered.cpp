@@ -0,0 +1,99 @@
+// LVGL's memory hooks for LV_STDLIB_CUSTOM, served by TieredAlloc.
+#include <lvgl.h>
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+
+#include "tiered_alloc.h"
+#include "logger.h"
+DEFINE_MODULE_LOGGER(LvMemLog)
+
+// -DBUBU_LV_ALLOC_TRACE prints every call as an "lvt" line for
+// tools/lv_alloc_replay. It blocks on Serial: capture only, never ship it.
+#ifdef BUBU_LV_ALLOC_TRACE
+#define LV_TRACE(...) Serial.printf(__VA_ARGS__)
+#else
+#define LV_TRACE(...) ((void)0)
+#endif
+
+void lv_mem_init(void) {}
+
+void lv_mem_deinit(void) {}  // pages stay reserved for the next lv_init()
+
+lv_mem_pool_t lv_mem_add_pool(void* mem, size_t bytes) {
+  LV_UNUSED(mem);
+  LV_UNUSED(bytes);
+  return nullptr;  // no extra pools: the tiers grow on their own
+}
+
+void lv_mem_remove_pool(lv_mem_pool_t pool) {
+  LV_UNUSED(pool);
+}
+
+void* lv_malloc_core(size_t size) {
+  void* p = TieredAlloc::alloc(size);
+  LV_TRACE("lvt a %p %u\n", p, static_cast<unsigned>(size));
+  return p;
+}
+
+void* lv_realloc_core(void* p, size_t new_size) {
+  void* q = TieredAlloc::resize(p, new_size);
+  LV_TRACE("lvt r %p %p %u\n", p, q, static_cast<unsigned>(new_size));
+  return q;
+}
+
+void lv_free_core(void* p) {
+  LV_TRACE("lvt f %p\n", p);
+  TieredAlloc::release(p);
+}
+
+// "free" here is what the slabs hold idle; PSRAM is not counted, so LVGL's
+// used_pct reads as slab occupancy rather than a pool about to run out.
+void lv_mem_monitor_core(lv_mem_monitor_t* mon) {
+  size_t idle = TieredAlloc::slabFreeBytes();
+  size_t total = TieredAlloc::slabBytes() + TieredAlloc::largeStats().liveBytes;
+  size_t biggest = 0;
+  uint32_t freeCnt = 0;
+  for (uint8_t i = 0; i < TieredAlloc::CLASS_COUNT; ++i) {
+    TieredAlloc::ClassStats c = TieredAlloc::classStats(i);
+    freeCnt += c.idle;
+    if (c.idle) biggest = c.size;
+  }
+  mon->total_size = total;
+  mon->free_cnt = freeCnt;
+  mon->free_size = idle;
+  mon->free_biggest_size = biggest;
+  mon->used_cnt = TieredAlloc::liveCount();
+  mon->max_used = TieredAlloc::peakLiveBytes();
+  mon->used_pct = total ? static_cast<uint8_t>(100 - idle * 100 / total) : 0;
+  mon->frag_pct = 0;
+}
+
+lv_result_t lv_mem_test_core(void) {
+  return TieredAlloc::check() ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+namespace TieredAlloc {
+
+void logReport() {
+  LOG_INFO(LvMemLog, "[LvMem] class   live   peak  pages   allocs  spills\n");
+  for (uint8_t i = 0; i < CLASS_COUNT; ++i) {
+    ClassStats c = classStats(i);
+    if (!c.allocs) continue;
+    LOG_INFO(LvMemLog, "[LvMem] %5u %6lu %6lu %6u %8lu %7lu\n", c.size,
+                       static_cast<unsigned long>(c.live), static_cast<unsigned long>(c.peak), c.pages,
+                       static_cast<unsigned long>(c.allocs), static_cast<unsigned long>(c.spills));
+  }
+  LargeStats l = largeStats();
+  LOG_INFO(LvMemLog, "[LvMem] psram  live %lu (%lu B)  peak %lu B  allocs %lu  internal fallbacks %lu\n",
+                     static_cast<unsigned long>(l.live), static_cast<unsigned long>(l.liveBytes),
+                     static_cast<unsigned long>(l.peakBytes), static_cast<unsigned long>(l.allocs),
+                     static_cast<unsigned long>(l.internalFallbacks));
+  LOG_INFO(LvMemLog, "[LvMem] slabs %u/%u B, %u B idle; live %u B, peak %u B, failures %lu\n",
+                     static_cast<unsigned>(slabBytes()), static_cast<unsigned>(INTERNAL_BUDGET),
+                     static_cast<unsigned>(slabFreeBytes()), static_cast<unsigned>(liveBytes()),
+                     static_cast<unsigned>(peakLiveBytes()), static_cast<unsigned long>(failures()));
+}
+
+}  // namespace TieredAlloc
+
+#endif  // LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
@@ -0,0 +1,241 @@
+#include "tiered_alloc.h"
+
+#include <esp_heap_caps.h>
+#include <string.h>
+
+namespace {
+
+using TieredAlloc::CLASS_COUNT;
+using TieredAlloc::HEADER_SIZE;
+
+constexpr uint16_t CLASS_SIZES[CLASS_COUNT] = {16, 32, 48, 64, 96, 128, 192, 256};
+static_assert(CLASS_SIZES[CLASS_COUNT - 1] == TieredAlloc::SMALL_MAX, "last class is SMALL_MAX");
+
+constexpr uint8_t TIER_LARGE = 0xFF;      // Header::cls of a PSRAM / internal-heap block
+constexpr uint16_t MAGIC_LIVE = 0xB10C;
+constexpr uint16_t MAGIC_FREE = 0xF4EE;
+constexpr uint16_t MAX_PAGES = TieredAlloc::INTERNAL_BUDGET / TieredAlloc::PAGE_SIZE;
+
+struct Header {
+  uint32_t size;   // requested bytes
+  uint16_t magic;
+  uint8_t cls;     // size class or TIER_LARGE
+  uint8_t spill;   // TIER_LARGE block that belongs to a size class
+};
+static_assert(sizeof(Header) == HEADER_SIZE, "header keeps payloads 8-byte aligned");
+
+struct FreeBlock {
+  Header header;
+  FreeBlock* next;
+};
+
+struct SizeClass {
+  FreeBlock* freeList;
+  uint32_t freeCount;
+  TieredAlloc::ClassStats stats;  // size and idle are filled in by classStats()
+};
+
+SizeClass classes[CLASS_COUNT];
+uint8_t* pages[MAX_PAGES];
+uint8_t pageClass[MAX_PAGES];
+uint16_t pageCount = 0;
+TieredAlloc::LargeStats large = {};
+size_t live = 0;
+size_t peakLive = 0;
+uint32_t liveBlocks = 0;
+uint32_t failed = 0;
+
+constexpr size_t stride(uint8_t cls) {
+  return HEADER_SIZE + CLASS_SIZES[cls];
+}
+
+// Size class for a request (smallest that fits); the 8 classes make a
+// linear scan as cheap as a lookup table.
+uint8_t classFor(size_t size) {
+  uint8_t cls = 0;
+  while (CLASS_SIZES[cls] < size) ++cls;
+  return cls;
+}
+
+void noteLive(size_t delta) {
+  live += delta;
+  ++liveBlocks;
+  if (live > peakLive) peakLive = live;
+}
+
+// Carves one more internal page into free blocks of this class.
+bool addPage(uint8_t cls) {
+  if (pageCount >= MAX_PAGES) return false;
+  uint8_t* page = static_cast<uint8_t*>(
+      heap_caps_malloc(TieredAlloc::PAGE_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+  if (!page) return false;
+  pages[pageCount] = page;
+  pageClass[pageCount] = cls;
+  ++pageCount;
+  SizeClass& c = classes[cls];
+  size_t n = TieredAlloc::PAGE_SIZE / stride(cls);
+  for (size_t i = n; i-- > 0;) {
+    FreeBlock* b = reinterpret_cast<FreeBlock*>(page + i * stride(cls));
+    b->header.magic = MAGIC_FREE;
+    b->header.cls = cls;
+    b->next = c.freeList;
+    c.freeList = b;
+  }
+  c.freeCount += n;
+  ++c.stats.pages;
+  return true;
+}
+
+void* allocLarge(size_t size, bool spill) {
+  void* raw = heap_caps_malloc(HEADER_SIZE + size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (!raw) {
+    raw = heap_caps_malloc(HEADER_SIZE + size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!raw) {
+      ++failed;
+      return nullptr;
+    }
+    ++large.internalFallbacks;
+  }
+  Header* h = static_cast<Header*>(raw);
+  h->size = size;
+  h->magic = MAGIC_LIVE;
+  h->cls = TIER_LARGE;
+  h->spill = spill;
+  if (!spill) {
+    ++large.allocs;
+    ++large.live;
+    large.liveBytes += size;
+    if (large.liveBytes > large.peakBytes) large.peakBytes = large.liveBytes;
+  }
+  noteLive(size);
+  return h + 1;
+}
+
+}  // namespace
+
+namespace TieredAlloc {
+
+void* alloc(size_t size) {
+  if (size == 0) size = 1;
+  if (size > SMALL_MAX) return allocLarge(size, false);
+
+  uint8_t cls = classFor(size);
+  SizeClass& c = classes[cls];
+  ++c.stats.allocs;
+  if (!c.freeList && !addPage(cls)) {
+    void* p = allocLarge(size, true);
+    if (p) {
+      ++c.stats.spills;
+      if (++c.stats.live > c.stats.peak) c.stats.peak = c.stats.live;
+    }
+    return p;
+  }
+  FreeBlock* b = c.freeList;
+  c.freeList = b->next;
+  --c.freeCount;
+  b->header.size = size;
+  b->header.magic = MAGIC_LIVE;
+  b->header.spill = 0;
+  if (++c.stats.live > c.stats.peak) c.stats.peak = c.stats.live;
+  noteLive(size);
+  return &b->header + 1;
+}
+
+void* resize(void* p, size_t size) {
+  if (!p) return alloc(size);
+  Header* h = static_cast<Header*>(p) - 1;
+  if (size == 0) size = 1;
+  if (h->cls != TIER_LARGE && size <= CLASS_SIZES[h->cls]) {
+    live = live - h->size + size;
+    if (live > peakLive) peakLive = live;
+    h->size = size;
+    return p;
+  }
+  void* q = alloc(size);
+  if (!q) return nullptr;  // the old block stays valid, as with realloc()
+  memcpy(q, p, h->size < size ? h->size : size);
+  release(p);
+  return q;
+}
+
+void release(void* p) {
+  if (!p) return;
+  Header* h = static_cast<Header*>(p) - 1;
+  live -= h->size;
+  --liveBlocks;
+  if (h->cls == TIER_LARGE) {
+    if (h->spill) {
+      --classes[classFor(h->size)].stats.live;
+    } else {
+      --large.live;
+      large.liveBytes -= h->size;
+    }
+    h->magic = MAGIC_FREE;
+    heap_caps_free(h);
+    return;
+  }
+  SizeClass& c = classes[h->cls];
+  FreeBlock* b = reinterpret_cast<FreeBlock*>(h);
+  b->header.magic = MAGIC_FREE;
+  b->next = c.freeList;
+  c.freeList = b;
+  ++c.freeCount;
+  --c.stats.live;
+}
+
+ClassStats classStats(uint8_t cls) {
+  ClassStats s = classes[cls].stats;
+  s.size = CLASS_SIZES[cls];
+  s.idle = classes[cls].freeCount;
+  return s;
+}
+
+LargeStats largeStats() {
+  return large;
+}
+
+size_t slabBytes() {
+  return static_cast<size_t>(pageCount) * PAGE_SIZE;
+}
+
+size_t slabFreeBytes() {
+  size_t bytes = 0;
+  for (uint8_t i = 0; i < CLASS_COUNT; ++i) bytes += classes[i].freeCount * CLASS_SIZES[i];
+  return bytes;
+}
+
+size_t liveBytes() {
+  return live;
+}
+
+size_t peakLiveBytes() {
+  return peakLive;
+}
+
+uint32_t liveCount() {
+  return liveBlocks;
+}
+
+uint32_t failures() {
+  return failed;
+}
+
+bool check() {
+  for (uint8_t cls = 0; cls < CLASS_COUNT; ++cls) {
+    uint32_t n = 0;
+    for (const FreeBlock* b = classes[cls].freeList; b; b = b->next) {
+      if (b->header.magic != MAGIC_FREE || b->header.cls != cls || ++n > classes[cls].freeCount) return false;
+      const uint8_t* at = reinterpret_cast<const uint8_t*>(b);
+      bool inPage = false;
+      for (uint16_t i = 0; i < pageCount && !inPage; ++i) {
+        inPage = pageClass[i] == cls && at >= pages[i] && at + stride(cls) <= pages[i] + PAGE_SIZE &&
+                 (at - pages[i]) % stride(cls) == 0;
+      }
+      if (!inPage) return false;
+    }
+    if (n != classes[cls].freeCount) return false;
+  }
+  return true;
+}
+
+}  // namespace TieredAlloc
@@ -0,0 +1,61 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Tiered allocator behind LVGL (LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM,
+// glue in lv_mem_tiered.cpp).
+// Requests up to 256 bytes (objects, styles, label text, event lists) come
+// from per-size-class slabs carved out of internal SRAM pages, at most
+// INTERNAL_BUDGET in total; freeing a block puts it back on its class's
+// free list, so a menu opened and closed again reuses the same blocks.
+// Larger requests (image/layer buffers, big arrays) go to PSRAM, as do small
+// ones once the budget is used up ("spills"). Every block carries an 8-byte
+// header with its tier and requested size.
+// Not thread-safe: LVGL runs with LV_OS_NONE, so only the LVGL task calls in.
+// This file has no LVGL or Arduino dependency and also builds on the host
+// (tools/lv_alloc_replay).
+namespace TieredAlloc {
+
+  static constexpr uint8_t CLASS_COUNT = 8;      // 16, 32, 48, 64, 96, 128, 192, 256 bytes
+  static constexpr size_t SMALL_MAX = 256;
+  static constexpr size_t HEADER_SIZE = 8;
+  static constexpr size_t PAGE_SIZE = 2048;      // internal slab page
+  static constexpr size_t INTERNAL_BUDGET = 48 * 1024;
+
+  struct ClassStats {
+    uint16_t size;     // payload bytes per block
+    uint16_t pages;
+    uint32_t live;     // blocks in use
+    uint32_t idle;     // blocks on the free list
+    uint32_t peak;     // high-water of live
+    uint32_t allocs;
+    uint32_t spills;   // requests of this class served from PSRAM
+  };
+
+  struct LargeStats {
+    uint32_t live;
+    uint32_t liveBytes;   // requested bytes, headers excluded
+    uint32_t peakBytes;
+    uint32_t allocs;
+    uint32_t internalFallbacks;  // PSRAM was full, served from internal heap
+  };
+
+  void* alloc(size_t size);
+  // Grows in place while the request still fits its size class.
+  void* resize(void* p, size_t size);
+  void release(void* p);
+
+  ClassStats classStats(uint8_t cls);
+  LargeStats largeStats();
+  size_t slabBytes();         // internal pages reserved
+  size_t slabFreeBytes();     // payload bytes sitting on free lists
+  size_t liveBytes();         // requested bytes in use, both tiers
+  size_t peakLiveBytes();
+  uint32_t liveCount();
+  uint32_t failures();        // requests no tier could serve
+  // Walks the free lists; false if a block is outside its class's pages.
+  bool check();
+
+  // Per-class and PSRAM tier table with high-water marks (lv_mem_tiered.cpp).
+  void logReport();
+}
@@ -7,6 +7,13 @@
 #include "imu_monitor.h"
 #include "wifi_service.h"
 #include "logger.h"
+#include "flight_recorder.h"
+#include "heap_telemetry.h"
+#include "persist_store.h"
+#include "stat_log/stat_log.h"
+#include "event_bus.h"
+#include "scheduler.h"
+#include "bubu_clock.h"
 #include "ota/ota_manager.h"
 #include "sound/sound_system.h"
 #include "battery_system.h"
@@ -18,38 +25,83 @@ DEFINE_MODULE_LOGGER(MainLog)
 
 static void checkPsram() {
   if (psramFound()) {
-    MainLog::println("[BOOT] PSRAM detected");
-    MainLog::printf("[BOOT] PSRAM free: %u bytes\n",
-                  heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
+    LOG_INFO(MainLog, "[BOOT] PSRAM detected\n");
+    LOG_INFO(MainLog, "[BOOT] PSRAM free: %u bytes\n",
+                      heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
   } else {
-    MainLog::println("[BOOT] PSRAM NOT FOUND");
+    LOG_ERROR(MainLog, "[BOOT] PSRAM NOT FOUND\n");
   }
 }
 
-static void printMemoryReport(const char* label) {
-  multi_heap_info_t info;
-  heap_caps_get_info(&info, MALLOC_CAP_INTERNAL);
-  size_t freeHeap = ESP.getFreeHeap();
-  size_t largestFree = info.largest_free_block;
-  size_t freePsram = ESP.getFreePsram();
-  size_t totalPsram = ESP.getPsramSize();
+static bool ota_check_done = false;
+static bool ota_wifi_stop_pending = false;
+
+// Frame cadence: eye animation, LVGL and touch polling (TouchSystem reads the
+// controller at most every 5 ms).
+static constexpr uint32_t FRAME_PERIOD_MS = 5;
+
+static void otaUpdate(uint32_t) {
+  // After wifi connection, check for OTA update once (runs on the OTA task)
+  if (!ota_check_done && wifiGetState() == WifiState::CONNECTED) {
+    ota_check_done = true;
+    BubuOTA::runOnce();
+    ota_wifi_stop_pending = true;
+  }
+  // A successful install reboots from the OTA task. Otherwise we're on the
+  // latest version or the check/install failed; shut down WiFi to save power.
+  if (ota_wifi_stop_pending && !BubuOTA::isBusy()) {
+    ota_wifi_stop_pending = false;
+    wifiStop();
+  }
+}
+
+static void careUpdate(uint32_t) {
+  CareSystem::setDecaySuspended(DisplaySystem_isHatching());
+  CareSystem::update();
+}
+
+static void frameUpdate(uint32_t) {
+  EyeGame::update();
+  DisplaySystem_update();
+}
+
+static void batteryUpdate(uint32_t) {
+  BatterySystem::update();
+}
+
+static void wifiTask(uint32_t) {
+  wifiUpdate();
+}
+
+static void schedulerReport(uint32_t) {
+  Scheduler::logReport();
+}
 
-  MainLog::println("------ Memory Report ------");
-  if (label) MainLog::printf("Label: %s\n", label);
-  MainLog::printf("Internal RAM free:    %u bytes\n", static_cast<unsigned>(freeHeap));
-  MainLog::printf("Internal largest blk: %u bytes\n", static_cast<unsigned>(largestFree));
-  MainLog::printf("PSRAM total:          %u bytes\n", static_cast<unsigned>(totalPsram));
-  MainLog::printf("PSRAM free:           %u bytes\n", static_cast<unsigned>(freePsram));
-  MainLog::println("---------------------------");
+// Period (ms) and CPU budget (us) per subsystem, in the order loop() used to
+// call them.
+static void scheduleTasks() {
+  Scheduler::add("ota", otaUpdate, 500, 2000);
+  Scheduler::add("care", careUpdate, 1000, 2000);
+  Scheduler::add("frame", frameUpdate, FRAME_PERIOD_MS, 33000);
+  Scheduler::add("imu", ImuMonitor::update, 100, 3000);
+  Scheduler::add("battery", batteryUpdate, 250, 3000);
+  Scheduler::add("heap", HeapTelemetry::update, HeapTelemetry::SAMPLE_PERIOD_MS, 5000);
+  Scheduler::add("store", PersistStore::update, 1000, 50000);  // an NVS commit
+  Scheduler::add("history", StatLog::update, 1000, 100000);    // a sector erase
+  Scheduler::add("wifi", wifiTask, 100, 5000);
+  Scheduler::add("sched", schedulerReport, Scheduler::REPORT_PERIOD_MS, 0, Scheduler::REPORT_PERIOD_MS);
 }
 
 // Main app entrypoints
 void setup() {
   Logger::begin(115200);
   delay(100);
+  FlightRecorder::begin();
+  HeapTelemetry::begin();
+  PersistStore::begin();
 
   checkPsram();
-  printMemoryReport("Boot start");
+  HeapTelemetry::logReport("Boot start");
 
   wifiInit();
   SoundSystem::begin();
@@ -59,12 +111,13 @@ void setup() {
   TCA6408::begin();
   DisplaySystem_begin();
 
-  printMemoryReport("After display init");
+  HeapTelemetry::logReport("After display init");
   BatterySystem::begin();
   LevelSystem::begin();
   ImuMonitor::begin();
   wifiAutoConnectKnown();  // boot: scan + connect to known SSID if visible (no provisioning)
   CareSystem::begin();
+  StatLog::beginPartition();
   EyeGame::Config gameCfg;
   gameCfg.maxRounds = 40;
   gameCfg.rewardPerHit = CareSystem::kGameRewardPerHit;
@@ -75,27 +128,15 @@ void setup() {
   if (BubuOTA::wasRollback()) {
     Serial.println("[OTA] Rollback detected (previous update crashed).");
   }
+  scheduleTasks();
 }
 
-static bool ota_check_done = false;
-
 void loop() {
-  // After wifi connection, check for OTA update once
-  if (!ota_check_done && wifiGetState() == WifiState::CONNECTED) {
-    ota_check_done = true;
-    BubuOTA::runOnce();
-    // If we're still here, it means no update was performed.
-    // This could be because we're on the latest version, or the check/install failed.
-    // In either case, shut down WiFi to save power.
-    wifiStop();
-  }
-
-  CareSystem::setDecaySuspended(DisplaySystem_isHatching());
-  CareSystem::update();
-  EyeGame::update();
-  ImuMonitor::update(millis());
-  DisplaySystem_update();
-  BatterySystem::update();
-  wifiUpdate();
-  delay(1);
+  uint32_t now = millis();
+  BubuOTA::noteLoopTick(now);
+  FlightRecorder::noteLoopTick(now);
+  EventBus::dispatch();
+  uint32_t idleMs = Scheduler::runDue(BubuClock::nowMs());
+  // Sleep until the next deadline; at least one tick so idle tasks run.
+  delay(idleMs ? idleMs : 1);
 }
@@ -1,4 +1,5 @@
 #include "menu_system.h"
+#include "bubu_clock.h"
 #include "care_system.h"
 #include "level_system.h"
 #include "display_system.h"
@@ -12,14 +13,23 @@
 #include <cstdio>
 #include <cmath>
 #include "logger.h"
+#include "flight_recorder.h"
+#include "event_bus.h"
 DEFINE_MODULE_LOGGER(MenuLog)
 
 namespace {
 
-MenuState currentState = MENU_CLOSED;
+MenuState currentState = MENU_CLOSED;  // changed through setState() only
+MenuState recordedState = MENU_CLOSED;  // last state sent to the flight recorder
 MenuItem selectedItem = MENU_FEED;
 bool gamesOpenedFromMenu = false;
 
+void setState(MenuState next) {
+  if (next == currentState) return;
+  EventBus::publish(EventBus::MenuChanged{static_cast<uint8_t>(currentState), static_cast<uint8_t>(next)});
+  currentState = next;
+}
+
 // LVGL objects
 lv_obj_t* menuPanel = nullptr;
 lv_obj_t* menuList = nullptr;
@@ -40,6 +50,7 @@ lv_obj_t* connectRow = nullptr;
 lv_obj_t* connectLabel = nullptr;
 lv_obj_t* connectSwitch = nullptr;
 lv_obj_t* connectOtaBtn = nullptr;
+lv_obj_t* connectOtaLabel = nullptr;
 lv_obj_t* batteryPanel = nullptr;
 lv_obj_t* batteryTitle = nullptr;
 lv_obj_t* batteryValue = nullptr;
@@ -75,9 +86,8 @@ constexpr uint32_t COLOR_TEXT = 0xFFFFFF;
 constexpr uint32_t COLOR_CONNECT_OK = 0x4CAF50;
 
 static constexpr uint32_t OTA_BREATH_PERIOD_MS = 2000;
-static bool otaActive = false;
-static uint32_t otaStartMs = 0;
-static uint32_t otaLastTickMs = 0;
+static constexpr const char* OTA_LABEL_IDLE = "CẬP NHẬT";
+static int otaLabelPct = -1;  // percent shown on the OTA button, -1 = idle text
 
 char gameStatusMsg[64] = "Chạm để chơi";
 
@@ -266,11 +276,30 @@ static void syncConnectSwitchState() {
              s == WifiState::CONNECTED);
   setConnectSwitchState(on);
 
-  if (otaActive) {
-    uint32_t nowMs = millis();
+  // OTA runs on its own task; poll its status and breathe while it works.
+  BubuOTA::Status ota = BubuOTA::status();
+  if (connectOtaLabel) {
+    int pct = -1;
+    if (ota.busy) {
+      pct = ota.bytesTotal
+                ? static_cast<int>(static_cast<uint64_t>(ota.bytesDone) * 100 / ota.bytesTotal)
+                : 0;
+      if (pct > 99) pct = 99;
+    }
+    if (pct != otaLabelPct) {
+      otaLabelPct = pct;
+      if (pct < 0) {
+        lv_label_set_text(connectOtaLabel, OTA_LABEL_IDLE);
+      } else {
+        lv_label_set_text_fmt(connectOtaLabel, "%d%%", pct);
+      }
+    }
+  }
+  if (ota.busy) {
+    uint32_t nowMs = BubuClock::nowMs();
     float phase = 0.0f;
     if (OTA_BREATH_PERIOD_MS > 0) {
-      phase = static_cast<float>((nowMs - otaStartMs) % OTA_BREATH_PERIOD_MS) /
+      phase = static_cast<float>((nowMs - ota.startedMs) % OTA_BREATH_PERIOD_MS) /
               static_cast<float>(OTA_BREATH_PERIOD_MS);
     }
     float sWave = sinf(phase * 2.0f * 3.14159265f);
@@ -364,21 +393,21 @@ bool isLevelOpen() {
 }
 
 void showLevel() {
-  currentState = MENU_LEVEL_OPEN;
+  setState(MENU_LEVEL_OPEN);
   lv_obj_add_flag(menuPanel, LV_OBJ_FLAG_HIDDEN);
   lv_obj_clear_flag(levelPanel, LV_OBJ_FLAG_HIDDEN);
   updateLevelUI();
-  MenuLog::println("[MenuSystem] Level screen opened (Layer 2)");
+  LOG_INFO(MenuLog, "[MenuSystem] Level screen opened (Layer 2)\n");
 }
 
 void closeLevelToMenu() {
   if (currentState != MENU_LEVEL_OPEN) return;
   lv_obj_add_flag(levelPanel, LV_OBJ_FLAG_HIDDEN);
   lv_obj_clear_flag(menuPanel, LV_OBJ_FLAG_HIDDEN);
-  currentState = MENU_OPEN;
+  setState(MENU_OPEN);
   selectedItem = MENU_LEVEL;
   scrollMenuToIndex(static_cast<uint8_t>(selectedItem), LV_ANIM_OFF);
-  MenuLog::println("[MenuSystem] Level screen closed -> back to menu");
+  LOG_INFO(MenuLog, "[MenuSystem] Level screen closed -> back to menu\n");
 }
 
 void createStatsPanel() {
@@ -596,10 +625,10 @@ void createConnectPanel() {
   lv_obj_add_style(connectOtaBtn, &gum_style_pr, LV_PART_MAIN | LV_STATE_PRESSED);
   lv_obj_add_style(connectOtaBtn, &gum_style_def, LV_PART_MAIN | LV_STATE_DEFAULT);
 
-  lv_obj_t* otaLabel = lv_label_create(connectOtaBtn);
-  lv_label_set_text(otaLabel, "CẬP NHẬT");
-  lv_obj_set_style_text_color(otaLabel, lv_color_hex(COLOR_TEXT), 0);
-  lv_obj_center(otaLabel);
+  connectOtaLabel = lv_label_create(connectOtaBtn);
+  lv_label_set_text(connectOtaLabel, OTA_LABEL_IDLE);
+  lv_obj_set_style_text_color(connectOtaLabel, lv_color_hex(COLOR_TEXT), 0);
+  lv_obj_center(connectOtaLabel);
 }
 
 void updateStatsUI() {
@@ -641,10 +670,10 @@ void updateGamesUI() {
 }
 
 static void startFeedAnim() {
-  feedAnimEndMs = millis() + FEED_ANIM_DURATION_MS;
-  currentState = MENU_FEEDING;
+  feedAnimEndMs = BubuClock::nowMs() + FEED_ANIM_DURATION_MS;
+  setState(MENU_FEEDING);
   lv_obj_add_flag(menuPanel, LV_OBJ_FLAG_HIDDEN);
-  MenuLog::println("[MenuSystem] Feed animation started");
+  LOG_INFO(MenuLog, "[MenuSystem] Feed animation started\n");
 }
 
 }  // anonymous namespace
@@ -652,7 +681,7 @@ static void startFeedAnim() {
 namespace MenuSystem {
 
 void begin() {
-  MenuLog::println("[MenuSystem] Initializing LVGL menu...");
+  LOG_INFO(MenuLog, "[MenuSystem] Initializing LVGL menu...\n");
   createCircularPanel();
   createMenuRoller();
   createStatsPanel();
@@ -663,13 +692,16 @@ void begin() {
   createBatteryPanel();
   createLevelPanel();
   syncConnectSwitchState();
-  MenuLog::println("[MenuSystem] Ready!");
+  EventBus::subscribe<EventBus::GameChanged>([](const EventBus::GameChanged& e, void*) {
+    if (!e.running) handleGameFinished();
+  });
+  LOG_INFO(MenuLog, "[MenuSystem] Ready!\n");
 }
 
 void open() {
   if (currentState == MENU_OPEN) return;
   
-  currentState = MENU_OPEN;
+  setState(MENU_OPEN);
   selectedItem = MENU_FEED;
   MessageSystem::close();
   
@@ -684,13 +716,13 @@ void open() {
   // Reset list to first item
   scrollMenuToIndex(0, LV_ANIM_OFF);
   
-  MenuLog::println("[MenuSystem] Menu opened (Layer 1)");
+  LOG_INFO(MenuLog, "[MenuSystem] Menu opened (Layer 1)\n");
 }
 
 void close() {
   if (currentState == MENU_CLOSED) return;
   
-  currentState = MENU_CLOSED;
+  setState(MENU_CLOSED);
   feedAnimEndMs = 0;
   
   // Hide all panels
@@ -703,7 +735,7 @@ void close() {
   lv_obj_add_flag(levelPanel, LV_OBJ_FLAG_HIDDEN);
   MessageSystem::close();
   
-  MenuLog::println("[MenuSystem] Menu closed (back to Layer 0)");
+  LOG_INFO(MenuLog, "[MenuSystem] Menu closed (back to Layer 0)\n");
 }
 
 bool isOpen() {
@@ -731,48 +763,50 @@ bool isMessageOpen() {
 }
 
 static void showConnect() {
-  currentState = MENU_CONNECT_OPEN;
+  setState(MENU_CONNECT_OPEN);
   lv_obj_add_flag(menuPanel, LV_OBJ_FLAG_HIDDEN);
   lv_obj_clear_flag(connectPanel, LV_OBJ_FLAG_HIDDEN);
   syncConnectSwitchState();
-  MenuLog::println("[MenuSystem] Connect opened (Layer 2)");
+  LOG_INFO(MenuLog, "[MenuSystem] Connect opened (Layer 2)\n");
 }
 
 static void showMessage() {
-  currentState = MENU_MESSAGE_OPEN;
+  setState(MENU_MESSAGE_OPEN);
   lv_obj_add_flag(menuPanel, LV_OBJ_FLAG_HIDDEN);
   MessageSystem::open(MenuSystem::closeMessageToMenu);
-  MenuLog::println("[MenuSystem] Message opened (Layer 2)");
+  LOG_INFO(MenuLog, "[MenuSystem] Message opened (Layer 2)\n");
 }
 
 void closeConnectToMenu() {
   if (currentState != MENU_CONNECT_OPEN) return;
   lv_obj_add_flag(connectPanel, LV_OBJ_FLAG_HIDDEN);
   lv_obj_clear_flag(menuPanel, LV_OBJ_FLAG_HIDDEN);
-  currentState = MENU_OPEN;
+  setState(MENU_OPEN);
   selectedItem = MENU_CONNECT;
   scrollMenuToIndex(static_cast<uint8_t>(selectedItem), LV_ANIM_OFF);
-  MenuLog::println("[MenuSystem] Connect closed -> back to menu");
+  LOG_INFO(MenuLog, "[MenuSystem] Connect closed -> back to menu\n");
 }
 
 void closeMessageToMenu() {
   if (currentState != MENU_MESSAGE_OPEN) return;
   MessageSystem::close();
   lv_obj_clear_flag(menuPanel, LV_OBJ_FLAG_HIDDEN);
-  currentState = MENU_OPEN;
+  setState(MENU_OPEN);
   selectedItem = MENU_MESSAGE;
   scrollMenuToIndex(static_cast<uint8_t>(selectedItem), LV_ANIM_OFF);
-  MenuLog::println("[MenuSystem] Message closed -> back to menu");
+  LOG_INFO(MenuLog, "[MenuSystem] Message closed -> back to menu\n");
 }
 
 bool handleConnectTap(uint16_t x, uint16_t y) {
   if (currentState != MENU_CONNECT_OPEN) return false;
   if (isPointInside(connectOtaBtn, x, y)) {
-    if (wifiGetState() == WifiState::CONNECTED) {
-      MenuLog::println("[MenuSystem] OTA triggered from Connect");
+    if (BubuOTA::isBusy()) {
+      LOG_INFO(MenuLog, "[MenuSystem] OTA already running\n");
+    } else if (wifiGetState() == WifiState::CONNECTED) {
+      LOG_INFO(MenuLog, "[MenuSystem] OTA triggered from Connect\n");
       BubuOTA::runManual();
     } else {
-      MenuLog::println("[MenuSystem] OTA blocked: Wi-Fi not connected");
+      LOG_INFO(MenuLog, "[MenuSystem] OTA blocked: Wi-Fi not connected\n");
     }
     return true;
   }
@@ -796,7 +830,7 @@ void selectNext() {
   if (current < MENU_ITEM_COUNT - 1) {
     uint8_t next = static_cast<uint8_t>(current + 1);
     scrollMenuToIndex(next, LV_ANIM_ON);
-    MenuLog::printf("[MenuSystem] Selected: %d\n", selectedItem);
+    LOG_INFO(MenuLog, "[MenuSystem] Selected: %d\n", selectedItem);
   }
 }
 
@@ -807,7 +841,7 @@ void selectPrev() {
   if (current > 0) {
     uint8_t prev = static_cast<uint8_t>(current - 1);
     scrollMenuToIndex(prev, LV_ANIM_ON);
-    MenuLog::printf("[MenuSystem] Selected: %d\n", selectedItem);
+    LOG_INFO(MenuLog, "[MenuSystem] Selected: %d\n", selectedItem);
   }
 }
 
@@ -824,40 +858,40 @@ bool isStatsOpen() {
 }
 
 void showStats() {
-  currentState = MENU_STATS_OPEN;
+  setState(MENU_STATS_OPEN);
   lv_obj_add_flag(menuPanel, LV_OBJ_FLAG_HIDDEN);
   lv_obj_clear_flag(statsPanel, LV_OBJ_FLAG_HIDDEN);
   updateStatsUI();
-  MenuLog::println("[MenuSystem] Stats opened (Layer 2)");
+  LOG_INFO(MenuLog, "[MenuSystem] Stats opened (Layer 2)\n");
 }
 
 void closeStatsToMenu() {
   if (currentState != MENU_STATS_OPEN) return;
   lv_obj_add_flag(statsPanel, LV_OBJ_FLAG_HIDDEN);
   lv_obj_clear_flag(menuPanel, LV_OBJ_FLAG_HIDDEN);
-  currentState = MENU_OPEN;
+  setState(MENU_OPEN);
   selectedItem = MENU_STATS;
-  MenuLog::println("[MenuSystem] Stats closed -> back to menu");
+  LOG_INFO(MenuLog, "[MenuSystem] Stats closed -> back to menu\n");
 }
 
 void closeBatteryToMenu() {
   if (currentState != MENU_BATTERY_OPEN) return;
   lv_obj_add_flag(batteryPanel, LV_OBJ_FLAG_HIDDEN);
   lv_obj_clear_flag(menuPanel, LV_OBJ_FLAG_HIDDEN);
-  currentState = MENU_OPEN;
+  setState(MENU_OPEN);
   selectedItem = MENU_BATTERY;
   scrollMenuToIndex(static_cast<uint8_t>(selectedItem), LV_ANIM_OFF);
-  MenuLog::println("[MenuSystem] Battery closed -> back to menu");
+  LOG_INFO(MenuLog, "[MenuSystem] Battery closed -> back to menu\n");
 }
 
 void closeLevelToMenu() {
   if (currentState != MENU_LEVEL_OPEN) return;
   lv_obj_add_flag(levelPanel, LV_OBJ_FLAG_HIDDEN);
   lv_obj_clear_flag(menuPanel, LV_OBJ_FLAG_HIDDEN);
-  currentState = MENU_OPEN;
+  setState(MENU_OPEN);
   selectedItem = MENU_LEVEL;
   scrollMenuToIndex(static_cast<uint8_t>(selectedItem), LV_ANIM_OFF);
-  MenuLog::println("[MenuSystem] Level screen closed -> back to menu");
+  LOG_INFO(MenuLog, "[MenuSystem] Level screen closed -> back to menu\n");
 }
 
 void statsNext() {
@@ -884,23 +918,27 @@ bool isGameActive() {
   return currentState == MENU_GAME_ACTIVE;
 }
 
+MenuState getState() {
+  return currentState;
+}
+
 void openOptionsForCurrentStat() {
   if (currentState != MENU_STATS_OPEN) return;
-  currentState = MENU_OPTIONS_OPEN;
+  setState(MENU_OPTIONS_OPEN);
   optionsSelection = OPTION_MAIN;
   lv_obj_add_flag(statsPanel, LV_OBJ_FLAG_HIDDEN);
   lv_obj_clear_flag(optionsPanel, LV_OBJ_FLAG_HIDDEN);
   updateOptionsUI();
-  MenuLog::printf("[MenuSystem] Options opened for %s (Layer 3)\n", statNames[statIndex]);
+  LOG_INFO(MenuLog, "[MenuSystem] Options opened for %s (Layer 3)\n", statNames[statIndex]);
 }
 
 void closeOptionsToStats() {
   if (currentState != MENU_OPTIONS_OPEN) return;
   lv_obj_add_flag(optionsPanel, LV_OBJ_FLAG_HIDDEN);
   lv_obj_clear_flag(statsPanel, LV_OBJ_FLAG_HIDDEN);
-  currentState = MENU_STATS_OPEN;
+  setState(MENU_STATS_OPEN);
   updateStatsUI();
-  MenuLog::println("[MenuSystem] Options closed -> back to stats");
+  LOG_INFO(MenuLog, "[MenuSystem] Options closed -> back to stats\n");
 }
 
 void openGamesMenu() {
@@ -910,7 +948,7 @@ void openGamesMenu() {
   if (fromStats && statIndex != 1) return;  // Stats path only when Mood
 
   gamesOpenedFromMenu = fromMenu;
-  currentState = MENU_GAMES_OPEN;
+  setState(MENU_GAMES_OPEN);
 
   if (fromStats) {
     lv_obj_add_flag(statsPanel, LV_OBJ_FLAG_HIDDEN);
@@ -920,7 +958,7 @@ void openGamesMenu() {
 
   lv_obj_clear_flag(gamesPanel, LV_OBJ_FLAG_HIDDEN);
   updateGamesUI();
-  MenuLog::println(fromMenu ? "[MenuSystem] Games menu opened from Play (Layer 4)" : "[MenuSystem] Games menu opened (Layer 4)");
+  LOG_INFO(MenuLog, "%s\n", fromMenu ? "[MenuSystem] Games menu opened from Play (Layer 4)" : "[MenuSystem] Games menu opened (Layer 4)");
 }
 
 void closeGamesToStats() {
@@ -928,25 +966,25 @@ void closeGamesToStats() {
   lv_obj_add_flag(gamesPanel, LV_OBJ_FLAG_HIDDEN);
   if (gamesOpenedFromMenu) {
     lv_obj_clear_flag(menuPanel, LV_OBJ_FLAG_HIDDEN);
-    currentState = MENU_OPEN;
+    setState(MENU_OPEN);
     selectedItem = MENU_PLAY;
     scrollMenuToIndex(static_cast<uint8_t>(selectedItem), LV_ANIM_OFF);
-    MenuLog::println("[MenuSystem] Games closed -> back to menu");
+    LOG_INFO(MenuLog, "[MenuSystem] Games closed -> back to menu\n");
   } else {
     lv_obj_clear_flag(statsPanel, LV_OBJ_FLAG_HIDDEN);
-    currentState = MENU_STATS_OPEN;
+    setState(MENU_STATS_OPEN);
     updateStatsUI();
-    MenuLog::println("[MenuSystem] Games closed -> back to stats");
+    LOG_INFO(MenuLog, "[MenuSystem] Games closed -> back to stats\n");
   }
 }
 
 void startTapTheGreens() {
   if (currentState != MENU_GAMES_OPEN) return;
   lv_obj_add_flag(gamesPanel, LV_OBJ_FLAG_HIDDEN);
-  currentState = MENU_GAME_ACTIVE;
+  setState(MENU_GAME_ACTIVE);
   strncpy(gameStatusMsg, "Playing...", sizeof(gameStatusMsg) - 1);
   EyeGame::start(CareSystem::STAT_MOOD);
-  MenuLog::println("[MenuSystem] Starting Tap the Greens (Layer 5)");
+  LOG_INFO(MenuLog, "[MenuSystem] Starting Tap the Greens (Layer 5)\n");
 }
 
 void handleGameFinished() {
@@ -968,62 +1006,16 @@ void handleGameFinished() {
       break;
   }
 
-  currentState = MENU_GAMES_OPEN;
+  setState(MENU_GAMES_OPEN);
   lv_obj_clear_flag(gamesPanel, LV_OBJ_FLAG_HIDDEN);
   updateGamesUI();
-  MenuLog::println("[MenuSystem] Game finished -> back to games menu");
-}
-
-void otaSetActive(bool active) {
-  otaActive = active;
-  if (active) {
-    otaStartMs = millis();
-    otaLastTickMs = otaStartMs;
-    syncConnectSwitchState();
-  } else {
-    otaStartMs = 0;
-    otaLastTickMs = 0;
-    syncConnectSwitchState();
-  }
-}
-
-void otaPulse(uint32_t nowMs) {
-  if (!otaActive) return;
-  if (currentState != MENU_CONNECT_OPEN) return;
-  if (!connectPanel) return;
-
-  if (otaLastTickMs == 0 || nowMs < otaLastTickMs) {
-    otaLastTickMs = nowMs;
-  } else {
-    uint32_t dt = nowMs - otaLastTickMs;
-    if (dt > 0) {
-      lv_tick_inc(dt);
-      otaLastTickMs = nowMs;
-    }
-  }
-
-  float phase = 0.0f;
-  if (OTA_BREATH_PERIOD_MS > 0) {
-    phase = static_cast<float>((nowMs - otaStartMs) % OTA_BREATH_PERIOD_MS) /
-            static_cast<float>(OTA_BREATH_PERIOD_MS);
-  }
-  float sWave = sinf(phase * 2.0f * 3.14159265f);
-  float blend = 0.5f + 0.5f * sWave;
-  uint8_t baseR = static_cast<uint8_t>((COLOR_CONNECT_OK >> 16) & 0xFF);
-  uint8_t baseG = static_cast<uint8_t>((COLOR_CONNECT_OK >> 8) & 0xFF);
-  uint8_t baseB = static_cast<uint8_t>(COLOR_CONNECT_OK & 0xFF);
-  uint8_t r = static_cast<uint8_t>(baseR + (255 - baseR) * blend);
-  uint8_t g = static_cast<uint8_t>(baseG + (255 - baseG) * blend);
-  uint8_t b = static_cast<uint8_t>(baseB + (255 - baseB) * blend);
-  lv_obj_set_style_bg_color(connectPanel, lv_color_hex(COLOR_BACKGROUND), 0);
-  lv_obj_set_style_border_color(connectPanel, lv_color_make(r, g, b), 0);
-  lv_timer_handler();
+  LOG_INFO(MenuLog, "[MenuSystem] Game finished -> back to games menu\n");
 }
 
 void activateCurrentOption() {
   if (currentState != MENU_OPTIONS_OPEN) return;
   if (optionsSelection == OPTION_MAIN) {
-    MenuLog::printf("[MenuSystem] Activate option: %s (%s)\n", statNames[statIndex], statOptionNames[statIndex]);
+    LOG_INFO(MenuLog, "[MenuSystem] Activate option: %s (%s)\n", statNames[statIndex], statOptionNames[statIndex]);
     // Simple stat boosts per option
     switch (statIndex) {
       case 0: CareSystem::addHunger(CareSystem::kSandwichBoost); break;        // Sandwich
@@ -1053,7 +1045,7 @@ void selectOptionsNext() {
 void activateSelected() {
   if (currentState != MENU_OPEN) return;
   
-  MenuLog::printf("[MenuSystem] Activated: %s\n", menuItemLabelTexts[selectedItem]);
+  LOG_INFO(MenuLog, "[MenuSystem] Activated: %s\n", menuItemLabelTexts[selectedItem]);
   
   switch (selectedItem) {
     case MENU_FEED:
@@ -1077,7 +1069,7 @@ void activateSelected() {
       showMessage();
       break;
     case MENU_BATTERY:
-      currentState = MENU_BATTERY_OPEN;
+      setState(MENU_BATTERY_OPEN);
       lv_obj_add_flag(menuPanel, LV_OBJ_FLAG_HIDDEN);
       lv_obj_clear_flag(batteryPanel, LV_OBJ_FLAG_HIDDEN);
       break;
@@ -1091,6 +1083,10 @@ void activateSelected() {
 }
 
 void render() {
+  if (currentState != recordedState) {
+    FlightRecorder::record(FlightRecorder::Event::MENU, static_cast<uint8_t>(currentState));
+    recordedState = currentState;
+  }
   if (currentState == MENU_STATS_OPEN) {
     updateStatsUI();
   } else if (currentState == MENU_LEVEL_OPEN) {
@@ -1100,13 +1096,13 @@ void render() {
   } else if (currentState == MENU_GAMES_OPEN) {
     updateGamesUI();
   } else if (currentState == MENU_FEEDING) {
-    if (feedAnimEndMs != 0 && millis() >= feedAnimEndMs) {
+    if (feedAnimEndMs != 0 && BubuClock::nowMs() >= feedAnimEndMs) {
       feedAnimEndMs = 0;
       CareSystem::addHunger(CareSystem::kSandwichBoost); // Apply feed after anim
       lv_obj_clear_flag(menuPanel, LV_OBJ_FLAG_HIDDEN);
-      currentState = MENU_OPEN;
+      setState(MENU_OPEN);
       scrollMenuToIndex(static_cast<uint8_t>(selectedItem), LV_ANIM_OFF);
-      MenuLog::println("[MenuSystem] Feed animation ended -> back to menu");
+      LOG_INFO(MenuLog, "[MenuSystem] Feed animation ended -> back to menu\n");
     }
   } else if (currentState == MENU_CONNECT_OPEN) {
     syncConnectSwitchState();
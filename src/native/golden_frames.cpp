@@ -0,0 +1,451 @@
+// Golden-frame harness ([env:golden_frames]): puts the display through a
+// scripted list of scenes (every EyeEmotion, blink and wink phases, pop
+// frames, hatch phases, rain, sleep, the clock and each menu layer), hashes
+// the 240x240 RGB565 panel image of each and times its render, then checks
+// both against the goldens. Replaces main.cpp's setup()/loop().
+//
+//   pio run -e golden_frames
+//   .pio/build/golden_frames/program -- [--update] [--golden DIR] [--out DIR]
+//       [--only TEXT] [--tolerance PIXELS] [--delta LEVELS] [--time-pct N]
+//
+// DIR/golden.txt holds "scene hash render_us" per line and DIR/<scene>.ppm
+// the reference image; --update rewrites both from this run. A scene fails
+// when it has no golden or its hash differs, unless --tolerance is given
+// and no more than that many pixels differ from the reference image by
+// more than --delta levels (0-255 per channel). The pixel check always
+// runs; the time check is opt-in: with --time-pct N a scene also fails when
+// its render time exceeds the golden's by more than N percent plus
+// TIME_SLACK_US. Render times are host times, so only compare against
+// goldens recorded on the same machine.
+// Failing frames are written to --out (default .pio/golden_frames).
+// No goldens are recorded yet, so [env:golden_frames] is commented out in
+// platformio.ini: enable it, record tools/golden_frames/ with --update on a
+// build with LVGL and commit both together. Without goldens every run fails
+// with "no goldens".
+#include <Arduino.h>
+#include <Wire.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <string>
+#include <vector>
+#include "battery_system.h"
+#include "board_pins.h"
+#include "bubu_clock.h"
+#include "care_system.h"
+#include "display_system.h"
+#include "event_bus.h"
+#include "flight_recorder.h"
+#include "level_system.h"
+#include "logger.h"
+#include "menu_system.h"
+#include "native_host.h"
+#include "persist_store.h"
+#include "sound/sound_system.h"
+#include "tca6408.h"
+
+namespace {
+
+constexpr uint32_t START_MS = 1000000;      // so scenes can start in the past
+constexpr uint32_t MENU_SETTLE_MS = 1000;   // menu scroll animations finish
+constexpr uint8_t SETTLE_FRAMES = 48;       // eased offsets converge
+constexpr uint8_t DEFAULT_TIMED_FRAMES = 5;
+constexpr uint32_t TIME_SLACK_US = 100;
+constexpr time_t CLOCK_EPOCH = 1767231000;  // 2026-01-01 08:30 ICT
+
+// --- scenes ---
+
+struct Scene {
+  const char* name;
+  void (*apply)(uint32_t a, uint32_t b);
+  uint32_t a;
+  uint32_t b;
+};
+
+void showEmotion(uint32_t emo, uint32_t) {
+  DisplaySystem_sceneEmotion(static_cast<EyeEmotion>(emo));
+}
+
+void showBlink(uint32_t ms, uint32_t eyes) {
+  DisplaySystem_sceneBlink(ms, eyes & 1, eyes & 2);
+}
+
+void showPop(uint32_t frame, uint32_t) {
+  DisplaySystem_scenePop(static_cast<uint8_t>(frame));
+}
+
+void showHatch(uint32_t phase, uint32_t ms) {
+  DisplaySystem_sceneHatch(static_cast<uint8_t>(phase), ms);
+}
+
+void showRain(uint32_t ms, uint32_t) {
+  DisplaySystem_sceneRain(ms);
+}
+
+void showSleep(uint32_t ms, uint32_t) {
+  DisplaySystem_sceneSleep(ms);
+}
+
+void showClock(uint32_t, uint32_t) {
+  DisplaySystem_sceneClock(CLOCK_EPOCH);
+}
+
+void selectItem(MenuItem item) {
+  MenuSystem::open();
+  for (uint8_t i = 0; i < MENU_ITEM_COUNT && MenuSystem::getSelected() != item; ++i) {
+    MenuSystem::selectNext();
+  }
+}
+
+// Menu layers, reached the way taps and swipes reach them.
+void showMenuItem(uint32_t item, uint32_t) {
+  selectItem(static_cast<MenuItem>(item));
+  NativeHost::advanceMs(MENU_SETTLE_MS);
+}
+
+void openPanel(uint32_t item, uint32_t) {
+  selectItem(static_cast<MenuItem>(item));
+  MenuSystem::activateSelected();
+  NativeHost::advanceMs(MENU_SETTLE_MS);
+}
+
+void openStats(uint32_t stat, uint32_t options) {
+  MenuSystem::open();
+  MenuSystem::showStats();
+  for (uint32_t i = 0; i < stat; ++i) MenuSystem::statsNext();
+  if (options) MenuSystem::openOptionsForCurrentStat();
+  NativeHost::advanceMs(MENU_SETTLE_MS);
+}
+
+void openGames(uint32_t, uint32_t) {
+  MenuSystem::open();
+  MenuSystem::openGamesMenu();
+  NativeHost::advanceMs(MENU_SETTLE_MS);
+}
+
+constexpr uint32_t BOTH = 3;
+constexpr uint32_t LEFT = 1;
+constexpr uint32_t RIGHT = 2;
+
+const Scene kScenes[] = {
+  {"emotion_idle", showEmotion, EYE_EMO_IDLE, 0},
+  {"emotion_curious", showEmotion, EYE_EMO_CURIOUS, 0},
+  {"emotion_angry1", showEmotion, EYE_EMO_ANGRY1, 0},
+  {"emotion_love", showEmotion, EYE_EMO_LOVE, 0},
+  {"emotion_tired", showEmotion, EYE_EMO_TIRED, 0},
+  {"emotion_excited", showEmotion, EYE_EMO_EXCITED, 0},
+  {"emotion_angry2", showEmotion, EYE_EMO_ANGRY2, 0},
+  {"emotion_angry3", showEmotion, EYE_EMO_ANGRY3, 0},
+  {"emotion_worried1", showEmotion, EYE_EMO_WORRIED1, 0},
+  {"emotion_curious1", showEmotion, EYE_EMO_CURIOUS1, 0},
+  {"emotion_curious2", showEmotion, EYE_EMO_CURIOUS2, 0},
+  {"emotion_sad1", showEmotion, EYE_EMO_SAD1, 0},
+  {"emotion_sad2", showEmotion, EYE_EMO_SAD2, 0},
+  {"emotion_happy1", showEmotion, EYE_EMO_HAPPY1, 0},
+  {"emotion_happy2", showEmotion, EYE_EMO_HAPPY2, 0},
+  {"blink_closing", showBlink, 30, BOTH},
+  {"blink_closed", showBlink, 80, BOTH},
+  {"blink_opening", showBlink, 160, BOTH},
+  {"wink_left", showBlink, 80, LEFT},
+  {"wink_right", showBlink, 80, RIGHT},
+  {"pop_1", showPop, 1, 0},
+  {"pop_2", showPop, 2, 0},
+  {"pop_3", showPop, 3, 0},
+  {"hatch_egg", showHatch, 1, 20000},
+  {"hatch_rock", showHatch, 2, 45000},
+  {"hatch_deform", showHatch, 3, 40000},
+  {"hatch_lobes", showHatch, 3, 110000},
+  {"hatch_split", showHatch, 4, 8000},
+  {"hatch_eyes", showHatch, 4, 17000},
+  {"rain_start", showRain, 0, 0},
+  {"rain_mid", showRain, 2500, 0},
+  {"sleep_start", showSleep, 0, 0},
+  {"sleep_zs", showSleep, 3000, 0},
+  {"clock", showClock, 0, 0},
+  {"menu_feed", showMenuItem, MENU_FEED, 0},
+  {"menu_play", showMenuItem, MENU_PLAY, 0},
+  {"menu_clean", showMenuItem, MENU_CLEAN, 0},
+  {"menu_sleep", showMenuItem, MENU_SLEEP, 0},
+  {"menu_connect", showMenuItem, MENU_CONNECT, 0},
+  {"menu_message", showMenuItem, MENU_MESSAGE, 0},
+  {"menu_battery", showMenuItem, MENU_BATTERY, 0},
+  {"menu_stats", showMenuItem, MENU_STATS, 0},
+  {"menu_level", showMenuItem, MENU_LEVEL, 0},
+  {"panel_connect", openPanel, MENU_CONNECT, 0},
+  {"panel_message", openPanel, MENU_MESSAGE, 0},
+  {"panel_battery", openPanel, MENU_BATTERY, 0},
+  {"panel_level", openPanel, MENU_LEVEL, 0},
+  {"panel_stats_hunger", openStats, 0, 0},
+  {"panel_stats_mood", openStats, 1, 0},
+  {"panel_stats_energy", openStats, 2, 0},
+  {"panel_stats_clean", openStats, 3, 0},
+  {"panel_options", openStats, 0, 1},
+  {"panel_games", openGames, 0, 0},
+};
+
+// --- goldens ---
+
+struct Golden {
+  std::string name;
+  uint64_t hash;
+  uint32_t renderUs;
+};
+
+struct Options {
+  const char* goldenDir = "tools/golden_frames";
+  const char* outDir = ".pio/golden_frames";
+  const char* only = nullptr;
+  bool update = false;
+  uint32_t tolerance = 0;
+  uint8_t delta = 0;
+  uint32_t timePct = 0;  // 0: render times are reported, not checked
+  uint8_t timedFrames = DEFAULT_TIMED_FRAMES;
+};
+
+bool parseArgs(Options& opt) {
+  int argc = NativeHost::argc();
+  char** argv = NativeHost::argv();
+  for (int i = 0; i < argc; ++i) {
+    const char* a = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (!strcmp(a, "--update")) {
+      opt.update = true;
+    } else if (!strcmp(a, "--golden") && hasValue) {
+      opt.goldenDir = argv[++i];
+    } else if (!strcmp(a, "--out") && hasValue) {
+      opt.outDir = argv[++i];
+    } else if (!strcmp(a, "--only") && hasValue) {
+      opt.only = argv[++i];
+    } else if (!strcmp(a, "--tolerance") && hasValue) {
+      opt.tolerance = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+    } else if (!strcmp(a, "--delta") && hasValue) {
+      opt.delta = static_cast<uint8_t>(strtoul(argv[++i], nullptr, 10));
+    } else if (!strcmp(a, "--time-pct") && hasValue) {
+      opt.timePct = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+    } else {
+      fprintf(stderr, "golden_frames: unknown argument %s\n", a);
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<Golden> loadGoldens(const std::string& path) {
+  std::vector<Golden> goldens;
+  FILE* f = fopen(path.c_str(), "r");
+  if (!f) return goldens;
+  char line[160];
+  while (fgets(line, sizeof(line), f)) {
+    char name[64];
+    unsigned long long hash;
+    unsigned long us;
+    if (line[0] == '#') continue;
+    if (sscanf(line, "%63s %llx %lu", name, &hash, &us) != 3) continue;
+    goldens.push_back({name, static_cast<uint64_t>(hash), static_cast<uint32_t>(us)});
+  }
+  fclose(f);
+  return goldens;
+}
+
+const Golden* findGolden(const std::vector<Golden>& goldens, const char* name) {
+  for (const Golden& g : goldens) {
+    if (g.name == name) return &g;
+  }
+  return nullptr;
+}
+
+bool saveGoldens(const std::string& path, const std::vector<Golden>& goldens) {
+  FILE* f = fopen(path.c_str(), "w");
+  if (!f) return false;
+  fprintf(f, "# scene hash render_us (written by golden_frames --update)\n");
+  for (const Golden& g : goldens) {
+    fprintf(f, "%s %016llx %lu\n", g.name.c_str(), static_cast<unsigned long long>(g.hash),
+            static_cast<unsigned long>(g.renderUs));
+  }
+  return fclose(f) == 0;
+}
+
+// mkdir -p
+bool makeDir(const char* path) {
+  std::string dir(path);
+  for (size_t i = 1; i <= dir.size(); ++i) {
+    if (i < dir.size() && dir[i] != '/') continue;
+    if (mkdir(dir.substr(0, i).c_str(), 0755) != 0 && errno != EEXIST) return false;
+  }
+  return true;
+}
+
+// Pixels of the panel that differ from a P6 reference by more than delta
+// in any channel; UINT32_MAX when the reference is missing or another size.
+uint32_t diffPixels(const std::string& ppmPath, uint8_t delta) {
+  FILE* f = fopen(ppmPath.c_str(), "rb");
+  if (!f) return UINT32_MAX;
+  int w = 0;
+  int h = 0;
+  int maxVal = 0;
+  bool ok = fscanf(f, "P6 %d %d %d", &w, &h, &maxVal) == 3 && fgetc(f) != EOF &&
+            w == NativeHost::panelWidth() && h == NativeHost::panelHeight() && maxVal == 255;
+  std::vector<uint8_t> ref(ok ? static_cast<size_t>(w) * h * 3 : 0);
+  ok = ok && fread(ref.data(), 1, ref.size(), f) == ref.size();
+  fclose(f);
+  if (!ok) return UINT32_MAX;
+
+  const uint16_t* fb = NativeHost::framebuffer();
+  uint32_t differing = 0;
+  for (int i = 0; i < w * h; ++i) {
+    uint16_t c = fb[i];
+    int rgb[3] = {(c >> 11) * 255 / 31, ((c >> 5) & 0x3F) * 255 / 63, (c & 0x1F) * 255 / 31};
+    for (int ch = 0; ch < 3; ++ch) {
+      if (abs(rgb[ch] - ref[i * 3 + ch]) > delta) {
+        ++differing;
+        break;
+      }
+    }
+  }
+  return differing;
+}
+
+// --- run ---
+
+uint64_t seedFor(const char* name) {
+  uint64_t h = 0xcbf29ce484222325ull;
+  for (const char* p = name; *p; ++p) h = (h ^ static_cast<uint8_t>(*p)) * 0x100000001b3ull;
+  return h;
+}
+
+struct Result {
+  uint64_t hash;
+  uint32_t renderUs;  // fastest of the timed frames
+  bool stable;        // every timed frame drew the same image
+};
+
+Result runScene(const Scene& scene, uint8_t timedFrames) {
+  DisplaySystem_sceneReset(static_cast<unsigned long>(seedFor(scene.name) | 1));
+  scene.apply(scene.a, scene.b);
+  for (uint8_t i = 0; i < SETTLE_FRAMES; ++i) DisplaySystem_sceneRender();
+
+  Result r = {NativeHost::frameHash(), UINT32_MAX, true};
+  for (uint8_t i = 0; i < timedFrames; ++i) {
+    uint32_t t0 = micros();
+    DisplaySystem_sceneRender();
+    uint32_t us = micros() - t0;
+    if (us < r.renderUs) r.renderUs = us;
+    if (NativeHost::frameHash() != r.hash) r.stable = false;
+  }
+  return r;
+}
+
+void boot() {
+  Logger::begin(115200);
+  FlightRecorder::begin();
+  PersistStore::begin();
+  SoundSystem::begin();
+  Wire.begin(PIN_I2C_SDA, PIN_I2C_SCL);
+  TCA6408::begin();
+  DisplaySystem_begin();
+  BatterySystem::begin();
+  LevelSystem::begin();
+  CareSystem::begin();
+  EventBus::dispatch();
+}
+
+int runAll(const Options& opt) {
+  std::string goldenPath = std::string(opt.goldenDir) + "/golden.txt";
+  std::vector<Golden> goldens = loadGoldens(goldenPath);
+  if (goldens.empty() && !opt.update) {
+    fprintf(stderr, "golden_frames: no goldens in %s; record them with --update and commit them\n",
+            goldenPath.c_str());
+    return 1;
+  }
+  std::vector<Golden> updated = goldens;
+
+  uint32_t failures = 0;
+  uint32_t ran = 0;
+  printf("\n%-20s %-16s %8s %8s  %s\n", "scene", "hash", "us", "gold_us", "result");
+  for (const Scene& scene : kScenes) {
+    if (opt.only && !strstr(scene.name, opt.only)) continue;
+    ++ran;
+    Result r = runScene(scene, opt.timedFrames);
+    std::string frameName = std::string(scene.name) + ".ppm";
+
+    if (opt.update) {
+      Golden g = {scene.name, r.hash, r.renderUs};
+      bool replaced = false;
+      for (Golden& old : updated) {
+        if (old.name == scene.name) {
+          old = g;
+          replaced = true;
+        }
+      }
+      if (!replaced) updated.push_back(g);
+      NativeHost::writePpm((std::string(opt.goldenDir) + "/" + frameName).c_str());
+      printf("%-20s %016llx %8lu %8s  %s\n", scene.name, static_cast<unsigned long long>(r.hash),
+             static_cast<unsigned long>(r.renderUs), "-", r.stable ? "recorded" : "recorded, UNSTABLE");
+      if (!r.stable) ++failures;
+      continue;
+    }
+
+    const Golden* g = findGolden(goldens, scene.name);
+    std::string verdict;
+    bool pixelsOk = g && r.hash == g->hash;
+    if (!g) {
+      verdict = "no golden";
+    } else if (!pixelsOk && (opt.tolerance > 0 || opt.delta > 0)) {
+      uint32_t differing = diffPixels(std::string(opt.goldenDir) + "/" + frameName, opt.delta);
+      pixelsOk = differing <= opt.tolerance;
+      char buf[48];
+      if (differing == UINT32_MAX) {
+        snprintf(buf, sizeof(buf), "no reference image");
+      } else {
+        snprintf(buf, sizeof(buf), "%lu px differ", static_cast<unsigned long>(differing));
+      }
+      verdict = buf;
+    } else if (!pixelsOk) {
+      verdict = "pixels changed";
+    }
+    bool timeOk = !g || !opt.timePct ||
+                  r.renderUs <= static_cast<uint64_t>(g->renderUs) * (100 + opt.timePct) / 100 + TIME_SLACK_US;
+    if (!timeOk) verdict += verdict.empty() ? "slower" : ", slower";
+    if (!r.stable) verdict += verdict.empty() ? "unstable" : ", unstable";
+    bool pass = g && pixelsOk && timeOk && r.stable;
+    if (pass && verdict.empty()) verdict = "ok";
+    else if (pass) verdict = "ok (" + verdict + ")";
+
+    char goldUs[12] = "-";
+    if (g) snprintf(goldUs, sizeof(goldUs), "%lu", static_cast<unsigned long>(g->renderUs));
+    printf("%-20s %016llx %8lu %8s  %s\n", scene.name, static_cast<unsigned long long>(r.hash),
+           static_cast<unsigned long>(r.renderUs), goldUs, verdict.c_str());
+    if (!pass) {
+      ++failures;
+      if (makeDir(opt.outDir)) NativeHost::writePpm((std::string(opt.outDir) + "/" + frameName).c_str());
+    }
+  }
+
+  if (opt.update && !saveGoldens(goldenPath, updated)) {
+    fprintf(stderr, "golden_frames: cannot write %s\n", goldenPath.c_str());
+    return 1;
+  }
+  printf("%lu scenes, %lu failed\n", static_cast<unsigned long>(ran), static_cast<unsigned long>(failures));
+  if (failures && !opt.update) printf("failing frames are in %s\n", opt.outDir);
+  return failures ? 1 : 0;
+}
+
+}  // namespace
+
+void setup() {
+  Options opt;
+  if (!parseArgs(opt)) {
+    NativeHost::stop(2);
+    return;
+  }
+  boot();
+  NativeHost::advanceMs(START_MS - millis());
+  if (opt.update && !makeDir(opt.goldenDir)) {
+    fprintf(stderr, "golden_frames: cannot create %s\n", opt.goldenDir);
+    NativeHost::stop(1);
+    return;
+  }
+  fflush(stdout);
+  NativeHost::stop(runAll(opt));
+}
+
+void loop() {}
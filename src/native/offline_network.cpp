@@ -0,0 +1,91 @@
+// Network stand-ins for the native build ([env:native]), which leaves out
+// wifi_service.cpp, portal/ and ota/: the radio never comes up, so Wi-Fi
+// stays OFF and an OTA check has nothing to reach. Provisioning from the
+// menu reports FAILED, like a device with no access point in range.
+#include "wifi_service.h"
+#include "ota/ota_manager.h"
+#include "logger.h"
+DEFINE_MODULE_LOGGER(WifiLog)
+
+namespace {
+WifiState state = WifiState::OFF;
+BubuOTA::Status otaStatus = {};
+}
+
+void wifiInit() {
+  state = WifiState::OFF;
+}
+
+void wifiStart(bool) {
+  LOG_INFO(WifiLog, "[WiFi] Native build: no radio\n");
+  state = WifiState::FAILED;
+}
+
+void wifiAutoConnectKnown() {}
+
+void wifiStop() {
+  state = WifiState::OFF;
+}
+
+void wifiUpdate() {}
+
+bool wifiIsProvisioning() {
+  return false;
+}
+
+WifiState wifiGetState() {
+  return state;
+}
+
+const char* wifiGetIp() {
+  return "";
+}
+
+uint32_t wifiLastConnectMs() {
+  return 0;
+}
+
+uint32_t wifiRadioOnMs() {
+  return 0;
+}
+
+namespace BubuOTA {
+
+void begin() {}
+
+void runOnce() {
+  otaStatus.phase = Phase::FAILED;
+}
+
+void runManual() {
+  otaStatus.phase = Phase::FAILED;
+}
+
+bool isBusy() {
+  return false;
+}
+
+Status status() {
+  return otaStatus;
+}
+
+const char* phaseToStr(Phase p) {
+  switch (p) {
+    case Phase::IDLE: return "IDLE";
+    case Phase::CHECKING: return "CHECKING";
+    case Phase::DOWNLOADING: return "DOWNLOADING";
+    case Phase::VERIFYING: return "VERIFYING";
+    case Phase::UP_TO_DATE: return "UP_TO_DATE";
+    case Phase::FAILED: return "FAILED";
+    case Phase::REBOOTING: return "REBOOTING";
+    default: return "?";
+  }
+}
+
+void noteLoopTick(uint32_t) {}
+
+bool wasRollback() {
+  return false;
+}
+
+}  // namespace BubuOTA
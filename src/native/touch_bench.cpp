@@ -0,0 +1,263 @@
+// Touch-trace benchmark ([env:touch_bench]): boots the firmware as an
+// already-hatched pet, replays touch traces (touch_trace.h) through
+// TouchSystem's gesture classifier into the real UI, and reports gesture
+// latency and frame time per trace. Replaces main.cpp's setup()/loop().
+//
+//   pio run -e touch_bench
+//   .pio/build/touch_bench/program -- [--trace NAME|FILE]... [--list]
+//       [--write DIR]
+//
+// --trace takes a canned trace name or a .btr file (a device recording, see
+// tools/touch_trace.py); without it every canned trace runs, in order, each
+// from the idle eyes with random() reseeded. A canned trace that does not
+// end back on the idle eyes fails the run: its touches went somewhere the
+// script did not expect. --write saves the canned traces as DIR/<name>.btr,
+// e.g. for a device build or for tools/touch_trace.py dump.
+//
+// Latency runs from the last contact of a gesture (a long press: the moment
+// it was held long enough) to the frame that takes it, in simulated time;
+// it includes the classifier's release timeout. Frame times are host times
+// of EyeGame::update() + DisplaySystem_update(), the loop's "frame" task.
+#include <Arduino.h>
+#include <Preferences.h>
+#include <Wire.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "battery_system.h"
+#include "board_pins.h"
+#include "bubu_clock.h"
+#include "care_system.h"
+#include "display_system.h"
+#include "event_bus.h"
+#include "eye_game.h"
+#include "flight_recorder.h"
+#include "level_system.h"
+#include "logger.h"
+#include "menu_system.h"
+#include "native_host.h"
+#include "persist_store.h"
+#include "sound/sound_system.h"
+#include "tca6408.h"
+#include "touch_system.h"
+#include "touch_trace.h"
+
+namespace {
+
+constexpr uint32_t FRAME_PERIOD_MS = 5;  // main.cpp's frame task
+constexpr uint32_t CARE_PERIOD_MS = 1000;
+constexpr uint32_t BOOT_SETTLE_MS = 3000;
+constexpr uint32_t TRACE_SETTLE_MS = 1000;
+constexpr unsigned long TRACE_SEED = 1;
+
+struct Options {
+  std::vector<const char*> traces;
+  const char* writeDir = nullptr;
+  bool list = false;
+};
+
+bool parseArgs(Options& opt) {
+  int argc = NativeHost::argc();
+  char** argv = NativeHost::argv();
+  for (int i = 0; i < argc; ++i) {
+    const char* a = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (!strcmp(a, "--trace") && hasValue) {
+      opt.traces.push_back(argv[++i]);
+    } else if (!strcmp(a, "--write") && hasValue) {
+      opt.writeDir = argv[++i];
+    } else if (!strcmp(a, "--list")) {
+      opt.list = true;
+    } else {
+      fprintf(stderr, "touch_bench: unknown argument %s\n", a);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool makeDir(const char* path) {
+  std::string dir(path);
+  for (size_t i = 1; i <= dir.size(); ++i) {
+    if (i < dir.size() && dir[i] != '/') continue;
+    if (mkdir(dir.substr(0, i).c_str(), 0755) != 0 && errno != EEXIST) return false;
+  }
+  return true;
+}
+
+bool isCanned(const char* name) {
+  return TouchTrace::cannedSize(name) > 0;
+}
+
+bool loadTrace(const char* nameOrPath, std::vector<uint8_t>& out) {
+  if (isCanned(nameOrPath)) {
+    out.resize(TouchTrace::cannedSize(nameOrPath));
+    return TouchTrace::buildCanned(nameOrPath, out.data(), out.size()) > 0;
+  }
+  FILE* f = fopen(nameOrPath, "rb");
+  if (!f) return false;
+  out.clear();
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.insert(out.end(), buf, buf + n);
+  fclose(f);
+  return true;
+}
+
+bool writeCanned(const char* dir) {
+  if (!makeDir(dir)) return false;
+  for (uint8_t i = 0; i < TouchTrace::cannedCount(); ++i) {
+    std::vector<uint8_t> trace;
+    if (!loadTrace(TouchTrace::cannedName(i), trace)) return false;
+    std::string path = std::string(dir) + "/" + TouchTrace::cannedName(i) + ".btr";
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+    bool ok = fwrite(trace.data(), 1, trace.size(), f) == trace.size();
+    if (fclose(f) != 0 || !ok) return false;
+    printf("%s: %lu bytes\n", path.c_str(), static_cast<unsigned long>(trace.size()));
+  }
+  return true;
+}
+
+// --- run ---
+
+uint32_t lastCareMs = 0;
+
+// One pass of main.cpp's loop for the UI: events, care, then the frame.
+// Returns the frame's host time.
+uint32_t runFrame() {
+  EventBus::dispatch();
+  uint32_t now = BubuClock::nowMs();
+  if (now - lastCareMs >= CARE_PERIOD_MS) {
+    lastCareMs = now;
+    CareSystem::update();
+  }
+  uint32_t t0 = micros();
+  EyeGame::update();
+  DisplaySystem_update();
+  uint32_t us = micros() - t0;
+  NativeHost::advanceMs(FRAME_PERIOD_MS);
+  return us;
+}
+
+void settle(uint32_t ms) {
+  uint32_t until = BubuClock::nowMs() + ms;
+  while (static_cast<int32_t>(BubuClock::nowMs() - until) < 0) runFrame();
+}
+
+bool atIdleEyes() {
+  return MenuSystem::getState() == MENU_CLOSED && !EyeGame::isRunning();
+}
+
+uint32_t percentile(std::vector<uint32_t>& sorted, uint32_t pct) {
+  if (sorted.empty()) return 0;
+  return sorted[std::min(sorted.size() - 1, sorted.size() * pct / 100)];
+}
+
+// False if the trace could not be loaded, or a canned one strayed.
+bool runTrace(const char* nameOrPath) {
+  std::vector<uint8_t> trace;
+  if (!loadTrace(nameOrPath, trace)) {
+    printf("%-18s cannot read\n", nameOrPath);
+    return false;
+  }
+  if (!TouchSystem::startReplay(trace.data(), trace.size())) {
+    printf("%-18s not a touch trace\n", nameOrPath);
+    return false;
+  }
+  randomSeed(TRACE_SEED);
+
+  std::vector<uint32_t> frameUs;
+  uint32_t startMs = BubuClock::nowMs();
+  while (TouchSystem::isReplaying()) frameUs.push_back(runFrame());
+  uint32_t durationMs = BubuClock::nowMs() - startMs;
+  std::sort(frameUs.begin(), frameUs.end());
+
+  TouchSystem::ReplayStats st = TouchSystem::replayStats();
+  bool home = atIdleEyes();
+  bool pass = home || !isCanned(nameOrPath);
+  printf("%-18s %7lu %7lu %5lu %6lu %6lu %6lu %6lu %6lu %7lu  %s\n", nameOrPath,
+         static_cast<unsigned long>(durationMs), static_cast<unsigned long>(st.samples),
+         static_cast<unsigned long>(st.gestures),
+         static_cast<unsigned long>(st.gestures ? st.latencyTotalMs / st.gestures : 0),
+         static_cast<unsigned long>(st.latencyMaxMs), static_cast<unsigned long>(frameUs.size()),
+         static_cast<unsigned long>(percentile(frameUs, 50)), static_cast<unsigned long>(percentile(frameUs, 95)),
+         static_cast<unsigned long>(frameUs.empty() ? 0 : frameUs.back()),
+         home ? "idle" : pass ? "ended elsewhere" : "FAILED: ended elsewhere");
+  fflush(stdout);
+  return pass;
+}
+
+void boot() {
+  Logger::begin(115200);
+  FlightRecorder::begin();
+  PersistStore::begin();
+  // An already-hatched pet: the hatch screen would take the first five
+  // minutes of taps. DisplaySystem_begin() migrates this legacy flag.
+  Preferences hatchPrefs;
+  hatchPrefs.begin("bubu");
+  hatchPrefs.putBool("hatched", true);
+  hatchPrefs.end();
+  SoundSystem::begin();
+  Wire.begin(PIN_I2C_SDA, PIN_I2C_SCL);
+  TCA6408::begin();
+  DisplaySystem_begin();
+  BatterySystem::begin();
+  LevelSystem::begin();
+  CareSystem::begin();
+  EyeGame::Config gameCfg;
+  gameCfg.maxRounds = 40;
+  gameCfg.rewardPerHit = CareSystem::kGameRewardPerHit;
+  gameCfg.wrongTapMoodDelta = CareSystem::kGameWrongTapMood;
+  gameCfg.wrongTapEnergyDelta = CareSystem::kGameWrongTapEnergy;
+  EyeGame::configure(gameCfg);
+  EventBus::dispatch();
+}
+
+int runAll(const Options& opt) {
+  std::vector<const char*> traces = opt.traces;
+  if (traces.empty()) {
+    for (uint8_t i = 0; i < TouchTrace::cannedCount(); ++i) traces.push_back(TouchTrace::cannedName(i));
+  }
+
+  boot();
+  settle(BOOT_SETTLE_MS);
+  printf("\n%-18s %7s %7s %5s %6s %6s %6s %6s %6s %7s  %s\n", "trace", "ms", "samples", "gest", "lat_ms",
+         "lat_mx", "frames", "p50_us", "p95_us", "max_us", "end");
+  uint32_t failures = 0;
+  for (const char* t : traces) {
+    settle(TRACE_SETTLE_MS);
+    if (!runTrace(t)) ++failures;
+  }
+  printf("%lu traces, %lu failed\n", static_cast<unsigned long>(traces.size()),
+         static_cast<unsigned long>(failures));
+  return failures ? 1 : 0;
+}
+
+}  // namespace
+
+void setup() {
+  Options opt;
+  if (!parseArgs(opt)) {
+    NativeHost::stop(2);
+    return;
+  }
+  if (opt.list) {
+    for (uint8_t i = 0; i < TouchTrace::cannedCount(); ++i) {
+      printf("%-18s %s\n", TouchTrace::cannedName(i), TouchTrace::cannedDescription(i));
+    }
+    NativeHost::stop(0);
+    return;
+  }
+  if (opt.writeDir) {
+    bool ok = writeCanned(opt.writeDir);
+    if (!ok) fprintf(stderr, "touch_bench: cannot write %s\n", opt.writeDir);
+    NativeHost::stop(ok ? 0 : 1);
+    return;
+  }
+  NativeHost::stop(runAll(opt));
+}
+
+void loop() {}
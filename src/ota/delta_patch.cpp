@@ -0,0 +1,179 @@
+#include "delta_patch.h"
+
+#include <string.h>
+
+namespace {
+
+constexpr uint8_t OP_END = 0x00;
+constexpr uint8_t OP_COPY = 0x01;
+constexpr uint8_t OP_LITERAL = 0x02;
+
+uint32_t readLe32(const uint8_t* p) {
+  return static_cast<uint32_t>(p[0]) |
+         (static_cast<uint32_t>(p[1]) << 8) |
+         (static_cast<uint32_t>(p[2]) << 16) |
+         (static_cast<uint32_t>(p[3]) << 24);
+}
+
+int32_t unzigzag(uint32_t v) {
+  return static_cast<int32_t>(v >> 1) ^ -static_cast<int32_t>(v & 1);
+}
+
+}  // namespace
+
+const char* DeltaApplier::statusToStr(Status s) {
+  switch (s) {
+    case Status::OK: return "OK";
+    case Status::BAD_HEADER: return "BAD_HEADER";
+    case Status::BAD_OP: return "BAD_OP";
+    case Status::SOURCE_RANGE: return "SOURCE_RANGE";
+    case Status::SOURCE_MISMATCH: return "SOURCE_MISMATCH";
+    case Status::READ_FAILED: return "READ_FAILED";
+    case Status::WRITE_FAILED: return "WRITE_FAILED";
+    case Status::TARGET_OVERFLOW: return "TARGET_OVERFLOW";
+    case Status::TRUNCATED: return "TRUNCATED";
+    default: return "?";
+  }
+}
+
+void DeltaApplier::begin(ReadFn read, SourceCheckFn check, void* readCtx, WriteFn write, void* writeCtx,
+                         uint8_t* scratch, size_t scratchLen) {
+  *this = DeltaApplier();
+  read_ = read;
+  check_ = check;
+  readCtx_ = readCtx;
+  write_ = write;
+  writeCtx_ = writeCtx;
+  scratch_ = scratch;
+  scratchLen_ = scratchLen;
+}
+
+bool DeltaApplier::fail(Status s) {
+  if (status_ == Status::OK) status_ = s;
+  state_ = State::DONE;
+  return false;
+}
+
+bool DeltaApplier::readVarint(const uint8_t*& p, const uint8_t* end, bool& complete) {
+  complete = false;
+  while (p < end) {
+    uint8_t b = *p++;
+    if (varintShift_ > 28) return fail(Status::BAD_OP);
+    varint_ |= static_cast<uint32_t>(b & 0x7F) << varintShift_;
+    varintShift_ += 7;
+    if ((b & 0x80) == 0) {
+      complete = true;
+      return true;
+    }
+  }
+  return true;
+}
+
+bool DeltaApplier::emit(const uint8_t* data, size_t len) {
+  if (len > targetSize_ - written_) return fail(Status::TARGET_OVERFLOW);
+  if (!write_(data, len, writeCtx_)) return fail(Status::WRITE_FAILED);
+  written_ += static_cast<uint32_t>(len);
+  return true;
+}
+
+bool DeltaApplier::copyFromSource(uint32_t len) {
+  if (srcPos_ > sourceSize_ || len > sourceSize_ - srcPos_) {
+    return fail(Status::SOURCE_RANGE);
+  }
+  while (len > 0) {
+    size_t n = len < scratchLen_ ? len : scratchLen_;
+    if (!read_(srcPos_, scratch_, n, readCtx_)) return fail(Status::READ_FAILED);
+    if (!emit(scratch_, n)) return false;
+    srcPos_ += static_cast<uint32_t>(n);
+    len -= static_cast<uint32_t>(n);
+  }
+  return true;
+}
+
+bool DeltaApplier::feed(const uint8_t* data, size_t len) {
+  const uint8_t* p = data;
+  const uint8_t* end = data + len;
+
+  while (p < end) {
+    if (status_ != Status::OK) return false;
+    switch (state_) {
+      case State::HEADER: {
+        size_t n = HEADER_SIZE - headerFill_;
+        if (n > static_cast<size_t>(end - p)) n = static_cast<size_t>(end - p);
+        memcpy(header_ + headerFill_, p, n);
+        headerFill_ += static_cast<uint8_t>(n);
+        p += n;
+        if (headerFill_ < HEADER_SIZE) break;
+        if (memcmp(header_, "BDLT", 4) != 0 || header_[4] != VERSION) {
+          return fail(Status::BAD_HEADER);
+        }
+        sourceSize_ = readLe32(header_ + 8);
+        targetSize_ = readLe32(header_ + 12);
+        if (!check_(sourceSize_, header_ + 16, scratch_, scratchLen_, readCtx_)) {
+          return fail(Status::SOURCE_MISMATCH);
+        }
+        state_ = State::OP;
+        break;
+      }
+      case State::OP: {
+        uint8_t op = *p++;
+        varint_ = 0;
+        varintShift_ = 0;
+        if (op == OP_COPY) {
+          state_ = State::COPY_LEN;
+        } else if (op == OP_LITERAL) {
+          state_ = State::LITERAL_LEN;
+        } else if (op == OP_END) {
+          state_ = State::DONE;
+        } else {
+          return fail(Status::BAD_OP);
+        }
+        break;
+      }
+      case State::COPY_LEN:
+      case State::LITERAL_LEN: {
+        bool complete = false;
+        if (!readVarint(p, end, complete)) return false;
+        if (!complete) break;
+        pendingLen_ = varint_;
+        varint_ = 0;
+        varintShift_ = 0;
+        state_ = (state_ == State::COPY_LEN) ? State::COPY_DELTA : State::LITERAL;
+        if (state_ == State::LITERAL && pendingLen_ == 0) state_ = State::OP;
+        break;
+      }
+      case State::COPY_DELTA: {
+        bool complete = false;
+        if (!readVarint(p, end, complete)) return false;
+        if (!complete) break;
+        int64_t pos = static_cast<int64_t>(srcPos_) + unzigzag(varint_);
+        if (pos < 0 || pos > static_cast<int64_t>(sourceSize_)) {
+          return fail(Status::SOURCE_RANGE);
+        }
+        srcPos_ = static_cast<uint32_t>(pos);
+        if (!copyFromSource(pendingLen_)) return false;
+        state_ = State::OP;
+        break;
+      }
+      case State::LITERAL: {
+        size_t n = pendingLen_;
+        if (n > static_cast<size_t>(end - p)) n = static_cast<size_t>(end - p);
+        if (!emit(p, n)) return false;
+        p += n;
+        pendingLen_ -= static_cast<uint32_t>(n);
+        if (pendingLen_ == 0) state_ = State::OP;
+        break;
+      }
+      case State::DONE:
+        // Trailing bytes after END are ignored.
+        return status_ == Status::OK;
+    }
+  }
+  return status_ == Status::OK;
+}
+
+bool DeltaApplier::finish() {
+  if (status_ != Status::OK) return false;
+  if (state_ != State::DONE || written_ != targetSize_) return fail(Status::TRUNCATED);
+  return true;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Streaming applier for BDLT delta patches (see tools/ota_delta.py).
+//
+// Patch layout (little endian):
+//   header  "BDLT" | u8 version | u8 flags | u16 reserved | u32 sourceSize | u32 targetSize
+//           | sha256 of the first sourceSize bytes of the source image
+//   ops     0x01 COPY    varint len, zigzag varint srcDelta  (copy from running image)
+//           0x02 LITERAL varint len, <len bytes>
+//           0x00 END
+// The patch is fed in arbitrary slices; RAM use is bounded by the scratch
+// buffer handed to begin() (used for COPY reads from the source image).
+// Once the header is in, the check callback must confirm the source image
+// matches sourceSize and digest; a patch built against another base is
+// rejected before a single image byte is written.
+class DeltaApplier {
+ public:
+  static constexpr uint8_t VERSION = 2;
+  static constexpr size_t DIGEST_SIZE = 32;
+  static constexpr size_t HEADER_SIZE = 16 + DIGEST_SIZE;
+
+  using ReadFn = bool (*)(uint32_t offset, uint8_t* dst, size_t len, void* ctx);
+  // True if the source image is at least sourceSize bytes and those bytes
+  // hash to sha256. May use scratch. ctx is the read context.
+  using SourceCheckFn = bool (*)(uint32_t sourceSize, const uint8_t* sha256,
+                                 uint8_t* scratch, size_t scratchLen, void* ctx);
+  using WriteFn = bool (*)(const uint8_t* data, size_t len, void* ctx);
+
+  enum class Status : uint8_t {
+    OK,
+    BAD_HEADER,
+    BAD_OP,
+    SOURCE_RANGE,
+    SOURCE_MISMATCH,
+    READ_FAILED,
+    WRITE_FAILED,
+    TARGET_OVERFLOW,
+    TRUNCATED
+  };
+
+  void begin(ReadFn read, SourceCheckFn check, void* readCtx, WriteFn write, void* writeCtx,
+             uint8_t* scratch, size_t scratchLen);
+
+  // Consume the next slice of patch bytes. Returns false once an error is hit.
+  bool feed(const uint8_t* data, size_t len);
+
+  // True when END was seen and exactly targetSize bytes were produced.
+  bool finish();
+
+  Status status() const { return status_; }
+  uint32_t sourceSize() const { return sourceSize_; }
+  uint32_t targetSize() const { return targetSize_; }
+  uint32_t written() const { return written_; }
+
+  static const char* statusToStr(Status s);
+
+ private:
+  enum class State : uint8_t { HEADER, OP, COPY_LEN, COPY_DELTA, LITERAL_LEN, LITERAL, DONE };
+
+  bool fail(Status s);
+  bool readVarint(const uint8_t*& p, const uint8_t* end, bool& complete);
+  bool emit(const uint8_t* data, size_t len);
+  bool copyFromSource(uint32_t len);
+
+  ReadFn read_ = nullptr;
+  SourceCheckFn check_ = nullptr;
+  void* readCtx_ = nullptr;
+  WriteFn write_ = nullptr;
+  void* writeCtx_ = nullptr;
+  uint8_t* scratch_ = nullptr;
+  size_t scratchLen_ = 0;
+
+  State state_ = State::HEADER;
+  Status status_ = Status::OK;
+  uint8_t header_[HEADER_SIZE] = {};
+  uint8_t headerFill_ = 0;
+  uint32_t varint_ = 0;
+  uint8_t varintShift_ = 0;
+  uint32_t pendingLen_ = 0;
+
+  uint32_t sourceSize_ = 0;
+  uint32_t targetSize_ = 0;
+  uint32_t srcPos_ = 0;
+  uint32_t written_ = 0;
+};
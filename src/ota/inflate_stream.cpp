@@ -0,0 +1,86 @@
+#include "inflate_stream.h"
+
+#include <sdkconfig.h>
+#include <esp_heap_caps.h>
+#include <stdlib.h>
+#if defined(CONFIG_IDF_TARGET_ESP32S3)
+#include <esp32s3/rom/miniz.h>
+#else
+#include <rom/miniz.h>
+#endif
+
+static_assert(InflateStream::WINDOW_SIZE == TINFL_LZ_DICT_SIZE, "window must match tinfl dictionary");
+
+namespace {
+
+void* psramAlloc(size_t bytes) {
+  void* p = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (!p) p = malloc(bytes);
+  return p;
+}
+
+}  // namespace
+
+bool InflateStream::begin(WriteFn write, void* ctx) {
+  end();
+  decomp_ = psramAlloc(sizeof(tinfl_decompressor));
+  window_ = static_cast<uint8_t*>(psramAlloc(WINDOW_SIZE));
+  if (!decomp_ || !window_) {
+    end();
+    return false;
+  }
+  tinfl_init(static_cast<tinfl_decompressor*>(decomp_));
+  windowOfs_ = 0;
+  write_ = write;
+  ctx_ = ctx;
+  done_ = false;
+  failed_ = false;
+  consumed_ = 0;
+  produced_ = 0;
+  return true;
+}
+
+void InflateStream::end() {
+  free(decomp_);
+  free(window_);
+  decomp_ = nullptr;
+  window_ = nullptr;
+}
+
+bool InflateStream::feed(const uint8_t* data, size_t len) {
+  if (failed_) return false;
+  tinfl_decompressor* d = static_cast<tinfl_decompressor*>(decomp_);
+  const mz_uint32 flags = TINFL_FLAG_PARSE_ZLIB_HEADER | TINFL_FLAG_COMPUTE_ADLER32 |
+                          TINFL_FLAG_HAS_MORE_INPUT;
+
+  // Keep calling until the input slice is used up and no output is pending.
+  for (;;) {
+    if (done_) return true;  // trailing bytes after the stream are ignored
+    size_t inBytes = len;
+    size_t outBytes = WINDOW_SIZE - windowOfs_;
+    tinfl_status st = tinfl_decompress(d, data, &inBytes, window_, window_ + windowOfs_,
+                                       &outBytes, flags);
+    data += inBytes;
+    len -= inBytes;
+    consumed_ += static_cast<uint32_t>(inBytes);
+
+    if (outBytes > 0) {
+      if (!write_(window_ + windowOfs_, outBytes, ctx_)) {
+        failed_ = true;
+        return false;
+      }
+      produced_ += static_cast<uint32_t>(outBytes);
+      windowOfs_ = (windowOfs_ + outBytes) & (WINDOW_SIZE - 1);
+    }
+
+    if (st == TINFL_STATUS_DONE) {
+      done_ = true;
+      return true;
+    }
+    if (st < TINFL_STATUS_DONE) {
+      failed_ = true;
+      return false;
+    }
+    if (st == TINFL_STATUS_NEEDS_MORE_INPUT && len == 0) return true;
+  }
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Streaming zlib inflater for compressed OTA images (see tools/ota_compress.py).
+// Uses the miniz tinfl decoder from ROM with a fixed 32 KB circular window;
+// decompressed bytes are forwarded to the write callback as they appear.
+class InflateStream {
+ public:
+  static constexpr size_t WINDOW_SIZE = 32768;  // TINFL_LZ_DICT_SIZE
+
+  using WriteFn = bool (*)(const uint8_t* data, size_t len, void* ctx);
+
+  // Allocates the decoder state and window (PSRAM when available).
+  bool begin(WriteFn write, void* ctx);
+  void end();
+
+  // Consume the next slice of compressed bytes. Returns false on corrupt
+  // input or a failed write.
+  bool feed(const uint8_t* data, size_t len);
+
+  // True when the zlib stream (including its Adler-32) completed cleanly.
+  bool finish() const { return done_ && !failed_; }
+
+  uint32_t consumed() const { return consumed_; }
+  uint32_t produced() const { return produced_; }
+
+ private:
+  void* decomp_ = nullptr;  // tinfl_decompressor
+  uint8_t* window_ = nullptr;
+  size_t windowOfs_ = 0;
+  WriteFn write_ = nullptr;
+  void* ctx_ = nullptr;
+  bool done_ = false;
+  bool failed_ = false;
+  uint32_t consumed_ = 0;
+  uint32_t produced_ = 0;
+};
@@ -1,83 +1,298 @@
 #include "ota_manager.h"
 #include "semver.h"
-#include "menu_system.h"
+#include "ota_pipeline.h"
+#include "delta_patch.h"
+#include "inflate_stream.h"
+#include "ota_resume.h"
+#include "json/json_stream.h"
+#include "logger.h"
+#include "flight_recorder.h"
 
 #include <WiFi.h>
 #include <WiFiClientSecure.h>
 #include <HTTPClient.h>
 #include <Update.h>
 #include <esp_ota_ops.h>
+#include <esp_app_format.h>
+#include <esp_partition.h>
+#include <esp_heap_caps.h>
 #include <mbedtls/sha256.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
 #define BUBU_FW_VERSION "1.5.4"
-static const char* MANIFEST_URL =
-  "https://raw.githubusercontent.com/hoangtalu/Bubu-OTA/refs/heads/main/latest.json";
+// Override with -DBUBU_OTA_MANIFEST_URL=... to test against a local HTTP server.
+#ifndef BUBU_OTA_MANIFEST_URL
+#define BUBU_OTA_MANIFEST_URL \
+  "https://raw.githubusercontent.com/hoangtalu/Bubu-OTA/refs/heads/main/latest.json"
+#endif
+static const char* MANIFEST_URL = BUBU_OTA_MANIFEST_URL;
+// -DBUBU_FR_UPLOAD_URL=... POSTs the flight recorder's crash report (text)
+// there before the manifest check; off by default.
+#ifdef BUBU_FR_UPLOAD_URL
+static constexpr size_t FR_REPORT_MAX = FlightRecorder::CAPACITY * 64;
+#endif
 
 static bool ran = false;
-static String m_version, m_fwUrl, m_sha256;
+// Manifest fields (fixed buffers, filled straight from the HTTP stream).
+static char m_version[16], m_fwUrl[256], m_sha256[65];
+static char m_patchFrom[16], m_patchUrl[256];  // optional delta against the running version
+static char m_fwZlibUrl[256];                  // optional zlib-compressed full image
+static_assert(JsonStringPicker::fits(sizeof(m_fwUrl)) && JsonStringPicker::fits(sizeof(m_patchUrl)) &&
+                  JsonStringPicker::fits(sizeof(m_fwZlibUrl)),
+              "manifest URLs must fit the picker's scratch");
+static constexpr size_t MANIFEST_MAX_BYTES = 4096;
+
+static constexpr size_t DELTA_SCRATCH_SIZE = 4096;
+static constexpr uint8_t RESUME_ATTEMPTS = 6;          // connections per install
+static constexpr uint32_t RECONNECT_WAIT_MS = 30000;   // Wi-Fi must come back within this
+static constexpr uint32_t RETRY_BACKOFF_MS = 2000;
+
+// Checks and installs run on their own task so the UI loop keeps its frame rate.
+static constexpr uint32_t OTA_TASK_STACK = 12288;  // TLS handshake needs the headroom
+static constexpr UBaseType_t OTA_TASK_PRIORITY = 1;
+static constexpr BaseType_t OTA_TASK_CORE = 0;     // loopTask (UI) runs on core 1
+
+static portMUX_TYPE statusMux = portMUX_INITIALIZER_UNLOCKED;
+static BubuOTA::Status otaStatus = {};
+
+static void setPhase(BubuOTA::Phase phase) {
+  portENTER_CRITICAL(&statusMux);
+  otaStatus.phase = phase;
+  portEXIT_CRITICAL(&statusMux);
+  FlightRecorder::record(FlightRecorder::Event::OTA, static_cast<uint8_t>(phase));
+}
+
+static void setProgress(uint32_t done, uint32_t total) {
+  portENTER_CRITICAL(&statusMux);
+  otaStatus.bytesDone = done;
+  otaStatus.bytesTotal = total;
+  portEXIT_CRITICAL(&statusMux);
+}
 
-// ---- tiny JSON string getter (same style as your old code) ----
-static String jsonGetString(const String& json, const char* key) {
-  String pat = String("\"") + key + "\"";
-  int k = json.indexOf(pat); if (k < 0) return "";
-  int c = json.indexOf(':', k); if (c < 0) return "";
-  int q1 = json.indexOf('"', c + 1); if (q1 < 0) return "";
-  int q2 = json.indexOf('"', q1 + 1); if (q2 < 0) return "";
-  return json.substring(q1 + 1, q2);
+// Plain http:// is accepted so a local server can serve test images.
+static WiFiClient& clientFor(const char* url, WiFiClient& plain, WiFiClientSecure& secure) {
+  if (strncmp(url, "http://", 7) == 0) return plain;
+  return secure;
 }
 
-static bool httpsGet(const String& url, String& body) {
-  WiFiClientSecure client;
-  client.setInsecure();
+// Feeds the HTTP body (chunked or not, via writeToStream) into the picker.
+class ManifestSink : public Stream {
+ public:
+  explicit ManifestSink(JsonStringPicker& picker) : picker_(picker) {}
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* data, size_t len) override {
+    received_ += len;
+    if (received_ > MANIFEST_MAX_BYTES) return 0;
+    return picker_.feed(reinterpret_cast<const char*>(data), len) ? len : 0;
+  }
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+
+ private:
+  JsonStringPicker& picker_;
+  size_t received_ = 0;
+};
+
+static bool fetchManifest() {
+  WiFiClient plainClient;
+  WiFiClientSecure secureClient;
+  secureClient.setInsecure();
 
   HTTPClient http;
   http.setTimeout(20000);
   http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
 
-  Serial.printf("[OTA] GET %s\n", url.c_str());
-  if (!http.begin(client, url)) return false;
+  Serial.printf("[OTA] GET %s\n", MANIFEST_URL);
+  if (!http.begin(clientFor(MANIFEST_URL, plainClient, secureClient), MANIFEST_URL)) return false;
 
   int code = http.GET();
-  MenuSystem::otaPulse(millis());
   if (code != HTTP_CODE_OK) {
     Serial.printf("[OTA] HTTP %d\n", code);
     http.end();
     return false;
   }
 
-  body = http.getString();
+  JsonStringField fields[] = {
+    {"version", m_version, sizeof(m_version), false, false},
+    {"url", m_fwUrl, sizeof(m_fwUrl), false, false},
+    {"sha256", m_sha256, sizeof(m_sha256), false, false},
+    {"patch_from", m_patchFrom, sizeof(m_patchFrom), false, false},
+    {"patch_url", m_patchUrl, sizeof(m_patchUrl), false, false},
+    {"url_zlib", m_fwZlibUrl, sizeof(m_fwZlibUrl), false, false},
+  };
+  JsonStringPicker picker(fields, sizeof(fields) / sizeof(fields[0]));
+  ManifestSink sink(picker);
+  int written = http.writeToStream(&sink);
   http.end();
+  if (written < 0 || !picker.finish()) {
+    Serial.printf("[OTA] Manifest parse error (%d, at byte %u)\n", written,
+                  static_cast<unsigned>(picker.errorOffset()));
+    return false;
+  }
+  for (const JsonStringField& f : fields) {
+    if (f.tooLong) Serial.printf("[OTA] Manifest field '%s' too long -> ignored\n", f.key);
+  }
+
+  if (!m_version[0] || !m_fwUrl[0] || !m_sha256[0]) {
+    Serial.println("[OTA] Manifest missing fields");
+    return false;
+  }
+
+  Serial.printf("[OTA] Manifest version=%s\n", m_version);
   return true;
 }
 
-static bool fetchManifest() {
-  String body;
-  if (!httpsGet(MANIFEST_URL, body)) return false;
+#ifdef BUBU_FR_UPLOAD_URL
+static void uploadCrashReport() {
+  if (!FlightRecorder::hasCrashReport()) return;
+  char* report = static_cast<char*>(heap_caps_malloc(FR_REPORT_MAX, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+  if (!report) return;
+  size_t len = FlightRecorder::formatCrashReport(report, FR_REPORT_MAX);
 
-  m_version = jsonGetString(body, "version");
-  m_fwUrl   = jsonGetString(body, "url");
-  m_sha256  = jsonGetString(body, "sha256");
+  WiFiClient plainClient;
+  WiFiClientSecure secureClient;
+  secureClient.setInsecure();
+  HTTPClient http;
+  http.setTimeout(10000);
+  const char* url = BUBU_FR_UPLOAD_URL;
+  if (http.begin(clientFor(url, plainClient, secureClient), url)) {
+    http.addHeader("Content-Type", "text/plain");
+    http.addHeader("X-Bubu-Version", BUBU_FW_VERSION);
+    int code = http.POST(reinterpret_cast<uint8_t*>(report), len);
+    http.end();
+    Serial.printf("[OTA] Crash report (%u bytes) -> HTTP %d\n", static_cast<unsigned>(len), code);
+    if (code >= 200 && code < 300) FlightRecorder::clearCrashReport();
+  }
+  heap_caps_free(report);
+}
+#endif
 
-  if (m_version.isEmpty() || m_fwUrl.isEmpty() || m_sha256.isEmpty()) {
-    Serial.println("[OTA] Manifest missing fields");
+// ---- download + write + compute sha256 at the same time ----
+// Streamed payloads go through Update; raw images use installImage() below.
+enum class Payload : uint8_t {
+  DELTA,       // BDLT patch against the running image
+  ZLIB_IMAGE   // zlib-compressed app image
+};
+
+struct InstallCtx {
+  mbedtls_sha256_context sha;
+  DeltaApplier* delta;     // Payload::DELTA only
+  InflateStream* inflate;  // Payload::ZLIB_IMAGE only
+  uint32_t streamSize;     // Content-Length, 0 if unknown
+};
+
+// Hash and flash the same bytes (final image bytes, after any patching).
+static bool flashSink(const uint8_t* data, size_t len, void* ctx) {
+  InstallCtx* ic = static_cast<InstallCtx*>(ctx);
+  if (Update.write(const_cast<uint8_t*>(data), len) != len) {
+    Serial.println("[OTA] Update.write failed");
     return false;
   }
+  mbedtls_sha256_update_ret(&ic->sha, data, len);
+  // A patch states its target size; a zlib stream does not, so compressed
+  // progress stands in for it.
+  if (ic->delta) {
+    setProgress(Update.progress(), ic->delta->targetSize());
+  } else {
+    setProgress(ic->inflate->consumed(), ic->streamSize);
+  }
+  return true;
+}
+
+// Delta path: patch bytes in, image bytes out through flashSink.
+static bool deltaSink(const uint8_t* data, size_t len, void* ctx) {
+  return static_cast<InstallCtx*>(ctx)->delta->feed(data, len);
+}
+
+// Compressed path: zlib bytes in, image bytes out through flashSink.
+static bool inflateSink(const uint8_t* data, size_t len, void* ctx) {
+  return static_cast<InstallCtx*>(ctx)->inflate->feed(data, len);
+}
+
+static bool readRunningImage(uint32_t offset, uint8_t* dst, size_t len, void* ctx) {
+  const esp_partition_t* part = static_cast<const esp_partition_t*>(ctx);
+  return esp_partition_read(part, offset, dst, len) == ESP_OK;
+}
 
-  Serial.printf("[OTA] Manifest version=%s\n", m_version.c_str());
+// The patch's base must be the running image: same size prefix, same hash.
+static bool checkRunningImage(uint32_t sourceSize, const uint8_t* sha256,
+                              uint8_t* scratch, size_t scratchLen, void* ctx) {
+  const esp_partition_t* part = static_cast<const esp_partition_t*>(ctx);
+  if (sourceSize > part->size) {
+    Serial.printf("[OTA] Delta source %u bytes > running partition %u\n",
+                  static_cast<unsigned>(sourceSize), static_cast<unsigned>(part->size));
+    return false;
+  }
+  mbedtls_sha256_context sha;
+  mbedtls_sha256_init(&sha);
+  mbedtls_sha256_starts_ret(&sha, 0);
+  bool ok = true;
+  for (uint32_t off = 0; ok && off < sourceSize; ) {
+    size_t n = sourceSize - off < scratchLen ? sourceSize - off : scratchLen;
+    ok = esp_partition_read(part, off, scratch, n) == ESP_OK;
+    if (ok) mbedtls_sha256_update_ret(&sha, scratch, n);
+    off += static_cast<uint32_t>(n);
+  }
+  uint8_t hash[32];
+  mbedtls_sha256_finish_ret(&sha, hash);
+  mbedtls_sha256_free(&sha);
+  if (!ok || memcmp(hash, sha256, sizeof(hash)) != 0) {
+    Serial.println("[OTA] Delta was built for another base image");
+    return false;
+  }
   return true;
 }
 
-// ---- download + write + compute sha256 at the same time ----
-static bool installFirmware() {
-  WiFiClientSecure client;
-  client.setInsecure();
+static const char* payloadToStr(Payload p) {
+  switch (p) {
+    case Payload::DELTA: return "delta";
+    case Payload::ZLIB_IMAGE: return "zlib";
+    default: return "?";
+  }
+}
+
+static void logPipelineStats(OtaPipeline::Result res, const OtaPipeline::Stats& st) {
+  uint32_t kbPerSec = st.elapsedMs ? (st.bytes / st.elapsedMs) : 0;  // bytes/ms == KB/s
+  Serial.printf("[OTA] Pipeline %s: %u bytes in %u ms (%u KB/s), %u chunks, max queued %u\n",
+                OtaPipeline::resultToStr(res), static_cast<unsigned>(st.bytes),
+                static_cast<unsigned>(st.elapsedMs), static_cast<unsigned>(kbPerSec),
+                static_cast<unsigned>(st.chunks), static_cast<unsigned>(st.maxQueued));
+  Serial.printf("[OTA] Stalls: reader %u ms (flash bound), writer idle %u ms (network bound), writer busy %u ms\n",
+                static_cast<unsigned>(st.readerStallMs), static_cast<unsigned>(st.writerIdleMs),
+                static_cast<unsigned>(st.writerBusyMs));
+}
+
+// Finish the hash and compare it with the manifest.
+static bool shaMatches(mbedtls_sha256_context* sha) {
+  uint8_t hash[32];
+  mbedtls_sha256_finish_ret(sha, hash);
+  mbedtls_sha256_free(sha);
+
+  char hex[65];
+  for (int i = 0; i < 32; i++) sprintf(hex + i*2, "%02x", hash[i]);
+  hex[64] = 0;
+
+  Serial.printf("[OTA] SHA256 computed: %s\n", hex);
+  Serial.printf("[OTA] SHA256 expected: %s\n", m_sha256);
+  return strcasecmp(m_sha256, hex) == 0;
+}
+
+static bool installFirmware(const char* url, Payload payload) {
+  const bool isDelta = (payload == Payload::DELTA);
+  WiFiClient plainClient;
+  WiFiClientSecure secureClient;
+  secureClient.setInsecure();
 
   HTTPClient http;
   http.setTimeout(30000);
   http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
 
-  Serial.printf("[OTA] Download %s\n", m_fwUrl.c_str());
-  if (!http.begin(client, m_fwUrl)) return false;
+  setPhase(BubuOTA::Phase::DOWNLOADING);
+  setProgress(0, 0);
+  Serial.printf("[OTA] Download %s (%s)\n", url, payloadToStr(payload));
+  if (!http.begin(clientFor(url, plainClient, secureClient), url)) return false;
 
   int code = http.GET();
   if (code != HTTP_CODE_OK) {
@@ -89,71 +304,90 @@ static bool installFirmware() {
   int contentLen = http.getSize();
   Serial.printf("[OTA] Content-Length=%d\n", contentLen);
 
-  if (!Update.begin(contentLen > 0 ? contentLen : UPDATE_SIZE_UNKNOWN)) {
+  // Update.begin erases the slot a resumable raw download may be parked in.
+  OtaResume::clear();
+  // Content-Length is the patch / compressed size, not the image size.
+  if (!Update.begin(UPDATE_SIZE_UNKNOWN)) {
     Serial.printf("[OTA] Update.begin error: %s\n", Update.errorString());
     http.end();
     return false;
   }
 
-  WiFiClient* stream = http.getStreamPtr();
-
-  // SHA256 init
-  mbedtls_sha256_context sha;
-  mbedtls_sha256_init(&sha);
-  mbedtls_sha256_starts_ret(&sha, 0);
-
-  uint8_t buf[1024];
-  int total = 0;
-  uint32_t lastData = millis();
-
-  while (http.connected()) {
-    MenuSystem::otaPulse(millis());
-    size_t avail = stream->available();
-
-    if (avail) {
-      int r = stream->readBytes(buf, static_cast<size_t>(min((size_t)avail, sizeof(buf))));
-      if (r > 0) {
-        // write to OTA partition
-        if (Update.write(buf, r) != static_cast<size_t>(r)) {
-          Serial.println("[OTA] Update.write failed");
-          mbedtls_sha256_free(&sha);
-          Update.abort();
-          http.end();
-          return false;
-        }
-        // hash the same bytes
-        mbedtls_sha256_update_ret(&sha, buf, r);
-        total += r;
-        lastData = millis();
-      }
-    } else {
-      // No data yet, wait a bit with timeout
-      if (millis() - lastData > 10000) {
-        Serial.println("[OTA] Timeout waiting for data");
-        break;
-      }
-      MenuSystem::otaPulse(millis());
-      delay(10);
+  InstallCtx ic;
+  ic.delta = nullptr;
+  ic.inflate = nullptr;
+  ic.streamSize = contentLen > 0 ? static_cast<uint32_t>(contentLen) : 0;
+  DeltaApplier delta;
+  InflateStream inflate;
+  uint8_t* scratch = nullptr;
+  if (isDelta) {
+    const esp_partition_t* running = esp_ota_get_running_partition();
+    scratch = static_cast<uint8_t*>(
+        heap_caps_malloc(DELTA_SCRATCH_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+    if (!running || !scratch) {
+      Serial.println("[OTA] Delta setup failed");
+      free(scratch);
+      Update.abort();
+      http.end();
+      return false;
+    }
+    delta.begin(readRunningImage, checkRunningImage, const_cast<esp_partition_t*>(running),
+                flashSink, &ic, scratch, DELTA_SCRATCH_SIZE);
+    ic.delta = &delta;
+  } else {
+    if (!inflate.begin(flashSink, &ic)) {
+      Serial.println("[OTA] Inflate setup failed");
+      Update.abort();
+      http.end();
+      return false;
     }
+    ic.inflate = &inflate;
   }
 
-  Serial.printf("[OTA] Total bytes written: %d\n", total);
+  OtaPipeline::ChunkSink sink = isDelta ? deltaSink : inflateSink;
 
-  http.end();
+  // SHA256 init
+  mbedtls_sha256_init(&ic.sha);
+  mbedtls_sha256_starts_ret(&ic.sha, 0);
+
+  OtaPipeline::Stats st;
+  OtaPipeline::Result res = OtaPipeline::run(*http.getStreamPtr(), contentLen,
+                                             sink, &ic, st);
+  uint32_t total = st.bytes;
+  if (isDelta) {
+    bool patchOk = (res == OtaPipeline::Result::OK) && delta.finish();
+    Serial.printf("[OTA] Delta %s: %u patch bytes -> %u/%u image bytes (source %u)\n",
+                  DeltaApplier::statusToStr(delta.status()), static_cast<unsigned>(st.bytes),
+                  static_cast<unsigned>(delta.written()), static_cast<unsigned>(delta.targetSize()),
+                  static_cast<unsigned>(delta.sourceSize()));
+    free(scratch);
+    total = delta.written();
+    if (!patchOk && res == OtaPipeline::Result::OK) res = OtaPipeline::Result::SINK_FAILED;
+  } else {
+    bool streamOk = inflate.finish();
+    uint32_t ratioPct = inflate.produced() ? (inflate.consumed() * 100u / inflate.produced()) : 0;
+    Serial.printf("[OTA] Inflate %s: %u compressed -> %u image bytes (%u%%)\n",
+                  streamOk ? "OK" : "FAILED", static_cast<unsigned>(inflate.consumed()),
+                  static_cast<unsigned>(inflate.produced()), static_cast<unsigned>(ratioPct));
+    inflate.end();
+    total = inflate.produced();
+    if (!streamOk && res == OtaPipeline::Result::OK) res = OtaPipeline::Result::SINK_FAILED;
+  }
+  logPipelineStats(res, st);
 
-  // SHA256 finish
-  uint8_t hash[32];
-  mbedtls_sha256_finish_ret(&sha, hash);
-  mbedtls_sha256_free(&sha);
+  if (res != OtaPipeline::Result::OK) {
+    mbedtls_sha256_free(&ic.sha);
+    Update.abort();
+    http.end();
+    return false;
+  }
 
-  char hex[65];
-  for (int i = 0; i < 32; i++) sprintf(hex + i*2, "%02x", hash[i]);
-  hex[64] = 0;
+  Serial.printf("[OTA] Total bytes written: %u\n", static_cast<unsigned>(total));
 
-  Serial.printf("[OTA] SHA256 computed: %s\n", hex);
-  Serial.printf("[OTA] SHA256 expected: %s\n", m_sha256.c_str());
+  http.end();
 
-  if (!m_sha256.equalsIgnoreCase(hex)) {
+  setPhase(BubuOTA::Phase::VERIFYING);
+  if (!shaMatches(&ic.sha)) {
     Serial.println("[OTA] SHA256 MISMATCH -> abort");
     Update.abort();
     return false;
@@ -164,57 +398,389 @@ static bool installFirmware() {
     return false;
   }
 
+  setPhase(BubuOTA::Phase::REBOOTING);
   Serial.println("[OTA] Update OK -> reboot");
+  Logger::flush();  // deferred module logs still queued
   delay(200);
   ESP.restart();
   return true;
 }
 
-namespace BubuOTA {
+// ---- resumable raw image: direct partition writes + NVS checkpoints ----
+struct ImageCtx {
+  OtaResume::Checkpoint cp;  // cp.sha is the live hash of everything flashed
+  OtaResume::PartitionWriter writer;
+  bool checkpointFailed;
+};
+
+// Hash and flash, splitting at checkpoint boundaries so every saved offset
+// is sector aligned and matches the saved hash state exactly.
+static bool imageSink(const uint8_t* data, size_t len, void* ctx) {
+  ImageCtx* ic = static_cast<ImageCtx*>(ctx);
+  if (ic->writer.offset() == 0 && len > 0 && data[0] != ESP_IMAGE_HEADER_MAGIC) {
+    Serial.printf("[OTA] Bad image magic 0x%02x\n", data[0]);
+    return false;
+  }
+  while (len > 0) {
+    uint32_t toMark = OtaResume::CHECKPOINT_INTERVAL -
+                      (ic->writer.offset() % OtaResume::CHECKPOINT_INTERVAL);
+    size_t n = len < toMark ? len : toMark;
+    if (!ic->writer.write(data, n)) {
+      Serial.println("[OTA] Partition write failed");
+      return false;
+    }
+    mbedtls_sha256_update_ret(&ic->cp.sha, data, n);
+    data += n;
+    len -= n;
+    setProgress(ic->writer.offset(), ic->cp.imageSize);
+    if (ic->writer.offset() % OtaResume::CHECKPOINT_INTERVAL == 0) {
+      ic->cp.offset = ic->writer.offset();
+      if (!OtaResume::save(m_sha256, ic->writer.partition(), ic->cp) && !ic->checkpointFailed) {
+        Serial.println("[OTA] Checkpoint save failed (download continues)");
+        ic->checkpointFailed = true;
+      }
+    }
+  }
+  return true;
+}
 
-void begin() { ran = false; }
+static void restartImage(ImageCtx& ic) {
+  ic.cp.offset = 0;
+  ic.cp.imageSize = 0;
+  mbedtls_sha256_free(&ic.cp.sha);
+  mbedtls_sha256_init(&ic.cp.sha);
+  mbedtls_sha256_starts_ret(&ic.cp.sha, 0);
+  ic.writer.begin(ic.writer.partition(), 0);
+  OtaResume::clear();
+}
 
-bool wasRollback() {
-  esp_ota_img_states_t st;
-  const esp_partition_t* p = esp_ota_get_running_partition();
-  if (esp_ota_get_state_partition(p, &st) == ESP_OK) {
-    return st == ESP_OTA_IMG_INVALID;
+// "bytes <first>-<last>/<total>" -> first and total (total 0 when "*").
+static bool parseContentRange(const String& v, uint32_t& first, uint32_t& total) {
+  if (!v.startsWith("bytes ")) return false;
+  int dash = v.indexOf('-');
+  int slash = v.indexOf('/');
+  if (dash < 0 || slash < dash) return false;
+  first = strtoul(v.c_str() + 6, nullptr, 10);
+  total = (v[slash + 1] == '*') ? 0 : strtoul(v.c_str() + slash + 1, nullptr, 10);
+  return true;
+}
+
+enum class Fetch : uint8_t { DONE, RETRY, FAILED };
+
+// One connection: request the rest of the image from the current offset.
+static Fetch fetchImage(const char* url, ImageCtx& ic) {
+  WiFiClient plainClient;
+  WiFiClientSecure secureClient;
+  secureClient.setInsecure();
+
+  HTTPClient http;
+  http.setTimeout(30000);
+  http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
+  const char* headerKeys[] = {"Content-Range"};
+  http.collectHeaders(headerKeys, 1);
+
+  uint32_t from = ic.writer.offset();
+  Serial.printf("[OTA] Download %s from %u\n", url, static_cast<unsigned>(from));
+  if (!http.begin(clientFor(url, plainClient, secureClient), url)) return Fetch::RETRY;
+  if (from > 0) http.addHeader("Range", String("bytes=") + from + "-");
+
+  int code = http.GET();
+  if (code <= 0 || code >= 500) {
+    Serial.printf("[OTA] Firmware HTTP %d\n", code);
+    http.end();
+    return Fetch::RETRY;
+  }
+
+  uint32_t total = 0;
+  if (code == HTTP_CODE_PARTIAL_CONTENT && from > 0) {
+    uint32_t first = 0;
+    if (!parseContentRange(http.header("Content-Range"), first, total) || first != from) {
+      Serial.printf("[OTA] Bad Content-Range '%s'\n", http.header("Content-Range").c_str());
+      http.end();
+      restartImage(ic);
+      return Fetch::RETRY;
+    }
+  } else if (code == HTTP_CODE_OK) {
+    if (from > 0) {
+      Serial.println("[OTA] Server ignored Range -> restart from 0");
+      restartImage(ic);
+    }
+    total = http.getSize() > 0 ? static_cast<uint32_t>(http.getSize()) : 0;
+  } else if (code == HTTP_CODE_RANGE_NOT_SATISFIABLE) {
+    Serial.println("[OTA] Range not satisfiable -> restart from 0");
+    http.end();
+    restartImage(ic);
+    return Fetch::RETRY;
+  } else {
+    Serial.printf("[OTA] Firmware HTTP %d\n", code);
+    http.end();
+    return Fetch::FAILED;
+  }
+
+  if (total > 0) {
+    if (ic.cp.imageSize > 0 && ic.cp.imageSize != total) {
+      Serial.println("[OTA] Image size changed -> restart from 0");
+      http.end();
+      restartImage(ic);
+      return Fetch::RETRY;
+    }
+    if (total > ic.writer.partition()->size) {
+      Serial.printf("[OTA] Image %u bytes > slot %u\n", static_cast<unsigned>(total),
+                    static_cast<unsigned>(ic.writer.partition()->size));
+      http.end();
+      return Fetch::FAILED;
+    }
+    ic.cp.imageSize = total;
+  }
+
+  int contentLen = http.getSize();
+  Serial.printf("[OTA] HTTP %d, Content-Length=%d, image %u bytes\n", code, contentLen,
+                static_cast<unsigned>(total));
+
+  OtaPipeline::Stats st;
+  OtaPipeline::Result res = OtaPipeline::run(*http.getStreamPtr(), contentLen,
+                                             imageSink, &ic, st);
+  logPipelineStats(res, st);
+  http.end();
+
+  switch (res) {
+    case OtaPipeline::Result::OK:
+      if (ic.cp.imageSize > 0 && ic.writer.offset() != ic.cp.imageSize) return Fetch::RETRY;
+      return Fetch::DONE;
+    case OtaPipeline::Result::STREAM_TIMEOUT:
+    case OtaPipeline::Result::STREAM_SHORT:
+      return Fetch::RETRY;
+    default:
+      return Fetch::FAILED;
   }
-  return false;
 }
 
-void runOnce() {
-  if (ran) return;
-  ran = true;
+static bool waitForWiFi(uint32_t timeoutMs) {
+  uint32_t start = millis();
+  while (WiFi.status() != WL_CONNECTED) {
+    if (millis() - start > timeoutMs) return false;
+    delay(50);
+  }
+  return true;
+}
+
+// Raw image install that survives dropped connections and reboots.
+static bool installImage(const char* url) {
+  const esp_partition_t* part = esp_ota_get_next_update_partition(nullptr);
+  if (!part) {
+    Serial.println("[OTA] No OTA slot");
+    return false;
+  }
+
+  setPhase(BubuOTA::Phase::DOWNLOADING);
+  ImageCtx ic;
+  ic.checkpointFailed = false;
+  mbedtls_sha256_init(&ic.cp.sha);
+  if (OtaResume::load(m_sha256, part, ic.cp)) {
+    Serial.printf("[OTA] Resuming at %u/%u\n", static_cast<unsigned>(ic.cp.offset),
+                  static_cast<unsigned>(ic.cp.imageSize));
+    setProgress(ic.cp.offset, ic.cp.imageSize);
+    ic.writer.begin(part, ic.cp.offset);
+  } else {
+    ic.writer.begin(part, 0);
+    restartImage(ic);
+    setProgress(0, 0);
+  }
+
+  Fetch f = Fetch::RETRY;
+  for (uint8_t attempt = 0; attempt < RESUME_ATTEMPTS && f == Fetch::RETRY; ++attempt) {
+    if (attempt > 0) {
+      Serial.printf("[OTA] Retry %u/%u at %u bytes\n", static_cast<unsigned>(attempt),
+                    static_cast<unsigned>(RESUME_ATTEMPTS - 1),
+                    static_cast<unsigned>(ic.writer.offset()));
+      delay(RETRY_BACKOFF_MS * attempt);
+      if (!waitForWiFi(RECONNECT_WAIT_MS)) {
+        Serial.println("[OTA] WiFi did not come back");
+        break;
+      }
+    }
+    f = fetchImage(url, ic);
+  }
+
+  if (f != Fetch::DONE) {
+    // Keep the checkpoint: the next run resumes from it.
+    Serial.printf("[OTA] Download incomplete at %u bytes\n", static_cast<unsigned>(ic.writer.offset()));
+    mbedtls_sha256_free(&ic.cp.sha);
+    if (f == Fetch::FAILED) OtaResume::clear();
+    return false;
+  }
 
+  Serial.printf("[OTA] Total bytes written: %u\n", static_cast<unsigned>(ic.writer.offset()));
+  OtaResume::clear();
+
+  setPhase(BubuOTA::Phase::VERIFYING);
+  if (!shaMatches(&ic.cp.sha)) {
+    Serial.println("[OTA] SHA256 MISMATCH -> abort");
+    return false;
+  }
+
+  // Validates the image header/segments before switching slots.
+  esp_err_t err = esp_ota_set_boot_partition(part);
+  if (err != ESP_OK) {
+    Serial.printf("[OTA] set_boot_partition error: %s\n", esp_err_to_name(err));
+    return false;
+  }
+
+  setPhase(BubuOTA::Phase::REBOOTING);
+  Serial.println("[OTA] Update OK -> reboot");
+  Logger::flush();  // deferred module logs still queued
+  delay(200);
+  ESP.restart();
+  return true;
+}
+
+// Manifest check + install; runs on the OTA task.
+static bool checkAndInstall() {
   if (WiFi.status() != WL_CONNECTED) {
     Serial.println("[OTA] WiFi not connected -> skip");
-    return;
+    return false;
   }
+#ifdef BUBU_FR_UPLOAD_URL
+  uploadCrashReport();
+#endif
 
   if (!fetchManifest()) {
     Serial.println("[OTA] Manifest fetch failed -> skip");
-    return;
+    return false;
   }
 
   // Only update if remote > local
-  if (semverCompare(m_version, String(BUBU_FW_VERSION)) <= 0) {
+  if (semverCompare(m_version, BUBU_FW_VERSION) <= 0) {
     Serial.println("[OTA] No update needed");
-    return;
+    setPhase(BubuOTA::Phase::UP_TO_DATE);
+    return true;
   }
 
   Serial.println("[OTA] Update available -> installing...");
-  if (!installFirmware()) {
+  // A half-downloaded raw image for this release wins over starting a new stream.
+  OtaResume::Checkpoint cp;
+  if (OtaResume::load(m_sha256, esp_ota_get_next_update_partition(nullptr), cp)) {
+    if (installImage(m_fwUrl)) return true;
     Serial.println("[OTA] Install failed");
+    return false;
+  }
+  // Prefer a delta against the running image; any failure falls back to the full image.
+  if (m_patchUrl[0] && strcmp(m_patchFrom, BUBU_FW_VERSION) == 0) {
+    if (installFirmware(m_patchUrl, Payload::DELTA)) return true;
+    Serial.println("[OTA] Delta install failed -> full image");
+  }
+  if (m_fwZlibUrl[0]) {
+    if (installFirmware(m_fwZlibUrl, Payload::ZLIB_IMAGE)) return true;
+    Serial.println("[OTA] Compressed install failed -> raw image");
   }
+  if (installImage(m_fwUrl)) return true;
+  Serial.println("[OTA] Install failed");
+  return false;
+}
+
+static void otaTask(void*) {
+  bool ok = checkAndInstall();
+  BubuOTA::Status st = BubuOTA::status();
+  if (!ok) st.phase = BubuOTA::Phase::FAILED;
+  Serial.printf("[OTA] Finished %s in %u ms, longest loop stall %u ms\n",
+                BubuOTA::phaseToStr(st.phase), static_cast<unsigned>(millis() - st.startedMs),
+                static_cast<unsigned>(st.loopStallMaxMs));
+
+  portENTER_CRITICAL(&statusMux);
+  otaStatus.phase = st.phase;
+  otaStatus.busy = false;
+  portEXIT_CRITICAL(&statusMux);
+  FlightRecorder::record(FlightRecorder::Event::OTA, static_cast<uint8_t>(st.phase));
+  vTaskDelete(nullptr);
+}
+
+static bool startTask() {
+  portENTER_CRITICAL(&statusMux);
+  bool already = otaStatus.busy;
+  if (!already) {
+    otaStatus = BubuOTA::Status{};
+    otaStatus.phase = BubuOTA::Phase::CHECKING;
+    otaStatus.busy = true;
+    otaStatus.startedMs = millis();
+  }
+  portEXIT_CRITICAL(&statusMux);
+  if (already) return false;
+  FlightRecorder::record(FlightRecorder::Event::OTA, static_cast<uint8_t>(BubuOTA::Phase::CHECKING));
+
+  if (xTaskCreatePinnedToCore(otaTask, "ota", OTA_TASK_STACK, nullptr,
+                              OTA_TASK_PRIORITY, nullptr, OTA_TASK_CORE) != pdPASS) {
+    Serial.println("[OTA] Task create failed");
+    portENTER_CRITICAL(&statusMux);
+    otaStatus.phase = BubuOTA::Phase::FAILED;
+    otaStatus.busy = false;
+    portEXIT_CRITICAL(&statusMux);
+    FlightRecorder::record(FlightRecorder::Event::OTA, static_cast<uint8_t>(BubuOTA::Phase::FAILED));
+    return false;
+  }
+  return true;
+}
+
+namespace BubuOTA {
+
+void begin() { ran = false; }
+
+bool wasRollback() {
+  esp_ota_img_states_t st;
+  const esp_partition_t* p = esp_ota_get_running_partition();
+  if (esp_ota_get_state_partition(p, &st) == ESP_OK) {
+    return st == ESP_OTA_IMG_INVALID;
+  }
+  return false;
+}
+
+void runOnce() {
+  if (ran) return;
+  ran = true;
+  startTask();
 }
 
 void runManual() {
   // Manual trigger ignores previous runs
-  ran = false;
-  MenuSystem::otaSetActive(true);
-  runOnce();
-  MenuSystem::otaSetActive(false);
+  ran = true;
+  startTask();
+}
+
+bool isBusy() {
+  portENTER_CRITICAL(&statusMux);
+  bool busy = otaStatus.busy;
+  portEXIT_CRITICAL(&statusMux);
+  return busy;
+}
+
+Status status() {
+  portENTER_CRITICAL(&statusMux);
+  Status snapshot = otaStatus;
+  portEXIT_CRITICAL(&statusMux);
+  return snapshot;
+}
+
+const char* phaseToStr(Phase p) {
+  switch (p) {
+    case Phase::IDLE: return "IDLE";
+    case Phase::CHECKING: return "CHECKING";
+    case Phase::DOWNLOADING: return "DOWNLOADING";
+    case Phase::VERIFYING: return "VERIFYING";
+    case Phase::UP_TO_DATE: return "UP_TO_DATE";
+    case Phase::FAILED: return "FAILED";
+    case Phase::REBOOTING: return "REBOOTING";
+    default: return "?";
+  }
+}
+
+void noteLoopTick(uint32_t nowMs) {
+  static uint32_t lastTickMs = 0;
+  portENTER_CRITICAL(&statusMux);
+  if (otaStatus.busy && lastTickMs != 0) {
+    uint32_t gap = nowMs - lastTickMs;
+    if (gap > otaStatus.loopStallMaxMs) otaStatus.loopStallMaxMs = gap;
+  }
+  portEXIT_CRITICAL(&statusMux);
+  lastTickMs = nowMs;
 }
 
 } // namespace
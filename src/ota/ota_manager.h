@@ -2,8 +2,33 @@
 #include <Arduino.h>
 
 namespace BubuOTA {
+  enum class Phase : uint8_t {
+    IDLE,
+    CHECKING,     // fetching the manifest
+    DOWNLOADING,
+    VERIFYING,
+    UP_TO_DATE,
+    FAILED,
+    REBOOTING
+  };
+
+  // Snapshot of the background task's progress; safe to read from any task.
+  struct Status {
+    Phase phase;
+    bool busy;             // task running
+    uint32_t bytesDone;    // image bytes flashed
+    uint32_t bytesTotal;   // 0 if unknown
+    uint32_t startedMs;
+    uint32_t loopStallMaxMs;  // longest gap between loop() ticks while busy
+  };
+
   void begin();
-  void runOnce();   // blocking update, just like your old code
+  void runOnce();   // start the background check/install once per boot
   void runManual(); // manual trigger, can be called multiple times
+  bool isBusy();
+  Status status();
+  const char* phaseToStr(Phase p);
+  // Call once per loop() pass; feeds Status::loopStallMaxMs.
+  void noteLoopTick(uint32_t nowMs);
   bool wasRollback();
 }
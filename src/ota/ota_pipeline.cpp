@@ -0,0 +1,194 @@
+#include "ota_pipeline.h"
+
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+namespace {
+
+constexpr uint32_t STREAM_TIMEOUT_MS = 10000;
+constexpr uint32_t WRITER_STACK = 6144;
+constexpr UBaseType_t WRITER_PRIORITY = 2;  // above the OTA task so full chunks drain promptly
+constexpr BaseType_t WRITER_CORE = 0;       // keep flash work off the UI core (loopTask on 1)
+
+struct ChunkMsg {
+  uint8_t idx;
+  uint32_t len;  // 0 = end of stream
+};
+
+struct Shared {
+  uint8_t* chunks[OtaPipeline::CHUNK_COUNT];
+  QueueHandle_t freeQ;
+  QueueHandle_t fullQ;
+  SemaphoreHandle_t done;
+  OtaPipeline::ChunkSink sink;
+  void* sinkCtx;
+  volatile bool sinkFailed;
+  uint32_t bytes;
+  uint32_t idleMs;
+  uint32_t busyMs;
+};
+
+void writerTask(void* arg) {
+  Shared* s = static_cast<Shared*>(arg);
+  for (;;) {
+    ChunkMsg msg;
+    uint32_t waitStart = millis();
+    xQueueReceive(s->fullQ, &msg, portMAX_DELAY);
+    s->idleMs += millis() - waitStart;
+    if (msg.len == 0) break;
+
+    if (!s->sinkFailed) {
+      uint32_t t0 = millis();
+      if (s->sink(s->chunks[msg.idx], msg.len, s->sinkCtx)) {
+        s->bytes += msg.len;
+      } else {
+        s->sinkFailed = true;
+      }
+      s->busyMs += millis() - t0;
+    }
+    xQueueSend(s->freeQ, &msg.idx, portMAX_DELAY);
+  }
+  xSemaphoreGive(s->done);
+  vTaskDelete(nullptr);
+}
+
+uint8_t* allocChunk() {
+  void* p = heap_caps_malloc(OtaPipeline::CHUNK_SIZE, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (!p) p = malloc(OtaPipeline::CHUNK_SIZE);
+  return static_cast<uint8_t*>(p);
+}
+
+void release(Shared& s) {
+  for (size_t i = 0; i < OtaPipeline::CHUNK_COUNT; ++i) {
+    free(s.chunks[i]);
+    s.chunks[i] = nullptr;
+  }
+  if (s.freeQ) vQueueDelete(s.freeQ);
+  if (s.fullQ) vQueueDelete(s.fullQ);
+  if (s.done) vSemaphoreDelete(s.done);
+}
+
+}  // namespace
+
+namespace OtaPipeline {
+
+const char* resultToStr(Result r) {
+  switch (r) {
+    case Result::OK: return "OK";
+    case Result::NO_MEMORY: return "NO_MEMORY";
+    case Result::STREAM_TIMEOUT: return "STREAM_TIMEOUT";
+    case Result::STREAM_SHORT: return "STREAM_SHORT";
+    case Result::SINK_FAILED: return "SINK_FAILED";
+    default: return "?";
+  }
+}
+
+Result run(Client& stream, int contentLen, ChunkSink sink, void* ctx,
+           Stats& stats, TickHook onTick) {
+  stats = Stats{};
+
+  Shared s{};
+  s.sink = sink;
+  s.sinkCtx = ctx;
+  s.freeQ = xQueueCreate(CHUNK_COUNT, sizeof(uint8_t));
+  s.fullQ = xQueueCreate(CHUNK_COUNT + 1, sizeof(ChunkMsg));
+  s.done = xSemaphoreCreateBinary();
+  bool ok = s.freeQ && s.fullQ && s.done;
+  for (size_t i = 0; ok && i < CHUNK_COUNT; ++i) {
+    s.chunks[i] = allocChunk();
+    if (!s.chunks[i]) ok = false;
+    else {
+      uint8_t idx = static_cast<uint8_t>(i);
+      xQueueSend(s.freeQ, &idx, 0);
+    }
+  }
+  if (!ok || xTaskCreatePinnedToCore(writerTask, "ota_writer", WRITER_STACK, &s,
+                                     WRITER_PRIORITY, nullptr, WRITER_CORE) != pdPASS) {
+    release(s);
+    return Result::NO_MEMORY;
+  }
+
+  Result result = Result::OK;
+  uint32_t startMs = millis();
+  uint32_t lastData = startMs;
+  uint32_t received = 0;
+  bool eof = false;
+
+  while (!eof && !s.sinkFailed) {
+    uint8_t idx;
+    uint32_t waitStart = millis();
+    while (xQueueReceive(s.freeQ, &idx, pdMS_TO_TICKS(20)) != pdTRUE) {
+      if (onTick) onTick(millis());
+    }
+    stats.readerStallMs += millis() - waitStart;
+    lastData = millis();
+
+    // Fill the chunk completely unless the stream ends first.
+    uint8_t* buf = s.chunks[idx];
+    uint32_t fill = 0;
+    while (fill < CHUNK_SIZE) {
+      if (contentLen > 0 && received >= static_cast<uint32_t>(contentLen)) {
+        eof = true;
+        break;
+      }
+      int avail = stream.available();
+      if (avail > 0) {
+        size_t want = CHUNK_SIZE - fill;
+        if (static_cast<size_t>(avail) < want) want = static_cast<size_t>(avail);
+        int r = stream.read(buf + fill, want);
+        if (r > 0) {
+          fill += static_cast<uint32_t>(r);
+          received += static_cast<uint32_t>(r);
+          lastData = millis();
+        }
+        continue;
+      }
+      if (!stream.connected()) {
+        eof = true;
+        if (contentLen > 0 && received < static_cast<uint32_t>(contentLen)) {
+          result = Result::STREAM_SHORT;
+        }
+        break;
+      }
+      if (millis() - lastData > STREAM_TIMEOUT_MS) {
+        eof = true;
+        result = Result::STREAM_TIMEOUT;
+        break;
+      }
+      if (onTick) onTick(millis());
+      delay(1);
+    }
+
+    if (fill > 0) {
+      ChunkMsg msg{idx, fill};
+      xQueueSend(s.fullQ, &msg, portMAX_DELAY);
+      stats.chunks++;
+      uint8_t queued = static_cast<uint8_t>(uxQueueMessagesWaiting(s.fullQ));
+      if (queued > stats.maxQueued) stats.maxQueued = queued;
+    } else {
+      xQueueSend(s.freeQ, &idx, 0);
+    }
+    if (onTick) onTick(millis());
+  }
+
+  // End-of-stream sentinel, then wait for the writer to drain.
+  ChunkMsg end{0, 0};
+  xQueueSend(s.fullQ, &end, portMAX_DELAY);
+  while (xSemaphoreTake(s.done, pdMS_TO_TICKS(20)) != pdTRUE) {
+    if (onTick) onTick(millis());
+  }
+
+  stats.bytes = s.bytes;
+  stats.elapsedMs = millis() - startMs;
+  stats.writerIdleMs = s.idleMs;
+  stats.writerBusyMs = s.busyMs;
+  if (s.sinkFailed) result = Result::SINK_FAILED;
+
+  release(s);
+  return result;
+}
+
+}  // namespace OtaPipeline
@@ -0,0 +1,41 @@
+#pragma once
+#include <Arduino.h>
+#include <Client.h>
+
+// Producer/consumer download pipeline for OTA images.
+// The calling task reads the network stream into large PSRAM chunks while a
+// dedicated writer task hands full chunks to the sink (hash + flash write).
+// Back-pressure: the reader blocks when every chunk is waiting to be written.
+namespace OtaPipeline {
+
+  static constexpr size_t CHUNK_SIZE  = 16 * 1024;
+  static constexpr size_t CHUNK_COUNT = 4;
+
+  // Runs on the writer task. Return false to abort the download.
+  using ChunkSink = bool (*)(const uint8_t* data, size_t len, void* ctx);
+  // Optional hook called from the reader loop while it waits.
+  using TickHook = void (*)(uint32_t nowMs);
+
+  enum class Result : uint8_t {
+    OK,
+    NO_MEMORY,
+    STREAM_TIMEOUT,   // no data for STREAM_TIMEOUT_MS
+    STREAM_SHORT,     // connection closed before Content-Length bytes arrived
+    SINK_FAILED
+  };
+
+  struct Stats {
+    uint32_t bytes;          // bytes accepted by the sink
+    uint32_t elapsedMs;      // first read -> writer drained
+    uint32_t readerStallMs;  // reader waiting for a free chunk (flash bound)
+    uint32_t writerIdleMs;   // writer waiting for a full chunk (network bound)
+    uint32_t writerBusyMs;   // time spent inside the sink
+    uint16_t chunks;
+    uint8_t  maxQueued;      // peak number of chunks waiting for the writer
+  };
+
+  Result run(Client& stream, int contentLen, ChunkSink sink, void* ctx,
+             Stats& stats, TickHook onTick = nullptr);
+
+  const char* resultToStr(Result r);
+}
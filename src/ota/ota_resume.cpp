@@ -0,0 +1,82 @@
+#include "ota_resume.h"
+
+#include <Preferences.h>
+
+namespace {
+
+constexpr const char* NVS_NAMESPACE = "bubu-ota";
+constexpr uint8_t FORMAT = 1;
+constexpr uint32_t ERASE_AHEAD = 64 * 1024;  // erase in 64 KB steps (block erase)
+
+}  // namespace
+
+namespace OtaResume {
+
+bool load(const char* sha256Hex, const esp_partition_t* part, Checkpoint& cp) {
+  if (!part) return false;
+  Preferences prefs;
+  if (!prefs.begin(NVS_NAMESPACE, true)) return false;
+
+  char storedSha[65];
+  bool ok = prefs.getUChar("v", 0) == FORMAT &&
+            prefs.getString("sha", storedSha, sizeof(storedSha)) > 0 &&
+            strcasecmp(storedSha, sha256Hex) == 0 &&
+            prefs.getUInt("part", 0) == part->address &&
+            prefs.getBytesLength("ctx") == sizeof(cp.sha);
+  if (ok) {
+    cp.offset = prefs.getUInt("off", 0);
+    cp.imageSize = prefs.getUInt("size", 0);
+    // mbedtls_sha256_context holds no pointers, so its bytes round-trip as-is.
+    ok = prefs.getBytes("ctx", &cp.sha, sizeof(cp.sha)) == sizeof(cp.sha) &&
+         cp.offset > 0 && cp.offset % SECTOR_SIZE == 0 && cp.offset <= part->size;
+  }
+  prefs.end();
+  return ok;
+}
+
+bool save(const char* sha256Hex, const esp_partition_t* part, const Checkpoint& cp) {
+  Preferences prefs;
+  if (!prefs.begin(NVS_NAMESPACE, false)) return false;
+
+  // Invalidate first so a reset mid-save never leaves a mixed checkpoint.
+  bool ok = prefs.putUChar("v", 0) == 1;
+  ok = ok && prefs.putString("sha", sha256Hex) > 0;
+  ok = ok && prefs.putUInt("part", part->address) > 0;
+  ok = ok && prefs.putUInt("off", cp.offset) > 0;
+  ok = ok && prefs.putUInt("size", cp.imageSize) > 0;
+  ok = ok && prefs.putBytes("ctx", &cp.sha, sizeof(cp.sha)) == sizeof(cp.sha);
+  ok = ok && prefs.putUChar("v", FORMAT) == 1;
+  prefs.end();
+  return ok;
+}
+
+void clear() {
+  Preferences prefs;
+  if (!prefs.begin(NVS_NAMESPACE, false)) return;
+  prefs.clear();
+  prefs.end();
+}
+
+bool PartitionWriter::begin(const esp_partition_t* part, uint32_t offset) {
+  if (!part || offset % SECTOR_SIZE != 0 || offset > part->size) return false;
+  part_ = part;
+  offset_ = offset;
+  erasedTo_ = offset;
+  return true;
+}
+
+bool PartitionWriter::write(const uint8_t* data, size_t len) {
+  if (!part_ || len > part_->size - offset_) return false;
+  uint32_t end = offset_ + static_cast<uint32_t>(len);
+  if (end > erasedTo_) {
+    uint32_t eraseEnd = (end + ERASE_AHEAD - 1) & ~(ERASE_AHEAD - 1);
+    if (eraseEnd > part_->size) eraseEnd = part_->size;
+    if (esp_partition_erase_range(part_, erasedTo_, eraseEnd - erasedTo_) != ESP_OK) return false;
+    erasedTo_ = eraseEnd;
+  }
+  if (esp_partition_write(part_, offset_, data, len) != ESP_OK) return false;
+  offset_ = end;
+  return true;
+}
+
+}  // namespace OtaResume
@@ -0,0 +1,46 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <esp_partition.h>
+#include <mbedtls/sha256.h>
+
+// Checkpointed raw-image install.
+// The image is written straight into the next OTA partition and, every
+// CHECKPOINT_INTERVAL bytes, the offset and running SHA-256 state are saved
+// to NVS ("bubu-ota"). After a dropped connection or a reboot the download
+// continues from the checkpoint with an HTTP Range request.
+namespace OtaResume {
+
+  static constexpr uint32_t SECTOR_SIZE = 4096;
+  static constexpr uint32_t CHECKPOINT_INTERVAL = 64 * 1024;
+  static_assert(CHECKPOINT_INTERVAL % SECTOR_SIZE == 0, "checkpoints must be sector aligned");
+
+  struct Checkpoint {
+    uint32_t offset;     // image bytes flashed and hashed
+    uint32_t imageSize;  // full image size, 0 if the server did not say
+    mbedtls_sha256_context sha;
+  };
+
+  // True when NVS holds a checkpoint for this image (manifest sha256) that
+  // targets the given partition.
+  bool load(const char* sha256Hex, const esp_partition_t* part, Checkpoint& cp);
+  bool save(const char* sha256Hex, const esp_partition_t* part, const Checkpoint& cp);
+  void clear();
+
+  // Sequential writer for an app partition; sectors are erased just ahead of
+  // the write position, so bytes before the start offset are left untouched.
+  class PartitionWriter {
+   public:
+    // offset must be sector aligned.
+    bool begin(const esp_partition_t* part, uint32_t offset);
+    bool write(const uint8_t* data, size_t len);
+
+    const esp_partition_t* partition() const { return part_; }
+    uint32_t offset() const { return offset_; }
+
+   private:
+    const esp_partition_t* part_ = nullptr;
+    uint32_t offset_ = 0;
+    uint32_t erasedTo_ = 0;
+  };
+}
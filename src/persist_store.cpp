@@ -0,0 +1,199 @@
+#include "persist_store.h"
+#include "bubu_clock.h"
+
+#include <Preferences.h>
+#include <esp_system.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <string.h>
+#include "battery_system.h"
+#include "logger.h"
+DEFINE_MODULE_LOGGER(StoreLog)
+
+namespace {
+
+using PersistStore::Slot;
+using PersistStore::Stats;
+
+constexpr const char* NVS_NAMESPACE = "bubu-store";
+constexpr uint32_t HOUR_MS = 60UL * 60UL * 1000UL;
+
+// What each subsystem wrote before the store existed, for Stats::legacyKeys:
+// legacyKeys per save, or per legacyPeriodMs if it saved on a timer.
+struct SlotInfo {
+  const char* key;
+  uint8_t legacyKeys;
+  uint32_t legacyPeriodMs;
+};
+
+const SlotInfo SLOTS[] = {
+  {"level", 2, 0},                  // bubu-level: level, xp on every XP gain
+  {"care", 5, 10UL * 60UL * 1000UL},  // care_stats: has, h, m, e, c every 10 min
+  {"clock", 2, 0},                  // clock: epoch, msref on every resync
+  {"hatch", 1, 0},                  // bubu: hatched
+};
+static_assert(sizeof(SLOTS) / sizeof(SLOTS[0]) == static_cast<size_t>(Slot::COUNT), "one entry per Slot");
+
+// blob[0] is the owner's version byte, the data follows.
+struct Cache {
+  uint8_t blob[PersistStore::MAX_BLOB + 1];
+  uint8_t len;  // 0: nothing cached
+  bool loaded;
+  bool dirty;
+};
+
+Cache cache[static_cast<size_t>(Slot::COUNT)];
+SemaphoreHandle_t commitLock = nullptr;
+bool started = false;
+
+Stats totals = {};
+Stats hour = {};
+Stats prevHour = {};
+uint32_t hourStartMs = 0;
+uint32_t lastCommitMs = 0;
+uint32_t legacyTimerMs[static_cast<size_t>(Slot::COUNT)];
+bool lowBattery = false;
+
+void addStats(Stats& s, const Stats& d) {
+  s.saves += d.saves;
+  s.legacyKeys += d.legacyKeys;
+  s.nvsWrites += d.nvsWrites;
+  s.commits += d.commits;
+}
+
+void load(Slot slot) {
+  Cache& c = cache[static_cast<size_t>(slot)];
+  if (c.loaded) return;
+  c.loaded = true;
+  Preferences prefs;
+  if (!prefs.begin(NVS_NAMESPACE, true)) return;  // first boot: namespace not created yet
+  const char* key = SLOTS[static_cast<size_t>(slot)].key;
+  size_t len = prefs.getBytesLength(key);
+  if (len >= 2 && len <= sizeof(c.blob) && prefs.getBytes(key, c.blob, len) == len) c.len = len;
+  prefs.end();
+}
+
+bool anyDirty() {
+  for (const Cache& c : cache) {
+    if (c.dirty) return true;
+  }
+  return false;
+}
+
+// Returns false if the lock is busy (a commit is running on another task).
+bool commitDirty(TickType_t wait) {
+  if (!commitLock || xSemaphoreTake(commitLock, wait) != pdTRUE) return false;
+  if (anyDirty()) {
+    Preferences prefs;
+    if (prefs.begin(NVS_NAMESPACE, false)) {
+      Stats d = {};
+      d.commits = 1;
+      for (size_t i = 0; i < static_cast<size_t>(Slot::COUNT); ++i) {
+        Cache& c = cache[i];
+        if (!c.dirty) continue;
+        if (prefs.putBytes(SLOTS[i].key, c.blob, c.len) == c.len) {
+          c.dirty = false;
+          ++d.nvsWrites;
+        } else {
+          LOG_WARN(StoreLog, "[Store] Write of '%s' failed\n", SLOTS[i].key);
+        }
+      }
+      prefs.end();
+      addStats(totals, d);
+      addStats(hour, d);
+    } else {
+      LOG_WARN(StoreLog, "[Store] Cannot open NVS namespace %s\n", NVS_NAMESPACE);
+    }
+  }
+  xSemaphoreGive(commitLock);
+  return true;
+}
+
+void onShutdown() {
+  commitDirty(pdMS_TO_TICKS(100));
+}
+
+}  // namespace
+
+namespace PersistStore {
+
+void begin() {
+  if (started) return;
+  commitLock = xSemaphoreCreateMutex();
+  esp_register_shutdown_handler(onShutdown);
+  hourStartMs = lastCommitMs = BubuClock::nowMs();
+  for (uint32_t& t : legacyTimerMs) t = hourStartMs;
+  started = true;
+}
+
+void update(uint32_t nowMs) {
+  if (!started) return;
+  if (nowMs - hourStartMs >= HOUR_MS) {
+    prevHour = hour;
+    hour = Stats();
+    hourStartMs += HOUR_MS;
+    LOG_INFO(StoreLog, "[Store] Last hour: %lu saves, %lu NVS writes (%lu key writes before write-back)\n",
+                       static_cast<unsigned long>(prevHour.saves), static_cast<unsigned long>(prevHour.nvsWrites),
+                       static_cast<unsigned long>(prevHour.legacyKeys));
+  }
+
+  for (size_t i = 0; i < static_cast<size_t>(Slot::COUNT); ++i) {
+    if (!SLOTS[i].legacyPeriodMs || nowMs - legacyTimerMs[i] < SLOTS[i].legacyPeriodMs) continue;
+    legacyTimerMs[i] += SLOTS[i].legacyPeriodMs;
+    totals.legacyKeys += SLOTS[i].legacyKeys;
+    hour.legacyKeys += SLOTS[i].legacyKeys;
+  }
+
+  BatteryStatus bat = BatterySystem::getStatus();
+  bool low = bat.state == ChargingState::ON_BATTERY && bat.percent <= LOW_BATTERY_PCT;
+  if (low != lowBattery) {
+    lowBattery = low;
+    if (low) {
+      LOG_INFO(StoreLog, "[Store] Battery at %u%%, committing now\n", bat.percent);
+      lastCommitMs = nowMs - LOW_BATTERY_PERIOD_MS;  // commit below
+    }
+  }
+  uint32_t period = lowBattery ? LOW_BATTERY_PERIOD_MS : COMMIT_PERIOD_MS;
+  if (nowMs - lastCommitMs < period) return;
+  lastCommitMs = nowMs;
+  commitDirty(0);
+}
+
+bool read(Slot slot, uint8_t version, void* out, size_t size) {
+  if (slot >= Slot::COUNT || size > MAX_BLOB) return false;
+  load(slot);
+  const Cache& c = cache[static_cast<size_t>(slot)];
+  if (c.len != size + 1 || c.blob[0] != version) return false;
+  memcpy(out, c.blob + 1, size);
+  return true;
+}
+
+void write(Slot slot, uint8_t version, const void* data, size_t size) {
+  if (slot >= Slot::COUNT || size > MAX_BLOB) return;
+  load(slot);
+  Cache& c = cache[static_cast<size_t>(slot)];
+  if (c.len == size + 1 && c.blob[0] == version && memcmp(c.blob + 1, data, size) == 0) return;
+  c.blob[0] = version;
+  memcpy(c.blob + 1, data, size);
+  c.len = size + 1;
+  c.dirty = true;
+  Stats d = {};
+  d.saves = 1;
+  if (!SLOTS[static_cast<size_t>(slot)].legacyPeriodMs) d.legacyKeys = SLOTS[static_cast<size_t>(slot)].legacyKeys;
+  addStats(totals, d);
+  addStats(hour, d);
+}
+
+void commit() {
+  commitDirty(portMAX_DELAY);
+}
+
+Stats total() {
+  return totals;
+}
+
+Stats lastHour() {
+  return prevHour;
+}
+
+}  // namespace PersistStore
@@ -0,0 +1,136 @@
+#include "portal_proto.h"
+
+#include <string.h>
+#include "json/json_stream.h"
+
+namespace {
+
+constexpr uint32_t DNS_TTL_S = 60;
+constexpr size_t DNS_HEADER = 12;
+constexpr size_t DNS_ANSWER = 16;
+
+int hexNibble(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+enum class Field : uint8_t { MISSING, OK, TOO_LONG };  // MISSING includes empty
+
+// Raw value of key in "k=v&k=v" -> dst (httpd_query_key_value's contract,
+// without the IDF dependency).
+Field queryValue(const char* query, const char* key, char* dst, size_t cap) {
+  size_t keyLen = strlen(key);
+  for (const char* p = query; *p;) {
+    const char* end = strchr(p, '&');
+    if (!end) end = p + strlen(p);
+    if (static_cast<size_t>(end - p) > keyLen && strncmp(p, key, keyLen) == 0 && p[keyLen] == '=') {
+      const char* v = p + keyLen + 1;
+      size_t n = static_cast<size_t>(end - v);
+      if (n >= cap) return Field::TOO_LONG;
+      memcpy(dst, v, n);
+      dst[n] = '\0';
+      return n ? Field::OK : Field::MISSING;
+    }
+    p = *end ? end + 1 : end;
+  }
+  return Field::MISSING;
+}
+
+// application/x-www-form-urlencoded value -> dst, which is left empty
+// unless the result is OK.
+Field formValue(const char* body, const char* key, char* dst, size_t cap) {
+  dst[0] = '\0';
+  char enc[3 * sizeof(PortalServer::Credentials::pass) + 4];
+  Field f = queryValue(body, key, enc, sizeof(enc));
+  if (f != Field::OK) return f;
+  size_t n = 0;
+  for (const char* p = enc; *p; ++p) {
+    char c = *p;
+    if (c == '+') {
+      c = ' ';
+    } else if (c == '%' && hexNibble(p[1]) >= 0 && hexNibble(p[2]) >= 0) {
+      c = static_cast<char>(hexNibble(p[1]) << 4 | hexNibble(p[2]));
+      p += 2;
+    }
+    if (n + 1 >= cap) {
+      dst[0] = '\0';
+      return Field::TOO_LONG;
+    }
+    dst[n++] = c;
+  }
+  dst[n] = '\0';
+  return Field::OK;
+}
+
+static_assert(JsonStringPicker::fits(sizeof(PortalServer::Credentials::ssid)) &&
+                  JsonStringPicker::fits(sizeof(PortalServer::Credentials::pass)),
+              "credentials must fit the picker's scratch");
+
+}  // namespace
+
+namespace PortalProto {
+
+size_t buildDnsReply(uint8_t* buf, size_t len, uint32_t apAddr) {
+  if (len < DNS_HEADER || (buf[2] & 0x80)) return 0;  // short, or not a query
+  uint8_t opcode = (buf[2] >> 3) & 0x0F;
+  uint16_t qdcount = static_cast<uint16_t>(buf[4] << 8 | buf[5]);
+  if (opcode != 0 || qdcount != 1) {
+    buf[2] = static_cast<uint8_t>(0x80 | (buf[2] & 0x79));
+    buf[3] = 0x04;  // NOTIMP
+    memset(buf + 4, 0, 8);
+    return DNS_HEADER;
+  }
+
+  size_t pos = DNS_HEADER;
+  while (pos < len && buf[pos] != 0) {
+    if (buf[pos] & 0xC0) return 0;  // no compression in questions
+    pos += buf[pos] + 1;
+  }
+  if (pos + 5 > len) return 0;
+  pos += 1;
+  uint16_t qtype = static_cast<uint16_t>(buf[pos] << 8 | buf[pos + 1]);
+  uint16_t qclass = static_cast<uint16_t>(buf[pos + 2] << 8 | buf[pos + 3]);
+  pos += 4;
+  bool answer = (qtype == 1 || qtype == 255) && qclass == 1;  // A / ANY, IN
+  if (answer && pos + DNS_ANSWER > DNS_PACKET_MAX) return 0;
+
+  buf[2] = static_cast<uint8_t>(0x84 | (buf[2] & 0x01));  // QR, AA, keep RD
+  buf[3] = 0x80;                                          // RA, NOERROR
+  buf[6] = 0;
+  buf[7] = answer ? 1 : 0;
+  memset(buf + 8, 0, 4);  // drop authority/additional (EDNS)
+  if (!answer) return pos;
+
+  const uint8_t rr[DNS_ANSWER - 4] = {
+    0xC0, 0x0C,  // name: pointer to the question
+    0x00, 0x01, 0x00, 0x01,
+    static_cast<uint8_t>(DNS_TTL_S >> 24), static_cast<uint8_t>(DNS_TTL_S >> 16),
+    static_cast<uint8_t>(DNS_TTL_S >> 8), static_cast<uint8_t>(DNS_TTL_S),
+    0x00, 0x04,
+  };
+  memcpy(buf + pos, rr, sizeof(rr));
+  memcpy(buf + pos + sizeof(rr), &apAddr, 4);  // already network order
+  return pos + DNS_ANSWER;
+}
+
+bool parseCredentials(const char* body, size_t len, PortalServer::Credentials& c) {
+  c.ssid[0] = '\0';
+  c.pass[0] = '\0';
+  if (body[0] == '{') {
+    JsonStringField fields[] = {
+      {"ssid", c.ssid, sizeof(c.ssid), false, false},
+      {"pass", c.pass, sizeof(c.pass), false, false},
+    };
+    JsonStringPicker picker(fields, 2);
+    bool ok = picker.feed(body, len) && picker.finish();
+    return ok && c.ssid[0] && !fields[0].tooLong && !fields[1].tooLong;
+  }
+  // A typed SSID wins over the picked one; no pass means an open network.
+  Field ssid = formValue(body, "ssid_manual", c.ssid, sizeof(c.ssid));
+  if (ssid == Field::MISSING) ssid = formValue(body, "ssid", c.ssid, sizeof(c.ssid));
+  return ssid == Field::OK && formValue(body, "pass", c.pass, sizeof(c.pass)) != Field::TOO_LONG;
+}
+
+}  // namespace PortalProto
@@ -0,0 +1,21 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "portal_server.h"
+
+// The portal's wire parsing, kept free of ESP-IDF so it builds on the host
+// (tools/portal_proto_test runs it under ASan).
+namespace PortalProto {
+
+  static constexpr size_t DNS_PACKET_MAX = 512;
+
+  // Rewrites the DNS query in buf (DNS_PACKET_MAX bytes, len of them used)
+  // into its reply: every A query is answered with apAddr (network order).
+  // Returns the reply length, or 0 to drop the packet.
+  size_t buildDnsReply(uint8_t* buf, size_t len, uint32_t apAddr);
+
+  // /save body, NUL terminated at len: {"ssid":"..","pass":".."} (portal)
+  // or form fields ssid/ssid_manual/pass. False without an SSID or when a
+  // value does not fit.
+  bool parseCredentials(const char* body, size_t len, PortalServer::Credentials& c);
+}
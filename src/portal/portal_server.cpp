@@ -0,0 +1,185 @@
+#include "portal_server.h"
+
+#include <string.h>
+#include <esp_http_server.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <lwip/sockets.h>
+#include "generated/portal_html.h"
+#include "logger.h"
+#include "portal_proto.h"
+DEFINE_MODULE_LOGGER(PortalLog)
+
+namespace {
+
+constexpr BaseType_t PORTAL_CORE = 0;       // UI runs on core 1
+constexpr uint32_t HTTP_STACK = 6144;
+constexpr uint32_t DNS_STACK = 3072;
+constexpr UBaseType_t DNS_PRIORITY = 2;
+constexpr uint32_t DNS_POLL_MS = 200;       // recv timeout, bounds stop() latency
+constexpr size_t SAVE_BODY_MAX = 512;
+constexpr uint8_t SAVE_RECV_RETRIES = 3;
+
+httpd_handle_t server = nullptr;
+QueueHandle_t credQ = nullptr;  // depth 1, newest submission wins
+SemaphoreHandle_t dnsDone = nullptr;
+volatile bool dnsStopRequested = false;
+bool dnsRunning = false;
+uint32_t apAddr = 0;
+char apUrl[24];                 // "http://a.b.c.d/"
+const char* scanBody = nullptr;
+size_t scanBodyLen = 0;
+
+// ---- HTTP ----
+
+// Pre-gzipped page from portal.html (tools/embed_portal.py). no-cache makes
+// the browser revalidate, which the ETag turns into a body-less 304.
+esp_err_t handleRoot(httpd_req_t* req) {
+  httpd_resp_set_hdr(req, "ETag", PortalAsset::ETAG);
+  httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+  char inm[24];
+  if (httpd_req_get_hdr_value_str(req, "If-None-Match", inm, sizeof(inm)) == ESP_OK &&
+      strcmp(inm, PortalAsset::ETAG) == 0) {
+    httpd_resp_set_status(req, "304 Not Modified");
+    return httpd_resp_send(req, nullptr, 0);
+  }
+  httpd_resp_set_type(req, "text/html");
+  httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+  return httpd_resp_send(req, reinterpret_cast<const char*>(PortalAsset::GZ), PortalAsset::GZ_LEN);
+}
+
+esp_err_t handleScan(httpd_req_t* req) {
+  httpd_resp_set_type(req, "application/json");
+  return httpd_resp_send(req, scanBody, scanBodyLen);
+}
+
+// Every unknown URL, including the OS captive-portal probes, lands on the page.
+esp_err_t handleCaptive(httpd_req_t* req, httpd_err_code_t) {
+  httpd_resp_set_status(req, "302 Found");
+  httpd_resp_set_hdr(req, "Location", apUrl);
+  httpd_resp_set_type(req, "text/plain");
+  return httpd_resp_sendstr(req, "Redirecting to setup...");
+}
+
+esp_err_t handleSave(httpd_req_t* req) {
+  if (req->content_len == 0 || req->content_len > SAVE_BODY_MAX) {
+    return httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "SSID required");
+  }
+  char body[SAVE_BODY_MAX + 1];
+  size_t got = 0;
+  uint8_t timeouts = 0;
+  while (got < req->content_len) {
+    int r = httpd_req_recv(req, body + got, req->content_len - got);
+    if (r == HTTPD_SOCK_ERR_TIMEOUT && ++timeouts < SAVE_RECV_RETRIES) continue;
+    if (r <= 0) return ESP_FAIL;  // closes the socket
+    got += r;
+  }
+  body[got] = '\0';
+
+  PortalServer::Credentials c;
+  if (!PortalProto::parseCredentials(body, got, c)) {
+    return httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "SSID required");
+  }
+  httpd_resp_set_type(req, "text/plain");
+  esp_err_t err = httpd_resp_sendstr(req, "Connecting...");
+  // Reply first: the loop tears the AP down as soon as it sees this.
+  xQueueOverwrite(credQ, &c);
+  return err;
+}
+
+const httpd_uri_t ROUTES[] = {
+  {"/", HTTP_GET, handleRoot, nullptr},
+  {"/scan", HTTP_GET, handleScan, nullptr},
+  {"/save", HTTP_POST, handleSave, nullptr},
+};
+
+// ---- DNS: answer every A query with the AP address ----
+
+void dnsTask(void*) {
+  int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(53);
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  timeval tv = {0, static_cast<long>(DNS_POLL_MS * 1000)};
+  if (sock < 0 || bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+      setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) != 0) {
+    LOG_ERROR(PortalLog, "Portal: DNS socket setup failed\n");
+    dnsStopRequested = true;
+  }
+
+  uint8_t buf[PortalProto::DNS_PACKET_MAX];
+  while (!dnsStopRequested) {
+    sockaddr_in from;
+    socklen_t fromLen = sizeof(from);
+    int n = recvfrom(sock, buf, sizeof(buf), 0, reinterpret_cast<sockaddr*>(&from), &fromLen);
+    if (n <= 0) continue;
+    size_t out = PortalProto::buildDnsReply(buf, static_cast<size_t>(n), apAddr);
+    if (out) sendto(sock, buf, out, 0, reinterpret_cast<sockaddr*>(&from), fromLen);
+  }
+  if (sock >= 0) close(sock);
+  xSemaphoreGive(dnsDone);
+  vTaskDelete(nullptr);
+}
+
+}  // namespace
+
+namespace PortalServer {
+
+bool start(uint32_t apIp, const char* scanJson, size_t scanJsonLen) {
+  if (server) return true;
+  if (!credQ) credQ = xQueueCreate(1, sizeof(Credentials));
+  if (!dnsDone) dnsDone = xSemaphoreCreateBinary();
+  if (!credQ || !dnsDone) return false;
+  xQueueReset(credQ);
+
+  apAddr = apIp;
+  const uint8_t* ip = reinterpret_cast<const uint8_t*>(&apAddr);
+  snprintf(apUrl, sizeof(apUrl), "http://%u.%u.%u.%u/", ip[0], ip[1], ip[2], ip[3]);
+  scanBody = scanJson;
+  scanBodyLen = scanJsonLen;
+
+  httpd_config_t cfg = HTTPD_DEFAULT_CONFIG();
+  cfg.core_id = PORTAL_CORE;
+  cfg.stack_size = HTTP_STACK;
+  cfg.max_open_sockets = MAX_CONNECTIONS;
+  cfg.lru_purge_enable = true;  // a new client evicts the oldest idle socket
+  cfg.max_uri_handlers = sizeof(ROUTES) / sizeof(ROUTES[0]);
+  if (httpd_start(&server, &cfg) != ESP_OK) {
+    LOG_ERROR(PortalLog, "Portal: httpd_start failed\n");
+    server = nullptr;
+    return false;
+  }
+  for (const httpd_uri_t& r : ROUTES) httpd_register_uri_handler(server, &r);
+  httpd_register_err_handler(server, HTTPD_404_NOT_FOUND, handleCaptive);
+
+  dnsStopRequested = false;
+  dnsRunning = xTaskCreatePinnedToCore(dnsTask, "portal_dns", DNS_STACK, nullptr, DNS_PRIORITY,
+                                       nullptr, PORTAL_CORE) == pdPASS;
+  if (!dnsRunning) LOG_ERROR(PortalLog, "Portal: DNS task start failed\n");
+  return true;
+}
+
+void stop() {
+  if (dnsRunning) {
+    dnsStopRequested = true;
+    xSemaphoreTake(dnsDone, portMAX_DELAY);
+    dnsRunning = false;
+  }
+  if (server) {
+    httpd_stop(server);
+    server = nullptr;
+  }
+}
+
+bool running() {
+  return server != nullptr;
+}
+
+bool takeCredentials(Credentials& out) {
+  return credQ && xQueueReceive(credQ, &out, 0) == pdTRUE;
+}
+
+}  // namespace PortalServer
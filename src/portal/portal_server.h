@@ -0,0 +1,27 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Captive portal on ESP-IDF's esp_http_server plus a small DNS responder.
+// Both run on their own tasks (core 0), so page loads never wait for the UI
+// loop and the UI never waits for a request. Handlers touch no Wi-Fi state:
+// submitted credentials are queued and picked up by wifiUpdate().
+namespace PortalServer {
+
+  static constexpr uint8_t MAX_CONNECTIONS = 4;  // open sockets; oldest idle is purged
+
+  struct Credentials {
+    char ssid[33];  // 802.11 SSID max 32 bytes
+    char pass[65];  // WPA2 passphrase max 63 chars / 64 hex
+  };
+
+  // apIp is the soft-AP address in network byte order (IPAddress's uint32_t).
+  // scanJson is served as /scan and must stay valid until stop().
+  bool start(uint32_t apIp, const char* scanJson, size_t scanJsonLen);
+  // Blocks until both tasks are gone. Not callable from a handler.
+  void stop();
+  bool running();
+
+  // Latest credentials posted to /save, if any (non-blocking).
+  bool takeCredentials(Credentials& out);
+}
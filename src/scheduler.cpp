@@ -0,0 +1,108 @@
+#include "scheduler.h"
+#include "bubu_clock.h"
+#include "logger.h"
+DEFINE_MODULE_LOGGER(SchedLog)
+
+namespace Scheduler {
+
+namespace {
+
+struct Task {
+  TaskFn fn;
+  uint32_t nextMs;
+  TaskStats stats;
+};
+
+Task tasks[MAX_TASKS];
+uint8_t count = 0;
+
+bool due(uint32_t nowMs, uint32_t atMs) {
+  return static_cast<int32_t>(nowMs - atMs) >= 0;
+}
+
+}  // namespace
+
+TaskId add(const char* name, TaskFn fn, uint32_t periodMs, uint32_t budgetUs, uint32_t firstDelayMs) {
+  if (count >= MAX_TASKS || !fn) {
+    LOG_ERROR(SchedLog, "[Sched] Cannot add task %s\n", name);
+    return -1;
+  }
+  Task& t = tasks[count];
+  t.fn = fn;
+  t.nextMs = BubuClock::nowMs() + firstDelayMs;
+  t.stats = TaskStats();
+  t.stats.name = name;
+  t.stats.periodMs = periodMs;
+  t.stats.budgetUs = budgetUs;
+  return static_cast<TaskId>(count++);
+}
+
+void setPeriod(TaskId id, uint32_t periodMs) {
+  if (id < 0 || id >= count) return;
+  tasks[id].stats.periodMs = periodMs;
+}
+
+void runSoon(TaskId id) {
+  if (id < 0 || id >= count) return;
+  tasks[id].nextMs = BubuClock::nowMs();
+}
+
+uint32_t runDue(uint32_t nowMs) {
+  for (uint8_t i = 0; i < count; ++i) {
+    Task& t = tasks[i];
+    if (!due(nowMs, t.nextMs)) continue;
+    uint32_t runMs = BubuClock::nowMs();
+    uint32_t startUs = micros();
+    t.fn(runMs);
+    uint32_t us = micros() - startUs;
+
+    TaskStats& s = t.stats;
+    ++s.runs;
+    s.totalUs += us;
+    if (us > s.maxUs) s.maxUs = us;
+    if (s.budgetUs && us > s.budgetUs) ++s.overruns;
+    if (s.periodMs == 0) {
+      t.nextMs = runMs;  // every pass
+      continue;
+    }
+    if (due(runMs, t.nextMs + s.periodMs)) ++s.late;
+    // A period after the time the task was given, not after the missed
+    // deadline: a task's own interval check then passes on every run.
+    t.nextMs = runMs + s.periodMs;
+  }
+
+  uint32_t now = BubuClock::nowMs();
+  uint32_t wait = UINT32_MAX;
+  for (uint8_t i = 0; i < count; ++i) {
+    if (due(now, tasks[i].nextMs)) return 0;
+    uint32_t left = tasks[i].nextMs - now;
+    if (left < wait) wait = left;
+  }
+  return wait;
+}
+
+uint8_t taskCount() {
+  return count;
+}
+
+bool stats(uint8_t index, TaskStats& out) {
+  if (index >= count) return false;
+  out = tasks[index].stats;
+  return true;
+}
+
+void logReport() {
+  uint64_t upUs = static_cast<uint64_t>(millis()) * 1000ULL;
+  LOG_INFO(SchedLog, "[Sched] task      period   runs    cpu%%   max us  budget  over  late\n");
+  for (uint8_t i = 0; i < count; ++i) {
+    const TaskStats& s = tasks[i].stats;
+    unsigned cpuPermille = upUs ? static_cast<unsigned>(s.totalUs * 1000ULL / upUs) : 0;
+    LOG_INFO(SchedLog, "[Sched] %-9s %6lu %7lu %3u.%u %8lu %7lu %5lu %5lu\n",
+                       s.name, static_cast<unsigned long>(s.periodMs), static_cast<unsigned long>(s.runs),
+                       cpuPermille / 10, cpuPermille % 10, static_cast<unsigned long>(s.maxUs),
+                       static_cast<unsigned long>(s.budgetUs), static_cast<unsigned long>(s.overruns),
+                       static_cast<unsigned long>(s.late));
+  }
+}
+
+}  // namespace Scheduler
@@ -27,7 +27,6 @@ static constexpr float BLINK_DURATION_SEC = 0.006f; // ~6 ms
 static constexpr size_t BLINK_SAMPLES =
     static_cast<size_t>(SAMPLE_RATE * BLINK_DURATION_SEC);
 static constexpr int16_t BLINK_PEAK = 50000;
-static constexpr bool SOUND_LOGS = true;
 static constexpr float kTwoPi = 6.2831853f;
 
 // Eye swoosh defaults
@@ -85,7 +84,7 @@ void begin() {
   gJitterBuf = static_cast<int16_t*>(heap_caps_malloc(JITTER_MAX_SAMPLES * sizeof(int16_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
   gHappyBuf  = static_cast<int16_t*>(heap_caps_malloc(HAPPY_PIP_SAMPLES * 2 * sizeof(int16_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
   if (!gBlinkBuf || !gSwooshBuf || !gJitterBuf || !gHappyBuf) {
-    SoundLog::println("[Sound] Buffer alloc failed");
+    LOG_ERROR(SoundLog, "[Sound] Buffer alloc failed\n");
     return;
   }
 
@@ -113,22 +112,20 @@ void begin() {
   };
 
   if (i2s_driver_install(gPort, &cfg, 0, nullptr) != ESP_OK) {
-    SoundLog::println("[Sound] i2s_driver_install failed");
+    LOG_ERROR(SoundLog, "[Sound] i2s_driver_install failed\n");
     return;
   }
   if (i2s_set_pin(gPort, &pins) != ESP_OK) {
-    SoundLog::println("[Sound] i2s_set_pin failed");
+    LOG_ERROR(SoundLog, "[Sound] i2s_set_pin failed\n");
     i2s_driver_uninstall(gPort);
     return;
   }
   i2s_zero_dma_buffer(gPort);
   gReady = true;
-  if (SOUND_LOGS) {
-    SoundLog::printf("[Sound] I2S ready: rate=%dHz, samples=%u, pins BCLK=%d LRCK=%d DATA=%d\n",
+  LOG_INFO(SoundLog, "[Sound] I2S ready: rate=%dHz, samples=%u, pins BCLK=%d LRCK=%d DATA=%d\n",
                      SAMPLE_RATE,
                      static_cast<unsigned>(BLINK_SAMPLES),
                      PIN_I2S_BCLK, PIN_I2S_LRCK, PIN_I2S_DATA);
-  }
 }
 
 void blinkClink() {
@@ -136,11 +133,9 @@ void blinkClink() {
   size_t written = 0;
   // Non-blocking write; if DMA full, drop this click.
   esp_err_t res = i2s_write(gPort, gBlinkBuf, sizeof(gBlinkBuf), &written, 0);
-  if (SOUND_LOGS) {
-    SoundLog::printf("[Sound] blinkClink res=%d written=%u\n",
-                     static_cast<int>(res),
-                     static_cast<unsigned>(written));
-  }
+  LOG_DEBUG(SoundLog, "[Sound] blinkClink res=%d written=%u\n",
+                      static_cast<int>(res),
+                      static_cast<unsigned>(written));
 }
 
 void eyeSwoosh(float strength) {
@@ -181,13 +176,11 @@ void eyeSwoosh(float strength) {
 
   size_t written = 0;
   esp_err_t res = i2s_write(gPort, gSwooshBuf, samples * sizeof(int16_t), &written, 0);
-  if (SOUND_LOGS) {
-    SoundLog::printf("[Sound] eyeSwoosh strength=%.2f dur_ms=%.1f res=%d written=%u\n",
-                     static_cast<double>(strength),
-                     static_cast<double>(durationSec * 1000.0f),
-                     static_cast<int>(res),
-                     static_cast<unsigned>(written));
-  }
+  LOG_DEBUG(SoundLog, "[Sound] eyeSwoosh strength=%.2f dur_ms=%.1f res=%d written=%u\n",
+                      static_cast<double>(strength),
+                      static_cast<double>(durationSec * 1000.0f),
+                      static_cast<int>(res),
+                      static_cast<unsigned>(written));
 }
 
 void eyeJitter(float strength) {
@@ -227,13 +220,11 @@ void eyeJitter(float strength) {
 
   size_t written = 0;
   esp_err_t res = i2s_write(gPort, gJitterBuf, samples * sizeof(int16_t), &written, 0);
-  if (SOUND_LOGS) {
-    SoundLog::printf("[Sound] eyeJitter strength=%.2f dur_ms=%.1f res=%d written=%u\n",
-                     static_cast<double>(strength),
-                     static_cast<double>(durationSec * 1000.0f),
-                     static_cast<int>(res),
-                     static_cast<unsigned>(written));
-  }
+  LOG_DEBUG(SoundLog, "[Sound] eyeJitter strength=%.2f dur_ms=%.1f res=%d written=%u\n",
+                      static_cast<double>(strength),
+                      static_cast<double>(durationSec * 1000.0f),
+                      static_cast<int>(res),
+                      static_cast<unsigned>(written));
 }
 
 void happyPip(float strength) {
@@ -273,13 +264,11 @@ void happyPip(float strength) {
 
   size_t written = 0;
   esp_err_t res = i2s_write(gPort, gHappyBuf, samples * sizeof(int16_t) * 2, &written, 0);
-  if (SOUND_LOGS) {
-    SoundLog::printf("[Sound] happyPip strength=%.2f dur_ms=%.1f res=%d written=%u\n",
-                     static_cast<double>(strength),
-                     static_cast<double>(HAPPY_PIP_DURATION_SEC * 1000.0f),
-                     static_cast<int>(res),
-                     static_cast<unsigned>(written));
-  }
+  LOG_DEBUG(SoundLog, "[Sound] happyPip strength=%.2f dur_ms=%.1f res=%d written=%u\n",
+                      static_cast<double>(strength),
+                      static_cast<double>(HAPPY_PIP_DURATION_SEC * 1000.0f),
+                      static_cast<int>(res),
+                      static_cast<unsigned>(written));
 }
 
 void mute(bool enabled) {
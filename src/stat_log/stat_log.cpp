@@ -0,0 +1,500 @@
+#include "stat_log.h"
+
+#include <string.h>
+
+namespace {
+
+using StatLog::EventCode;
+using StatLog::FIELD_COUNT;
+using StatLog::PAGE_SIZE;
+using StatLog::Record;
+using StatLog::SECTOR_SIZE;
+using StatLog::Tier;
+
+constexpr uint32_t MAGIC = 0x31474C53;  // "SLG1"
+constexpr uint32_t HEADER_SIZE = 16;
+constexpr uint32_t NONE = 0xFFFFFFFF;
+constexpr size_t TIER_COUNT = static_cast<size_t>(Tier::COUNT);
+constexpr size_t RECORD_MAX = 1 + 5 + FIELD_COUNT * 5;
+constexpr uint8_t AVERAGED_FIELDS = StatLog::LEVEL;  // HUNGER..CLEANLINESS
+
+// Record tags; anything from TAG_END up ends a sector (erased flash is 0xFF).
+constexpr uint8_t TAG_SAMPLE = 0x40;  // | mask of the fields that changed
+constexpr uint8_t TAG_EVENT = 0x80;
+constexpr uint8_t TAG_END = 0xC0;
+
+struct SectorHeader {
+  uint32_t magic;
+  uint32_t seq;
+  uint32_t startTime;  // time of the first record
+  uint8_t tier;
+  uint8_t reserved[3];
+};
+static_assert(sizeof(SectorHeader) == HEADER_SIZE, "sector header layout");
+
+struct TierState {
+  uint32_t first;    // first sector of the tier in the region
+  uint32_t count;    // sectors
+  uint32_t used;     // sectors holding a header
+  uint32_t oldest;   // sector index within the tier
+  uint32_t head;     // sector being appended to, NONE if the tier is empty
+  uint32_t seq;      // of head
+  uint32_t offset;   // append position within head
+  uint32_t lastTime;
+  int32_t prev[FIELD_COUNT];  // delta baseline, reset at each sector
+  uint8_t page[PAGE_SIZE];    // the page holding offset
+  uint32_t pageFlushed;       // bytes of page already on flash
+};
+
+// Running average of the finer tier for the current hour / day.
+struct Accum {
+  uint32_t bucket;
+  uint32_t n;
+  int64_t sum[FIELD_COUNT];
+  int32_t last[FIELD_COUNT];
+};
+
+StatLog::Flash flash = {};
+bool ready = false;
+TierState tiers[TIER_COUNT];
+Accum hourAcc;
+Accum dayAcc;
+
+constexpr uint32_t HOUR_S = 3600;
+constexpr uint32_t DAY_S = 86400;
+
+uint32_t sectorOffset(const TierState& t, uint32_t sector) {
+  return (t.first + sector) * SECTOR_SIZE;
+}
+
+uint32_t zigzag(int32_t v) {
+  return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+int32_t unzigzag(uint32_t v) {
+  return static_cast<int32_t>(v >> 1) ^ -static_cast<int32_t>(v & 1);
+}
+
+size_t putVarint(uint8_t* out, uint32_t v) {
+  size_t n = 0;
+  while (v >= 0x80) {
+    out[n++] = static_cast<uint8_t>(v | 0x80);
+    v >>= 7;
+  }
+  out[n++] = static_cast<uint8_t>(v);
+  return n;
+}
+
+// Reads one sector sequentially; the unflushed tail of the head sector
+// comes from the RAM page.
+struct Reader {
+  const TierState* t;
+  uint32_t base;   // sector offset in the region
+  uint32_t pos;    // within the sector
+  uint32_t end;
+  uint32_t pageStart;  // within the sector; NONE if the page is not used
+  uint8_t buf[64];
+  uint32_t bufStart;
+  uint32_t bufLen;
+  bool failed;
+
+  Reader(const TierState& tier, uint32_t sector) : t(&tier), base(sectorOffset(tier, sector)),
+      pos(HEADER_SIZE), end(SECTOR_SIZE), pageStart(NONE), bufStart(0), bufLen(0), failed(false) {
+    if (sector == tier.head) {
+      end = tier.offset;
+      pageStart = tier.offset & ~(PAGE_SIZE - 1);
+    }
+  }
+
+  bool byte(uint8_t& out) {
+    if (pos >= end) return false;
+    if (pageStart != NONE && pos >= pageStart) {
+      out = t->page[pos - pageStart];
+    } else {
+      if (pos < bufStart || pos >= bufStart + bufLen) {
+        uint32_t len = sizeof(buf);
+        if (pos + len > end) len = end - pos;
+        if (pageStart != NONE && pos + len > pageStart) len = pageStart - pos;
+        if (!flash.read(flash.ctx, base + pos, buf, len)) {
+          failed = true;
+          return false;
+        }
+        bufStart = pos;
+        bufLen = len;
+      }
+      out = buf[pos - bufStart];
+    }
+    ++pos;
+    return true;
+  }
+
+  bool varint(uint32_t& out) {
+    out = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+      uint8_t b;
+      if (!byte(b)) return false;
+      out |= static_cast<uint32_t>(b & 0x7F) << shift;
+      if (!(b & 0x80)) return true;
+    }
+    return false;
+  }
+};
+
+// Decodes the next record; false at the end of the data or on a record cut
+// short. prev and time carry the delta baseline.
+bool decode(Reader& r, int32_t (&prev)[FIELD_COUNT], uint32_t& time, Record& rec) {
+  uint8_t tag;
+  uint32_t dt;
+  if (!r.byte(tag) || tag >= TAG_END || !(tag & (TAG_SAMPLE | TAG_EVENT)) || !r.varint(dt)) return false;
+  time += dt;
+  rec.time = time;
+  rec.isEvent = tag & TAG_EVENT;
+  if (rec.isEvent) {
+    uint8_t code;
+    uint32_t arg;
+    if (!r.byte(code) || !r.varint(arg)) return false;
+    rec.code = static_cast<EventCode>(code);
+    rec.arg = unzigzag(arg);
+    memcpy(rec.values, prev, sizeof(prev));
+    return true;
+  }
+  for (uint8_t f = 0; f < FIELD_COUNT; ++f) {
+    if (tag & (1u << f)) {
+      uint32_t d;
+      if (!r.varint(d)) return false;
+      prev[f] += unzigzag(d);
+    }
+  }
+  memcpy(rec.values, prev, sizeof(prev));
+  rec.code = EventCode();
+  rec.arg = 0;
+  return true;
+}
+
+size_t encode(const TierState& t, const Record& rec, uint8_t* out) {
+  size_t n = 1;
+  n += putVarint(out + n, rec.time - t.lastTime);
+  if (rec.isEvent) {
+    out[0] = TAG_EVENT;
+    out[n++] = static_cast<uint8_t>(rec.code);
+    n += putVarint(out + n, zigzag(rec.arg));
+    return n;
+  }
+  uint8_t mask = 0;
+  for (uint8_t f = 0; f < FIELD_COUNT; ++f) {
+    if (rec.values[f] == t.prev[f]) continue;
+    mask |= 1u << f;
+    n += putVarint(out + n, zigzag(rec.values[f] - t.prev[f]));
+  }
+  out[0] = TAG_SAMPLE | mask;
+  return n;
+}
+
+bool readHeader(const TierState& t, uint32_t sector, SectorHeader& h, Tier tier) {
+  return flash.read(flash.ctx, sectorOffset(t, sector), &h, sizeof(h)) && h.magic == MAGIC &&
+         h.tier == static_cast<uint8_t>(tier);
+}
+
+bool flushPage(TierState& t) {
+  if (t.head == NONE) return true;
+  uint32_t fill = t.offset & (PAGE_SIZE - 1);  // 0: the page was written when it filled
+  if (fill <= t.pageFlushed) return true;
+  uint32_t pageBase = sectorOffset(t, t.head) + (t.offset & ~(PAGE_SIZE - 1));
+  if (!flash.write(flash.ctx, pageBase + t.pageFlushed, t.page + t.pageFlushed, fill - t.pageFlushed)) return false;
+  t.pageFlushed = fill;
+  return true;
+}
+
+bool openSector(TierState& t, Tier tier, uint32_t startTime) {
+  uint32_t next = t.head == NONE ? 0 : (t.head + 1) % t.count;
+  if (!flash.erase(flash.ctx, sectorOffset(t, next))) return false;
+  SectorHeader h;
+  memset(&h, 0, sizeof(h));
+  h.magic = MAGIC;
+  h.seq = t.head == NONE ? 1 : t.seq + 1;
+  h.startTime = startTime;
+  h.tier = static_cast<uint8_t>(tier);
+  if (!flash.write(flash.ctx, sectorOffset(t, next), &h, sizeof(h))) return false;
+  if (t.used < t.count) ++t.used;
+  if (t.used == t.count) t.oldest = (next + 1) % t.count;
+  t.head = next;
+  t.seq = h.seq;
+  t.offset = HEADER_SIZE;
+  memcpy(t.page, &h, sizeof(h));
+  t.pageFlushed = HEADER_SIZE;
+  memset(t.prev, 0, sizeof(t.prev));
+  t.lastTime = startTime;
+  return true;
+}
+
+bool append(Tier tier, Record& rec) {
+  TierState& t = tiers[static_cast<size_t>(tier)];
+  if (rec.time < t.lastTime) rec.time = t.lastTime;
+  uint8_t buf[RECORD_MAX];
+  size_t len = encode(t, rec, buf);
+  if (t.head == NONE || t.offset + len > SECTOR_SIZE) {
+    if (!flushPage(t) || !openSector(t, tier, rec.time)) return false;
+    len = encode(t, rec, buf);
+  }
+  for (size_t i = 0; i < len;) {
+    uint32_t inPage = t.offset & (PAGE_SIZE - 1);
+    size_t n = PAGE_SIZE - inPage;
+    if (n > len - i) n = len - i;
+    memcpy(t.page + inPage, buf + i, n);
+    t.offset += n;
+    i += n;
+    if ((t.offset & (PAGE_SIZE - 1)) == 0) {
+      // Page complete: one batched write of whatever was not flushed yet.
+      uint32_t pageBase = sectorOffset(t, t.head) + t.offset - PAGE_SIZE;
+      if (!flash.write(flash.ctx, pageBase + t.pageFlushed, t.page + t.pageFlushed, PAGE_SIZE - t.pageFlushed)) {
+        return false;
+      }
+      t.pageFlushed = 0;
+    }
+  }
+  t.lastTime = rec.time;
+  if (!rec.isEvent) memcpy(t.prev, rec.values, sizeof(t.prev));
+  return true;
+}
+
+// Finds head, oldest and the append position after the newest record.
+bool recover(Tier tier) {
+  TierState& t = tiers[static_cast<size_t>(tier)];
+  t.head = NONE;
+  t.used = 0;
+  t.oldest = 0;
+  t.lastTime = 0;
+  for (uint32_t s = 0; s < t.count; ++s) {
+    SectorHeader h;
+    if (!readHeader(t, s, h, tier)) continue;
+    ++t.used;
+    if (t.head == NONE || h.seq > t.seq) {
+      t.head = s;
+      t.seq = h.seq;
+      t.lastTime = h.startTime;
+    }
+  }
+  if (t.head == NONE) return true;
+  // Oldest: first sector with a header after head (the one after head may
+  // have been erased just before a reset).
+  t.oldest = t.head;
+  for (uint32_t i = 1; i <= t.count; ++i) {
+    uint32_t s = (t.head + i) % t.count;
+    SectorHeader h;
+    if (readHeader(t, s, h, tier)) {
+      t.oldest = s;
+      break;
+    }
+  }
+
+  // Replay the head sector; a record cut short by a reset ends it.
+  uint32_t head = t.head;
+  t.head = NONE;  // read it from flash only
+  Reader r(t, head);
+  t.head = head;
+  memset(t.prev, 0, sizeof(t.prev));
+  uint32_t end = HEADER_SIZE;
+  for (;;) {
+    int32_t prev[FIELD_COUNT];
+    memcpy(prev, t.prev, sizeof(prev));
+    uint32_t time = t.lastTime;
+    Record rec;
+    if (!decode(r, prev, time, rec)) break;
+    memcpy(t.prev, prev, sizeof(prev));
+    t.lastTime = time;
+    end = r.pos;
+  }
+  if (r.failed) return false;
+
+  // Anything but erased flash after the last record (a write cut short by a
+  // reset) cannot be written over: seal the sector.
+  uint8_t buf[64];
+  for (uint32_t pos = end; pos < SECTOR_SIZE; pos += sizeof(buf)) {
+    uint32_t len = SECTOR_SIZE - pos < sizeof(buf) ? SECTOR_SIZE - pos : sizeof(buf);
+    if (!flash.read(flash.ctx, sectorOffset(t, head) + pos, buf, len)) return false;
+    for (uint32_t i = 0; i < len; ++i) {
+      if (buf[i] != 0xFF) {
+        t.offset = SECTOR_SIZE;
+        t.pageFlushed = 0;
+        return true;
+      }
+    }
+  }
+  t.offset = end;
+  uint32_t pageStart = end & ~(PAGE_SIZE - 1);
+  t.pageFlushed = end - pageStart;
+  return t.pageFlushed == 0 || flash.read(flash.ctx, sectorOffset(t, head) + pageStart, t.page, t.pageFlushed);
+}
+
+uint32_t logicalSector(const TierState& t, uint32_t i) {
+  return (t.oldest + i) % t.count;
+}
+
+void accumulate(Accum& a, const Record& rec) {
+  for (uint8_t f = 0; f < FIELD_COUNT; ++f) {
+    if (f < AVERAGED_FIELDS) a.sum[f] += rec.values[f];
+    a.last[f] = rec.values[f];
+  }
+  ++a.n;
+}
+
+// Closes the accumulator's bucket when rec falls in a later one.
+bool rollUp(Accum& a, uint32_t period, Tier tier, const Record& rec);
+
+bool emit(Accum& a, uint32_t period, Tier tier) {
+  Record avg;
+  memset(&avg, 0, sizeof(avg));
+  avg.time = a.bucket * period;
+  for (uint8_t f = 0; f < FIELD_COUNT; ++f) {
+    avg.values[f] = f < AVERAGED_FIELDS ? static_cast<int32_t>(a.sum[f] / a.n) : a.last[f];
+  }
+  memset(&a, 0, sizeof(a));
+  if (tier == Tier::HOUR && !rollUp(dayAcc, DAY_S, Tier::DAY, avg)) return false;
+  return append(tier, avg);
+}
+
+bool rollUp(Accum& a, uint32_t period, Tier tier, const Record& rec) {
+  uint32_t bucket = rec.time / period;
+  if (a.n && bucket != a.bucket && !emit(a, period, tier)) return false;
+  a.bucket = bucket;
+  accumulate(a, rec);
+  return true;
+}
+
+bool restoreAccum(const Record& r, void* ctx) {
+  accumulate(*static_cast<Accum*>(ctx), r);
+  return true;
+}
+
+bool restoreHourAccum(const Record& r, void* ctx) {
+  if (!r.isEvent) restoreAccum(r, ctx);
+  return true;
+}
+
+}  // namespace
+
+namespace StatLog {
+
+bool begin(const Flash& f) {
+  ready = false;
+  if (f.size / SECTOR_SIZE < MIN_SECTORS) return false;
+  flash = f;
+  uint32_t total = f.size / SECTOR_SIZE;
+  uint32_t day = total / 16 < 2 ? 2 : total / 16;
+  uint32_t hour = total / 4 < 2 ? 2 : total / 4;
+  TierState* t = tiers;
+  t[0] = TierState();
+  t[1] = TierState();
+  t[2] = TierState();
+  t[static_cast<size_t>(Tier::MINUTE)].first = 0;
+  t[static_cast<size_t>(Tier::MINUTE)].count = total - hour - day;
+  t[static_cast<size_t>(Tier::HOUR)].first = total - hour - day;
+  t[static_cast<size_t>(Tier::HOUR)].count = hour;
+  t[static_cast<size_t>(Tier::DAY)].first = total - day;
+  t[static_cast<size_t>(Tier::DAY)].count = day;
+  for (size_t i = 0; i < TIER_COUNT; ++i) {
+    if (!recover(static_cast<Tier>(i))) return false;
+  }
+  ready = true;
+
+  // Rebuild the open hour and day from what already reached the log.
+  memset(&hourAcc, 0, sizeof(hourAcc));
+  memset(&dayAcc, 0, sizeof(dayAcc));
+  const TierState& minute = tiers[static_cast<size_t>(Tier::MINUTE)];
+  const TierState& hourly = tiers[static_cast<size_t>(Tier::HOUR)];
+  if (minute.head != NONE) {
+    hourAcc.bucket = minute.lastTime / HOUR_S;
+    query(Tier::MINUTE, hourAcc.bucket * HOUR_S, minute.lastTime, restoreHourAccum, &hourAcc);
+  }
+  if (hourly.head != NONE) {
+    dayAcc.bucket = hourly.lastTime / DAY_S;
+    query(Tier::HOUR, dayAcc.bucket * DAY_S, hourly.lastTime, restoreAccum, &dayAcc);
+  }
+  return true;
+}
+
+void end() {
+  flush();
+  ready = false;
+}
+
+bool appendSample(uint32_t time, const int32_t (&values)[FIELD_COUNT]) {
+  if (!ready) return false;
+  Record rec;
+  memset(&rec, 0, sizeof(rec));
+  rec.time = time;
+  memcpy(rec.values, values, sizeof(rec.values));
+  if (!append(Tier::MINUTE, rec)) return false;
+  return rollUp(hourAcc, HOUR_S, Tier::HOUR, rec);
+}
+
+bool appendEvent(uint32_t time, EventCode code, int32_t arg) {
+  if (!ready) return false;
+  Record rec;
+  memset(&rec, 0, sizeof(rec));
+  rec.time = time;
+  rec.isEvent = true;
+  rec.code = code;
+  rec.arg = arg;
+  return append(Tier::MINUTE, rec);
+}
+
+bool flush() {
+  if (!ready) return false;
+  bool ok = true;
+  for (TierState& t : tiers) ok = flushPage(t) && ok;
+  return ok;
+}
+
+size_t query(Tier tier, uint32_t from, uint32_t to, RecordFn fn, void* ctx) {
+  if (!ready || tier >= Tier::COUNT || from > to) return 0;
+  const TierState& t = tiers[static_cast<size_t>(tier)];
+  if (t.head == NONE) return 0;
+
+  // Last sector starting at or before from (or the oldest one).
+  uint32_t lo = 0;
+  uint32_t hi = t.used;
+  while (hi - lo > 1) {
+    uint32_t mid = lo + (hi - lo) / 2;
+    SectorHeader h;
+    if (!readHeader(t, logicalSector(t, mid), h, tier)) return 0;
+    if (h.startTime <= from) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+
+  size_t delivered = 0;
+  for (uint32_t i = lo; i < t.used; ++i) {
+    uint32_t sector = logicalSector(t, i);
+    SectorHeader h;
+    if (!readHeader(t, sector, h, tier)) return delivered;
+    if (h.startTime > to) break;
+    Reader r(t, sector);
+    int32_t prev[FIELD_COUNT] = {};
+    uint32_t time = h.startTime;
+    Record rec;
+    while (decode(r, prev, time, rec)) {
+      if (rec.time > to) return delivered;
+      if (rec.time < from) continue;
+      ++delivered;
+      if (!fn(rec, ctx)) return delivered;
+    }
+  }
+  return delivered;
+}
+
+uint32_t newestTime() {
+  return ready ? tiers[static_cast<size_t>(Tier::MINUTE)].lastTime : 0;
+}
+
+uint32_t sectors(Tier tier) {
+  return tier < Tier::COUNT ? tiers[static_cast<size_t>(tier)].count : 0;
+}
+
+uint32_t usedSectors(Tier tier) {
+  return tier < Tier::COUNT ? tiers[static_cast<size_t>(tier)].used : 0;
+}
+
+}  // namespace StatLog
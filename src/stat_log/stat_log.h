@@ -0,0 +1,85 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Append-only history of care stats, level/XP and key events.
+// The flash region (the spiffs partition on the device, a file on the host)
+// is split into three circular tiers of 4 KB sectors: MINUTE holds every
+// sample and event, HOUR and DAY hold averages that are appended as each
+// hour and day closes, so the coarse tiers reach back much further than
+// the minute ring before it wraps.
+// Each sector starts with a header (sequence number, time of its first
+// record); records are delta-encoded against the previous one in the same
+// sector, so a sample whose stats did not change takes 3 bytes. Appends
+// collect in a RAM page and reach flash a whole PAGE_SIZE at a time; flush()
+// writes a partial page (the rest of it stays erased and is filled later).
+// query() binary-searches the sector headers for the start time and decodes
+// from there: O(log sectors) + one sector.
+// No Arduino or ESP-IDF dependency (the partition backend and the sampling
+// live in stat_log_esp.cpp), so it also runs on the host (tools/stat_log_host).
+// Not thread-safe: call from one task.
+namespace StatLog {
+
+  static constexpr uint32_t SECTOR_SIZE = 4096;
+  static constexpr uint32_t PAGE_SIZE = 256;
+  static constexpr uint32_t MIN_SECTORS = 6;  // two per tier
+
+  enum class Tier : uint8_t { MINUTE, HOUR, DAY, COUNT };
+  enum Field : uint8_t { HUNGER, MOOD, ENERGY, CLEANLINESS, LEVEL, XP, FIELD_COUNT };
+
+  enum class EventCode : uint8_t {
+    BOOT = 1,    // arg: reset reason
+    LEVEL_UP,    // arg: new level
+    HATCHED,
+    CARE,        // arg: Field << 8 | amount, a care action that raised a stat
+  };
+
+  // Backing store: offsets are relative to the region; erase() takes a
+  // sector-aligned offset. Written bytes must be erased (0xFF) beforehand.
+  struct Flash {
+    bool (*read)(void* ctx, uint32_t offset, void* out, size_t len);
+    bool (*write)(void* ctx, uint32_t offset, const void* data, size_t len);
+    bool (*erase)(void* ctx, uint32_t offset);
+    uint32_t size;
+    void* ctx;
+  };
+
+  struct Record {
+    uint32_t time;     // seconds (Unix time once the clock was set)
+    bool isEvent;
+    int32_t values[FIELD_COUNT];  // samples; HOUR/DAY: averages, LEVEL/XP last
+    EventCode code;    // events
+    int32_t arg;
+  };
+
+  // Return false to stop the query.
+  using RecordFn = bool (*)(const Record& r, void* ctx);
+
+  // Scans the sector headers and resumes after the newest record.
+  bool begin(const Flash& flash);
+  void end();  // flush(), then forget the backend
+
+  // Times earlier than the newest record are clamped to it.
+  bool appendSample(uint32_t time, const int32_t (&values)[FIELD_COUNT]);
+  bool appendEvent(uint32_t time, EventCode code, int32_t arg);
+  // Writes the pending part of the current page.
+  bool flush();
+
+  // Calls fn for each record of the tier with from <= time <= to, oldest
+  // first; returns how many were delivered.
+  size_t query(Tier tier, uint32_t from, uint32_t to, RecordFn fn, void* ctx);
+
+  uint32_t newestTime();  // 0 if the log is empty
+  uint32_t sectors(Tier tier);
+  uint32_t usedSectors(Tier tier);
+
+  // Device side (stat_log_esp.cpp): the spiffs partition as Flash, a sample
+  // of CareSystem and LevelSystem every SAMPLE_PERIOD_MS, events from the
+  // other systems. Until the clock is set, time continues from the newest
+  // record by uptime.
+  static constexpr uint32_t SAMPLE_PERIOD_MS = 60UL * 1000UL;
+  static constexpr uint32_t FLUSH_PERIOD_MS = 10UL * 60UL * 1000UL;
+  bool beginPartition();
+  void update(uint32_t nowMs);
+  void recordEvent(EventCode code, int32_t arg = 0);
+}
@@ -0,0 +1,101 @@
+// StatLog on the device: spiffs partition backend and periodic sampling.
+#include "stat_log.h"
+#include "bubu_clock.h"
+
+#include <Arduino.h>
+#include <esp_partition.h>
+#include <esp_system.h>
+#include <time.h>
+#include "care_system.h"
+#include "level_system.h"
+#include "logger.h"
+DEFINE_MODULE_LOGGER(HistoryLog)
+
+namespace {
+
+constexpr time_t CLOCK_VALID_AFTER = 1600000000;
+
+const esp_partition_t* partition = nullptr;
+bool running = false;
+uint32_t lastSampleMs = 0;
+uint32_t lastFlushMs = 0;
+uint32_t bootBase = 0;  // log time at millis() == 0 while the clock is unset
+
+bool partRead(void* ctx, uint32_t offset, void* out, size_t len) {
+  return esp_partition_read(static_cast<const esp_partition_t*>(ctx), offset, out, len) == ESP_OK;
+}
+
+bool partWrite(void* ctx, uint32_t offset, const void* data, size_t len) {
+  return esp_partition_write(static_cast<const esp_partition_t*>(ctx), offset, data, len) == ESP_OK;
+}
+
+bool partErase(void* ctx, uint32_t offset) {
+  return esp_partition_erase_range(static_cast<const esp_partition_t*>(ctx), offset, StatLog::SECTOR_SIZE) == ESP_OK;
+}
+
+uint32_t logTime() {
+  time_t now = time(nullptr);
+  if (now > CLOCK_VALID_AFTER) return static_cast<uint32_t>(now);
+  return bootBase + BubuClock::nowMs() / 1000;
+}
+
+void onShutdown() {
+  if (running) StatLog::flush();
+}
+
+}  // namespace
+
+namespace StatLog {
+
+bool beginPartition() {
+  if (running) return true;
+  partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, "spiffs");
+  if (!partition) {
+    LOG_WARN(HistoryLog, "[History] No spiffs partition, history disabled\n");
+    return false;
+  }
+  Flash f = {partRead, partWrite, partErase, partition->size, const_cast<esp_partition_t*>(partition)};
+  uint32_t t0 = millis();
+  if (!begin(f)) {
+    LOG_ERROR(HistoryLog, "[History] Cannot read the log (%u KB partition)\n",
+                          static_cast<unsigned>(partition->size / 1024));
+    return false;
+  }
+  bootBase = newestTime() + 1;
+  running = true;
+  esp_register_shutdown_handler(onShutdown);
+  LOG_INFO(HistoryLog, "[History] %u/%u minute, %u/%u hour, %u/%u day sectors; resumed in %lu ms\n",
+                       static_cast<unsigned>(usedSectors(Tier::MINUTE)), static_cast<unsigned>(sectors(Tier::MINUTE)),
+                       static_cast<unsigned>(usedSectors(Tier::HOUR)), static_cast<unsigned>(sectors(Tier::HOUR)),
+                       static_cast<unsigned>(usedSectors(Tier::DAY)), static_cast<unsigned>(sectors(Tier::DAY)),
+                       static_cast<unsigned long>(millis() - t0));
+  recordEvent(EventCode::BOOT, static_cast<int32_t>(esp_reset_reason()));
+  lastSampleMs = lastFlushMs = BubuClock::nowMs() - SAMPLE_PERIOD_MS;  // first sample on the next update()
+  return true;
+}
+
+void update(uint32_t nowMs) {
+  if (!running) return;
+  if (nowMs - lastSampleMs >= SAMPLE_PERIOD_MS) {
+    lastSampleMs = nowMs;
+    int32_t values[FIELD_COUNT];
+    values[HUNGER] = CareSystem::getHunger();
+    values[MOOD] = CareSystem::getMood();
+    values[ENERGY] = CareSystem::getEnergy();
+    values[CLEANLINESS] = CareSystem::getCleanliness();
+    values[LEVEL] = LevelSystem::getLevel();
+    values[XP] = LevelSystem::getXP();
+    if (!appendSample(logTime(), values)) LOG_WARN(HistoryLog, "[History] Sample write failed\n");
+  }
+  if (nowMs - lastFlushMs >= FLUSH_PERIOD_MS) {
+    lastFlushMs = nowMs;
+    flush();
+  }
+}
+
+void recordEvent(EventCode code, int32_t arg) {
+  if (!running) return;
+  if (!appendEvent(logTime(), code, arg)) LOG_WARN(HistoryLog, "[History] Event write failed\n");
+}
+
+}  // namespace StatLog
@@ -1,6 +1,8 @@
 #include "sub_state_system.h"
+#include "bubu_clock.h"
 #include "care_system.h"
 #include "level_system.h"
+#include "flight_recorder.h"
 
 namespace SubStateSystem {
 
@@ -33,9 +35,21 @@ struct State {
 };
 
 static State g;
+static uint8_t recordedBits = 0;  // last sub-state set sent to the flight recorder
+
+// The snapshot only depends on the care stats, the level and the low timers,
+// so update() hands out the last one until an input changes or a timer is due.
+static Snapshot cached;
+static bool cacheValid = false;
+static uint32_t cachedCareVersion = 0;
+static int cachedLevel = 0;
+static uint32_t evaluatedMs = 0;
+static bool deadlinePending = false;
+static uint32_t deadlineWaitMs = 0;  // after evaluatedMs
 
 void begin() {
   g = State{};
+  cacheValid = false;
 }
 
 static bool sustainedLow(uint32_t sinceMs, uint32_t nowMs, uint32_t thresholdMs) {
@@ -47,9 +61,7 @@ static void resetAllPrimary(State& s) {
   s.hungerLowSince = s.energyLowSince = s.moodLowSince = s.cleanLowSince = 0;
 }
 
-void update(Snapshot& out) {
-  uint32_t now = millis();
-
+static void evaluate(uint32_t now, Snapshot& out) {
   // Read current stats
   int hunger      = CareSystem::getHunger();
   int energy      = CareSystem::getEnergy();
@@ -131,6 +143,13 @@ void update(Snapshot& out) {
     g.sub_depressed = false;
   }
 
+  uint8_t bits = (g.sub_irritable ? 1 : 0) | (g.sub_sluggish ? 2 : 0) | (g.sub_withdrawn ? 4 : 0) |
+                 (g.sub_uncomfortable ? 8 : 0) | (g.sub_depressed ? 16 : 0);
+  if (bits != recordedBits) {
+    FlightRecorder::record(FlightRecorder::Event::SUBSTATE, bits);
+    recordedBits = bits;
+  }
+
   // Build snapshot output
   out.sub_irritable = g.sub_irritable;
   out.sub_sluggish = g.sub_sluggish;
@@ -296,4 +315,45 @@ void update(Snapshot& out) {
   if (!LevelSystem::isUnlocked(LevelSystem::IDLE_SPEED_FAST)) { out.suppressSpeedFast = true; }
 }
 
+// Earliest time a running low timer crosses one of its thresholds.
+static void scheduleDeadline(uint32_t now) {
+  deadlinePending = false;
+  auto consider = [&](uint32_t sinceMs, uint32_t thresholdMs) {
+    if (sinceMs == 0) return;
+    uint32_t elapsed = now - sinceMs;
+    if (elapsed >= thresholdMs) return;  // already applied
+    uint32_t wait = thresholdMs - elapsed;
+    if (!deadlinePending || wait < deadlineWaitMs) {
+      deadlinePending = true;
+      deadlineWaitMs = wait;
+    }
+  };
+  if (!g.sub_irritable) consider(g.hungerLowSince, PRIMARY_ACTIVATE_MS);
+  if (!g.sub_sluggish) consider(g.energyLowSince, PRIMARY_ACTIVATE_MS);
+  if (!g.sub_withdrawn) consider(g.moodLowSince, PRIMARY_ACTIVATE_MS);
+  if (!g.sub_uncomfortable) consider(g.cleanLowSince, PRIMARY_ACTIVATE_MS);
+  consider(g.hungerLowSince, DEPRESSED_LONG_MS);
+  consider(g.energyLowSince, DEPRESSED_LONG_MS);
+  consider(g.moodLowSince, DEPRESSED_LONG_MS);
+  consider(g.cleanLowSince, DEPRESSED_LONG_MS);
+}
+
+void update(Snapshot& out) {
+  uint32_t now = BubuClock::nowMs();
+  uint32_t careVersion = CareSystem::version();
+  int level = LevelSystem::getLevel();
+  bool due = deadlinePending && now - evaluatedMs >= deadlineWaitMs;
+  if (!cacheValid || due || careVersion != cachedCareVersion || level != cachedLevel) {
+    evaluate(now, cached);
+    scheduleDeadline(now);
+    evaluatedMs = now;
+    cachedCareVersion = careVersion;
+    cachedLevel = level;
+    // A timer started at time 0 reads as "not low" and restarts on
+    // the next evaluation, so do not cache that one.
+    cacheValid = now != 0;
+  }
+  out = cached;
+}
+
 }  // namespace SubStateSystem
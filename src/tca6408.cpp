@@ -18,7 +18,7 @@ bool begin() {
   Wire.write(REG_CONFIG);
   Wire.write(0x55); // Test pattern
   if (Wire.endTransmission(true) != 0) {
-    TcaLog::println("[TCA6408] begin() failed at endTransmission 1");
+    LOG_ERROR(TcaLog, "[TCA6408] begin() failed at endTransmission 1\n");
     return false;
   }
   delay(10);
@@ -27,17 +27,17 @@ bool begin() {
   Wire.beginTransmission(TCA6408_ADDR);
   Wire.write(REG_CONFIG);
   if (Wire.endTransmission(false) != 0) {
-    TcaLog::println("[TCA6408] begin() failed at endTransmission 2");
+    LOG_ERROR(TcaLog, "[TCA6408] begin() failed at endTransmission 2\n");
     return false;
   }
   if (Wire.requestFrom(TCA6408_ADDR, (uint8_t)1) != 1) {
-    TcaLog::println("[TCA6408] begin() failed at requestFrom");
+    LOG_ERROR(TcaLog, "[TCA6408] begin() failed at requestFrom\n");
     return false;
   }
   uint8_t test = Wire.read();
   
   if (test != 0x55) {
-    TcaLog::printf("[TCA6408] begin() failed, test read %02X, expected 55\n", test);
+    LOG_ERROR(TcaLog, "[TCA6408] begin() failed, test read %02X, expected 55\n", test);
     return false;
   }
   
@@ -47,9 +47,9 @@ bool begin() {
   Wire.write(0xFF);
   bool success = (Wire.endTransmission(true) == 0);
   if (success) {
-    TcaLog::println("[TCA6408] begin() OK");
+    LOG_INFO(TcaLog, "[TCA6408] begin() OK\n");
   } else {
-    TcaLog::println("[TCA6408] begin() failed to set config to FF");
+    LOG_ERROR(TcaLog, "[TCA6408] begin() failed to set config to FF\n");
   }
   return success;
 }
@@ -1,10 +1,14 @@
 #include "touch_system.h"
+#include "bubu_clock.h"
 
 #include <Arduino.h>
 #include <Wire.h>
 
 #include "board_pins.h"
 #include "logger.h"
+#ifdef BUBU_TOUCH_REPLAY
+#include "esp_heap_caps.h"
+#endif
 DEFINE_MODULE_LOGGER(TouchLog)
 
 // Forward declarations for functions used in implementation
@@ -35,6 +39,8 @@ volatile bool tcaInterruptFlag = false;
 
 TouchPoint pendingEvent;
 bool eventAvailable = false;
+uint32_t pendingInputMs = 0;  // when the input that made pendingEvent ended
+bool pendingFromReplay = false;
 
 // Touch state tracking
 struct TouchState {
@@ -56,6 +62,26 @@ constexpr uint16_t SWIPE_MIN_DIST_PX = 40;
 constexpr uint32_t RELEASE_TIMEOUT_MS = 120; // Tighter timeout
 constexpr uint32_t DEBOUNCE_MS = 20;         // Very short debounce
 
+TouchTrace::Writer* recorder = nullptr;
+
+struct Replay {
+  bool active = false;
+  bool started = false;  // startMs is set by the first update()
+  uint32_t startMs = 0;
+  bool haveNext = false;
+  TouchTrace::Sample next;
+  TouchTrace::Reader reader;
+  TouchSystem::ReplayStats stats = {};
+} replay;
+
+#ifdef BUBU_TOUCH_RECORD
+constexpr size_t RECORD_BUF_BYTES = TouchTrace::HEADER_BYTES + 1024 * TouchTrace::RECORD_BYTES;
+constexpr uint32_t RECORD_FLUSH_IDLE_MS = 1000;
+constexpr size_t RECORD_LINE_RECORDS = 32;
+uint8_t recordBuf[RECORD_BUF_BYTES];
+TouchTrace::Writer recordWriter(recordBuf, sizeof(recordBuf), 0);
+#endif
+
 void IRAM_ATTR touchISR() {
   touchInterruptFlag = true;
   tcaInterruptFlag = true;
@@ -165,18 +191,20 @@ uint16_t calculateDistance(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2) {
   return static_cast<uint16_t>(abs(static_cast<int>(dx)) + abs(static_cast<int>(dy)));
 }
 
-void emitGesture(TouchGesture gesture, uint16_t x, uint16_t y, uint32_t duration) {
+void emitGesture(TouchGesture gesture, uint16_t x, uint16_t y, uint32_t duration, uint32_t inputMs) {
   pendingEvent.gesture = gesture;
   pendingEvent.x = x;
   pendingEvent.y = y;
   pendingEvent.duration = duration;
+  pendingInputMs = inputMs;
+  pendingFromReplay = replay.active;
   eventAvailable = true;
 
   const char* gestureName[] = {
     "NONE", "TAP", "LONG_PRESS", "LONG", "SWIPE_UP", "SWIPE_DOWN", "SWIPE_LEFT", "SWIPE_RIGHT"
   };
-  TouchLog::printf("[Touch] %s at (%d,%d) dur=%lums\n", 
-                gestureName[gesture], x, y, duration);
+  LOG_DEBUG(TouchLog, "[Touch] %s at (%d,%d) dur=%lums\n", 
+                      gestureName[gesture], x, y, duration);
 }
 
 void handleTouchDown(uint16_t x, uint16_t y, uint32_t now) {
@@ -189,7 +217,7 @@ void handleTouchDown(uint16_t x, uint16_t y, uint32_t now) {
   touch.lastReadTime = now;
   touch.longPressFired = false;
   
-  TouchLog::printf("[Touch] DOWN at (%d,%d)\n", x, y);
+  LOG_DEBUG(TouchLog, "[Touch] DOWN at (%d,%d)\n", x, y);
 }
 
 void handleTouchMove(uint16_t x, uint16_t y, uint32_t now) {
@@ -212,16 +240,16 @@ void checkLongPress(uint32_t now) {
   uint16_t drift = calculateDistance(touch.downX, touch.downY, 
                                      touch.currentX, touch.currentY);
   
-  TouchLog::printf("[Touch] Long press check: held=%lums, drift=%upx (max=%u)\n", 
-                heldDuration, drift, TAP_MAX_DRIFT_PX);
+  LOG_DEBUG(TouchLog, "[Touch] Long press check: held=%lums, drift=%upx (max=%u)\n", 
+                      heldDuration, drift, TAP_MAX_DRIFT_PX);
   
   if (drift <= TAP_MAX_DRIFT_PX) {
     touch.longPressFired = true;
-    emitGesture(TOUCH_LONG_PRESS, touch.downX, touch.downY, heldDuration);
-    TouchLog::println("[Touch] *** LONG PRESS FIRED ***");
+    emitGesture(TOUCH_LONG_PRESS, touch.downX, touch.downY, heldDuration, touch.downTime + LONG_PRESS_MS);
+    LOG_DEBUG(TouchLog, "[Touch] *** LONG PRESS FIRED ***\n");
   } else {
-    TouchLog::printf("[Touch] Long press rejected - too much drift (%u > %u)\n", 
-                  drift, TAP_MAX_DRIFT_PX);
+    LOG_DEBUG(TouchLog, "[Touch] Long press rejected - too much drift (%u > %u)\n", 
+                        drift, TAP_MAX_DRIFT_PX);
   }
 }
 
@@ -230,14 +258,14 @@ void handleTouchRelease(uint32_t now) {
   
   // If long press already fired, don't emit another gesture
   if (touch.longPressFired) {
-    TouchLog::printf("[Touch] RELEASE after long press (dur=%lums)\n", duration);
+    LOG_DEBUG(TouchLog, "[Touch] RELEASE after long press (dur=%lums)\n", duration);
     touch.isDown = false;
     return;
   }
 
   // Ignore very short taps (debounce)
   if (duration < DEBOUNCE_MS) {
-    TouchLog::printf("[Touch] IGNORED - too short (%lums)\n", duration);
+    LOG_DEBUG(TouchLog, "[Touch] IGNORED - too short (%lums)\n", duration);
     touch.isDown = false;
     return;
   }
@@ -247,8 +275,8 @@ void handleTouchRelease(uint32_t now) {
   int16_t deltaY = static_cast<int16_t>(touch.currentY) - static_cast<int16_t>(touch.downY);
   uint16_t totalDrift = static_cast<uint16_t>(abs(static_cast<int>(deltaX)) + abs(static_cast<int>(deltaY)));
 
-  TouchLog::printf("[Touch] Release analysis: dur=%lums, drift=%upx, dx=%d, dy=%d\n", 
-                duration, totalDrift, deltaX, deltaY);
+  LOG_DEBUG(TouchLog, "[Touch] Release analysis: dur=%lums, drift=%upx, dx=%d, dy=%d\n", 
+                      duration, totalDrift, deltaX, deltaY);
 
   TouchGesture gesture = TOUCH_TAP;
   uint16_t reportX = touch.downX;
@@ -266,25 +294,100 @@ void handleTouchRelease(uint32_t now) {
     // Report end position for swipes
     reportX = touch.currentX;
     reportY = touch.currentY;
-    TouchLog::printf("[Touch] -> Classified as SWIPE (drift %u >= %u)\n", totalDrift, SWIPE_MIN_DIST_PX);
+    LOG_DEBUG(TouchLog, "[Touch] -> Classified as SWIPE (drift %u >= %u)\n", totalDrift, SWIPE_MIN_DIST_PX);
   } else {
     // Tap (with or without small drift)
     gesture = TOUCH_TAP;
     reportX = touch.downX;
     reportY = touch.downY;
-    TouchLog::printf("[Touch] -> Classified as TAP (drift %u < %u)\n", totalDrift, SWIPE_MIN_DIST_PX);
+    LOG_DEBUG(TouchLog, "[Touch] -> Classified as TAP (drift %u < %u)\n", totalDrift, SWIPE_MIN_DIST_PX);
   }
 
-  emitGesture(gesture, reportX, reportY, duration);
+  emitGesture(gesture, reportX, reportY, duration, touch.lastReadTime);
   touch.isDown = false;
 }
 
+// One controller read (live or from a trace) through the gesture classifier.
+// touching: the read returned a valid point.
+void classifySample(uint32_t now, bool touching, uint16_t x, uint16_t y) {
+  if (touch.isDown) {
+    checkLongPress(now);
+    if (touching) {
+      // Update position (only log if significant movement)
+      uint16_t dist = calculateDistance(touch.currentX, touch.currentY, x, y);
+      if (dist > 5) {
+        LOG_TRACE(TouchLog, "[Touch] MOVE to (%d,%d), delta=(%d,%d)\n", 
+                            x, y, 
+                            (int)x - (int)touch.downX, 
+                            (int)y - (int)touch.downY);
+      }
+      handleTouchMove(x, y, now);
+    } else if ((now - touch.lastReadTime) >= RELEASE_TIMEOUT_MS) {
+      // Can't read data - released once the timeout passes
+      LOG_DEBUG(TouchLog, "[Touch] Read timeout -> RELEASE\n");
+      handleTouchRelease(now);
+    }
+    return;
+  }
+  if (touching) {
+    handleTouchDown(x, y, now);
+  }
+}
+
+// Feeds the trace samples that are due by now, each at its own time, so the
+// classifier sees the recorded timing however late this pass runs.
+void replayDue(uint32_t now) {
+  if (!replay.started) {
+    replay.started = true;
+    replay.startMs = now;
+  }
+  while (replay.haveNext && static_cast<int32_t>(now - (replay.startMs + replay.next.tMs)) >= 0) {
+    const TouchTrace::Sample& s = replay.next;
+    classifySample(replay.startMs + s.tMs, s.fingers > 0, s.x, s.y);
+    ++replay.stats.samples;
+    replay.haveNext = replay.reader.next(replay.next);
+  }
+  if (!replay.haveNext) {
+    LOG_INFO(TouchLog, "[Touch] Replay done: %lu samples, %lu gestures\n",
+                       static_cast<unsigned long>(replay.stats.samples),
+                       static_cast<unsigned long>(replay.stats.gestures));
+    TouchSystem::stopReplay();
+  }
+}
+
+#ifdef BUBU_TOUCH_RECORD
+// Prints the recorded samples as "btr <hex records>" lines once the finger
+// has been off for a while (or the buffer is nearly full), so the Serial
+// writes stay out of gestures. Chunks concatenate into one trace.
+void Record_flush(uint32_t now) {
+  if (recordWriter.records() == 0) return;
+  bool nearlyFull = recordWriter.size() + 16 * TouchTrace::RECORD_BYTES > RECORD_BUF_BYTES;
+  if (!nearlyFull && (touch.isDown || now - touch.lastReadTime < RECORD_FLUSH_IDLE_MS)) return;
+  const uint8_t* p = recordWriter.data() + TouchTrace::HEADER_BYTES;
+  uint32_t left = recordWriter.records();
+  char line[4 + RECORD_LINE_RECORDS * TouchTrace::RECORD_BYTES * 2 + 2];
+  while (left > 0) {
+    uint32_t n = left < RECORD_LINE_RECORDS ? left : RECORD_LINE_RECORDS;
+    char* out = line + snprintf(line, sizeof(line), "btr ");
+    for (uint32_t i = 0; i < n * TouchTrace::RECORD_BYTES; ++i) {
+      out += snprintf(out, 3, "%02x", p[i]);
+    }
+    *out++ = '\n';
+    *out = '\0';
+    Serial.print(line);
+    p += n * TouchTrace::RECORD_BYTES;
+    left -= n;
+  }
+  recordWriter.restart();
+}
+#endif
+
 }  // anonymous namespace
 
 namespace TouchSystem {
 
 void begin() {
-  TouchLog::println("[TouchSystem] Initializing...");
+  LOG_INFO(TouchLog, "[TouchSystem] Initializing...\n");
   
   Wire.begin(PIN_I2C_SDA, PIN_I2C_SCL);
   Wire.setClock(400000);
@@ -307,15 +410,15 @@ void begin() {
   Wire.requestFrom(CST816_ADDR, static_cast<size_t>(1), true);
   uint8_t chipID = Wire.read();
   
-  TouchLog::printf("[TouchSystem] Chip ID: 0x%02X", chipID);
+  LOG_INFO(TouchLog, "[TouchSystem] Chip ID: 0x%02X", chipID);
   if (chipID == 0xB4) {
-    TouchLog::println(" (CST816S) ✓");
+    LOG_INFO(TouchLog, " (CST816S) ✓\n");
   } else if (chipID == 0xB5) {
-    TouchLog::println(" (CST816T) ✓");
+    LOG_INFO(TouchLog, " (CST816T) ✓\n");
   } else if (chipID == 0xB6) {
-    TouchLog::println(" (CST816D) ✓");
+    LOG_INFO(TouchLog, " (CST816D) ✓\n");
   } else {
-    TouchLog::println(" (Unknown)");
+    LOG_INFO(TouchLog, " (Unknown)\n");
   }
   
   // Configure interrupt control (register 0xFA)
@@ -337,19 +440,38 @@ void begin() {
   // Setup interrupt pin
   pinMode(PIN_TCA_INT, INPUT_PULLUP);
   attachInterrupt(digitalPinToInterrupt(PIN_TCA_INT), touchISR, FALLING);
+
+#ifdef BUBU_TOUCH_RECORD
+  record(&recordWriter);
+  LOG_INFO(TouchLog, "[TouchSystem] Recording touch samples (btr lines)\n");
+#endif
+#ifdef BUBU_TOUCH_REPLAY
+  size_t traceBytes = TouchTrace::cannedSize(BUBU_TOUCH_REPLAY);
+  uint8_t* trace = traceBytes ? static_cast<uint8_t*>(heap_caps_malloc(traceBytes, MALLOC_CAP_SPIRAM)) : nullptr;
+  if (trace && TouchTrace::buildCanned(BUBU_TOUCH_REPLAY, trace, traceBytes) && startReplay(trace, traceBytes)) {
+    LOG_INFO(TouchLog, "[TouchSystem] Replaying trace %s (%u bytes)\n", BUBU_TOUCH_REPLAY,
+                       static_cast<unsigned>(traceBytes));
+  } else {
+    LOG_ERROR(TouchLog, "[TouchSystem] Cannot replay trace %s\n", BUBU_TOUCH_REPLAY);
+  }
+#endif
   
-  TouchLog::println("[TouchSystem] Ready!");
+  LOG_INFO(TouchLog, "[TouchSystem] Ready!\n");
 }
 
 void update() {
-  uint32_t now = millis();
-  static uint32_t lastUpdate = 0;
-  
-  // Limit update rate to reduce I2C bus congestion
-  if ((now - lastUpdate) < 5) {
+  // Polled once per frame task run (every 5 ms, main.cpp), which sets the
+  // I2C read rate; a gate here measured from later in the pass than the
+  // scheduler's deadline would skip reads.
+  uint32_t now = BubuClock::nowMs();
+
+  if (replay.active) {
+    replayDue(now);
     return;
   }
-  lastUpdate = now;
+#ifdef BUBU_TOUCH_RECORD
+  Record_flush(now);
+#endif
   
   // Poll TCA6408 for touch interrupt status
   Wire.beginTransmission(TCA6408_ADDR);
@@ -363,55 +485,24 @@ void update() {
     }
   }
   
-  // If touch is down, always try to read new coordinates
-  if (touch.isDown) {
-    checkLongPress(now);
-    
-    // Try to read new coordinates
-    uint8_t gestureID, fingerCount;
-    uint16_t x, y;
-    
-    if (readTouchData(gestureID, fingerCount, x, y)) {
-      if (fingerCount > 0) {
-        // Update position (only log if significant movement)
-        uint16_t dist = calculateDistance(touch.currentX, touch.currentY, x, y);
-        if (dist > 5) {
-          TouchLog::printf("[Touch] MOVE to (%d,%d), delta=(%d,%d)\n", 
-                        x, y, 
-                        (int)x - (int)touch.downX, 
-                        (int)y - (int)touch.downY);
-        }
-        handleTouchMove(x, y, now);
-      } else {
-        // Finger lifted
-        TouchLog::println("[Touch] Finger lifted -> RELEASE");
-        handleTouchRelease(now);
-        return;
-      }
-    } else {
-      // Can't read data - check timeout
-      if ((now - touch.lastReadTime) >= RELEASE_TIMEOUT_MS) {
-        TouchLog::println("[Touch] Read timeout -> RELEASE");
-        handleTouchRelease(now);
-        return;
-      }
+  // While touch is down every pass reads the controller; otherwise only
+  // after an interrupt
+  if (!touch.isDown) {
+    if (!touchInterruptFlag) {
+      return;
     }
-  }
-  
-  // Check for new touch down
-  if (!touch.isDown && touchInterruptFlag) {
     touchInterruptFlag = false;
-    
-    uint8_t gestureID, fingerCount;
-    uint16_t x, y;
-    
-    if (readTouchData(gestureID, fingerCount, x, y)) {
-      if (fingerCount > 0) {
-        handleTouchDown(x, y, now);
-        TouchLog::printf("[Touch] DOWN at (%d,%d)\n", x, y);
-      }
-    }
   }
+
+  uint8_t gestureID = 0, fingerCount = 0;
+  uint16_t x = 0, y = 0;
+  bool touching = readTouchData(gestureID, fingerCount, x, y);
+  if (recorder) {
+    TouchTrace::Sample sample = {now, touching ? x : uint16_t(0), touching ? y : uint16_t(0),
+                                 touching ? fingerCount : uint8_t(0), gestureID};
+    recorder->add(sample);
+  }
+  classifySample(now, touching, x, y);
 }
 
 bool available() {
@@ -419,6 +510,12 @@ bool available() {
 }
 
 TouchPoint get() {
+  if (eventAvailable && pendingFromReplay) {
+    uint32_t latency = BubuClock::nowMs() - pendingInputMs;
+    ++replay.stats.gestures;
+    replay.stats.latencyTotalMs += latency;
+    if (latency > replay.stats.latencyMaxMs) replay.stats.latencyMaxMs = latency;
+  }
   eventAvailable = false;
   return pendingEvent;
 }
@@ -433,7 +530,7 @@ bool isTcaActive() {
 }
 
 bool hasRecentSample(uint32_t windowMs) {
-  return (millis() - touch.lastReadTime) < windowMs;
+  return (BubuClock::nowMs() - touch.lastReadTime) < windowMs;
 }
 
 TouchPoint getLastPoint() {
@@ -458,6 +555,40 @@ bool isTouchPressed() {
   return touch.isDown;
 }
 
+void record(TouchTrace::Writer* writer) {
+  recorder = writer;
+}
+
+bool startReplay(const uint8_t* trace, size_t len) {
+  stopReplay();
+  if (!replay.reader.open(trace, len)) {
+    return false;
+  }
+  replay.stats = {};
+  replay.started = false;
+  replay.haveNext = replay.reader.next(replay.next);
+  replay.active = true;
+  return true;
+}
+
+void stopReplay() {
+  if (!replay.active) {
+    return;
+  }
+  replay.active = false;
+  // Drop a touch the trace left down, and anything the hardware flagged meanwhile
+  touch.isDown = false;
+  touchInterruptFlag = false;
+}
+
+bool isReplaying() {
+  return replay.active;
+}
+
+ReplayStats replayStats() {
+  return replay.stats;
+}
+
 bool consumeTcaInterrupt() {
   bool fired = false;
   noInterrupts();
@@ -0,0 +1,268 @@
+#include "touch_trace.h"
+
+#include <string.h>
+
+namespace {
+
+constexpr uint8_t MAGIC[3] = {'B', 'T', 'R'};
+
+// CST816 gesture register values (see touch_system.cpp)
+constexpr uint8_t HW_SWIPE_UP = 0x01;
+constexpr uint8_t HW_SWIPE_DOWN = 0x02;
+constexpr uint8_t HW_SWIPE_LEFT = 0x03;
+constexpr uint8_t HW_SWIPE_RIGHT = 0x04;
+constexpr uint8_t HW_SINGLE_CLICK = 0x05;
+constexpr uint8_t HW_LONG_PRESS = 0x0C;
+
+void putU32(uint8_t* p, uint32_t v) {
+  p[0] = static_cast<uint8_t>(v);
+  p[1] = static_cast<uint8_t>(v >> 8);
+  p[2] = static_cast<uint8_t>(v >> 16);
+  p[3] = static_cast<uint8_t>(v >> 24);
+}
+
+uint32_t getU32(const uint8_t* p) {
+  return p[0] | (p[1] << 8) | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// --- canned scripts ---
+
+constexpr uint32_t READ_MS = 5;          // TouchSystem::update() rate
+constexpr uint32_t LIFT_READS_MS = 150;  // failed reads until the classifier's release timeout
+constexpr uint32_t CHIP_LONG_PRESS_MS = 500;
+constexpr uint16_t SWIPE_TRAVEL_PX = 40;
+
+enum class Op : uint8_t { WAIT, TOUCH, END };
+
+struct Step {
+  Op op;
+  uint8_t x0, y0, x1, y1;
+  uint16_t ms;  // WAIT: pause, TOUCH: contact time
+};
+
+constexpr Step Wait(uint16_t ms) { return {Op::WAIT, 0, 0, 0, 0, ms}; }
+constexpr Step Tap(uint8_t x, uint8_t y) { return {Op::TOUCH, x, y, x, y, 80}; }
+constexpr Step Hold(uint8_t x, uint8_t y) { return {Op::TOUCH, x, y, x, y, 700}; }
+constexpr Step Swipe(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) { return {Op::TOUCH, x0, y0, x1, y1, 150}; }
+constexpr Step End() { return {Op::END, 0, 0, 0, 0, 0}; }
+
+// The eyes cover x 35-205, y 80-160; the selected menu item sits at the
+// centre; the menu list steps to the next item on SWIPE_DOWN.
+constexpr Step OPEN_MENU = Tap(120, 30);
+constexpr Step ENTER = Tap(120, 120);
+constexpr Step NEXT = Swipe(120, 90, 120, 150);
+constexpr Step PREV = Swipe(120, 150, 120, 90);
+constexpr Step STAT_NEXT = Swipe(90, 120, 150, 120);
+constexpr Step STAT_PREV = Swipe(150, 120, 90, 120);
+constexpr Step EXIT = Hold(120, 215);  // off the eyes, so it also ends a game
+
+const Step MENU_BROWSE[] = {
+  Wait(2000), OPEN_MENU, Wait(600),
+  NEXT, Wait(400), NEXT, Wait(400), NEXT, Wait(400), NEXT, Wait(400),
+  NEXT, Wait(400), NEXT, Wait(400), NEXT, Wait(400), NEXT, Wait(400),
+  PREV, Wait(400), PREV, Wait(400), PREV, Wait(400),
+  NEXT, Wait(400), NEXT, Wait(600),  // Stats
+  ENTER, Wait(800),
+  STAT_NEXT, Wait(500), STAT_NEXT, Wait(500), STAT_NEXT, Wait(500),
+  STAT_PREV, Wait(500), STAT_PREV, Wait(500), STAT_PREV, Wait(500),
+  EXIT, Wait(600), EXIT, Wait(1500),
+  End()
+};
+
+const Step GAME_SESSION[] = {
+  Wait(2000), OPEN_MENU, Wait(600), NEXT, Wait(600),  // Play
+  ENTER, Wait(1500),
+  Tap(75, 120), Wait(600), Tap(165, 120), Wait(600), Tap(120, 60), Wait(600), Tap(75, 100), Wait(600),
+  Tap(165, 140), Wait(600), Tap(60, 190), Wait(600), Tap(165, 100), Wait(600), Tap(75, 140), Wait(600),
+  Tap(180, 190), Wait(600), Tap(75, 120), Wait(600), Tap(165, 120), Wait(600), Tap(120, 200), Wait(600),
+  Tap(90, 110), Wait(600), Tap(150, 130), Wait(600), Tap(60, 50), Wait(600), Tap(165, 110), Wait(600),
+  Tap(75, 130), Wait(600), Tap(165, 120), Wait(600), Tap(75, 120), Wait(600), Tap(200, 40), Wait(600),
+  // A wrong tap ends the game and the next tap restarts it, so the game may
+  // or may not be running here: game -> games menu -> menu (Play was opened
+  // from it) -> eyes, and a hold on the eyes is ignored.
+  EXIT, Wait(800), EXIT, Wait(800), EXIT, Wait(600), EXIT, Wait(1500),
+  End()
+};
+
+const Step LONG_PRESS_EXITS[] = {
+  Wait(2000), OPEN_MENU, Wait(600),
+  NEXT, Wait(400), NEXT, Wait(400), NEXT, Wait(400), NEXT, Wait(600),  // Connect
+  ENTER, Wait(800), EXIT, Wait(600),
+  NEXT, Wait(600), ENTER, Wait(800), EXIT, Wait(600),                  // Message
+  NEXT, Wait(600), ENTER, Wait(800), EXIT, Wait(600),                  // Battery
+  NEXT, Wait(400), NEXT, Wait(600), ENTER, Wait(800), EXIT, Wait(600),  // Level
+  EXIT, Wait(1500),
+  End()
+};
+
+struct Canned {
+  const char* name;
+  const char* description;
+  const Step* steps;
+};
+
+const Canned CANNED[] = {
+  {"menu_browse", "open the menu, swipe through every item, page through Stats, long-press out", MENU_BROWSE},
+  {"game_session", "start Tap the Greens from the menu, 20 taps, long-press back to the eyes", GAME_SESSION},
+  {"long_press_exits", "open Connect, Message, Battery and Level and long-press out of each", LONG_PRESS_EXITS},
+};
+constexpr uint8_t CANNED_COUNT = sizeof(CANNED) / sizeof(CANNED[0]);
+
+const Canned* findCanned(const char* name) {
+  for (const Canned& c : CANNED) {
+    if (!strcmp(c.name, name)) return &c;
+  }
+  return nullptr;
+}
+
+uint8_t chipGesture(const Step& s, uint32_t heldMs, bool last) {
+  int dx = s.x1 - s.x0;
+  int dy = s.y1 - s.y0;
+  int adx = dx < 0 ? -dx : dx;
+  int ady = dy < 0 ? -dy : dy;
+  if (adx + ady >= SWIPE_TRAVEL_PX) {
+    if (!last) return 0;
+    if (adx > ady) return dx > 0 ? HW_SWIPE_RIGHT : HW_SWIPE_LEFT;
+    return dy > 0 ? HW_SWIPE_DOWN : HW_SWIPE_UP;
+  }
+  if (heldMs >= CHIP_LONG_PRESS_MS) return HW_LONG_PRESS;
+  return last && s.ms < CHIP_LONG_PRESS_MS ? HW_SINGLE_CLICK : 0;
+}
+
+bool synthesize(const Step* steps, TouchTrace::Writer& w) {
+  uint32_t t = 0;
+  for (const Step* s = steps; s->op != Op::END; ++s) {
+    if (s->op == Op::WAIT) {
+      t += s->ms;
+      continue;
+    }
+    for (uint32_t held = 0; held <= s->ms; held += READ_MS) {
+      TouchTrace::Sample smp;
+      smp.tMs = t + held;
+      smp.x = static_cast<uint16_t>(s->x0 + (static_cast<int>(s->x1) - s->x0) * static_cast<int>(held) / s->ms);
+      smp.y = static_cast<uint16_t>(s->y0 + (static_cast<int>(s->y1) - s->y0) * static_cast<int>(held) / s->ms);
+      smp.fingers = 1;
+      smp.gesture = chipGesture(*s, held, held + READ_MS > s->ms);
+      if (!w.add(smp)) return false;
+    }
+    t += s->ms;
+    for (uint32_t after = READ_MS; after <= LIFT_READS_MS; after += READ_MS) {
+      TouchTrace::Sample none = {t + after, 0, 0, 0, 0};
+      if (!w.add(none)) return false;
+    }
+    t += LIFT_READS_MS;
+  }
+  // A last idle read, so a trailing wait is part of the trace
+  TouchTrace::Sample idle = {t, 0, 0, 0, 0};
+  return w.add(idle);
+}
+
+}  // namespace
+
+namespace TouchTrace {
+
+Writer::Writer(uint8_t* buf, size_t cap, uint32_t startMs)
+    : buf_(buf), cap_(cap), len_(0), records_(0), lastMs_(startMs) {
+  restart();
+}
+
+void Writer::restart() {
+  records_ = 0;
+  if (cap_ < HEADER_BYTES) {
+    cap_ = 0;
+    return;
+  }
+  len_ = HEADER_BYTES;
+  if (!buf_) return;
+  memcpy(buf_, MAGIC, sizeof(MAGIC));
+  buf_[3] = VERSION;
+  putU32(buf_ + 4, 0);
+}
+
+bool Writer::put(uint16_t dt, uint8_t x, uint8_t y, uint8_t packed) {
+  if (len_ + RECORD_BYTES > cap_) return false;
+  if (buf_) {
+    uint8_t* p = buf_ + len_;
+    p[0] = static_cast<uint8_t>(dt);
+    p[1] = static_cast<uint8_t>(dt >> 8);
+    p[2] = x;
+    p[3] = y;
+    p[4] = packed;
+    putU32(buf_ + 4, records_ + 1);
+  }
+  len_ += RECORD_BYTES;
+  ++records_;
+  return true;
+}
+
+bool Writer::add(const Sample& s) {
+  uint32_t dt = s.tMs - lastMs_;
+  while (dt > 0xFFFF) {
+    if (!put(0xFFFF, 0, 0, GAP_FINGERS)) return false;
+    lastMs_ += 0xFFFF;
+    dt -= 0xFFFF;
+  }
+  uint8_t fingers = s.fingers < GAP_FINGERS ? s.fingers : GAP_FINGERS - 1;
+  uint8_t x = static_cast<uint8_t>(s.x < 0xFF ? s.x : 0xFF);
+  uint8_t y = static_cast<uint8_t>(s.y < 0xFF ? s.y : 0xFF);
+  if (!put(static_cast<uint16_t>(dt), x, y, static_cast<uint8_t>((s.gesture << 4) | fingers))) return false;
+  lastMs_ = s.tMs;
+  return true;
+}
+
+bool Reader::open(const uint8_t* data, size_t len) {
+  data_ = nullptr;
+  if (!data || len < HEADER_BYTES || memcmp(data, MAGIC, sizeof(MAGIC)) || data[3] != VERSION) return false;
+  uint32_t records = getU32(data + 4);
+  if (records > (len - HEADER_BYTES) / RECORD_BYTES) return false;
+  data_ = data;
+  records_ = records;
+  pos_ = 0;
+  tMs_ = 0;
+  return true;
+}
+
+bool Reader::next(Sample& out) {
+  while (data_ && pos_ < records_) {
+    const uint8_t* p = data_ + HEADER_BYTES + pos_ * RECORD_BYTES;
+    ++pos_;
+    tMs_ += p[0] | (p[1] << 8);
+    uint8_t fingers = p[4] & 0x0F;
+    if (fingers == GAP_FINGERS) continue;
+    out.tMs = tMs_;
+    out.x = p[2];
+    out.y = p[3];
+    out.fingers = fingers;
+    out.gesture = p[4] >> 4;
+    return true;
+  }
+  return false;
+}
+
+uint8_t cannedCount() {
+  return CANNED_COUNT;
+}
+
+const char* cannedName(uint8_t index) {
+  return index < CANNED_COUNT ? CANNED[index].name : nullptr;
+}
+
+const char* cannedDescription(uint8_t index) {
+  return index < CANNED_COUNT ? CANNED[index].description : nullptr;
+}
+
+size_t buildCanned(const char* name, uint8_t* out, size_t cap) {
+  const Canned* c = findCanned(name);
+  if (!c || !out) return 0;
+  Writer w(out, cap, 0);
+  return synthesize(c->steps, w) ? w.size() : 0;
+}
+
+size_t cannedSize(const char* name) {
+  const Canned* c = findCanned(name);
+  if (!c) return 0;
+  Writer w(nullptr, SIZE_MAX, 0);
+  return synthesize(c->steps, w) ? w.size() : 0;
+}
+
+}  // namespace TouchTrace
@@ -1,27 +1,25 @@
 #include "wifi_service.h"
 #include <WiFi.h>
-#include <WebServer.h>
-#include <DNSServer.h>
 #include <vector>
 #include <Preferences.h>
+#include "json/json_stream.h"
+#include "portal/portal_server.h"
 #include "logger.h"
+#include "flight_recorder.h"
 DEFINE_MODULE_LOGGER(WifiLog)
 
 namespace {
   constexpr uint32_t CONNECT_TIMEOUT_MS = 15000;
   constexpr uint32_t PROVISION_TIMEOUT_MS = 180000;
   const char* AP_SSID = "BUBU-SETUP";
-  constexpr bool WIFI_PROVISION_LOGS = false;
-  constexpr bool WIFI_LOGS = false;
-
-#define WIFI_PROV_LOG(MSG) \
-  do {                     \
-    if (WIFI_PROVISION_LOGS) { WifiLog::println(MSG); } \
-  } while (0)
-#define WIFI_PROV_LOGF(FMT, ...) \
-  do {                           \
-    if (WIFI_PROVISION_LOGS) { WifiLog::printf((FMT), __VA_ARGS__); } \
-  } while (0)
+  // Fast connect: one directed connect (cached BSSID + channel) before scanning.
+  constexpr uint32_t FAST_CONNECT_TIMEOUT_MS = 5000;
+  // Reuse the cached DHCP lease as a static IP on fast connect (skips DHCP).
+  // Off by default: a lease that expired meanwhile could collide on the LAN.
+  constexpr bool WIFI_REUSE_LEASE = false;
+  constexpr uint8_t FAST_CONNECT_VERSION = 1;
+  constexpr size_t SCAN_JSON_SIZE = 1536;  // /scan reply; the portal shows at most 8
+  constexpr size_t SCAN_JSON_MAX_NETS = 16;
 
   WifiState state = WifiState::OFF;
   uint32_t connectStartMs = 0;
@@ -33,77 +31,30 @@ namespace {
   bool autoScanInProgress = false;
 
   bool provisioning = false;
-  WebServer webServer(80);
-  DNSServer dnsServer;
   std::vector<String> scannedSsids;
   std::vector<int32_t> scannedRssi;
-  String targetSsid;
-  String targetPass;
-  struct KnownNet { String ssid; String pass; };
+  char scanJson[SCAN_JSON_SIZE];
+  // Per-slot fast-connect cache, stored as "fc0"/"fc1" next to ssidN/passN.
+  struct FastConnect {
+    uint8_t version;
+    uint8_t channel;
+    uint8_t bssid[6];
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t mask;
+    uint32_t dns;
+  };
+  struct KnownNet { String ssid; String pass; uint8_t slot; bool hasFast; FastConnect fast; };
   std::vector<KnownNet> known;
   Preferences prefs;
 
-  const char PORTAL_HTML[] PROGMEM = R"HTML(<!DOCTYPE html>
-<html lang="en">
-<head>
-<meta charset="UTF-8"><meta name="viewport" content="width=device-width, initial-scale=1.0"><title>BUBU Setup</title>
-<style>
-  :root{--eye-width:64px;--eye-height:64px;--eye-gap:22px;--text-color:#fff;--bg:#000;}
-  *{box-sizing:border-box;}
-  body{margin:0;width:100vw;height:100vh;background:var(--bg);color:var(--text-color);font-family:"Inter","Helvetica Neue",Arial,sans-serif;overflow:hidden;display:flex;align-items:center;justify-content:center;position:relative;}
-  .layer{position:absolute;inset:0;display:flex;align-items:center;justify-content:center;pointer-events:none;}
-  #message{position:absolute;top:32%;width:90%;max-width:320px;text-align:center;font-size:18px;letter-spacing:0.5px;opacity:0;transition:opacity var(--text-fade) linear;z-index:3;pointer-events:none;}
-  #eyes{gap:var(--eye-gap);z-index:2;opacity:0;transition:opacity var(--eyes-fade) linear;}
-  .eye{width:var(--eye-width);height:var(--eye-height);background:#fff;border-radius:16px;transform-origin:center;}
-  .blink{animation:blink var(--blink-duration) ease-in-out forwards;}
-  @keyframes blink{0%{transform:scaleY(1);}45%{transform:scaleY(0.08);}100%{transform:scaleY(1);}}
-  #bubbles{position:absolute;inset:0;z-index:1;pointer-events:none;}
-  .bubble{position:absolute;color:#fff;border-radius:50%;display:flex;align-items:center;justify-content:center;text-align:center;padding:6px;font-size:12px;opacity:0;transform:translateY(0);pointer-events:auto;overflow:hidden;}
-  .bubble::after{content:"";position:absolute;width:80%;height:80%;background:#000;border-radius:50%;top:10%;left:10%;z-index:1;}
-  .bubble span{position:relative;z-index:2;}
-  .bubble.show{animation:bubbleFadeIn var(--bubble-fade) ease forwards,bubbleFloat var(--bubble-float) ease-in-out infinite alternate;}
-  .bubble.nofloat{animation:bubbleFadeIn var(--bubble-fade) ease forwards!important;}
-  .bubble.dim{opacity:0.3!important;}
-  .bubble.selected{transition:transform 300ms ease,opacity 200ms linear;transform:translate(-50%,-50%) scale(1);left:50%!important;top:50%!important;z-index:4;}
-  .bubble.pulsing{animation:bubblePulse var(--connect-pulse) ease-in-out infinite;}
-  @keyframes bubbleFadeIn{from{opacity:0;}to{opacity:1;}}
-  @keyframes bubbleFloat{from{transform:translateY(0);}to{transform:translateY(-10px);}}
-  @keyframes bubblePulse{0%{transform:translate(-50%,-50%) scale(1);}50%{transform:translate(-50%,-50%) scale(1.15);}100%{transform:translate(-50%,-50%) scale(1);}}
-  #form{position:absolute;top:65%;width:80%;max-width:320px;display:flex;flex-direction:column;gap:10px;opacity:0;pointer-events:none;transition:opacity 300ms ease;z-index:4;}
-  #form.show{opacity:1;pointer-events:auto;}
-  input,button{width:100%;padding:10px 12px;border:1px solid rgba(255,255,255,0.3);background:rgba(255,255,255,0.06);color:#fff;border-radius:6px;font-size:14px;}
-  button{border:1px solid rgba(255,255,255,0.5);background:rgba(255,255,255,0.12);}
-  #successText{position:absolute;top:18%;width:90%;max-width:320px;text-align:center;font-size:18px;letter-spacing:0.5px;opacity:0;z-index:3;pointer-events:none;}
-  @keyframes eyesPop{0%{transform:scale(1);}50%{transform:scale(1.1);}100%{transform:scale(1);}}
-</style>
-</head>
-<body>
-  <div id="message">HELLO! ARE YOU GOING TO SHOW ME THE WORLD?</div>
-  <div id="eyes" class="layer"><div class="eye"></div><div class="eye"></div></div>
-  <div id="bubbles"></div>
-  <div id="form"><input id="password" type="password" placeholder="Password (leave blank if open)"><button id="connectBtn" type="button">Connect</button></div>
-  <div id="successText">WOW! THANKS!</div>
-<script>
-const TIMING={EYES_FADE_IN:800,BLINK_DURATION:160,BLINK_GAP:220,TEXT_FADE_IN:700,BUBBLE_FADE_IN:600,BUBBLE_FLOAT_PERIOD:6000,CONNECT_PULSE_PERIOD:900};
-const COLORS=["#FF6B6B","#FFD93D","#6BCB77","#4D96FF","#9D4EDD","#F28482","#F7B801","#3AB0FF"];
-document.documentElement.style.setProperty('--eyes-fade',TIMING.EYES_FADE_IN+'ms');document.documentElement.style.setProperty('--blink-duration',TIMING.BLINK_DURATION+'ms');document.documentElement.style.setProperty('--text-fade',TIMING.TEXT_FADE_IN+'ms');document.documentElement.style.setProperty('--bubble-fade',TIMING.BUBBLE_FADE_IN+'ms');document.documentElement.style.setProperty('--bubble-float',TIMING.BUBBLE_FLOAT_PERIOD+'ms');document.documentElement.style.setProperty('--connect-pulse',TIMING.CONNECT_PULSE_PERIOD+'ms');
-const STATES={INTRO:'INTRO',EYES_VISIBLE:'EYES_VISIBLE',TEXT_VISIBLE:'TEXT_VISIBLE',WIFI_SELECTION:'WIFI_SELECTION',PASSWORD_INPUT:'PASSWORD_INPUT',CONNECTING:'CONNECTING',SUCCESS:'SUCCESS'};
-let state=STATES.INTRO,bubbles=[],selectedBubble=null;
-const eyesEl=document.getElementById('eyes'),messageEl=document.getElementById('message'),bubblesEl=document.getElementById('bubbles'),formEl=document.getElementById('form'),passwordEl=document.getElementById('password'),connectBtn=document.getElementById('connectBtn'),successTextEl=document.getElementById('successText');
-const setState=s=>{console.log('State ->',s);state=s;};
-const wait=ms=>new Promise(r=>setTimeout(r,ms));
-async function runIntro(){setState(STATES.INTRO);eyesEl.style.opacity='1';await wait(TIMING.EYES_FADE_IN);setState(STATES.EYES_VISIBLE);await doBlinkSequence(2);messageEl.style.opacity='1';await wait(TIMING.TEXT_FADE_IN);setState(STATES.TEXT_VISIBLE);await startWifiSelection();}
-async function doBlinkSequence(c){const eyes=[...document.querySelectorAll('.eye')];for(let i=0;i<c;i++){eyes.forEach(e=>{e.classList.remove('blink');void e.offsetWidth;e.classList.add('blink');});await wait(TIMING.BLINK_DURATION+TIMING.BLINK_GAP);}}
-const mapRssiToSize=r=>{const min=-90,max=-30,cl=Math.max(min,Math.min(max,r||-80)),t=(cl-min)/(max-min);return 100+t*(200-100);};
-async function fetchNetworks(){try{const r=await fetch('/scan');if(!r.ok)throw new Error('scan failed');const d=await r.json();return Array.isArray(d)?d:[]}catch(e){console.warn('Scan failed',e);return[]}}
-function placeBubbles(nets){bubbles=[];bubblesEl.innerHTML='';const w=innerWidth,h=innerHeight,taken=[];const avoid={x1:w/2-140,x2:w/2+140,y1:h*0.18,y2:h*0.7};nets.slice(0,8).forEach((net,idx)=>{const size=mapRssiToSize(net.rssi),radius=size/2,margin=20;let x=0,y=0;if(idx===0){x=w/2;y=h*0.55;}else{let tries=0;do{x=margin+radius+Math.random()*(w-2*(margin+radius));y=margin+radius+Math.random()*(h-2*(margin+radius));tries++;}while(tries<20&&((x>avoid.x1&&x<avoid.x2&&y>avoid.y1&&y<avoid.y2)||taken.some(p=>{const dx=p.x-x,dy=p.y-y,dist=Math.sqrt(dx*dx+dy*dy);return dist<(p.r+radius+12);})));}taken.push({x,y,r:radius});const div=document.createElement('div');div.className='bubble';if(idx===0)div.classList.add('nofloat');div.style.background=COLORS[idx%COLORS.length];div.style.width=`${size}px`;div.style.height=`${size}px`;div.style.left=`${x-radius}px`;div.style.top=`${y-radius}px`;const label=document.createElement('span');label.textContent=net.ssid||'(hidden)';div.appendChild(label);div.dataset.ssid=net.ssid||'';div.dataset.rssi=net.rssi||'';bubblesEl.appendChild(div);bubbles.push(div);});}
-function showBubbles(){bubbles.forEach(b=>{b.classList.add('show');b.addEventListener('click',()=>handleBubbleSelect(b));});}
-async function startWifiSelection(){setState(STATES.WIFI_SELECTION);const nets=await fetchNetworks();nets.sort((a,b)=>(b.rssi||-999)-(a.rssi||-999));placeBubbles(nets.slice(0,8));if(bubbles.length>0){const b=bubbles[0];const rect=b.getBoundingClientRect();b.style.left=`calc(50% - ${rect.width/2}px)`;b.style.top=`calc(55% - ${rect.height/2}px)`;b.classList.add('show');b.removeEventListener('click',()=>{});}showBubbles();}
-function handleBubbleSelect(el){if(state!==STATES.WIFI_SELECTION&&state!==STATES.PASSWORD_INPUT)return;selectedBubble=el;setState(STATES.PASSWORD_INPUT);bubbles.forEach(b=>{if(b!==el)b.classList.add('dim');});el.classList.add('selected');formEl.classList.add('show');passwordEl.focus();}
-async function handleConnect(){if(!selectedBubble)return;setState(STATES.CONNECTING);selectedBubble.classList.add('pulsing');connectBtn.disabled=true;const payload={ssid:selectedBubble.dataset.ssid,pass:passwordEl.value||''};try{const res=await fetch('/save',{method:'POST',headers:{'Content-Type':'application/x-www-form-urlencoded'},body:`ssid=${encodeURIComponent(payload.ssid)}&pass=${encodeURIComponent(payload.pass)}`});if(!res.ok)throw new Error('connect failed');await showSuccess();}catch(e){console.warn('Connect failed',e);connectBtn.disabled=false;selectedBubble.classList.remove('pulsing');setState(STATES.PASSWORD_INPUT);}}
-async function showSuccess(){setState(STATES.SUCCESS);bubbles.forEach(b=>b.style.opacity='0');formEl.classList.remove('show');eyesEl.style.animation=`eyesPop 400ms ease`;await wait(400);eyesEl.style.animation='';messageEl.style.opacity='0';await wait(200);successTextEl.style.opacity='1';}
-connectBtn.addEventListener('click',handleConnect);window.addEventListener('load',runIntro);
-</script></body></html>)HTML";
+  bool fastConnectActive = false;
+  bool leaseApplied = false;
+  uint8_t lastSlot = 0;           // slot that connected last ("fcl")
+  uint32_t radioOnSinceMs = 0;    // 0 = radio off
+  uint32_t radioOnTotalMs = 0;    // since boot
+  uint32_t connectAttemptMs = 0;  // radio on -> connected, for the boot report
+  uint32_t lastConnectMs = 0;
 
   const char* stateToStr(WifiState s) {
     switch (s) {
@@ -119,18 +70,19 @@ connectBtn.addEventListener('click',handleConnect);window.addEventListener('load
   void setState(WifiState newState) {
     if (state == newState) return;
     state = newState;
+    FlightRecorder::record(FlightRecorder::Event::WIFI, static_cast<uint8_t>(state));
     switch (state) {
       case WifiState::PROVISIONING:
-        WIFI_PROV_LOG("WiFi: PROVISIONING (AP)");
+        LOG_DEBUG(WifiLog, "WiFi: PROVISIONING (AP)\n");
         break;
       case WifiState::CONNECTING:
-        if (WIFI_LOGS) WifiLog::println("WiFi: CONNECTING");
+        LOG_DEBUG(WifiLog, "WiFi: CONNECTING\n");
         break;
       case WifiState::CONNECTED:
-        if (WIFI_LOGS) WifiLog::printf("WiFi: CONNECTED, IP=%s\n", ipStr.c_str());
+        LOG_DEBUG(WifiLog, "WiFi: CONNECTED, IP=%s\n", ipStr.c_str());
         break;
       case WifiState::FAILED:
-        if (WIFI_LOGS) WifiLog::println("WiFi: FAILED");
+        LOG_DEBUG(WifiLog, "WiFi: FAILED\n");
         break;
       case WifiState::OFF:
       default:
@@ -139,69 +91,138 @@ connectBtn.addEventListener('click',handleConnect);window.addEventListener('load
   }
 
   void stopServers() {
-    dnsServer.stop();
-    webServer.stop();
+    PortalServer::stop();
     lastProvisionLogMs = 0;
   }
 
-  void handleRoot() {
-    webServer.send_P(200, "text/html", PORTAL_HTML);
+  void radioOn() {
+    if (radioOnSinceMs == 0) radioOnSinceMs = millis() | 1;
+    if (connectAttemptMs == 0) connectAttemptMs = millis() | 1;
   }
 
-  void handleCaptive() {
-    // Always send the portal page for captive portal probes
-    webServer.sendHeader("Location", String("http://") + WiFi.softAPIP().toString(), true);
-    webServer.send(302, "text/plain", "Redirecting to setup...");
+  void radioOff() {
+    if (radioOnSinceMs == 0) return;
+    uint32_t on = millis() - radioOnSinceMs;
+    radioOnTotalMs += on;
+    radioOnSinceMs = 0;
+    LOG_INFO(WifiLog, "WiFi: radio off after %lu ms (boot total %lu ms)\n",
+                      static_cast<unsigned long>(on), static_cast<unsigned long>(radioOnTotalMs));
   }
 
-  void handleSave() {
-    String chosenSsid;
-    if (webServer.hasArg("ssid_manual") && webServer.arg("ssid_manual").length() > 0) {
-      chosenSsid = webServer.arg("ssid_manual");
-    } else if (webServer.hasArg("ssid")) {
-      chosenSsid = webServer.arg("ssid");
+  KnownNet* knownBySsid(const String& ssid) {
+    for (auto& k : known) {
+      if (k.ssid == ssid) return &k;
     }
-    if (chosenSsid.length() == 0) {
-      webServer.send(400, "text/plain", "SSID required");
+    return nullptr;
+  }
+
+  void clearLease() {
+    if (!leaseApplied) return;
+    WiFi.config(IPAddress(static_cast<uint32_t>(0)), IPAddress(static_cast<uint32_t>(0)),
+                IPAddress(static_cast<uint32_t>(0)));
+    leaseApplied = false;
+  }
+
+  // Remember how we reached this AP; only writes NVS when something changed.
+  void saveFastConnect() {
+    KnownNet* k = knownBySsid(WiFi.SSID());
+    if (!k) return;
+    FastConnect fc = {};
+    fc.version = FAST_CONNECT_VERSION;
+    fc.channel = static_cast<uint8_t>(WiFi.channel());
+    const uint8_t* bssid = WiFi.BSSID();
+    if (!bssid) return;
+    memcpy(fc.bssid, bssid, sizeof(fc.bssid));
+    fc.ip = WiFi.localIP();
+    fc.gateway = WiFi.gatewayIP();
+    fc.mask = WiFi.subnetMask();
+    fc.dns = WiFi.dnsIP();
+    bool same = k->hasFast && memcmp(&k->fast, &fc, sizeof(fc)) == 0;
+    if (same && lastSlot == k->slot) return;
+    if (!prefs.begin("wifi", false)) return;
+    char key[4] = {'f', 'c', static_cast<char>('0' + k->slot), '\0'};
+    if (!same) prefs.putBytes(key, &fc, sizeof(fc));
+    prefs.putUChar("fcl", k->slot);
+    prefs.end();
+    k->fast = fc;
+    k->hasFast = true;
+    lastSlot = k->slot;
+  }
+
+  void onConnected() {
+    ipStr = WiFi.localIP().toString();
+    bool viaFast = fastConnectActive;
+    fastConnectActive = false;
+    setState(WifiState::CONNECTED);
+    if (connectAttemptMs) {
+      lastConnectMs = millis() - connectAttemptMs;
+      connectAttemptMs = 0;
+    }
+    LOG_INFO(WifiLog, "WiFi: connected in %lu ms (%s, ch %ld)\n",
+                      static_cast<unsigned long>(lastConnectMs), viaFast ? "fast" : "scan",
+                      static_cast<long>(WiFi.channel()));
+    saveFastConnect();
+  }
+
+  // One quick async scan to see if any known SSID is visible; wifiUpdate picks it up.
+  void startKnownScan() {
+    int n = WiFi.scanNetworks(true, true);
+    if (n == WIFI_SCAN_FAILED) {
+      wifiStop();
       return;
     }
-    targetSsid = chosenSsid;
-    targetPass = webServer.hasArg("pass") ? webServer.arg("pass") : "";
-    webServer.send(200, "text/plain", "Connecting...");
+    autoScanInProgress = true;
+  }
+
+  // Credentials posted to the portal; runs on the loop task via wifiUpdate().
+  void applyCredentials(const PortalServer::Credentials& c) {
     stopServers();
     WiFi.softAPdisconnect(true);
     provisioning = false;
     lastProvisionLogMs = 0;
     WiFi.mode(WIFI_STA);
     WiFi.setSleep(false);
-    WiFi.begin(targetSsid.c_str(), targetPass.c_str());
-    // Persist as primary known network (slot 0)
+    WiFi.begin(c.ssid, c.pass);
+    // Persist as primary known network (slot 0); its fast-connect entry is stale.
     if (prefs.begin("wifi", false)) {
-      prefs.putString("ssid0", targetSsid);
-      prefs.putString("pass0", targetPass);
+      prefs.putString("ssid0", c.ssid);
+      prefs.putString("pass0", c.pass);
+      prefs.remove("fc0");
       prefs.end();
     }
+    for (auto it = known.begin(); it != known.end(); ++it) {
+      if (it->slot == 0) {
+        known.erase(it);
+        break;
+      }
+    }
+    KnownNet fresh;
+    fresh.ssid = c.ssid;
+    fresh.pass = c.pass;
+    fresh.slot = 0;
+    fresh.hasFast = false;
+    known.insert(known.begin(), fresh);
     connectStartMs = millis();
     setState(WifiState::CONNECTING);
   }
 
-  void handleScan() {
-    String json = "[";
+  // Fills scanJson for the portal's /scan; built once, the list is fixed per session.
+  size_t buildScanJson() {
+    JsonWriter json(scanJson, sizeof(scanJson));
+    json.beginArray();
     size_t count = scannedSsids.size();
+    if (count > SCAN_JSON_MAX_NETS) count = SCAN_JSON_MAX_NETS;
     for (size_t i = 0; i < count; ++i) {
-      json += "{\"ssid\":\"";
-      json += scannedSsids[i];
-      json += "\",\"rssi\":";
-      if (i < scannedRssi.size()) {
-        json += scannedRssi[i];
-      } else {
-        json += 0;
+      JsonWriter::Mark m = json.mark();
+      int32_t rssi = (i < scannedRssi.size()) ? scannedRssi[i] : 0;
+      json.beginObject().field("ssid", scannedSsids[i].c_str()).field("rssi", rssi).endObject();
+      if (!json.ok()) {  // out of room: drop this entry, keep the array valid
+        json.rewind(m);
+        break;
       }
-      json += "}";
-      if (i + 1 < count) json += ",";
     }
-    json += "]";
-    webServer.send(200, "application/json", json);
+    json.endArray();
+    return json.length();
   }
 
   void placeStrongestCenter() {
@@ -236,7 +257,7 @@ connectBtn.addEventListener('click',handleConnect);window.addEventListener('load
   }
 
   void startProvisioning() {
-    WIFI_PROV_LOG("WiFi: starting provisioning (AP-only)");
+    LOG_DEBUG(WifiLog, "WiFi: starting provisioning (AP-only)\n");
     stopServers();
     provisioning = false;
     lastProvisionLogMs = 0;
@@ -247,14 +268,15 @@ connectBtn.addEventListener('click',handleConnect);window.addEventListener('load
     WiFi.disconnect(true, false);  // disconnect but keep stored credentials
     bool modeOk = WiFi.mode(WIFI_AP_STA);
     WiFi.setSleep(false);
+    radioOn();
     delay(100);
-    WIFI_PROV_LOGF("WiFi: mode set to AP_STA (ok=%d, mode=%d)\n", modeOk, WiFi.getMode());
+    LOG_DEBUG(WifiLog, "WiFi: mode set to AP_STA (ok=%d, mode=%d)\n", modeOk, WiFi.getMode());
 
     // Scan once for nearby SSIDs
     scannedSsids.clear();
     scannedRssi.clear();
     int n = WiFi.scanNetworks(false, true);
-      WIFI_PROV_LOGF("WiFi: scan complete, found %d networks\n", n);
+      LOG_DEBUG(WifiLog, "WiFi: scan complete, found %d networks\n", n);
     for (int i = 0; i < n; ++i) {
       String ssid = WiFi.SSID(i);
       if (ssid.length()) {
@@ -289,35 +311,29 @@ connectBtn.addEventListener('click',handleConnect);window.addEventListener('load
     WiFi.softAPConfig(apIP, apGW, apMask);
     bool apOk = WiFi.softAP(AP_SSID, nullptr, 1, false, 4);
     if (!apOk) {
-      WIFI_PROV_LOG("WiFi: softAP primary start failed, retrying with defaults");
+      LOG_WARN(WifiLog, "WiFi: softAP primary start failed, retrying with defaults\n");
       apOk = WiFi.softAP(AP_SSID);
     }
     if (!apOk) {
-      WIFI_PROV_LOGF("WiFi: failed to start AP (mode=%d)\n", WiFi.getMode());
+      LOG_WARN(WifiLog, "WiFi: failed to start AP (mode=%d)\n", WiFi.getMode());
       setState(WifiState::FAILED);
       provisioning = false;
       return;
     }
-    WIFI_PROV_LOGF("WiFi: AP started, IP=%s\n", WiFi.softAPIP().toString().c_str());
-
-    dnsServer.start(53, "*", WiFi.softAPIP());
-    webServer.on("/", HTTP_GET, handleRoot);
-    webServer.on("/scan", HTTP_GET, handleScan);
-    // Common captive portal endpoints across platforms
-    webServer.on("/generate_204", HTTP_GET, handleCaptive);
-    webServer.on("/gen_204", HTTP_GET, handleCaptive);
-    webServer.on("/hotspot-detect.html", HTTP_GET, handleCaptive);
-    webServer.on("/library/test/success.html", HTTP_GET, handleCaptive);
-    webServer.on("/connecttest.txt", HTTP_GET, handleCaptive);
-    webServer.on("/ncsi.txt", HTTP_GET, handleCaptive);
-    webServer.onNotFound([]() { handleCaptive(); });
-    webServer.on("/save", HTTP_POST, handleSave);
-    webServer.begin();
+    LOG_DEBUG(WifiLog, "WiFi: AP started, IP=%s\n", WiFi.softAPIP().toString().c_str());
+
+    size_t scanLen = buildScanJson();
+    if (!PortalServer::start(static_cast<uint32_t>(WiFi.softAPIP()), scanJson, scanLen)) {
+      LOG_WARN(WifiLog, "WiFi: portal server failed to start\n");
+      WiFi.softAPdisconnect(true);
+      setState(WifiState::FAILED);
+      return;
+    }
 
     provisioning = true;
     provisionStartMs = millis();
     lastProvisionLogMs = provisionStartMs;
-    WIFI_PROV_LOG("WiFi: captive portal running");
+    LOG_DEBUG(WifiLog, "WiFi: captive portal running\n");
   }
 }  // namespace
 
@@ -336,8 +352,21 @@ void wifiInit() {
     String p0 = prefs.getString("pass0", "");
     String s1 = prefs.getString("ssid1", "");
     String p1 = prefs.getString("pass1", "");
-    if (s0.length()) known.push_back({s0, p0});
-    if (s1.length()) known.push_back({s1, p1});
+    const char* fcKeys[2] = {"fc0", "fc1"};
+    const String* ssids[2] = {&s0, &s1};
+    const String* passes[2] = {&p0, &p1};
+    for (uint8_t slot = 0; slot < 2; ++slot) {
+      if (!ssids[slot]->length()) continue;
+      KnownNet k;
+      k.ssid = *ssids[slot];
+      k.pass = *passes[slot];
+      k.slot = slot;
+      k.hasFast = prefs.getBytesLength(fcKeys[slot]) == sizeof(FastConnect) &&
+                  prefs.getBytes(fcKeys[slot], &k.fast, sizeof(FastConnect)) == sizeof(FastConnect) &&
+                  k.fast.version == FAST_CONNECT_VERSION && k.fast.channel != 0;
+      known.push_back(k);
+    }
+    lastSlot = prefs.getUChar("fcl", 0);
     prefs.end();
   }
   // Enable NVS persistence so credentials survive reboot
@@ -360,6 +389,10 @@ void wifiStop() {
   // Disconnect but keep saved credentials (NVS)
   WiFi.disconnect(true, false);
   WiFi.scanDelete();
+  clearLease();
+  radioOff();
+  fastConnectActive = false;
+  connectAttemptMs = 0;
   provisioning = false;
   lastProvisionLogMs = 0;
   ipStr = "";
@@ -407,26 +440,29 @@ void wifiUpdate() {
     return;
   }
   if (provisioning) {
-    dnsServer.processNextRequest();
-    webServer.handleClient();
+    // HTTP and DNS are served on their own tasks; only the hand-off lands here.
+    PortalServer::Credentials cred;
+    if (PortalServer::takeCredentials(cred)) {
+      applyCredentials(cred);
+      return;
+    }
     // Monitor STA connect while portal runs
     if (state == WifiState::CONNECTING) {
       wl_status_t s = WiFi.status();
       if (s == WL_CONNECTED) {
-        ipStr = WiFi.localIP().toString();
-        setState(WifiState::CONNECTED);
+        onConnected();
       } else if (millis() - connectStartMs > CONNECT_TIMEOUT_MS) {
         if (allowProvisionFallback) {
-          if (WIFI_LOGS) WifiLog::println("WiFi: connect timed out during provisioning");
+          LOG_DEBUG(WifiLog, "WiFi: connect timed out during provisioning\n");
           setState(WifiState::FAILED);
         } else {
-          if (WIFI_LOGS) WifiLog::println("WiFi: connect timed out -> stopping");
+          LOG_DEBUG(WifiLog, "WiFi: connect timed out -> stopping\n");
           wifiStop();
         }
       }
     }
     if (now - lastProvisionLogMs > 5000) {
-      WIFI_PROV_LOGF("WiFi: provisioning active (%lus)\n", (now - provisionStartMs) / 1000);
+      LOG_DEBUG(WifiLog, "WiFi: provisioning active (%lus)\n", (now - provisionStartMs) / 1000);
       lastProvisionLogMs = now;
     }
     if (now - provisionStartMs > PROVISION_TIMEOUT_MS) {
@@ -439,15 +475,23 @@ void wifiUpdate() {
   if (state == WifiState::CONNECTING) {
     wl_status_t s = WiFi.status();
     if (s == WL_CONNECTED) {
-      ipStr = WiFi.localIP().toString();
-      setState(WifiState::CONNECTED);
+      onConnected();
+    } else if (fastConnectActive &&
+               (s == WL_NO_SSID_AVAIL || s == WL_CONNECT_FAILED ||
+                millis() - connectStartMs > FAST_CONNECT_TIMEOUT_MS)) {
+      LOG_DEBUG(WifiLog, "WiFi: fast connect failed (status %d) -> scan\n", s);
+      fastConnectActive = false;
+      WiFi.disconnect(false, false);
+      clearLease();
+      setState(WifiState::OFF);
+      startKnownScan();
     } else if (millis() - connectStartMs > CONNECT_TIMEOUT_MS) {
       if (allowProvisionFallback) {
-        if (WIFI_LOGS) WifiLog::println("WiFi: connect timed out -> provisioning");
+        LOG_DEBUG(WifiLog, "WiFi: connect timed out -> provisioning\n");
         wifiStop();
         startProvisioning();
       } else {
-        if (WIFI_LOGS) WifiLog::println("WiFi: connect timed out -> stopping");
+        LOG_DEBUG(WifiLog, "WiFi: connect timed out -> stopping\n");
         wifiStop();
       }
     }
@@ -469,18 +513,39 @@ const char* wifiGetIp() {
   return (state == WifiState::CONNECTED) ? ipStr.c_str() : "";
 }
 
+uint32_t wifiLastConnectMs() {
+  return lastConnectMs;
+}
+
+uint32_t wifiRadioOnMs() {
+  return radioOnTotalMs + (radioOnSinceMs ? millis() - radioOnSinceMs : 0);
+}
+
 void wifiAutoConnectKnown() {
   if (provisioning || state == WifiState::CONNECTING || state == WifiState::CONNECTED) return;
   if (known.empty()) return;
   if (autoScanInProgress) return;
 
-  // One quick scan to see if any known SSID is visible
   WiFi.mode(WIFI_STA);
   WiFi.setSleep(false);
-  int n = WiFi.scanNetworks(true, true);
-  if (n == WIFI_SCAN_FAILED) {
-    wifiStop();
+  radioOn();
+
+  // Directed connect to the AP that worked last time; scan only if it fails.
+  const KnownNet* fast = nullptr;
+  for (const auto& k : known) {
+    if (k.hasFast && (!fast || k.slot == lastSlot)) fast = &k;
+  }
+  if (fast) {
+    if (WIFI_REUSE_LEASE && fast->fast.ip != 0) {
+      leaseApplied = WiFi.config(IPAddress(fast->fast.ip), IPAddress(fast->fast.gateway),
+                                 IPAddress(fast->fast.mask), IPAddress(fast->fast.dns));
+    }
+    allowProvisionFallback = false;
+    fastConnectActive = true;
+    WiFi.begin(fast->ssid.c_str(), fast->pass.c_str(), fast->fast.channel, fast->fast.bssid);
+    connectStartMs = millis();
+    setState(WifiState::CONNECTING);
     return;
   }
-  autoScanInProgress = true;
+  startKnownScan();
 }
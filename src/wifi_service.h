@@ -11,9 +11,11 @@ enum class WifiState {
 
 void wifiInit();                     // initialize internal state (does NOT connect)
 void wifiStart(bool allowProvisionFallback = true);  // begin provisioning (AP + portal)
-void wifiAutoConnectKnown();         // boot-time: scan + connect to known SSID if visible
+void wifiAutoConnectKnown();         // boot-time: directed connect from the cache, else scan for a known SSID
 void wifiStop();                     // disconnect Wi-Fi
 void wifiUpdate();                   // non-blocking state update (call in loop)
 bool wifiIsProvisioning();           // captive portal is active
 WifiState wifiGetState();             // current Wi-Fi state
 const char* wifiGetIp();              // returns IP string or ""
+uint32_t wifiLastConnectMs();         // radio on -> connected for the last connect, 0 if none
+uint32_t wifiRadioOnMs();             // total radio-on time since boot
@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+"""Minify and gzip portal.html into src/generated/portal_html.h.
+
+  embed_portal.py          regenerate the header (only rewritten if it changed)
+  embed_portal.py check    fail if the header is stale or does not inflate back
+
+Runs automatically before every PlatformIO build (extra_scripts = pre:...).
+The device serves the bytes as-is with Content-Encoding: gzip; the ETag is a
+hash of the compressed page, so it changes whenever portal.html does.
+
+The minifier is deliberately conservative: HTML comments and indentation go,
+CSS is collapsed, and JS only loses indentation, blank lines and full-line
+// comments. Keep the page free of multi-line template literals.
+"""
+import gzip
+import hashlib
+import os
+import re
+import sys
+
+SOURCE = "portal.html"
+HEADER = os.path.join("src", "generated", "portal_html.h")
+BYTES_PER_LINE = 16
+
+
+def minify_css(css):
+    css = re.sub(r"/\*.*?\*/", "", css, flags=re.S)
+    css = re.sub(r"\s+", " ", css)
+    css = re.sub(r"\s*([{};:,>])\s*", r"\1", css)
+    css = css.replace(";}", "}")
+    return css.strip()
+
+
+def minify_js(js):
+    out = []
+    for line in js.splitlines():
+        line = line.strip()
+        if not line or line.startswith("//"):
+            continue
+        out.append(line)
+    # Joining without a newline is only safe after these; ASI needs the rest.
+    text = ""
+    for line in out:
+        if text and text[-1] not in ";{,(":
+            text += "\n"
+        text += line
+    return text
+
+
+def minify_html(html):
+    parts = re.split(r"(<style>.*?</style>|<script>.*?</script>)", html, flags=re.S)
+    out = []
+    for part in parts:
+        if part.startswith("<style>"):
+            out.append("<style>" + minify_css(part[7:-8]) + "</style>")
+        elif part.startswith("<script>"):
+            out.append("<script>" + minify_js(part[8:-9]) + "</script>")
+        else:
+            part = re.sub(r"<!--.*?-->", "", part, flags=re.S)
+            part = "".join(line.strip() for line in part.splitlines())
+            out.append(re.sub(r">\s+<", "><", part))
+    return "".join(out)
+
+
+def build(root):
+    with open(os.path.join(root, SOURCE), "rb") as f:
+        raw = f.read()
+    mini = minify_html(raw.decode("utf-8")).encode("utf-8")
+    # mtime=0 keeps the output (and the ETag) reproducible.
+    gz = gzip.compress(mini, compresslevel=9, mtime=0)
+    etag = '"%s"' % hashlib.sha256(gz).hexdigest()[:16]
+
+    lines = [
+        "#pragma once",
+        "// Generated by tools/embed_portal.py from %s; do not edit." % SOURCE,
+        "// %d bytes -> %d minified -> %d gzip" % (len(raw), len(mini), len(gz)),
+        "#include <Arduino.h>",
+        "",
+        "namespace PortalAsset {",
+        "  constexpr size_t GZ_LEN = %d;" % len(gz),
+        "  constexpr size_t RAW_LEN = %d;" % len(mini),
+        "  constexpr const char* ETAG = \"%s\";" % etag.replace('"', '\\"'),
+        "  static const uint8_t GZ[] PROGMEM = {",
+    ]
+    for i in range(0, len(gz), BYTES_PER_LINE):
+        lines.append("    " + ", ".join("0x%02x" % b for b in gz[i:i + BYTES_PER_LINE]) + ",")
+    lines += ["  };", "}", ""]
+    return "\n".join(lines), raw, mini, gz
+
+
+def generate(root):
+    text, raw, mini, gz = build(root)
+    path = os.path.join(root, HEADER)
+    try:
+        with open(path) as f:
+            if f.read() == text:
+                return False
+    except IOError:
+        pass
+    if not os.path.isdir(os.path.dirname(path)):
+        os.makedirs(os.path.dirname(path))
+    with open(path, "w") as f:
+        f.write(text)
+    print("embed_portal: %s %d -> %d bytes gzip" % (HEADER, len(raw), len(gz)))
+    return True
+
+
+def check(root):
+    text, raw, mini, gz = build(root)
+    if gzip.decompress(gz) != mini:
+        print("embed_portal: gzip round trip failed")
+        return 1
+    with open(os.path.join(root, HEADER)) as f:
+        if f.read() != text:
+            print("embed_portal: %s is stale, run tools/embed_portal.py" % HEADER)
+            return 1
+    print("embed_portal: ok (%d -> %d -> %d bytes)" % (len(raw), len(mini), len(gz)))
+    return 0
+
+
+def main(argv):
+    root = os.path.dirname(os.path.dirname(os.path.abspath(argv[0])))
+    if len(argv) == 1:
+        generate(root)
+        return 0
+    if len(argv) == 2 and argv[1] == "check":
+        return check(root)
+    print(__doc__)
+    return 2
+
+
+try:
+    Import("env")  # noqa: F821 (provided by PlatformIO/SCons)
+except NameError:
+    if __name__ == "__main__":
+        sys.exit(main(sys.argv))
+else:
+    generate(env.subst("$PROJECT_DIR"))  # noqa: F821
@@ -0,0 +1,110 @@
+// Host benchmark for EventBus: publish + dispatch throughput and the cost of
+// one dispatch per event, with the firmware's subscriber set.
+//
+//   g++ -O2 -std=gnu++11 -Ilib/bubu_native/include -Iinclude
+//       tools/event_bus_bench/bench.cpp src/event_bus.cpp -o event_bus_bench
+//   ./event_bus_bench [--events N]
+//
+// Subscribers mirror the device: DisplaySystem (menu, game), MenuSystem
+// (game), CareSystem (stat deltas, publishing XP like the real one) and
+// LevelSystem (XP). Critical sections are no-ops here, so on the ESP32 each
+// publish and each take() costs a spinlock pair on top. Host timings only
+// show relative cost.
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+#include "event_bus.h"
+
+namespace {
+
+volatile uint32_t sink = 0;
+
+void onMenu(const EventBus::MenuChanged& e, void*) { sink += e.to; }
+void onGameDisplay(const EventBus::GameChanged& e, void*) { sink += e.running; }
+void onGameMenu(const EventBus::GameChanged& e, void*) { sink += e.score; }
+void onStat(const EventBus::StatDelta& e, void*) {
+  sink += e.delta;
+  if (e.delta >= 10) EventBus::publish(EventBus::XpEarned{static_cast<int16_t>(e.delta / 10)});
+}
+void onXp(const EventBus::XpEarned& e, void*) { sink += e.amount; }
+
+void subscribeFirmwareSet() {
+  EventBus::reset();
+  EventBus::subscribe(onMenu);
+  EventBus::subscribe(onGameDisplay);
+  EventBus::subscribe(onGameMenu);
+  EventBus::subscribe(onStat);
+  EventBus::subscribe(onXp);
+}
+
+void publishOne(uint32_t i) {
+  switch (i % 4) {
+    case 0: EventBus::publish(EventBus::MenuChanged{static_cast<uint8_t>(i), static_cast<uint8_t>(i + 1)}); break;
+    case 1: EventBus::publish(EventBus::GameChanged{(i & 8) != 0, 1, static_cast<uint8_t>(i)}); break;
+    case 2: EventBus::publish(EventBus::StatDelta{static_cast<uint8_t>(i % 4), static_cast<int16_t>(i % 30)}); break;
+    default: EventBus::publish(EventBus::XpEarned{1}); break;
+  }
+}
+
+double nsSince(std::chrono::steady_clock::time_point start) {
+  std::chrono::duration<double, std::nano> ns = std::chrono::steady_clock::now() - start;
+  return ns.count();
+}
+
+// batch events are published, then one dispatch() drains them. The first
+// pass is timed as a whole; the second splits publish from dispatch with a
+// clock read per batch, which only stays small against batches of 8 or more.
+void run(const char* name, uint32_t events, uint32_t batch) {
+  subscribeFirmwareSet();
+  uint32_t taken = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < events; i += batch) {
+    for (uint32_t j = 0; j < batch; ++j) publishOne(i + j);
+    taken += static_cast<uint32_t>(EventBus::dispatch());
+  }
+  double totalNs = nsSince(t0);
+  EventBus::Stats s = EventBus::stats();
+  printf("%-9s %6.1f M events/s  %5.1f ns/event  (%u events, %.2f handler calls each, %u dropped, peak depth %u)\n",
+         name, taken / totalNs * 1e3, totalNs / taken, taken, static_cast<double>(s.delivered) / taken, s.dropped,
+         s.peakDepth);
+  if (batch < 8) return;
+
+  subscribeFirmwareSet();
+  double publishNs = 0;
+  double dispatchNs = 0;
+  taken = 0;
+  for (uint32_t i = 0; i < events; i += batch) {
+    t0 = std::chrono::steady_clock::now();
+    for (uint32_t j = 0; j < batch; ++j) publishOne(i + j);
+    publishNs += nsSince(t0);
+    t0 = std::chrono::steady_clock::now();
+    taken += static_cast<uint32_t>(EventBus::dispatch());
+    dispatchNs += nsSince(t0);
+  }
+  printf("%-9s publish %5.1f ns, dispatch %5.1f ns per event\n", "", publishNs / events, dispatchNs / taken);
+}
+
+// Cost of dispatch() on an empty queue: what every loop() pass pays.
+void runIdle(uint32_t passes) {
+  subscribeFirmwareSet();
+  auto t0 = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < passes; ++i) sink += static_cast<uint32_t>(EventBus::dispatch());
+  printf("idle      dispatch() on an empty queue: %.1f ns\n", nsSince(t0) / passes);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  uint32_t events = 10000000;
+  for (int i = 1; i + 1 < argc; ++i) {
+    if (!strcmp(argv[i], "--events")) events = static_cast<uint32_t>(strtoul(argv[i + 1], nullptr, 0));
+  }
+  run("batch 1", events, 1);
+  run("batch 8", events, 8);
+  run("batch 24", events, 24);
+  runIdle(events);
+  return 0;
+}
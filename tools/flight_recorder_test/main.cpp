@@ -0,0 +1,279 @@
+// Host test for the flight recorder (src/flight_recorder.cpp) across
+// simulated resets, under ASan/UBSan.
+//
+//   g++ -O1 -g -std=gnu++11 -fsanitize=address,undefined -Isrc -Iinclude
+//       -Ilib/bubu_native/include tools/flight_recorder_test/main.cpp
+//       src/logger.cpp lib/bubu_native/src/core.cpp
+//       lib/bubu_native/src/heap_caps.cpp -o flight_recorder_test
+//   ./flight_recorder_test [--seed S]
+//
+// The test includes flight_recorder.cpp, so a "reset" keeps rtcRing (as RTC
+// slow memory does) and clears everything else before begin() runs again
+// with the reset reason set through NativeHost. It checks the wraparound
+// of the 160-entry ring, a record torn by a reset and a ring with a bad
+// magic or random contents, the crash/non-crash split of every reset
+// reason, and that formatCrashReport() keeps whole lines at every buffer
+// size. The previous-boot dumps go to stdout; results go to stderr.
+// Exits non-zero if any check fails.
+#include "flight_recorder.cpp"
+
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include "native_host.h"
+
+// Stand-ins for the two name lookups the report uses; the real ones live in
+// translation units that pull in Wi-Fi and the heap monitor.
+namespace BubuOTA {
+const char* phaseToStr(Phase p) {
+  return p == Phase::FAILED ? "FAILED" : "?";
+}
+}  // namespace BubuOTA
+
+namespace HeapTelemetry {
+const char* warningToStr(Warning w) {
+  return w == Warning::INTERNAL_LOW ? "INTERNAL_LOW" : "?";
+}
+}  // namespace HeapTelemetry
+
+namespace {
+
+using FlightRecorder::CAPACITY;
+
+uint64_t rngState = 0x9e3779b97f4a7c15ull;
+int failures = 0;
+
+uint32_t rnd() {
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 7;
+  rngState ^= rngState << 17;
+  return static_cast<uint32_t>(rngState >> 32);
+}
+
+void check(bool ok, const char* what, const std::string& detail = std::string()) {
+  if (ok) return;
+  fprintf(stderr, "FAIL: %s %s\n", what, detail.c_str());
+  ++failures;
+}
+
+// What survives a reset: rtcRing. Everything else starts over.
+void reset(esp_reset_reason_t reason) {
+  FlightRecorder::clearCrashReport();
+  lastBoot = 0;
+  lastReason = ESP_RST_UNKNOWN;
+  started = false;
+  lastTickMs = windowStartMs = windowMaxMs = windowTicks = 0;
+  NativeHost::setResetReason(reason);
+  FlightRecorder::begin();
+}
+
+std::string report() {
+  std::vector<char> buf(16384);
+  size_t n = FlightRecorder::formatCrashReport(buf.data(), buf.size());
+  return std::string(buf.data(), n);
+}
+
+std::vector<std::string> lines(const std::string& s) {
+  std::vector<std::string> out;
+  size_t start = 0;
+  for (size_t i = 0; i < s.size(); ++i) {
+    if (s[i] != '\n') continue;
+    out.push_back(s.substr(start, i - start));
+    start = i + 1;
+  }
+  return out;
+}
+
+// HEAP events carry a sequence number in c: "HEAP free=<seq> ...".
+long seqOf(const std::string& line) {
+  size_t at = line.find("HEAP free=");
+  return at == std::string::npos ? -1 : strtol(line.c_str() + at + 10, nullptr, 10);
+}
+
+// ---- wraparound ----
+
+void testWraparound() {
+  const uint32_t counts[] = {0, 1, CAPACITY - 2, CAPACITY - 1, CAPACITY, CAPACITY + 1, 2 * CAPACITY + 7, 5000};
+  for (uint32_t n : counts) {
+    reset(ESP_RST_SW);
+    for (uint32_t i = 0; i < n; ++i) {
+      NativeHost::advanceMs(3);
+      FlightRecorder::record(FlightRecorder::Event::HEAP, 50, 10, i);
+    }
+    reset(ESP_RST_PANIC);
+    std::vector<std::string> ls = lines(report());
+    uint32_t kept = n + 1 < CAPACITY ? n + 1 : CAPACITY;  // + this boot's BOOT event
+    std::string tag = "n=" + std::to_string(n);
+    check(!ls.empty() && ls[0].find("events=" + std::to_string(kept)) != std::string::npos, "event count", tag);
+    check(ls.size() == kept + 1, "report lines", tag + " got " + std::to_string(ls.size()));
+    if (ls.size() != kept + 1) continue;
+    // Oldest first: the BOOT event until it is overwritten, then a run of
+    // consecutive sequence numbers ending at the last one recorded.
+    long first = n + 1 <= CAPACITY ? 0 : static_cast<long>(n - CAPACITY);
+    size_t from = 1;
+    if (n + 1 <= CAPACITY) {
+      check(ls[1].find("BOOT #") != std::string::npos, "BOOT first", tag);
+      from = 2;
+    }
+    for (size_t i = from; i < ls.size(); ++i) {
+      check(seqOf(ls[i]) == first + static_cast<long>(i - from), "sequence", tag + ": " + ls[i]);
+    }
+    // Timestamps never go backwards within a boot.
+    double last = -1;
+    for (size_t i = 1; i < ls.size(); ++i) {
+      double t = strtod(ls[i].c_str(), nullptr);
+      check(t >= last, "time order", tag + ": " + ls[i]);
+      last = t;
+    }
+  }
+}
+
+// ---- torn records and bad rings ----
+
+void testTornRecord() {
+  reset(ESP_RST_SW);
+  for (uint32_t i = 0; i < 10; ++i) FlightRecorder::record(FlightRecorder::Event::HEAP, 0, 0, i);
+  // A reset after the entry is stored but before head moves past it.
+  uint32_t head = rtcRing.head;
+  Entry torn = {millis(), static_cast<uint8_t>(FlightRecorder::Event::HEAP), 0, 0, 999};
+  rtcRing.entries[head % CAPACITY] = torn;
+  reset(ESP_RST_TASK_WDT);
+  std::string r = report();
+  check(r.find("free=999") == std::string::npos, "torn record reported", r);
+  check(r.find("events=11") != std::string::npos, "torn: events kept", r);
+  check(seqOf(lines(r).back()) == 9, "torn: last whole record", r);
+}
+
+void testBadRing() {
+  // Power-on: random RTC memory, even with a valid magic, is never read.
+  for (int round = 0; round < 50; ++round) {
+    uint8_t* raw = reinterpret_cast<uint8_t*>(&rtcRing);
+    for (size_t i = 0; i < sizeof(rtcRing); ++i) raw[i] = static_cast<uint8_t>(rnd());
+    if (round & 1) rtcRing.magic = MAGIC;
+    reset(ESP_RST_POWERON);
+    check(!FlightRecorder::hasCrashReport() && lastCount == 0, "power-on kept the ring");
+    check(rtcRing.boots == 1 && rtcRing.head == 1, "power-on restarts the count");
+  }
+  // Another image's ring (magic from a different Entry layout) after a crash.
+  reset(ESP_RST_SW);
+  FlightRecorder::record(FlightRecorder::Event::STALL, 0, 300);
+  rtcRing.magic = MAGIC + 1;
+  reset(ESP_RST_PANIC);
+  check(!FlightRecorder::hasCrashReport() && lastCount == 0, "bad magic kept the ring");
+  check(rtcRing.boots == 1, "bad magic restarts the count");
+  // A valid magic over garbage (e.g. a reset inside begin()): any head and
+  // any entry bytes must format safely, within the ring.
+  for (int round = 0; round < 200; ++round) {
+    uint8_t* raw = reinterpret_cast<uint8_t*>(&rtcRing);
+    for (size_t i = 0; i < sizeof(rtcRing); ++i) raw[i] = static_cast<uint8_t>(rnd());
+    rtcRing.magic = MAGIC;
+    uint32_t head = rtcRing.head;
+    reset(ESP_RST_PANIC);
+    uint32_t kept = head < CAPACITY ? head : CAPACITY;
+    check(lastCount == kept, "garbage head count");
+    std::string r = report();
+    check(lines(r).size() == (kept ? kept + 1 : 0), "garbage ring lines", std::to_string(head));
+  }
+}
+
+// ---- reset reasons ----
+
+void testResetReasons() {
+  struct Case {
+    esp_reset_reason_t reason;
+    const char* name;
+    bool crash;
+  };
+  const Case cases[] = {
+    {ESP_RST_UNKNOWN, "UNKNOWN", false}, {ESP_RST_EXT, "EXT", false},
+    {ESP_RST_SW, "SW", false},           {ESP_RST_PANIC, "PANIC", true},
+    {ESP_RST_INT_WDT, "INT_WDT", true},  {ESP_RST_TASK_WDT, "TASK_WDT", true},
+    {ESP_RST_WDT, "WDT", true},          {ESP_RST_DEEPSLEEP, "DEEPSLEEP", false},
+    {ESP_RST_BROWNOUT, "BROWNOUT", true}, {ESP_RST_SDIO, "SDIO", false},
+  };
+  for (const Case& c : cases) {
+    reset(ESP_RST_POWERON);
+    FlightRecorder::record(FlightRecorder::Event::MENU, 6);
+    uint32_t boots = rtcRing.boots;
+    reset(c.reason);
+    check(FlightRecorder::hasCrashReport() == c.crash, "crash classification", c.name);
+    check(rtcRing.boots == boots + 1, "boot count", c.name);
+    check(rtcRing.entries[0].type == static_cast<uint8_t>(FlightRecorder::Event::BOOT) &&
+              rtcRing.entries[0].a == static_cast<uint8_t>(c.reason),
+          "BOOT event reason", c.name);
+    std::string r = report();
+    if (c.crash) {
+      std::string head = "boot=" + std::to_string(boots) + " reset=" + c.name + " events=2\n";
+      check(r.compare(0, head.size(), head) == 0, "report header", r);
+      check(r.find("MENU STATS") != std::string::npos, "report event", r);
+    } else {
+      check(r.empty(), "report after a clean reset", r);
+    }
+  }
+  // A crash with nothing recorded before it leaves no report.
+  reset(ESP_RST_SW);
+  rtcRing.head = 0;
+  reset(ESP_RST_PANIC);
+  check(!FlightRecorder::hasCrashReport(), "empty crash report kept");
+}
+
+// ---- whole-line truncation ----
+
+void testTruncation() {
+  reset(ESP_RST_SW);
+  for (uint32_t i = 0; i < 3 * CAPACITY; ++i) {
+    NativeHost::advanceMs(rnd() % 5000);
+    uint32_t v = rnd();
+    FlightRecorder::Event e = static_cast<FlightRecorder::Event>(1 + v % 11);  // 11: unknown type
+    FlightRecorder::record(e, static_cast<uint8_t>(v >> 8), static_cast<uint16_t>(v >> 16), rnd());
+  }
+  reset(ESP_RST_BROWNOUT);
+  std::string full = report();
+  check(lines(full).size() == CAPACITY + 1U, "full report lines");
+  for (size_t cap = 0; cap <= full.size() + 2; ++cap) {
+    // Exactly cap bytes on the heap, so ASan sees any write past them.
+    char* buf = static_cast<char*>(malloc(cap ? cap : 1));
+    size_t n = FlightRecorder::formatCrashReport(buf, cap);
+    std::string tag = "cap=" + std::to_string(cap);
+    if (cap == 0) {
+      check(n == 0, "cap 0", tag);
+    } else {
+      check(n < cap && buf[n] == '\0' && strlen(buf) == n, "terminated", tag);
+      std::string got(buf, n);
+      check(full.compare(0, n, got) == 0, "prefix of the full report", tag);
+      check(n == 0 || got.back() == '\n', "whole lines", tag + ": ..." + got.substr(n > 40 ? n - 40 : 0));
+      // The longest whole-line prefix that fits.
+      size_t best = 0;
+      for (size_t i = 0; i < full.size() && i + 1 < cap; ++i) {
+        if (full[i] == '\n') best = i + 1;
+      }
+      check(n == best, "fills the buffer", tag + " got " + std::to_string(n) + " want " + std::to_string(best));
+    }
+    free(buf);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+      rngState = strtoull(argv[++i], nullptr, 0) * 2 + 1;
+    } else {
+      fprintf(stderr, "usage: %s [--seed S]\n", argv[0]);
+      return 2;
+    }
+  }
+  testWraparound();
+  testTornRecord();
+  testBadRing();
+  testResetReasons();
+  testTruncation();
+  reset(ESP_RST_SW);
+  if (failures) {
+    fprintf(stderr, "%d failures\n", failures);
+    return 1;
+  }
+  fprintf(stderr, "flight recorder: all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,457 @@
+// Host test for gesture dispatch: scripted gesture sequences go through
+// GestureTable::layerFor()/lookup()/run() into the real MenuSystem and
+// EyeGame, and every step checks the action taken, whether it blocks until
+// the finger lifts, and the layer it lands on. Then each canned touch trace
+// (touch_trace.cpp) is replayed through TouchSystem's classifier, once per
+// random seed, and must end on the idle eyes.
+//
+//   g++ -O1 -g -std=gnu++11 -fsanitize=address,undefined -DBUBU_LOG_LEVELS='"*=WARN"'
+//       -Itools/gesture_script_test/shim -Iinclude -Isrc -Ilib/bubu_native/include
+//       tools/gesture_script_test/main.cpp src/gesture_table.cpp src/menu_system.cpp
+//       src/eye_game.cpp src/event_bus.cpp src/logger.cpp src/touch_system.cpp
+//       src/touch_trace.cpp lib/bubu_native/src/core.cpp lib/bubu_native/src/heap_caps.cpp
+//       lib/bubu_native/src/wire.cpp -o gesture_script_test
+//   ./gesture_script_test
+//
+// shim/lvgl.h is a headless LVGL with just enough layout for the menu's
+// hit tests (the selected item at the centre, the stats title, the connect
+// buttons); it is a model of the real layout, not LVGL. The display side of
+// the actions (eye hit test, clean animation, test emotion) and the
+// services the menu calls (care stats, Wi-Fi, OTA, messages, battery,
+// flight recorder) are stand-ins below, and so is the touch routing of
+// DisplaySystem_update() for the traces (lift blocking, the release marker,
+// touches dropped while feeding); the clock screensaver, clean and sleep
+// animations it also checks are not reached by the canned traces. Exits
+// non-zero on the first mismatch.
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "battery_system.h"
+#include "bubu_clock.h"
+#include "care_system.h"
+#include "display_system.h"
+#include "event_bus.h"
+#include "eye_game.h"
+#include "flight_recorder.h"
+#include "gesture_table.h"
+#include "level_system.h"
+#include "menu_system.h"
+#include "message_system.h"
+#include "native_host.h"
+#include "ota/ota_manager.h"
+#include "touch_system.h"
+#include "touch_trace.h"
+#include "wifi_service.h"
+
+using GestureTable::Action;
+
+// ---- stand-ins ----
+
+namespace {
+int hunger = 50, mood = 50, energy = 50, cleanliness = 50;
+bool messageOpen = false;
+bool wifiOn = false;
+uint32_t cleanStarts = 0;
+uint32_t testEmotions = 0;
+uint32_t sleepStarts = 0;
+}  // namespace
+
+namespace CareSystem {
+void addHunger(int v) { hunger += v; }
+void addMood(int v) { mood += v; }
+void addEnergy(int v) { energy += v; }
+void addCleanliness(int v) { cleanliness += v; }
+int getHunger() { return hunger; }
+int getMood() { return mood; }
+int getEnergy() { return energy; }
+int getCleanliness() { return cleanliness; }
+}  // namespace CareSystem
+
+namespace LevelSystem {
+int getLevel() { return 1; }
+int getXP() { return 0; }
+int getXPForNextLevel() { return 100; }
+}  // namespace LevelSystem
+
+namespace MessageSystem {
+void begin() {}
+void open(FinishedCallback) { messageOpen = true; }
+void close() { messageOpen = false; }
+bool isOpen() { return messageOpen; }
+}  // namespace MessageSystem
+
+namespace BatterySystem {
+BatteryStatus getStatus() { return BatteryStatus{4.0f, 80, false, ChargingState::ON_BATTERY}; }
+}  // namespace BatterySystem
+
+namespace BubuOTA {
+bool isBusy() { return false; }
+void runManual() {}
+Status status() { return Status(); }
+}  // namespace BubuOTA
+
+namespace FlightRecorder {
+void record(Event, uint8_t, uint16_t, uint32_t) {}
+}  // namespace FlightRecorder
+
+WifiState wifiGetState() { return wifiOn ? WifiState::CONNECTED : WifiState::OFF; }
+void wifiStart(bool) { wifiOn = true; }
+void wifiStop() { wifiOn = false; }
+void DisplaySystem_startSleep() { ++sleepStarts; }
+
+namespace {
+
+// The eye boxes of display_system.cpp's layout: x 35-205, y 80-160.
+bool tapOnEyes(const TouchPoint& t) {
+  return t.x >= 35 && t.x <= 205 && t.y >= 80 && t.y <= 160;
+}
+void startClean(uint32_t) { ++cleanStarts; }
+void triggerTestEmotion(uint32_t) { ++testEmotions; }
+
+const GestureTable::Hooks HOOKS = {tapOnEyes, startClean, triggerTestEmotion};
+
+const char* const MENU_NAMES[] = {
+  "CLOSED", "OPEN", "FEEDING", "BATTERY", "CONNECT", "MESSAGE",
+  "STATS", "OPTIONS", "GAMES", "GAME_ACTIVE", "LEVEL"
+};
+static_assert(sizeof(MENU_NAMES) / sizeof(MENU_NAMES[0]) == MENU_STATE_COUNT, "MenuState names");
+
+const char* const GESTURE_NAMES[] = {
+  "NONE", "TAP", "LONG_PRESS", "LONG", "SWIPE_UP", "SWIPE_DOWN", "SWIPE_LEFT", "SWIPE_RIGHT"
+};
+static_assert(sizeof(GESTURE_NAMES) / sizeof(GESTURE_NAMES[0]) == TOUCH_GESTURE_COUNT, "TouchGesture names");
+
+// Screen points the scripts touch
+constexpr uint16_t OFF_EYES_X = 120, OFF_EYES_Y = 30;   // above the eyes
+constexpr uint16_t CENTRE = 120;                        // selected item, stats title, eyes
+constexpr uint16_t BOTTOM_Y = 215;                      // below the eyes
+constexpr uint16_t OTA_BTN_Y = 190;                     // connect panel's OTA button
+constexpr uint16_t SWITCH_X = 178, SWITCH_Y = 130;      // connect panel's Wi-Fi switch
+
+struct Step {
+  TouchGesture gesture;
+  uint16_t x, y;
+  Action action;     // what the table must pick
+  bool blocks;       // run() result: block gestures until the finger lifts
+  MenuState layer;   // layer after the step (layerFor(), game included)
+};
+
+struct Script {
+  const char* name;
+  const Step* steps;
+  size_t count;
+};
+
+#define SCRIPT(name, steps) {name, steps, sizeof(steps) / sizeof(steps[0])}
+
+// Swipe down steps to the next menu item, up to the previous one.
+const Step BROWSE_TO_STATS[] = {
+  {TOUCH_TAP, OFF_EYES_X, OFF_EYES_Y, Action::IDLE_TAP, true, MENU_OPEN},
+  {TOUCH_SWIPE_UP, CENTRE, CENTRE, Action::MENU_PREV, false, MENU_OPEN},  // already on the first
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},
+  {TOUCH_SWIPE_RIGHT, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},
+  {TOUCH_SWIPE_LEFT, CENTRE, CENTRE, Action::MENU_PREV, false, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},   // Stats
+  {TOUCH_LONG, CENTRE, CENTRE, Action::IGNORE, false, MENU_OPEN},
+  {TOUCH_TAP, CENTRE, OFF_EYES_Y, Action::MENU_ENTER, false, MENU_OPEN},     // not on the item
+  {TOUCH_TAP, CENTRE, CENTRE, Action::MENU_ENTER, true, MENU_STATS_OPEN},
+  // Stats 0 (hunger) -> options -> activate returns to stats
+  {TOUCH_TAP, CENTRE, CENTRE, Action::STATS_ENTER, true, MENU_OPTIONS_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::OPTIONS_NEXT, false, MENU_OPTIONS_OPEN},
+  {TOUCH_TAP, CENTRE, CENTRE, Action::OPTION_ACTIVATE, true, MENU_STATS_OPEN},
+  // Stats 1 (mood) -> games menu, which backs out to stats
+  {TOUCH_SWIPE_RIGHT, CENTRE, CENTRE, Action::STATS_NEXT, false, MENU_STATS_OPEN},
+  {TOUCH_TAP, CENTRE, CENTRE, Action::STATS_ENTER, true, MENU_GAMES_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::IGNORE, false, MENU_GAMES_OPEN},
+  {TOUCH_LONG_PRESS, CENTRE, CENTRE, Action::GAMES_BACK, true, MENU_STATS_OPEN},
+  // Stats 2 (energy) -> options -> back
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::STATS_NEXT, false, MENU_STATS_OPEN},
+  {TOUCH_TAP, CENTRE, CENTRE, Action::STATS_ENTER, true, MENU_OPTIONS_OPEN},
+  {TOUCH_LONG_PRESS, CENTRE, CENTRE, Action::OPTIONS_BACK, true, MENU_STATS_OPEN},
+  {TOUCH_SWIPE_UP, CENTRE, CENTRE, Action::STATS_PREV, false, MENU_STATS_OPEN},
+  {TOUCH_SWIPE_LEFT, CENTRE, CENTRE, Action::STATS_PREV, false, MENU_STATS_OPEN},
+  {TOUCH_LONG_PRESS, CENTRE, CENTRE, Action::STATS_EXIT, true, MENU_OPEN},
+  {TOUCH_LONG_PRESS, CENTRE, CENTRE, Action::MENU_EXIT, true, MENU_CLOSED},
+};
+
+// Stats 3 (cleanliness): a tap on the title starts the clean animation and
+// closes the menu; anywhere else opens the options.
+const Step CLEAN_FROM_STATS[] = {
+  {TOUCH_TAP, OFF_EYES_X, OFF_EYES_Y, Action::IDLE_TAP, true, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},  // Stats
+  {TOUCH_TAP, CENTRE, CENTRE, Action::MENU_ENTER, true, MENU_STATS_OPEN},
+  {TOUCH_SWIPE_UP, CENTRE, CENTRE, Action::STATS_PREV, false, MENU_STATS_OPEN},  // wraps to 3
+  {TOUCH_TAP, CENTRE, OFF_EYES_Y, Action::STATS_ENTER, true, MENU_OPTIONS_OPEN},
+  {TOUCH_LONG_PRESS, CENTRE, CENTRE, Action::OPTIONS_BACK, true, MENU_STATS_OPEN},
+  {TOUCH_TAP, CENTRE, CENTRE, Action::STATS_ENTER, true, MENU_CLOSED},
+};
+
+const Step EYES_AND_IGNORED[] = {
+  {TOUCH_TAP, CENTRE, CENTRE, Action::IDLE_TAP, false, MENU_CLOSED},  // on the eyes: test emotion
+  {TOUCH_LONG_PRESS, OFF_EYES_X, OFF_EYES_Y, Action::IGNORE, false, MENU_CLOSED},
+  {TOUCH_LONG, OFF_EYES_X, OFF_EYES_Y, Action::IGNORE, false, MENU_CLOSED},
+  {TOUCH_SWIPE_UP, CENTRE, CENTRE, Action::IGNORE, false, MENU_CLOSED},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::IGNORE, false, MENU_CLOSED},
+  {TOUCH_SWIPE_LEFT, CENTRE, CENTRE, Action::IGNORE, false, MENU_CLOSED},
+  {TOUCH_SWIPE_RIGHT, CENTRE, CENTRE, Action::IGNORE, false, MENU_CLOSED},
+};
+
+// Play starts Tap the Greens; a long press on the eyes does not end it, one
+// below them goes back to the games menu, then to the menu (Play was opened
+// from the menu) and out.
+const Step GAME_FROM_PLAY[] = {
+  {TOUCH_TAP, OFF_EYES_X, OFF_EYES_Y, Action::IDLE_TAP, true, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},
+  {TOUCH_TAP, CENTRE, CENTRE, Action::MENU_ENTER, false, MENU_GAME_ACTIVE},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::IGNORE, false, MENU_GAME_ACTIVE},
+  {TOUCH_LONG_PRESS, CENTRE, CENTRE, Action::GAME_EXIT, false, MENU_GAME_ACTIVE},
+  {TOUCH_LONG_PRESS, CENTRE, BOTTOM_Y, Action::GAME_EXIT, true, MENU_GAMES_OPEN},
+  {TOUCH_TAP, CENTRE, CENTRE, Action::GAMES_START, true, MENU_GAME_ACTIVE},
+  {TOUCH_LONG_PRESS, CENTRE, BOTTOM_Y, Action::GAME_EXIT, true, MENU_GAMES_OPEN},
+  {TOUCH_LONG_PRESS, CENTRE, CENTRE, Action::GAMES_BACK, true, MENU_OPEN},
+  {TOUCH_LONG_PRESS, CENTRE, CENTRE, Action::MENU_EXIT, true, MENU_CLOSED},
+};
+
+// Connect (switch and OTA button), Message, Battery and Level, each left
+// with a long press; taps exit Battery and Level too.
+const Step PANELS[] = {
+  {TOUCH_TAP, OFF_EYES_X, OFF_EYES_Y, Action::IDLE_TAP, true, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},  // Connect
+  {TOUCH_TAP, CENTRE, CENTRE, Action::MENU_ENTER, true, MENU_CONNECT_OPEN},
+  {TOUCH_TAP, CENTRE, OFF_EYES_Y, Action::CONNECT_TAP, false, MENU_CONNECT_OPEN},  // on nothing
+  {TOUCH_TAP, CENTRE, OTA_BTN_Y, Action::CONNECT_TAP, true, MENU_CONNECT_OPEN},
+  {TOUCH_TAP, SWITCH_X, SWITCH_Y, Action::CONNECT_TAP, true, MENU_CONNECT_OPEN},  // Wi-Fi on
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::IGNORE, false, MENU_CONNECT_OPEN},
+  {TOUCH_LONG_PRESS, CENTRE, CENTRE, Action::CONNECT_EXIT, true, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},  // Message
+  {TOUCH_TAP, CENTRE, CENTRE, Action::MENU_ENTER, true, MENU_MESSAGE_OPEN},
+  {TOUCH_TAP, CENTRE, CENTRE, Action::IGNORE, false, MENU_MESSAGE_OPEN},
+  {TOUCH_LONG_PRESS, CENTRE, CENTRE, Action::MESSAGE_EXIT, true, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},  // Battery
+  {TOUCH_TAP, CENTRE, CENTRE, Action::MENU_ENTER, false, MENU_BATTERY_OPEN},
+  {TOUCH_SWIPE_UP, CENTRE, CENTRE, Action::IGNORE, false, MENU_BATTERY_OPEN},
+  {TOUCH_TAP, CENTRE, CENTRE, Action::BATTERY_EXIT, true, MENU_OPEN},
+  {TOUCH_TAP, CENTRE, CENTRE, Action::MENU_ENTER, false, MENU_BATTERY_OPEN},
+  {TOUCH_LONG_PRESS, CENTRE, CENTRE, Action::BATTERY_EXIT, true, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},  // Level
+  {TOUCH_SWIPE_DOWN, CENTRE, CENTRE, Action::MENU_NEXT, false, MENU_OPEN},  // stays on the last
+  {TOUCH_TAP, CENTRE, CENTRE, Action::MENU_ENTER, false, MENU_LEVEL_OPEN},
+  {TOUCH_TAP, CENTRE, CENTRE, Action::LEVEL_EXIT, true, MENU_OPEN},
+  {TOUCH_TAP, CENTRE, CENTRE, Action::MENU_ENTER, false, MENU_LEVEL_OPEN},
+  {TOUCH_LONG_PRESS, CENTRE, CENTRE, Action::LEVEL_EXIT, true, MENU_OPEN},
+  {TOUCH_LONG_PRESS, CENTRE, CENTRE, Action::MENU_EXIT, true, MENU_CLOSED},
+};
+
+bool failed = false;
+
+void fail(const char* script, size_t step, const char* what, const char* got, const char* want) {
+  fprintf(stderr, "FAIL: %s step %zu: %s %s, expected %s\n", script, step, what, got, want);
+  failed = true;
+}
+
+MenuState currentLayer() {
+  return GestureTable::layerFor(MenuSystem::getState(), EyeGame::isRunning());
+}
+
+// One gesture the way DisplaySystem_update() handles it, then the frame's
+// render() and event dispatch.
+bool gesture(TouchGesture g, uint16_t x, uint16_t y, Action& action) {
+  TouchPoint t = {x, y, g, 0};
+  action = GestureTable::lookup(currentLayer(), g);
+  bool blocks = GestureTable::run(action, t, BubuClock::nowMs(), HOOKS);
+  NativeHost::advanceMs(20);
+  EventBus::dispatch();
+  MenuSystem::render();
+  EyeGame::update();
+  EventBus::dispatch();
+  return blocks;
+}
+
+bool runScript(const Script& s) {
+  for (size_t i = 0; i < s.count && !failed; ++i) {
+    const Step& st = s.steps[i];
+    Action action;
+    bool blocks = gesture(st.gesture, st.x, st.y, action);
+    if (action != st.action) {
+      fail(s.name, i, "action", GestureTable::actionName(action), GestureTable::actionName(st.action));
+    } else if (blocks != st.blocks) {
+      fail(s.name, i, "blocks", blocks ? "true" : "false", st.blocks ? "true" : "false");
+    } else if (currentLayer() != st.layer) {
+      fail(s.name, i, "layer", MENU_NAMES[currentLayer()], MENU_NAMES[st.layer]);
+    }
+  }
+  return !failed;
+}
+
+// Every gesture on every point of a feeding menu is IGNORE and changes
+// nothing; the feed animation then ends back in the menu.
+bool feedingIgnoresEverything() {
+  const Step openFeed[] = {
+    {TOUCH_TAP, OFF_EYES_X, OFF_EYES_Y, Action::IDLE_TAP, true, MENU_OPEN},
+    {TOUCH_TAP, CENTRE, CENTRE, Action::MENU_ENTER, false, MENU_FEEDING},
+  };
+  if (!runScript(SCRIPT("feeding", openFeed))) return false;
+  const uint16_t points[][2] = {{CENTRE, CENTRE}, {OFF_EYES_X, OFF_EYES_Y}, {CENTRE, BOTTOM_Y}, {CENTRE, OTA_BTN_Y}};
+  int hungerBefore = hunger;
+  uint32_t emotionsBefore = testEmotions;
+  size_t step = 0;
+  for (int g = TOUCH_TAP; g < TOUCH_GESTURE_COUNT; ++g) {
+    if (GestureTable::TABLE[MENU_FEEDING][g] != Action::IGNORE) {
+      fail("feeding", step, "table cell for", GESTURE_NAMES[g], "IGNORE");
+      return false;
+    }
+    for (const auto& p : points) {
+      Action action;
+      bool blocks = gesture(static_cast<TouchGesture>(g), p[0], p[1], action);
+      if (action != Action::IGNORE || blocks) {
+        fail("feeding", step, GESTURE_NAMES[g], GestureTable::actionName(action), "IGNORE, no block");
+        return false;
+      }
+      if (currentLayer() != MENU_FEEDING) {
+        fail("feeding", step, "layer", MENU_NAMES[currentLayer()], "FEEDING");
+        return false;
+      }
+      ++step;
+    }
+  }
+  if (hunger != hungerBefore || testEmotions != emotionsBefore) {
+    fail("feeding", step, "side effects", "seen", "none");
+    return false;
+  }
+  NativeHost::advanceMs(5000);
+  MenuSystem::render();
+  EventBus::dispatch();
+  if (currentLayer() != MENU_OPEN || hunger != hungerBefore + CareSystem::kSandwichBoost) {
+    fail("feeding", step, "after the animation", MENU_NAMES[currentLayer()], "OPEN, fed");
+    return false;
+  }
+  Action action;
+  gesture(TOUCH_LONG_PRESS, CENTRE, CENTRE, action);
+  return currentLayer() == MENU_CLOSED;
+}
+
+// ---- canned traces ----
+
+constexpr uint32_t FRAME_MS = 5;  // the frame task's period (main.cpp)
+constexpr unsigned long TRACE_SEEDS = 64;
+
+bool blockedUntilLift = false;
+
+// The touch part of DisplaySystem_update(), after TouchSystem::update().
+// Returns the action run, IGNORE if there was none.
+Action routeTouch() {
+  if (blockedUntilLift) {
+    if (!TouchSystem::isTouchPressed()) blockedUntilLift = false;
+    if (TouchSystem::available()) TouchSystem::get();  // dropped while blocked
+    return Action::IGNORE;
+  }
+  if (!TouchSystem::available()) return Action::IGNORE;
+  TouchPoint t = TouchSystem::get();
+  if (MenuSystem::isFeeding()) return Action::IGNORE;
+  if (t.gesture == TOUCH_NONE) {
+    if (!TouchSystem::isTouchPressed()) blockedUntilLift = false;
+    return Action::IGNORE;
+  }
+  Action action = GestureTable::lookup(currentLayer(), t.gesture);
+  if (GestureTable::run(action, t, BubuClock::nowMs(), HOOKS)) blockedUntilLift = true;
+  return action;
+}
+
+void frame(uint32_t actions[]) {
+  NativeHost::advanceMs(FRAME_MS);
+  TouchSystem::update();
+  MenuSystem::render();
+  EventBus::dispatch();
+  ++actions[static_cast<size_t>(routeTouch())];
+  EyeGame::update();
+  EventBus::dispatch();
+}
+
+// Replays the canned trace once per seed (the game's colours come from
+// random()); each run starts on the idle eyes and must end there, with no
+// game running and the finger up.
+bool cannedTraceEndsOnEyes(const char* name) {
+  std::vector<uint8_t> trace(TouchTrace::cannedSize(name));
+  if (trace.empty() || TouchTrace::buildCanned(name, trace.data(), trace.size()) != trace.size()) {
+    fprintf(stderr, "FAIL: %s: cannot build the trace\n", name);
+    return false;
+  }
+  uint32_t restarts = 0;
+  for (unsigned long seed = 1; seed <= TRACE_SEEDS; ++seed) {
+    randomSeed(seed);
+    uint32_t actions[static_cast<size_t>(Action::COUNT)] = {};
+    if (!TouchSystem::startReplay(trace.data(), trace.size())) {
+      fprintf(stderr, "FAIL: %s: not a trace\n", name);
+      return false;
+    }
+    while (TouchSystem::isReplaying()) frame(actions);
+    for (int i = 0; i < 100; ++i) frame(actions);  // let a last transition settle
+    if (actions[static_cast<size_t>(Action::IDLE_TAP)] == 0 || TouchSystem::replayStats().gestures == 0) {
+      fprintf(stderr, "FAIL: %s seed %lu: the trace never opened the menu\n", name, seed);
+      return false;
+    }
+    if (currentLayer() != MENU_CLOSED || EyeGame::isRunning() || TouchSystem::isTouchPressed() ||
+        blockedUntilLift) {
+      fprintf(stderr, "FAIL: %s seed %lu: ends on layer %s%s%s, expected the idle eyes\n", name, seed,
+              MENU_NAMES[currentLayer()], EyeGame::isRunning() ? ", game running" : "",
+              blockedUntilLift ? ", blocked" : "");
+      return false;
+    }
+    restarts += actions[static_cast<size_t>(Action::GAMES_START)] > 0;
+  }
+  printf("trace %s: %lu seeds end on the idle eyes (%lu restarted the game after a wrong tap)\n", name,
+         TRACE_SEEDS, static_cast<unsigned long>(restarts));
+  return true;
+}
+
+}  // namespace
+
+int main() {
+  NativeHost::advanceMs(1000);
+  randomSeed(1);
+  MenuSystem::begin();
+
+  const Script scripts[] = {
+    SCRIPT("browse_to_stats", BROWSE_TO_STATS),
+    SCRIPT("eyes_and_ignored", EYES_AND_IGNORED),
+    SCRIPT("clean_from_stats", CLEAN_FROM_STATS),
+    SCRIPT("game_from_play", GAME_FROM_PLAY),
+    SCRIPT("panels", PANELS),
+  };
+  for (const Script& s : scripts) {
+    if (!runScript(s)) return 1;
+  }
+  if (testEmotions != 1 || cleanStarts != 1 || !wifiOn) {
+    fprintf(stderr, "FAIL: %lu test emotions, %lu clean animations, Wi-Fi %s; expected 1, 1, on\n",
+            static_cast<unsigned long>(testEmotions), static_cast<unsigned long>(cleanStarts),
+            wifiOn ? "on" : "off");
+    return 1;
+  }
+  if (!feedingIgnoresEverything()) return 1;
+  uint32_t cleanBefore = cleanStarts, sleepBefore = sleepStarts;
+  for (uint8_t i = 0; i < TouchTrace::cannedCount(); ++i) {
+    if (!cannedTraceEndsOnEyes(TouchTrace::cannedName(i))) return 1;
+  }
+  if (cleanStarts != cleanBefore || sleepStarts != sleepBefore) {
+    fprintf(stderr, "FAIL: a canned trace started the clean or sleep animation\n");
+    return 1;
+  }
+  printf("gesture scripts: %zu scripts, the feeding row and %u canned traces, all as expected\n",
+         sizeof(scripts) / sizeof(scripts[0]), TouchTrace::cannedCount());
+  return 0;
+}
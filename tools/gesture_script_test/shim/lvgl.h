@@ -0,0 +1,236 @@
+#pragma once
+// Headless stand-in for the slice of LVGL 9 that src/menu_system.cpp uses.
+// Objects keep a parent, a box on the 240x240 screen, flags and states;
+// styles, fonts, arcs and animations are accepted and dropped. Layout is a
+// model of what the firmware asks for:
+// - lv_obj_set_size()/set_width() (lv_pct() of the parent too), labels
+//   26 px high until sized, lv_obj_set_style_min_height();
+// - lv_obj_align()/lv_obj_center() against the parent, for CENTER and
+//   TOP_MID;
+// - a FLEX_FLOW_ROW parent centres its children side by side, with
+//   pad_column between them;
+// - lv_obj_scroll_to_view() on a FLEX_FLOW_COLUMN child scrolls it to the
+//   middle of the list (LV_SCROLL_SNAP_CENTER), siblings a row apart.
+// Scroll events never fire. Hit tests read the boxes through
+// lv_obj_get_coords().
+#include <stdint.h>
+#include <stddef.h>
+
+typedef int32_t lv_coord_t;
+typedef uint8_t lv_opa_t;
+typedef uint32_t lv_style_selector_t;
+typedef uint16_t lv_state_t;
+typedef uint32_t lv_obj_flag_t;
+typedef int lv_style_prop_t;
+
+struct lv_color_t { uint8_t blue, green, red; };
+struct lv_area_t { int32_t x1, y1, x2, y2; };
+struct lv_font_t { int32_t line_height; };
+struct lv_style_t { int unused; };
+struct lv_style_transition_dsc_t { int unused; };
+struct lv_event_t;
+typedef int32_t (*lv_anim_path_cb_t)(const void*);
+typedef void (*lv_event_cb_t)(lv_event_t*);
+
+enum lv_anim_enable_t { LV_ANIM_OFF, LV_ANIM_ON };
+enum { LV_OPA_TRANSP = 0, LV_OPA_30 = 76, LV_OPA_40 = 102, LV_OPA_50 = 127, LV_OPA_COVER = 255 };
+enum { LV_PART_MAIN = 0, LV_PART_INDICATOR = 0x020000, LV_PART_KNOB = 0x030000 };
+enum { LV_STATE_DEFAULT = 0, LV_STATE_CHECKED = 0x01, LV_STATE_PRESSED = 0x20 };
+enum { LV_OBJ_FLAG_HIDDEN = 1 << 0, LV_OBJ_FLAG_SCROLLABLE = 1 << 4, LV_OBJ_FLAG_SCROLL_MOMENTUM = 1 << 7 };
+enum { LV_ALIGN_TOP_MID = 2, LV_ALIGN_CENTER = 9 };
+enum { LV_RADIUS_CIRCLE = 0x7FFF };
+enum { LV_TEXT_ALIGN_CENTER = 2 };
+enum { LV_DIR_VER = 12 };
+enum { LV_SCROLL_SNAP_CENTER = 3 };
+enum { LV_SCROLLBAR_MODE_OFF = 0 };
+enum { LV_GRAD_DIR_VER = 1 };
+enum { LV_ARC_MODE_NORMAL = 0 };
+enum { LV_FLEX_ALIGN_START = 0, LV_FLEX_ALIGN_CENTER = 2 };
+enum lv_flex_flow_t { LV_FLEX_FLOW_NONE = -1, LV_FLEX_FLOW_ROW = 0, LV_FLEX_FLOW_COLUMN = 1 };
+enum lv_event_code_t { LV_EVENT_ALL = 0, LV_EVENT_SCROLL_END = 10 };
+enum { LV_STYLE_TRANSFORM_WIDTH = 1, LV_STYLE_TRANSFORM_HEIGHT, LV_STYLE_TEXT_LETTER_SPACE };
+
+static const lv_font_t lv_font_montserrat_vn_20 = {20};
+static const lv_font_t lv_font_montserrat_vn_22 = {22};
+static const lv_font_t lv_font_montserrat_vn_28 = {28};
+static const lv_font_t lv_font_montserrat_48 = {48};
+
+namespace LvStub {
+
+constexpr int32_t SCREEN = 240;
+constexpr int32_t LABEL_W = 100;
+constexpr int32_t LABEL_H = 26;
+constexpr int32_t PCT_FLAG = 0x40000000;
+constexpr size_t MAX_OBJECTS = 128;
+constexpr size_t MAX_CHILDREN = 16;
+
+}  // namespace LvStub
+
+struct lv_obj_t {
+  lv_obj_t* parent;
+  lv_obj_t* children[LvStub::MAX_CHILDREN];
+  size_t childCount;
+  int32_t x, y, w, h;
+  uint32_t flags;
+  lv_state_t state;
+  lv_flex_flow_t flow;
+  int32_t padRow, padColumn;
+};
+
+namespace LvStub {
+
+inline lv_obj_t* pool() {
+  static lv_obj_t objects[MAX_OBJECTS];
+  return objects;
+}
+
+inline size_t& used() {
+  static size_t n = 0;
+  return n;
+}
+
+inline lv_obj_t* screen() {
+  static lv_obj_t root = {nullptr, {}, 0, 0, 0, SCREEN, SCREEN, 0, 0, LV_FLEX_FLOW_NONE, 0, 0};
+  return &root;
+}
+
+inline void layoutRow(lv_obj_t* row) {
+  int32_t total = 0;
+  for (size_t i = 0; i < row->childCount; ++i) total += row->children[i]->w + (i ? row->padColumn : 0);
+  int32_t x = row->x + (row->w - total) / 2;
+  for (size_t i = 0; i < row->childCount; ++i) {
+    lv_obj_t* c = row->children[i];
+    c->x = x;
+    c->y = row->y + (row->h - c->h) / 2;
+    x += c->w + row->padColumn;
+  }
+}
+
+inline lv_obj_t* create(lv_obj_t* parent, int32_t w, int32_t h) {
+  if (used() >= MAX_OBJECTS || (parent && parent->childCount >= MAX_CHILDREN)) return nullptr;
+  lv_obj_t* o = &pool()[used()++];
+  *o = lv_obj_t{parent, {}, 0, parent ? parent->x : 0, parent ? parent->y : 0, w, h, 0, 0, LV_FLEX_FLOW_NONE, 0, 0};
+  if (parent) {
+    parent->children[parent->childCount++] = o;
+    if (parent->flow == LV_FLEX_FLOW_ROW) layoutRow(parent);
+  }
+  return o;
+}
+
+inline int32_t resolve(lv_obj_t* o, int32_t v, bool width) {
+  if (!(v & PCT_FLAG) || !o->parent) return v;
+  return (width ? o->parent->w : o->parent->h) * (v & ~PCT_FLAG) / 100;
+}
+
+}  // namespace LvStub
+
+inline int32_t lv_pct(int32_t v) { return v | LvStub::PCT_FLAG; }
+inline lv_color_t lv_color_hex(uint32_t c) {
+  return lv_color_t{static_cast<uint8_t>(c), static_cast<uint8_t>(c >> 8), static_cast<uint8_t>(c >> 16)};
+}
+inline lv_color_t lv_color_make(uint8_t r, uint8_t g, uint8_t b) { return lv_color_t{b, g, r}; }
+
+inline lv_obj_t* lv_screen_active() { return LvStub::screen(); }
+inline lv_obj_t* lv_obj_create(lv_obj_t* parent) { return LvStub::create(parent, parent->w, parent->h); }
+inline lv_obj_t* lv_label_create(lv_obj_t* parent) { return LvStub::create(parent, LvStub::LABEL_W, LvStub::LABEL_H); }
+inline lv_obj_t* lv_arc_create(lv_obj_t* parent) { return LvStub::create(parent, parent->w, parent->h); }
+inline lv_obj_t* lv_switch_create(lv_obj_t* parent) { return LvStub::create(parent, 50, 26); }
+inline lv_obj_t* lv_btn_create(lv_obj_t* parent) { return LvStub::create(parent, 100, 40); }
+
+inline void lv_obj_set_size(lv_obj_t* o, int32_t w, int32_t h) {
+  o->w = LvStub::resolve(o, w, true);
+  o->h = LvStub::resolve(o, h, false);
+  if (o->parent && o->parent->flow == LV_FLEX_FLOW_ROW) LvStub::layoutRow(o->parent);
+}
+inline void lv_obj_set_width(lv_obj_t* o, int32_t w) { lv_obj_set_size(o, w, o->h); }
+inline void lv_obj_set_style_min_height(lv_obj_t* o, int32_t h, lv_style_selector_t) {
+  if (o->h < h) o->h = h;
+}
+inline void lv_obj_align(lv_obj_t* o, int align, int32_t dx, int32_t dy) {
+  const lv_obj_t* p = o->parent ? o->parent : LvStub::screen();
+  o->x = p->x + (p->w - o->w) / 2 + dx;
+  o->y = (align == LV_ALIGN_TOP_MID ? p->y : p->y + (p->h - o->h) / 2) + dy;
+}
+inline void lv_obj_center(lv_obj_t* o) { lv_obj_align(o, LV_ALIGN_CENTER, 0, 0); }
+inline void lv_obj_get_coords(const lv_obj_t* o, lv_area_t* a) {
+  *a = lv_area_t{o->x, o->y, o->x + o->w - 1, o->y + o->h - 1};
+}
+
+inline void lv_obj_set_flex_flow(lv_obj_t* o, lv_flex_flow_t flow) {
+  o->flow = flow;
+  if (flow == LV_FLEX_FLOW_ROW) LvStub::layoutRow(o);
+}
+inline void lv_obj_set_flex_align(lv_obj_t*, int, int, int) {}
+inline void lv_obj_set_style_pad_row(lv_obj_t* o, int32_t v, lv_style_selector_t) { o->padRow = v; }
+inline void lv_obj_set_style_pad_column(lv_obj_t* o, int32_t v, lv_style_selector_t) {
+  o->padColumn = v;
+  if (o->flow == LV_FLEX_FLOW_ROW) LvStub::layoutRow(o);
+}
+inline void lv_obj_scroll_to_view(lv_obj_t* o, lv_anim_enable_t) {
+  lv_obj_t* list = o->parent;
+  if (!list || list->flow != LV_FLEX_FLOW_COLUMN) return;
+  size_t at = 0;
+  while (at < list->childCount && list->children[at] != o) ++at;
+  int32_t mid = list->y + list->h / 2;
+  for (size_t i = 0; i < list->childCount; ++i) {
+    lv_obj_t* c = list->children[i];
+    int32_t rows = static_cast<int32_t>(i) - static_cast<int32_t>(at);
+    c->x = list->x + (list->w - c->w) / 2;
+    c->y = mid - c->h / 2 + rows * (c->h + list->padRow);
+  }
+}
+
+inline void lv_obj_add_flag(lv_obj_t* o, lv_obj_flag_t f) { o->flags |= f; }
+inline void lv_obj_clear_flag(lv_obj_t* o, lv_obj_flag_t f) { o->flags &= ~f; }
+inline void lv_obj_add_state(lv_obj_t* o, lv_state_t s) { o->state |= s; }
+inline void lv_obj_clear_state(lv_obj_t* o, lv_state_t s) { o->state &= ~s; }
+inline bool lv_obj_has_state(const lv_obj_t* o, lv_state_t s) { return (o->state & s) != 0; }
+
+inline void lv_label_set_text(lv_obj_t*, const char*) {}
+inline void lv_label_set_text_fmt(lv_obj_t*, const char*, ...) {}
+inline void lv_obj_add_event_cb(lv_obj_t*, lv_event_cb_t, lv_event_code_t, void*) {}
+inline lv_event_code_t lv_event_get_code(lv_event_t*) { return LV_EVENT_ALL; }
+inline void* lv_event_get_target(lv_event_t*) { return nullptr; }
+
+inline void lv_obj_set_scroll_dir(lv_obj_t*, int) {}
+inline void lv_obj_set_scroll_snap_y(lv_obj_t*, int) {}
+inline void lv_obj_set_scrollbar_mode(lv_obj_t*, int) {}
+inline void lv_obj_set_style_radius(lv_obj_t*, int32_t, lv_style_selector_t) {}
+inline void lv_obj_set_style_pad_all(lv_obj_t*, int32_t, lv_style_selector_t) {}
+inline void lv_obj_set_style_bg_color(lv_obj_t*, lv_color_t, lv_style_selector_t) {}
+inline void lv_obj_set_style_bg_opa(lv_obj_t*, lv_opa_t, lv_style_selector_t) {}
+inline void lv_obj_set_style_bg_grad_dir(lv_obj_t*, int, lv_style_selector_t) {}
+inline void lv_obj_set_style_bg_grad_color(lv_obj_t*, lv_color_t, lv_style_selector_t) {}
+inline void lv_obj_set_style_border_width(lv_obj_t*, int32_t, lv_style_selector_t) {}
+inline void lv_obj_set_style_border_color(lv_obj_t*, lv_color_t, lv_style_selector_t) {}
+inline void lv_obj_set_style_border_opa(lv_obj_t*, lv_opa_t, lv_style_selector_t) {}
+inline void lv_obj_set_style_text_color(lv_obj_t*, lv_color_t, lv_style_selector_t) {}
+inline void lv_obj_set_style_text_font(lv_obj_t*, const lv_font_t*, lv_style_selector_t) {}
+inline void lv_obj_set_style_text_opa(lv_obj_t*, lv_opa_t, lv_style_selector_t) {}
+inline void lv_obj_set_style_text_align(lv_obj_t*, int, lv_style_selector_t) {}
+inline void lv_obj_set_style_shadow_width(lv_obj_t*, int32_t, lv_style_selector_t) {}
+inline void lv_obj_set_style_shadow_opa(lv_obj_t*, lv_opa_t, lv_style_selector_t) {}
+inline void lv_obj_set_style_shadow_color(lv_obj_t*, lv_color_t, lv_style_selector_t) {}
+inline void lv_obj_set_style_outline_width(lv_obj_t*, int32_t, lv_style_selector_t) {}
+inline void lv_obj_set_style_outline_opa(lv_obj_t*, lv_opa_t, lv_style_selector_t) {}
+inline void lv_obj_set_style_outline_color(lv_obj_t*, lv_color_t, lv_style_selector_t) {}
+inline void lv_obj_set_style_arc_width(lv_obj_t*, int32_t, lv_style_selector_t) {}
+inline void lv_obj_set_style_arc_color(lv_obj_t*, lv_color_t, lv_style_selector_t) {}
+inline void lv_obj_remove_style(lv_obj_t*, lv_style_t*, lv_style_selector_t) {}
+inline void lv_obj_add_style(lv_obj_t*, lv_style_t*, lv_style_selector_t) {}
+
+inline void lv_arc_set_rotation(lv_obj_t*, int32_t) {}
+inline void lv_arc_set_bg_angles(lv_obj_t*, int32_t, int32_t) {}
+inline void lv_arc_set_mode(lv_obj_t*, int) {}
+inline void lv_arc_set_range(lv_obj_t*, int32_t, int32_t) {}
+inline void lv_arc_set_value(lv_obj_t*, int32_t) {}
+
+inline int32_t lv_anim_path_overshoot(const void*) { return 0; }
+inline int32_t lv_anim_path_ease_in_out(const void*) { return 0; }
+inline void lv_style_init(lv_style_t*) {}
+inline void lv_style_transition_dsc_init(lv_style_transition_dsc_t*, const lv_style_prop_t*, lv_anim_path_cb_t,
+                                         uint32_t, uint32_t, void*) {}
+inline void lv_style_set_transition(lv_style_t*, const lv_style_transition_dsc_t*) {}
+inline void lv_style_set_transform_width(lv_style_t*, int32_t) {}
+inline void lv_style_set_transform_height(lv_style_t*, int32_t) {}
+inline void lv_style_set_text_letter_space(lv_style_t*, int32_t) {}
@@ -0,0 +1,266 @@
+// Host test for InflateStream (src/ota/inflate_stream.cpp): zlib streams made
+// with the host zlib are inflated through tinfl's 32 KB circular window in
+// slices split at every byte offset, single bytes, random sizes and the
+// pipeline's 16 KB chunks, and compared with the input byte for byte.
+//
+//   g++ -O2 -std=gnu++11 -Itools/inflate_stream_test/shim -I<miniz>
+//       -Ilib/bubu_native/include -Isrc/ota tools/inflate_stream_test/main.cpp
+//       src/ota/inflate_stream.cpp lib/bubu_native/src/heap_caps.cpp
+//       <miniz>/miniz.c -lz -o inflate_stream_test
+//   ./inflate_stream_test [--seed S]
+//
+// <miniz> is an upstream miniz release (the ROM's decoder is its tinfl).
+// The "wrap" images repeat blocks from 30-32 KB back, so back-references
+// reach across the point where the window offset wraps to 0; runs give
+// distance-1 matches over the wrap. Exits non-zero on the first mismatch.
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+#include <vector>
+
+#include "inflate_stream.h"
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+constexpr size_t PIPELINE_CHUNK = 16 * 1024;
+
+uint64_t rngState = 0x9e3779b97f4a7c15ull;
+
+uint32_t rnd() {
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 7;
+  rngState ^= rngState << 17;
+  return static_cast<uint32_t>(rngState >> 16);
+}
+
+uint32_t rnd(uint32_t lo, uint32_t hi) {  // inclusive
+  return lo + rnd() % (hi - lo + 1);
+}
+
+// --- images ---
+
+Bytes noise(size_t n) {
+  Bytes b(n);
+  for (uint8_t& v : b) v = static_cast<uint8_t>(rnd());
+  return b;
+}
+
+// Each block is a lightly edited copy of the data 30-32 KB earlier.
+Bytes wrapImage(size_t n) {
+  Bytes b = noise(std::min<size_t>(n, InflateStream::WINDOW_SIZE));
+  while (b.size() < n) {
+    size_t dist = rnd(InflateStream::WINDOW_SIZE - 2048, InflateStream::WINDOW_SIZE);
+    size_t len = std::min<size_t>(rnd(300, 4000), n - b.size());
+    size_t from = b.size() - dist;
+    for (size_t i = 0; i < len; ++i) b.push_back(b[from + i]);
+    for (uint32_t e = rnd(0, 3); e > 0; --e) b[b.size() - 1 - rnd(0, static_cast<uint32_t>(len - 1))] ^= 0xA5;
+  }
+  return b;
+}
+
+Bytes runsImage(size_t n) {
+  Bytes b;
+  while (b.size() < n) {
+    size_t len = std::min<size_t>(rnd(1, 20000), n - b.size());
+    b.insert(b.end(), len, static_cast<uint8_t>(rnd()));
+  }
+  return b;
+}
+
+Bytes textImage(size_t n) {
+  static const char* const WORDS[] = {"bubu ", "eyes ", "menu ", "feed ", "sleep ", "play ", "\n", "0x3C00 "};
+  Bytes b;
+  while (b.size() < n) {
+    const char* w = WORDS[rnd() % (sizeof(WORDS) / sizeof(WORDS[0]))];
+    b.insert(b.end(), w, w + strlen(w));
+  }
+  b.resize(n);
+  return b;
+}
+
+// flushEvery > 0 ends a deflate block with Z_FULL_FLUSH every so many bytes.
+Bytes compress(const Bytes& in, int level, int strategy, size_t flushEvery = 0) {
+  z_stream z;
+  memset(&z, 0, sizeof(z));
+  if (deflateInit2(&z, level, Z_DEFLATED, 15, 9, strategy) != Z_OK) abort();
+  Bytes out(deflateBound(&z, in.size()) + 64 + (flushEvery ? in.size() / flushEvery * 16 : 0));
+  z.next_out = out.data();
+  z.avail_out = static_cast<uInt>(out.size());
+  size_t pos = 0;
+  for (;;) {
+    size_t n = flushEvery ? std::min(flushEvery, in.size() - pos) : in.size() - pos;
+    z.next_in = const_cast<Bytes::value_type*>(in.data()) + pos;
+    z.avail_in = static_cast<uInt>(n);
+    pos += n;
+    bool last = pos == in.size();
+    int rc = deflate(&z, last ? Z_FINISH : Z_FULL_FLUSH);
+    if (last ? rc != Z_STREAM_END : rc != Z_OK) abort();
+    if (last) break;
+  }
+  out.resize(z.total_out);
+  deflateEnd(&z);
+  return out;
+}
+
+// --- harness ---
+
+struct Sink {
+  Bytes out;
+  uint32_t writes = 0;
+  uint32_t wraps = 0;  // writes that end at the top of the window
+  bool inWindow = true;
+  bool failAfter = false;
+  const uint8_t* window = nullptr;
+};
+
+bool collect(const uint8_t* data, size_t len, void* ctx) {
+  Sink* s = static_cast<Sink*>(ctx);
+  if (s->failAfter && s->writes > 0) return false;
+  if (!s->window) s->window = data;  // the first write starts at the window base
+  size_t ofs = static_cast<size_t>(data - s->window);
+  if (data < s->window || ofs + len > InflateStream::WINDOW_SIZE || len == 0) s->inWindow = false;
+  if (ofs + len == InflateStream::WINDOW_SIZE) ++s->wraps;
+  ++s->writes;
+  s->out.insert(s->out.end(), data, data + len);
+  return true;
+}
+
+struct Result {
+  bool fed;
+  bool finished;
+  uint32_t consumed;
+  uint32_t produced;
+  Sink sink;
+};
+
+// A slice plan: the next slice length given the position.
+typedef size_t (*Slicer)(size_t pos, size_t arg);
+
+size_t fixedSlices(size_t, size_t arg) { return arg; }
+size_t randomSlices(size_t, size_t arg) { return rnd() % 4 == 0 ? rnd(1, 7) : rnd(1, static_cast<uint32_t>(arg)); }
+
+Result run(const Bytes& z, Slicer slicer, size_t arg, size_t splitAt = 0, bool failWrite = false) {
+  Result r;
+  r.sink.failAfter = failWrite;
+  InflateStream inf;
+  if (!inf.begin(collect, &r.sink)) {
+    fprintf(stderr, "begin failed\n");
+    exit(2);
+  }
+  r.fed = true;
+  for (size_t pos = 0; pos < z.size() && r.fed;) {
+    size_t n = splitAt ? (pos == 0 ? splitAt : z.size() - pos) : slicer(pos, arg);
+    n = std::min(n, z.size() - pos);
+    r.fed = inf.feed(z.data() + pos, n);
+    pos += n;
+  }
+  r.finished = inf.finish();
+  r.consumed = inf.consumed();
+  r.produced = inf.produced();
+  inf.end();
+  return r;
+}
+
+int failures = 0;
+
+void check(bool cond, const char* name, const char* what, size_t arg) {
+  if (cond) return;
+  ++failures;
+  fprintf(stderr, "%s: %s (%lu)\n", name, what, static_cast<unsigned long>(arg));
+}
+
+void checkResult(const Result& r, const Bytes& want, const Bytes& z, const char* name, const char* how, size_t arg) {
+  check(r.fed && r.finished, name, how, arg);
+  check(r.sink.out == want, name, "output differs", arg);
+  check(r.produced == want.size() && r.consumed == z.size(), name, "byte counts", arg);
+  check(r.sink.inWindow, name, "write outside the window", arg);
+}
+
+void runImage(const char* name, const Bytes& img, const Bytes& z) {
+  checkResult(run(z, fixedSlices, z.size()), img, z, name, "whole stream", 0);
+  checkResult(run(z, fixedSlices, 1), img, z, name, "1-byte slices", 1);
+  checkResult(run(z, fixedSlices, PIPELINE_CHUNK), img, z, name, "16 KB slices", PIPELINE_CHUNK);
+  checkResult(run(z, fixedSlices, PIPELINE_CHUNK - 1), img, z, name, "16 KB - 1 slices", PIPELINE_CHUNK - 1);
+  for (int i = 0; i < 8; ++i) checkResult(run(z, randomSlices, 9000), img, z, name, "random slices", i);
+  // Two slices, split at every offset (every 97th on big streams)
+  size_t step = z.size() > 4096 ? 97 : 1;
+  for (size_t at = 1; at < z.size(); at += step) checkResult(run(z, fixedSlices, 0, at), img, z, name, "split", at);
+
+  Result whole = run(z, fixedSlices, z.size());
+  // All but the Adler-32: every image byte must be out once feed() returns
+  if (z.size() > 4) {
+    Bytes body(z.begin(), z.end() - 4);
+    Result r = run(body, fixedSlices, body.size());
+    check(r.fed && !r.finished && r.sink.out == img, name, "output held back", 0);
+  }
+  if (img.size() > 2 * InflateStream::WINDOW_SIZE) check(whole.sink.wraps > 0, name, "window never wrapped", 0);
+
+  // Trailing bytes after the Adler-32 are ignored
+  Bytes tail = z;
+  tail.push_back(0x42);
+  tail.push_back(0x99);
+  Result t = run(tail, fixedSlices, 5);
+  check(t.fed && t.finished && t.sink.out == img && t.consumed == z.size(), name, "trailing bytes", 0);
+
+  // Cut short: never finished, and what came out is a prefix
+  if (z.size() > 8) {
+    Bytes cut(z.begin(), z.begin() + rnd(1, static_cast<uint32_t>(z.size() - 1)));
+    Result c = run(cut, randomSlices, 3000);
+    check(!c.finished, name, "truncated stream finished", cut.size());
+    check(c.sink.out.size() <= img.size() && std::equal(c.sink.out.begin(), c.sink.out.end(), img.begin()), name,
+          "truncated output is not a prefix", cut.size());
+  }
+  // Adler-32 mismatch
+  Bytes bad = z;
+  bad[bad.size() - 1] ^= 0x01;
+  Result b = run(bad, fixedSlices, 777);
+  check(!b.fed && !b.finished, name, "bad Adler-32 accepted", 0);
+  // A failed write stops the stream
+  if (!img.empty()) {
+    Result w = run(z, fixedSlices, 512, 0, true);
+    check(!w.fed && !w.finished, name, "failed write ignored", 0);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+      rngState = strtoull(argv[++i], nullptr, 10) * 2 + 1;
+    } else {
+      fprintf(stderr, "usage: %s [--seed S]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  Bytes wrap = wrapImage(300 * 1024);
+  Bytes runs = runsImage(200 * 1024);
+  Bytes text = textImage(180 * 1024);
+  Bytes rand = noise(100 * 1024);
+  Bytes small = wrapImage(3000);
+
+  runImage("wrap-l9", wrap, compress(wrap, 9, Z_DEFAULT_STRATEGY));
+  runImage("wrap-fixed", wrap, compress(wrap, 6, Z_FIXED));
+  runImage("wrap-flushed", wrap, compress(wrap, 9, Z_DEFAULT_STRATEGY, 10000));
+  runImage("runs", runs, compress(runs, 9, Z_DEFAULT_STRATEGY));
+  runImage("runs-rle", runs, compress(runs, 9, Z_RLE));
+  runImage("text", text, compress(text, 9, Z_DEFAULT_STRATEGY));
+  runImage("stored", rand, compress(rand, 0, Z_DEFAULT_STRATEGY));
+  runImage("random", rand, compress(rand, 9, Z_DEFAULT_STRATEGY));
+  runImage("small", small, compress(small, 9, Z_DEFAULT_STRATEGY));
+  runImage("small-fixed", small, compress(small, 9, Z_FIXED));
+  runImage("empty", Bytes(), compress(Bytes(), 9, Z_DEFAULT_STRATEGY));
+
+  // Not a zlib stream
+  Bytes junk = noise(64);
+  junk[0] = 0x12;
+  Result j = run(junk, fixedSlices, 64);
+  check(!j.fed && !j.finished && j.sink.out.empty(), "junk", "bad header accepted", 0);
+
+  printf("%s\n", failures ? "FAILED" : "all streams OK");
+  return failures ? 1 : 0;
+}
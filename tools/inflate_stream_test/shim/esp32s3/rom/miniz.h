@@ -0,0 +1,4 @@
+#pragma once
+// The ROM decoder is miniz's tinfl; on the host, upstream miniz stands in
+// (https://github.com/richgel999/miniz, release amalgamation miniz.h/.c).
+#include <miniz.h>
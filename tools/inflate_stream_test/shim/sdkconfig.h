@@ -0,0 +1,3 @@
+#pragma once
+// Host build of src/ota/inflate_stream.cpp: take the ESP32-S3 ROM include.
+#define CONFIG_IDF_TARGET_ESP32S3 1
@@ -0,0 +1,433 @@
+// Host test for src/json/json_stream.cpp: JsonReader must emit the same
+// tokens and the same verdict however the body is sliced, reject malformed
+// input at the right byte, and JsonStringPicker must pick the OTA manifest
+// and portal fields the firmware reads.
+//
+//   g++ -O1 -g -std=gnu++11 -fsanitize=address,undefined -Isrc/json
+//       tools/json_stream_test/main.cpp src/json/json_stream.cpp -o json_stream_test
+//   ./json_stream_test [--corpus tools/json_stream_test/corpus] [--fuzz N] [--seed S]
+//
+// Every document (built in, plus the corpus files) is fed whole, split in
+// two at every byte offset, in single bytes and in random slices. --fuzz
+// mutates corpus documents (byte flips, inserts, deletes, splices) and
+// checks the same invariants on each mutant. The last section compares heap
+// traffic for one manifest with the String-based parse this replaced.
+// Exits non-zero on the first mismatch.
+#include <dirent.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "json_stream.h"
+
+// --- heap accounting, for the String comparison ---
+
+namespace {
+size_t heapCalls = 0;
+size_t heapBytes = 0;
+bool countHeap = false;
+}  // namespace
+
+void* operator new(size_t n) {
+  if (countHeap) {
+    ++heapCalls;
+    heapBytes += n;
+  }
+  void* p = malloc(n ? n : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+namespace {
+
+uint64_t rngState = 0x9e3779b97f4a7c15ull;
+
+uint32_t rnd() {
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 7;
+  rngState ^= rngState << 17;
+  return static_cast<uint32_t>(rngState >> 16);
+}
+
+uint32_t rnd(uint32_t lo, uint32_t hi) {  // inclusive
+  return lo + rnd() % (hi - lo + 1);
+}
+
+// --- tokenizing into a comparable transcript ---
+
+constexpr size_t SCRATCH = 64;  // small, so long strings and numbers truncate
+
+struct Transcript {
+  std::string tokens;
+  bool fed = true;
+  bool finished = false;
+  size_t errorOffset = 0;
+  bool depthOk = true;
+
+  bool operator==(const Transcript& o) const {
+    return tokens == o.tokens && fed == o.fed && finished == o.finished && errorOffset == o.errorOffset;
+  }
+};
+
+struct Tokenizer {
+  JsonReader reader;
+  char scratch[SCRATCH];
+  Transcript t;
+};
+
+void onToken(void* ctx, JsonReader::Event ev, uint8_t depth, const char* text, size_t len) {
+  Tokenizer* tk = static_cast<Tokenizer*>(ctx);
+  if (depth > JsonReader::MAX_DEPTH || len >= SCRATCH || text[len] != '\0') tk->t.depthOk = false;
+  char head[16];
+  snprintf(head, sizeof(head), "%d.%u%c:", static_cast<int>(ev), depth, tk->reader.truncated() ? '~' : ' ');
+  tk->t.tokens += head;
+  tk->t.tokens.append(text, len);
+  tk->t.tokens += '\n';
+}
+
+// sizes: slice lengths, cycled; empty means one slice.
+Transcript tokenize(const std::string& doc, const std::vector<size_t>& sizes) {
+  Tokenizer tk;
+  tk.reader.begin(tk.scratch, sizeof(tk.scratch), onToken, &tk);
+  size_t k = 0;
+  for (size_t pos = 0; pos < doc.size();) {
+    size_t n = sizes.empty() ? doc.size() : sizes[k++ % sizes.size()];
+    n = std::min(n, doc.size() - pos);
+    if (!tk.reader.feed(doc.data() + pos, n)) {
+      tk.t.fed = false;
+      break;
+    }
+    pos += n;
+  }
+  tk.t.finished = tk.reader.finish();
+  tk.t.errorOffset = tk.reader.errorOffset();
+  return tk.t;
+}
+
+int failures = 0;
+
+void fail(const char* what, const std::string& doc, size_t arg) {
+  ++failures;
+  std::string shown = doc.substr(0, 80);
+  for (char& c : shown) {
+    if (static_cast<uint8_t>(c) < 0x20) c = '.';
+  }
+  fprintf(stderr, "%s (%lu): %s\n", what, static_cast<unsigned long>(arg), shown.c_str());
+}
+
+// Returns the whole-body transcript after checking every slicing against it.
+Transcript checkSplits(const std::string& doc, bool everyOffset) {
+  Transcript whole = tokenize(doc, std::vector<size_t>());
+  if (!whole.depthOk) fail("token outside depth/scratch limits", doc, 0);
+  if (whole.finished != (whole.fed && whole.finished)) fail("finished after a failed feed", doc, 0);
+  std::vector<size_t> one(1, 1);
+  if (!(tokenize(doc, one) == whole)) fail("1-byte slices differ", doc, 1);
+  if (everyOffset) {
+    for (size_t at = 1; at < doc.size(); ++at) {
+      std::vector<size_t> split;
+      split.push_back(at);
+      split.push_back(doc.size());
+      if (!(tokenize(doc, split) == whole)) fail("split differs", doc, at);
+    }
+  }
+  for (int i = 0; i < 4; ++i) {
+    std::vector<size_t> sizes;
+    for (int j = 0; j < 16; ++j) sizes.push_back(rnd(1, 9));
+    if (!(tokenize(doc, sizes) == whole)) fail("random slices differ", doc, i);
+  }
+  return whole;
+}
+
+// --- fixed cases ---
+
+struct Valid {
+  const char* doc;
+  const char* tokens;  // transcript; nullptr: only check that it is accepted
+};
+
+const Valid VALID[] = {
+  {"{}", "0.0 :\n1.0 :\n"},
+  {"[]", "2.0 :\n3.0 :\n"},
+  {" [ 1 , -2.5e+3 , 0 , true , false , null ] ",
+   "2.0 :\n6.1 :1\n6.1 :-2.5e+3\n6.1 :0\n7.1 :\n8.1 :\n9.1 :\n3.0 :\n"},
+  {"{\"a\":{\"b\":[\"c\"]}}", "0.0 :\n4.1 :a\n0.1 :\n4.2 :b\n2.2 :\n5.3 :c\n3.2 :\n1.1 :\n1.0 :\n"},
+  {"\"\\u00e9\\ud83d\\ude00\\\"\\\\\\/\\b\\f\\n\\r\\t\"", "5.0 :\xc3\xa9\xf0\x9f\x98\x80\"\\/\b\f\n\r\t\n"},
+  {"\"\\ud800x\"", "5.0 :\xef\xbf\xbdx\n"},      // lone high surrogate
+  {"\"\\udc00\"", "5.0 :\xef\xbf\xbd\n"},        // lone low surrogate
+  {"\"\\ud800\\ud800\\udc00\"", "5.0 :\xef\xbf\xbd\xf0\x90\x80\x80\n"},
+  {"42", "6.0 :42\n"},                           // top-level number, ended by finish()
+  {"-0.0e0", "6.0 :-0.0e0\n"},
+  {"\"" "0123456789012345678901234567890123456789012345678901234567890123456789" "\"",
+   "5.0~:012345678901234567890123456789012345678901234567890123456789012\n"},
+  {"[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]", nullptr},  // MAX_DEPTH
+  {"{\"version\":\"1.0\",\"nested\":{\"version\":\"2.0\"},\"list\":[{\"url\":\"x\"}]}", nullptr},
+};
+
+struct Malformed {
+  const char* doc;
+  size_t errorOffset;  // byte the reader stops at
+};
+
+const Malformed MALFORMED[] = {
+  {"", 0},
+  {"   ", 3},
+  {"{", 1},
+  {"[1,]", 3},
+  {"{\"a\":1,}", 7},
+  {"{\"a\" 1}", 5},
+  {"{1:2}", 1},
+  {"[1 2]", 3},
+  {"[1}", 2},
+  {"{\"a\":1]", 6},
+  {"]", 0},
+  {"{}}", 2},
+  {"{} x", 3},
+  {"[01]", 2},
+  {"[-]", 2},
+  {"[1.]", 3},
+  {"[.5]", 1},
+  {"[1e]", 3},
+  {"[1e+]", 4},
+  {"[1-2]", 2},
+  {"[+1]", 1},
+  {"-", 1},
+  {"1.", 2},
+  {"[tru]", 4},
+  {"[nul", 4},
+  {"[True]", 1},
+  {"[\"a\tb\"]", 3},
+  {"[\"\\x\"]", 3},
+  {"[\"\\u12G4\"]", 6},
+  {"[\"abc", 5},
+  {"{\"a\":\"b\"", 8},
+  {"[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]", 32},  // MAX_DEPTH + 1
+};
+
+void runFixedCases() {
+  for (const Valid& v : VALID) {
+    Transcript t = checkSplits(v.doc, true);
+    if (!t.fed || !t.finished) fail("valid document rejected", v.doc, t.errorOffset);
+    if (v.tokens && t.tokens != v.tokens) {
+      fail("tokens differ", v.doc, 0);
+      fprintf(stderr, "got:\n%s", t.tokens.c_str());
+    }
+  }
+  for (const Malformed& m : MALFORMED) {
+    Transcript t = checkSplits(m.doc, true);
+    if (t.finished) fail("malformed document accepted", m.doc, 0);
+    if (t.errorOffset != m.errorOffset) fail("wrong error offset", m.doc, t.errorOffset);
+  }
+  // Nothing is read after an error
+  Tokenizer tk;
+  tk.reader.begin(tk.scratch, sizeof(tk.scratch), onToken, &tk);
+  bool first = tk.reader.feed("[1,]", 4);
+  bool second = tk.reader.feed("[2]", 3);
+  if (first || second || !tk.reader.failed() || tk.reader.errorOffset() != 3) fail("feed after an error", "[1,][2]", 0);
+}
+
+// --- JsonStringPicker ---
+
+void checkPicker() {
+  const std::string longUrl = "https://ota.example.com/" + std::string(JsonStringPicker::SCRATCH_SIZE, 'u');
+  const std::string doc = "{\"version\":\"1.5.0\",\"notes\":{\"url\":\"nested\"},\"sha256\":12,"
+                          "\"url\":\"https://ota.example.com/fw.bin\",\"patch_url\":\"" + longUrl + "\","
+                          "\"list\":[\"url\"],\"url_zlib\":\"" + std::string(255, 'z') + "\"}";
+  for (size_t at = 0; at <= doc.size(); ++at) {
+    char version[16], url[256], sha[65], patchUrl[256], zlibUrl[256];
+    JsonStringField fields[] = {
+      {"version", version, sizeof(version), false, false},
+      {"url", url, sizeof(url), false, false},
+      {"sha256", sha, sizeof(sha), false, false},
+      {"patch_url", patchUrl, sizeof(patchUrl), false, false},
+      {"url_zlib", zlibUrl, sizeof(zlibUrl), false, false},
+    };
+    JsonStringPicker picker(fields, 5);
+    bool ok = picker.feed(doc.data(), at) && picker.feed(doc.data() + at, doc.size() - at) && picker.finish();
+    bool good = ok && !strcmp(version, "1.5.0") && !strcmp(url, "https://ota.example.com/fw.bin") &&
+                sha[0] == '\0' && !fields[2].tooLong && fields[3].found && fields[3].tooLong &&
+                patchUrl[0] == '\0' && !fields[4].tooLong && strlen(zlibUrl) == 255;
+    if (!good) {
+      fail("picker", doc, at);
+      break;
+    }
+  }
+  // A value one byte longer than its buffer
+  char ssid[33], pass[65];
+  JsonStringField creds[] = {{"ssid", ssid, sizeof(ssid), false, false}, {"pass", pass, sizeof(pass), false, false}};
+  std::string body = "{\"ssid\":\"" + std::string(33, 's') + "\",\"pass\":\"" + std::string(64, 'p') + "\"}";
+  JsonStringPicker picker(creds, 2);
+  bool ok = picker.feed(body.data(), body.size()) && picker.finish();
+  if (!ok || !creds[0].tooLong || creds[1].tooLong || strlen(pass) != 64) fail("picker caps", body, 0);
+}
+
+// --- fuzzing ---
+
+std::string mutate(const std::string& doc, const std::vector<std::string>& corpus) {
+  static const char* const PIECES[] = {"{", "}", "[", "]", "\"", ":", ",", "\\", "\\u", "\\ud83d", "0", "-",
+                                       ".", "e", "true", "null", " ", "\x01", "\xff"};
+  std::string m = doc;
+  for (uint32_t n = rnd() % 4 ? 1 : rnd(2, 6); n > 0; --n) {
+    size_t at = m.empty() ? 0 : rnd(0, static_cast<uint32_t>(m.size() - 1));
+    switch (rnd() % 5) {
+      case 0:
+        if (!m.empty()) m[at] = static_cast<char>(rnd());
+        break;
+      case 1:
+        m.insert(at, PIECES[rnd() % (sizeof(PIECES) / sizeof(PIECES[0]))]);
+        break;
+      case 2:
+        if (!m.empty()) m.erase(at, rnd(1, 8));
+        break;
+      case 3: {
+        const std::string& other = corpus[rnd() % corpus.size()];
+        if (other.empty()) break;
+        size_t from = rnd(0, static_cast<uint32_t>(other.size() - 1));
+        m.insert(at, other.substr(from, rnd(1, 40)));
+        break;
+      }
+      default:
+        if (at < m.size()) m.insert(at, m.substr(at, rnd(1, 16)));
+        break;
+    }
+  }
+  return m;
+}
+
+void fuzz(const std::vector<std::string>& corpus, uint32_t runs) {
+  uint32_t accepted = 0;
+  for (uint32_t i = 0; i < runs && !failures; ++i) {
+    std::string m = mutate(corpus[rnd() % corpus.size()], corpus);
+    Transcript t = checkSplits(m, m.size() < 200 && i % 16 == 0);
+    if (t.finished) ++accepted;
+    // The bytes before the error are read the same way on their own
+    if (!t.finished && t.errorOffset <= m.size()) {
+      Transcript prefix = tokenize(m.substr(0, t.errorOffset), std::vector<size_t>());
+      if (t.tokens.compare(0, prefix.tokens.size(), prefix.tokens) != 0) {
+        fail("tokens before the error differ", m, t.errorOffset);
+      }
+    }
+  }
+  printf("fuzz: %u mutants, %u still valid\n", runs, accepted);
+}
+
+bool loadCorpus(const char* dir, std::vector<std::string>& out) {
+  DIR* d = opendir(dir);
+  if (!d) return false;
+  while (dirent* e = readdir(d)) {
+    if (e->d_name[0] == '.') continue;
+    std::string path = std::string(dir) + "/" + e->d_name;
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) continue;
+    std::string doc;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) doc.append(buf, n);
+    fclose(f);
+    out.push_back(doc);
+  }
+  closedir(d);
+  return true;
+}
+
+// --- heap: the String-based manifest parse this replaced ---
+
+// ota_manager.cpp before json_stream: http.getString() grew the body, then
+// jsonGetString built a pattern and a substring for each of six keys
+// (std::string stands in for Arduino String here).
+std::string oldGetString(const std::string& json, const char* key) {
+  std::string pat = std::string("\"") + key + "\"";
+  size_t k = json.find(pat);
+  if (k == std::string::npos) return "";
+  size_t c = json.find(':', k);
+  if (c == std::string::npos) return "";
+  size_t q1 = json.find('"', c + 1);
+  if (q1 == std::string::npos) return "";
+  size_t q2 = json.find('"', q1 + 1);
+  if (q2 == std::string::npos) return "";
+  return json.substr(q1 + 1, q2 - q1 - 1);
+}
+
+void compareHeap(const std::string& manifest) {
+  const size_t HTTP_CHUNK = 128;
+  static const char* const KEYS[] = {"version", "url", "sha256", "patch_from", "patch_url", "url_zlib"};
+
+  heapCalls = heapBytes = 0;
+  countHeap = true;
+  {
+    std::string body;
+    for (size_t pos = 0; pos < manifest.size(); pos += HTTP_CHUNK) body.append(manifest, pos, HTTP_CHUNK);
+    std::string fields[6];
+    for (int i = 0; i < 6; ++i) fields[i] = oldGetString(body, KEYS[i]);
+  }
+  countHeap = false;
+  size_t oldCalls = heapCalls, oldBytes = heapBytes;
+
+  heapCalls = heapBytes = 0;
+  countHeap = true;
+  {
+    char version[16], url[256], sha[65], from[16], patchUrl[256], zlibUrl[256];
+    JsonStringField fields[] = {
+      {"version", version, sizeof(version), false, false}, {"url", url, sizeof(url), false, false},
+      {"sha256", sha, sizeof(sha), false, false},          {"patch_from", from, sizeof(from), false, false},
+      {"patch_url", patchUrl, sizeof(patchUrl), false, false}, {"url_zlib", zlibUrl, sizeof(zlibUrl), false, false},
+    };
+    JsonStringPicker picker(fields, 6);
+    for (size_t pos = 0; pos < manifest.size(); pos += HTTP_CHUNK) {
+      picker.feed(manifest.data() + pos, std::min(HTTP_CHUNK, manifest.size() - pos));
+    }
+    picker.finish();
+  }
+  countHeap = false;
+  printf("heap per %lu-byte manifest: String parse %lu allocations / %lu bytes, JsonStringPicker %lu / %lu\n",
+         static_cast<unsigned long>(manifest.size()), static_cast<unsigned long>(oldCalls),
+         static_cast<unsigned long>(oldBytes), static_cast<unsigned long>(heapCalls),
+         static_cast<unsigned long>(heapBytes));
+  if (heapCalls != 0) fail("JsonStringPicker allocated", manifest, heapCalls);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const char* corpusDir = "tools/json_stream_test/corpus";
+  uint32_t fuzzRuns = 20000;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--corpus") && i + 1 < argc) {
+      corpusDir = argv[++i];
+    } else if (!strcmp(argv[i], "--fuzz") && i + 1 < argc) {
+      fuzzRuns = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+    } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+      rngState = strtoull(argv[++i], nullptr, 10) * 2 + 1;
+    } else {
+      fprintf(stderr, "usage: %s [--corpus DIR] [--fuzz N] [--seed S]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  runFixedCases();
+  checkPicker();
+
+  std::vector<std::string> corpus;
+  if (!loadCorpus(corpusDir, corpus)) {
+    fprintf(stderr, "cannot read corpus %s\n", corpusDir);
+    return 2;
+  }
+  std::string manifest;
+  for (const std::string& doc : corpus) {
+    checkSplits(doc, true);
+    if (doc.find("\"patch_url\"") != std::string::npos) manifest = doc;
+  }
+  for (const Valid& v : VALID) corpus.push_back(v.doc);
+  for (const Malformed& m : MALFORMED) corpus.push_back(m.doc);
+  fuzz(corpus, fuzzRuns);
+  if (!manifest.empty()) compareHeap(manifest);
+
+  printf("%s\n", failures ? "FAILED" : "OK");
+  return failures ? 1 : 0;
+}
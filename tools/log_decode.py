@@ -0,0 +1,247 @@
+#!/usr/bin/env python3
+"""Decode the serial log of a -DBUBU_LOG_TOKENIZED build back into text.
+
+  log_decode.py --port /dev/ttyACM0 [--baud 115200]   live (needs pyserial)
+  log_decode.py capture.bin                           a raw capture
+  log_decode.py -                                     raw bytes on stdin
+  options: --dict FILE   token dictionary (default: extract from the sources;
+                         a build writes .pio/build/<env>/log_tokens.csv)
+           --stats       print wire bytes vs decoded text bytes at the end
+
+The stream is a sequence of units, each ended by 0x00: COBS-framed token
+payloads (format in include/logger.h) or plain text (Logger::print). A unit
+that does not decode to a known token is printed as text; text written
+straight to Serial (boot ROM, panics, Serial.printf) is recovered too.
+"""
+import argparse
+import os
+import re
+import struct
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import log_tokens  # noqa: E402
+
+SPEC = re.compile(rb"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|L|z|j|t)?([diouxXeEfFgGaAcspn%])")
+# Argument widths on the ESP32 (ILP32): int, long, size_t are 32-bit.
+BITS = {b"hh": 8, b"h": 16, b"ll": 64, b"j": 64}
+IDLE_FLUSH_S = 0.2
+CUT_MARK = "\u2026".encode()  # the device cut a %s argument at 64 bytes
+
+
+class Malformed(Exception):
+    pass
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0:
+            raise Malformed("cobs")
+        block = data[i + 1:i + code]
+        if len(block) != code - 1:
+            raise Malformed("cobs")
+        out += block
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class Args:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def varint(self, zigzag=True):
+        shift = 0
+        value = 0
+        while True:
+            if self.pos >= len(self.data):
+                raise IndexError
+            b = self.data[self.pos]
+            self.pos += 1
+            value |= (b & 0x7F) << shift
+            shift += 7
+            if not b & 0x80:
+                return (value >> 1) ^ -(value & 1) if zigzag else value
+
+    def real(self):
+        if self.pos + 4 > len(self.data):
+            raise IndexError
+        (v,) = struct.unpack_from("<f", self.data, self.pos)
+        self.pos += 4
+        return v
+
+    def string(self):
+        v = self.varint(zigzag=False)
+        n = v >> 1
+        if self.pos + n > len(self.data):
+            raise IndexError
+        s = self.data[self.pos:self.pos + n]
+        self.pos += n
+        return s + CUT_MARK if v & 1 else s
+
+
+def render(fmt, args):
+    """printf() on the host; arguments that ran out render as <?>."""
+    out = bytearray()
+    last = 0
+    for m in SPEC.finditer(fmt):
+        out += fmt[last:m.start()]
+        last = m.end()
+        flags, width, prec, length, conv = m.groups()
+        if conv == b"%":
+            out += b"%"
+            continue
+        try:
+            if width == b"*":
+                width = str(args.varint()).encode()
+            if prec == b"*":
+                prec = str(args.varint()).encode()
+            spec = b"%" + flags + (width or b"") + (b"." + prec if prec is not None else b"")
+            bits = BITS.get(length, 32)
+            if conv in b"di":
+                v = args.varint() & ((1 << bits) - 1)
+                if v >> (bits - 1):
+                    v -= 1 << bits
+                out += (spec + b"d") % v
+            elif conv in b"ouxX":
+                v = args.varint() & ((1 << bits) - 1)
+                out += (spec + (b"d" if conv == b"u" else conv)) % v
+            elif conv == b"c":
+                out += (spec + b"c") % (args.varint() & 0xFF)
+            elif conv in b"aA":
+                out += args.real().hex().encode()
+            elif conv in b"eEfFgG":
+                out += (spec + conv) % args.real()
+            elif conv == b"s":
+                out += (spec + b"s") % args.string()
+            elif conv == b"p":
+                out += b"0x%x" % (args.varint() & 0xFFFFFFFF)
+            else:  # %n
+                args.varint()
+        except IndexError:
+            out += b"<?>"
+    out += fmt[last:]
+    return bytes(out)
+
+
+class Decoder:
+    def __init__(self, tokens, write):
+        self.tokens = tokens
+        self.write = write
+        self.pending = bytearray()
+        self.wire = 0
+        self.text = 0
+        self.frames = 0
+
+    def frame(self, data):
+        """Rendered text of a token frame, or None if data is not one."""
+        try:
+            payload = cobs_decode(data)
+        except Malformed:
+            return None
+        if len(payload) < 4:
+            return None
+        fmt = self.tokens.get(struct.unpack_from("<I", payload)[0])
+        if fmt is None:
+            return None
+        self.frames += 1
+        return render(fmt, Args(payload[4:]))
+
+    def unit(self, data):
+        self.wire += len(data) + 1
+        if not data:
+            return
+        text = self.frame(data)
+        # Serial.printf() output (OTA, boot ROM) has no terminator of its own
+        # and runs into the next frame: split after one of its newlines.
+        i = data.find(b"\n")
+        while text is None and i >= 0:
+            tail = self.frame(data[i + 1:])
+            if tail is not None:
+                text = data[:i + 1] + tail
+            i = data.find(b"\n", i + 1)
+        if text is None:
+            text = data
+        self.text += len(text)
+        self.write(text)
+
+    def feed(self, chunk):
+        self.pending += chunk
+        while True:
+            i = self.pending.find(b"\0")
+            if i < 0:
+                return
+            self.unit(bytes(self.pending[:i]))
+            del self.pending[:i + 1]
+
+    def idle(self):
+        # Frames are written in one go, so a unit stalled mid-line is text
+        # without a terminator yet (e.g. a panic dump); show it now.
+        if self.pending:
+            self.write(bytes(self.pending))
+            self.pending = bytearray()
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("input", nargs="?")
+    ap.add_argument("--port")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--dict")
+    ap.add_argument("--stats", action="store_true")
+    args = ap.parse_args()
+    if bool(args.input) == bool(args.port):
+        ap.error("give an input file, - or --port")
+
+    if args.dict:
+        tokens = log_tokens.read_csv(args.dict)
+    else:
+        root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+        tokens, errors = log_tokens.extract(root)
+        for e in errors:
+            sys.stderr.write("log_decode: collision, %s\n" % e)
+
+    out = sys.stdout.buffer
+
+    def write(b):
+        out.write(b)
+        out.flush()
+
+    dec = Decoder(tokens, write)
+    try:
+        if args.port:
+            import serial  # pyserial
+            port = serial.Serial(args.port, args.baud, timeout=IDLE_FLUSH_S)
+            last = time.time()
+            while True:
+                chunk = port.read(4096)
+                if chunk:
+                    dec.feed(chunk)
+                    last = time.time()
+                elif time.time() - last >= IDLE_FLUSH_S:
+                    dec.idle()
+        else:
+            f = sys.stdin.buffer if args.input == "-" else open(args.input, "rb")
+            with f:
+                while True:
+                    chunk = f.read1(4096) if hasattr(f, "read1") else f.read(4096)
+                    if not chunk:
+                        break
+                    dec.feed(chunk)
+            dec.idle()
+    except KeyboardInterrupt:
+        pass
+    if args.stats:
+        sys.stderr.write("log_decode: %d frames, %d bytes on the wire -> %d bytes of text\n"
+                         % (dec.frames, dec.wire, dec.text))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
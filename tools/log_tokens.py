@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+"""Extract the tokenized-logging dictionary from the firmware sources.
+
+  log_tokens.py              list every token and its format string
+  log_tokens.py --out FILE   write the dictionary as CSV (token,format)
+
+Runs automatically before every PlatformIO build (extra_scripts = pre:...)
+and writes $BUILD_DIR/log_tokens.csv next to firmware.elf, so each build
+ships with the dictionary that matches it. With -DBUBU_LOG_TOKENIZED the
+device sends LogToken::fnv1a(format) instead of the text (include/logger.h);
+tools/log_decode.py maps the tokens back with this dictionary.
+
+The build fails if two different format strings hash to the same token.
+"""
+import csv
+import os
+import re
+import sys
+
+SOURCE_DIRS = ("src", "include")
+EXTENSIONS = (".cpp", ".c", ".h", ".hpp")
+OUTPUT = "log_tokens.csv"
+
+# The format string is the first macro argument after these prefixes.
+CALL = re.compile(r"\bLOG_(?:(?:ERROR|WARN|INFO|DEBUG|TRACE)\s*\(\s*\w+\s*,"
+                  r"|AT\s*\(\s*\w+\s*,\s*\w+\s*,"
+                  r"|EMIT\s*\()\s*(?=\")")
+LITERAL = re.compile(r'"((?:[^"\\\n]|\\.)*)"\s*')
+ESCAPES = {"n": "\n", "r": "\r", "t": "\t", "a": "\a", "b": "\b", "f": "\f", "v": "\v",
+           "\\": "\\", "'": "'", '"': '"', "?": "?"}
+
+
+def fnv1a(data):
+    h = 2166136261
+    for b in data:
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def unescape(body):
+    out = bytearray()
+    i = 0
+    while i < len(body):
+        c = body[i]
+        if c != "\\":
+            out += c.encode("utf-8")
+            i += 1
+            continue
+        n = body[i + 1]
+        if n in ESCAPES:
+            out += ESCAPES[n].encode()
+            i += 2
+        elif n == "x":
+            m = re.match(r"[0-9a-fA-F]+", body[i + 2:])
+            out.append(int(m.group(0), 16) & 0xFF)
+            i += 2 + len(m.group(0))
+        elif n in "01234567":
+            m = re.match(r"[0-7]{1,3}", body[i + 1:])
+            out.append(int(m.group(0), 8) & 0xFF)
+            i += 1 + len(m.group(0))
+        else:
+            raise ValueError("unsupported escape \\%s" % n)
+    return bytes(out)
+
+
+def scan_text(text):
+    """Yields (format bytes, line) for every LOG_x call with a literal format."""
+    for m in CALL.finditer(text):
+        pos = m.end()
+        fmt = b""
+        lit = LITERAL.match(text, pos)
+        while lit:  # adjacent literals concatenate
+            fmt += unescape(lit.group(1))
+            pos = lit.end()
+            lit = LITERAL.match(text, pos)
+        yield fmt, text.count("\n", 0, m.start()) + 1
+
+
+def extract(root):
+    """Returns {token: format bytes} and a list of collision messages."""
+    tokens = {}
+    where = {}
+    errors = []
+    for sub in SOURCE_DIRS:
+        for dirpath, _, files in sorted(os.walk(os.path.join(root, sub))):
+            for name in sorted(files):
+                if not name.endswith(EXTENSIONS):
+                    continue
+                path = os.path.join(dirpath, name)
+                with open(path, encoding="utf-8") as f:
+                    text = f.read()
+                for fmt, line in scan_text(text):
+                    site = "%s:%d" % (os.path.relpath(path, root), line)
+                    token = fnv1a(fmt)
+                    if token in tokens and tokens[token] != fmt:
+                        errors.append("token %08x: %s and %s" % (token, where[token], site))
+                        continue
+                    tokens[token] = fmt
+                    where.setdefault(token, site)
+    return tokens, errors
+
+
+def write_csv(tokens, path):
+    d = os.path.dirname(path)
+    if d and not os.path.isdir(d):
+        os.makedirs(d)
+    with open(path, "w", newline="", encoding="utf-8") as f:
+        w = csv.writer(f)
+        for token in sorted(tokens):
+            w.writerow(["%08x" % token, tokens[token].decode("utf-8", "replace")])
+
+
+def read_csv(path):
+    tokens = {}
+    with open(path, newline="", encoding="utf-8") as f:
+        for row in csv.reader(f):
+            if row:
+                tokens[int(row[0], 16)] = row[1].encode("utf-8")
+    return tokens
+
+
+def main(argv):
+    root = os.path.dirname(os.path.dirname(os.path.abspath(argv[0])))
+    tokens, errors = extract(root)
+    for e in errors:
+        print("log_tokens: collision, " + e)
+    if len(argv) == 3 and argv[1] == "--out":
+        write_csv(tokens, argv[2])
+        print("log_tokens: %d formats -> %s" % (len(tokens), argv[2]))
+    elif len(argv) == 1:
+        for token in sorted(tokens):
+            print("%08x %r" % (token, tokens[token].decode("utf-8", "replace")))
+    else:
+        print(__doc__)
+        return 2
+    return 1 if errors else 0
+
+
+try:
+    Import("env")  # noqa: F821 (provided by PlatformIO/SCons)
+except NameError:
+    if __name__ == "__main__":
+        sys.exit(main(sys.argv))
+else:
+    _tokens, _errors = extract(env.subst("$PROJECT_DIR"))  # noqa: F821
+    for _e in _errors:
+        print("log_tokens: collision, " + _e)
+    if _errors:
+        env.Exit(1)  # noqa: F821
+    write_csv(_tokens, os.path.join(env.subst("$BUILD_DIR"), OUTPUT))  # noqa: F821
@@ -0,0 +1,358 @@
+// Host stress test for the deferred logger (src/logger.cpp): several
+// producer threads log through the lock-free ring while a consumer thread
+// drains it, under TSan or ASan/UBSan.
+//
+//   g++ -O1 -g -std=gnu++11 -pthread -fsanitize=thread -Isrc -Iinclude
+//       -Ilib/bubu_native/include tools/logger_stress/main.cpp
+//       lib/bubu_native/src/core.cpp lib/bubu_native/src/heap_caps.cpp
+//       -o logger_stress
+//   (or -fsanitize=address,undefined; add -DBUBU_LOG_TOKENIZED for the
+//    tokenized frames; -O2 without a sanitizer for --bench)
+//   ./logger_stress [--threads N] [--count N] [--capture FILE]
+//   ./logger_stress --bench
+//
+// The native shims have no tasks, so Logger::begin() stays synchronous;
+// the test includes logger.cpp, gives it a ring and runs drainOnce() on its
+// own thread instead. Serial (stdout) goes to a capture file (by default
+// logger_stress.out in $TMPDIR, or /tmp), which is then checked: every
+// line whole and as sent, each producer's lines in order, lines + drops ==
+// calls, "[log] dropped" totals matching the counter, and every %s
+// argument over 64 bytes ending in the cut mark. A tokenized
+// capture is kept with a FILE.csv dictionary for tools/log_decode.py --dict.
+// Exits non-zero on the first failure.
+#include "logger.cpp"
+
+#include <stdlib.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Every producer line starts "p<thread> n=<seq> "; the rest depends on kind.
+#define FMT_ARGS "p%u n=%u k=%08x s=%s|\n"
+#define FMT_BENCH "Touch: move x=%d y=%d dx=%d dy=%d t=%lu\n"
+
+struct Failure {};
+
+void fail(const char* what, const std::string& line) {
+  fprintf(stderr, "FAIL: %s: %s\n", what, line.c_str());
+  throw Failure();
+}
+
+uint32_t mix(uint32_t a, uint32_t b) {
+  uint32_t h = a * 0x9E3779B1u ^ (b + 0x7F4A7C15u);
+  h ^= h >> 15;
+  h *= 0x2C1B3C6Du;
+  return h ^ (h >> 12);
+}
+
+// Argument for (thread, seq): 0-100 printable bytes, so some are cut.
+std::string argFor(uint32_t t, uint32_t n) {
+  uint32_t h = mix(t, n);
+  std::string s(h % 101, 'a');
+  for (size_t i = 0; i < s.size(); ++i) s[i] = static_cast<char>('a' + (h >> (i % 24)) % 26);
+  return s;
+}
+
+std::string expectedArg(uint32_t t, uint32_t n) {
+  std::string s = argFor(t, n);
+  if (s.size() > STRING_MAX) s = s.substr(0, STRING_MAX) + CUT_MARK;
+  return s;
+}
+
+// ---- producers / consumer ----
+
+std::atomic<bool> producing(false);
+
+void producer(uint32_t t, uint32_t count) {
+  char text[RECORD_MAX];
+  for (uint32_t n = 0; n < count; ++n) {
+    switch (mix(n, t) % 4) {
+      case 0:
+      case 1: {
+        std::string s = argFor(t, n);
+        LOG_EMIT(FMT_ARGS, t, n, mix(t, n), s.c_str());
+        break;
+      }
+      case 2:
+        snprintf(text, sizeof(text), "p%u n=%u text|\n", t, n);
+        Logger::print(text);
+        break;
+      default:
+        snprintf(text, sizeof(text), "p%u n=%u line|", t, n);
+        Logger::println(text);
+        break;
+    }
+    if (n % 64 == 63) std::this_thread::yield();
+  }
+}
+
+void consumer() {
+  while (producing.load(std::memory_order_acquire)) {
+    if (!drainOnce()) std::this_thread::yield();
+  }
+  while (drainOnce()) {
+  }
+}
+
+// ---- capture ----
+
+std::string readFile(const char* path) {
+  std::string s;
+  FILE* f = fopen(path, "rb");
+  if (!f) return s;
+  char buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) s.append(buf, n);
+  fclose(f);
+  return s;
+}
+
+// Splits the capture into rendered lines. Text mode: lines end in "\n".
+// Tokenized: units end in 0x00 and are COBS token frames or plain text.
+bool cobsDecode(const std::string& in, std::string& out) {
+  out.clear();
+  size_t i = 0;
+  while (i < in.size()) {
+    uint8_t code = static_cast<uint8_t>(in[i]);
+    if (code == 0 || i + code > in.size()) return false;
+    out.append(in, i + 1, code - 1);
+    i += code;
+    if (code < 0xFF && i < in.size()) out.push_back('\0');
+  }
+  return true;
+}
+
+bool varint(const std::string& p, size_t& pos, uint64_t& v) {
+  v = 0;
+  for (int shift = 0; pos < p.size() && shift < 64; shift += 7) {
+    uint8_t b = static_cast<uint8_t>(p[pos++]);
+    v |= static_cast<uint64_t>(b & 0x7F) << shift;
+    if (!(b & 0x80)) return true;
+  }
+  return false;
+}
+
+int64_t unzigzag(uint64_t v) {
+  return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+// Renders one FMT_ARGS frame the way tools/log_decode.py does.
+bool renderFrame(const std::string& payload, std::string& line) {
+  uint32_t token;
+  if (payload.size() < 4) return false;
+  memcpy(&token, payload.data(), 4);
+  if (token != LogToken::fnv1a(FMT_ARGS)) return false;
+  size_t pos = 4;
+  uint64_t t, n, k, v;
+  if (!varint(payload, pos, t) || !varint(payload, pos, n) || !varint(payload, pos, k) ||
+      !varint(payload, pos, v) || pos + (v >> 1) != payload.size()) {
+    return false;
+  }
+  std::string s = payload.substr(pos, v >> 1);
+  if (v & 1) s += CUT_MARK;
+  char head[64];
+  snprintf(head, sizeof(head), "p%u n=%u k=%08x s=", static_cast<unsigned>(unzigzag(t)),
+           static_cast<unsigned>(unzigzag(n)), static_cast<unsigned>(unzigzag(k)));
+  line = head + s + "|\n";
+  return true;
+}
+
+std::vector<std::string> splitCapture(const std::string& cap) {
+  std::vector<std::string> lines;
+  char end = TOKENIZED ? '\0' : '\n';
+  size_t start = 0;
+  for (size_t i = 0; i < cap.size(); ++i) {
+    if (cap[i] != end) continue;
+    std::string unit = cap.substr(start, i + 1 - start);
+    start = i + 1;
+    if (TOKENIZED) {
+      unit.pop_back();
+      std::string payload, line;
+      if (cobsDecode(unit, payload) && renderFrame(payload, line)) unit = line;
+    }
+    lines.push_back(unit);
+  }
+  if (start != cap.size()) fail("capture ends mid-line", cap.substr(start));
+  return lines;
+}
+
+void writeDict(const std::string& path) {
+  FILE* f = fopen(path.c_str(), "w");
+  if (!f) return;
+  fprintf(f, "%08x,\"%s\"\n", static_cast<unsigned>(LogToken::fnv1a(FMT_ARGS)), FMT_ARGS);
+  fclose(f);
+}
+
+// ---- checks ----
+
+struct Tally {
+  uint32_t lines = 0;
+  uint32_t cut = 0;
+  uint32_t droppedLines = 0;
+};
+
+Tally check(const std::vector<std::string>& lines, uint32_t threads) {
+  Tally tally;
+  std::vector<int64_t> last(threads, -1);
+  for (const std::string& line : lines) {
+    unsigned long drops;
+    if (sscanf(line.c_str(), "[log] dropped %lu messages", &drops) == 1) {
+      if (line.size() < 2 || line.compare(line.size() - 2, 2, "\r\n")) fail("drop line", line);
+      tally.droppedLines += drops;
+      continue;
+    }
+    unsigned t, n;
+    int used = 0;
+    if (sscanf(line.c_str(), "p%u n=%u %n", &t, &n, &used) != 2 || !used || t >= threads) {
+      fail("not a producer line", line);
+    }
+    if (static_cast<int64_t>(n) <= last[t]) fail("out of order", line);
+    last[t] = n;
+    std::string expect;
+    switch (mix(n, t) % 4) {
+      case 0:
+      case 1: {
+        char head[64];
+        snprintf(head, sizeof(head), "p%u n=%u k=%08x s=", t, n, mix(t, n));
+        expect = head + expectedArg(t, n) + "|\n";
+        if (argFor(t, n).size() > STRING_MAX) ++tally.cut;
+        break;
+      }
+      case 2: {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "p%u n=%u text|\n", t, n);
+        expect = buf;
+        break;
+      }
+      default: {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "p%u n=%u line|\r\n", t, n);
+        expect = buf;
+        break;
+      }
+    }
+    if (line != expect) fail(("expected " + expect).c_str(), line);
+    ++tally.lines;
+  }
+  return tally;
+}
+
+// Resets the ring between runs (no thread is using it).
+void resetRing() {
+  memset(ring, 0, RING_SIZE);
+  head.store(0);
+  tail.store(0);
+  written.store(0);
+  dropped.store(0);
+  droppedReported = 0;
+  highWater = 0;
+}
+
+int stress(uint32_t threads, uint32_t count, const char* capture) {
+  resetRing();
+  fflush(stdout);
+  if (!freopen(capture, "wb", stdout)) {
+    fprintf(stderr, "cannot write %s\n", capture);
+    return 2;
+  }
+  producing.store(true, std::memory_order_release);
+  std::thread drain(consumer);
+  std::vector<std::thread> producers;
+  for (uint32_t t = 0; t < threads; ++t) producers.emplace_back(producer, t, count);
+  for (std::thread& p : producers) p.join();
+  producing.store(false, std::memory_order_release);
+  drain.join();
+  fflush(stdout);
+
+  Logger::Stats st = Logger::stats();
+  Tally tally;
+  try {
+    tally = check(splitCapture(readFile(capture)), threads);
+    uint32_t calls = threads * count;
+    if (st.written + st.dropped != calls) fail("written + dropped != calls", std::to_string(calls));
+    if (tally.lines != st.written) fail("lines != written", std::to_string(tally.lines));
+    if (tally.droppedLines != st.dropped) fail("reported drops != dropped", std::to_string(tally.droppedLines));
+  } catch (Failure&) {
+    return 1;
+  }
+  if (TOKENIZED) writeDict(std::string(capture) + ".csv");
+  fprintf(stderr, "%s: %u threads x %u calls: %u lines (%u with a cut %%s), %u dropped, high water %u bytes\n",
+          TOKENIZED ? "tokenized" : "text", threads, count, tally.lines, tally.cut, st.dropped, st.highWater);
+  return 0;
+}
+
+// ---- bench ----
+
+// Host ns per call of a touch-event line, as BUBU_LOG_BENCH times it in
+// cycles on the device: direct snprintf + Serial, deferred printf, LOG_EMIT.
+// The ring is drained outside the timed batches.
+template <typename F>
+double timeBatches(F call) {
+  constexpr int BATCH = 64;
+  constexpr int BATCHES = 2000;
+  double best = 1e30;
+  for (int b = 0; b < BATCHES; ++b) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < BATCH; ++i) call(i);
+    auto t1 = std::chrono::steady_clock::now();
+    while (drainOnce()) {
+    }
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / BATCH;
+    if (ns < best) best = ns;
+  }
+  return best;
+}
+
+int bench() {
+  resetRing();
+  fflush(stdout);
+  if (!freopen("/dev/null", "wb", stdout)) return 2;
+  double direct = timeBatches([](int i) {
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer), FMT_BENCH, i, 2 * i, 3, -4, static_cast<unsigned long>(millis()));
+    Serial.print(buffer);
+  });
+  double deferred = timeBatches([](int i) {
+    Logger::printf(FMT_BENCH, i, 2 * i, 3, -4, static_cast<unsigned long>(millis()));
+  });
+  double emitted = timeBatches([](int i) {
+    LOG_EMIT(FMT_BENCH, i, 2 * i, 3, -4, static_cast<unsigned long>(millis()));
+  });
+  fprintf(stderr, "direct %.0f ns, deferred %.0f ns, LOG_EMIT (%s) %.0f ns per call (best of 2000 x 64)\n",
+          direct, deferred, TOKENIZED ? "tokenized" : "text", emitted);
+  return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  uint32_t threads = 4;
+  uint32_t count = 20000;
+  // Out of the tree by default: a run from the repo root must not leave
+  // its capture behind as an untracked file.
+  const char* tmp = getenv("TMPDIR");
+  std::string defaultCapture = std::string(tmp && *tmp ? tmp : "/tmp") + "/logger_stress.out";
+  const char* capture = defaultCapture.c_str();
+  bool doBench = false;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--threads") && i + 1 < argc) {
+      threads = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+    } else if (!strcmp(argv[i], "--count") && i + 1 < argc) {
+      count = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+    } else if (!strcmp(argv[i], "--capture") && i + 1 < argc) {
+      capture = argv[++i];
+    } else if (!strcmp(argv[i], "--bench")) {
+      doBench = true;
+    } else {
+      fprintf(stderr, "usage: %s [--threads N] [--count N] [--capture FILE] | --bench\n", argv[0]);
+      return 2;
+    }
+  }
+  ring = static_cast<uint8_t*>(heap_caps_calloc(1, RING_SIZE, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+  if (!ring) return 2;
+  return doBench ? bench() : stress(threads, count, capture);
+}
@@ -0,0 +1,225 @@
+// Replays an LVGL allocation trace against TieredAlloc and the host's malloc.
+//
+//   g++ -O2 -std=gnu++11 -Ilib/bubu_native/include -Isrc/lvgl_mem
+//       tools/lv_alloc_replay/replay.cpp src/lvgl_mem/tiered_alloc.cpp
+//       lib/bubu_native/src/heap_caps.cpp -o lv_alloc_replay
+//   ./lv_alloc_replay capture.log [--runs N]   "lvt" lines from a -DBUBU_LV_ALLOC_TRACE build
+//   ./lv_alloc_replay --synthetic [--runs N]   generated menu open/close churn
+//
+// Prints time per call for both, the internal / PSRAM bytes TieredAlloc
+// asked the heap for (peak, from the native build's heap_caps accounting)
+// and the per-class high-water table. Host timings
+// only compare the two on this machine; they say nothing about the ESP32.
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "native_host.h"
+#include "tiered_alloc.h"
+
+namespace {
+
+enum class Op : uint8_t { ALLOC, RESIZE, FREE };
+
+struct Call {
+  Op op;
+  int32_t id;     // block freed / resized (-1: none)
+  int32_t newId;  // block produced
+  uint32_t size;
+};
+
+struct Trace {
+  std::vector<Call> calls;
+  int32_t ids = 0;
+};
+
+bool loadCapture(const char* path, Trace& t) {
+  FILE* f = fopen(path, "r");
+  if (!f) return false;
+  std::unordered_map<unsigned long long, int32_t> live;
+  char line[256];
+  auto idOf = [&](unsigned long long p) -> int32_t {
+    auto it = live.find(p);
+    if (it == live.end()) return -1;
+    int32_t id = it->second;
+    live.erase(it);
+    return id;
+  };
+  while (fgets(line, sizeof(line), f)) {
+    const char* s = strstr(line, "lvt ");
+    if (!s) continue;
+    char kind = s[4];
+    char* end = nullptr;
+    unsigned long long a = strtoull(s + 6, &end, 16);
+    Call c = {Op::FREE, -1, -1, 0};
+    if (kind == 'a') {
+      c.op = Op::ALLOC;
+      c.size = static_cast<uint32_t>(strtoul(end, nullptr, 10));
+      if (!a) continue;  // failed on the device
+      c.newId = t.ids++;
+      live[a] = c.newId;
+    } else if (kind == 'r') {
+      unsigned long long b = strtoull(end, &end, 16);
+      c.op = Op::RESIZE;
+      c.size = static_cast<uint32_t>(strtoul(end, nullptr, 10));
+      if (!b) continue;
+      c.id = a ? idOf(a) : -1;
+      c.newId = t.ids++;
+      live[b] = c.newId;
+    } else if (kind == 'f') {
+      if (!a) continue;
+      c.id = idOf(a);
+      if (c.id < 0) continue;  // allocated before the capture started
+    } else {
+      continue;
+    }
+    t.calls.push_back(c);
+  }
+  fclose(f);
+  return true;
+}
+
+// Menus built and torn down: objects, styles, label text (resized as it
+// changes) and now and then a large image or layer buffer.
+void synthesize(Trace& t) {
+  static const uint32_t OBJ_SIZES[] = {12, 16, 24, 32, 40, 56, 64, 88, 104, 136, 180, 240};
+  uint32_t rng = 12345;
+  auto next = [&rng](uint32_t n) {
+    rng = rng * 1103515245u + 12345u;
+    return (rng >> 16) % n;
+  };
+  std::vector<int32_t> resident;
+  for (int i = 0; i < 300; ++i) {  // eyes, status bar, fonts cache
+    Call c = {Op::ALLOC, -1, t.ids++, OBJ_SIZES[next(12)]};
+    t.calls.push_back(c);
+    resident.push_back(c.newId);
+  }
+  for (int panel = 0; panel < 400; ++panel) {
+    std::vector<int32_t> objs;
+    uint32_t n = 40 + next(80);
+    for (uint32_t i = 0; i < n; ++i) {
+      Call c = {Op::ALLOC, -1, t.ids++, OBJ_SIZES[next(12)]};
+      t.calls.push_back(c);
+      objs.push_back(c.newId);
+    }
+    if (next(4) == 0) {
+      Call c = {Op::ALLOC, -1, t.ids++, 4096 + next(16384)};
+      t.calls.push_back(c);
+      objs.push_back(c.newId);
+    }
+    for (uint32_t i = 0; i < n / 4; ++i) {  // label text updates
+      size_t k = next(static_cast<uint32_t>(objs.size()));
+      Call c = {Op::RESIZE, objs[k], t.ids++, 8 + next(48)};
+      t.calls.push_back(c);
+      objs[k] = c.newId;
+    }
+    for (int32_t id : objs) {
+      Call c = {Op::FREE, id, -1, 0};
+      t.calls.push_back(c);
+    }
+  }
+  for (int32_t id : resident) {
+    Call c = {Op::FREE, id, -1, 0};
+    t.calls.push_back(c);
+  }
+}
+
+struct Backend {
+  const char* name;
+  void* (*alloc)(size_t);
+  void* (*resize)(void*, size_t);
+  void (*release)(void*);
+};
+
+double replay(const Trace& t, const Backend& b, int runs) {
+  std::vector<void*> blocks(t.ids, nullptr);
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < runs; ++r) {
+    for (const Call& c : t.calls) {
+      switch (c.op) {
+        case Op::ALLOC:
+          blocks[c.newId] = b.alloc(c.size);
+          break;
+        case Op::RESIZE: {
+          void* old = c.id >= 0 ? blocks[c.id] : nullptr;
+          blocks[c.newId] = b.resize(old, c.size);
+          if (c.id >= 0) blocks[c.id] = nullptr;
+          break;
+        }
+        case Op::FREE:
+          b.release(blocks[c.id]);
+          blocks[c.id] = nullptr;
+          break;
+      }
+    }
+    for (void*& p : blocks) {  // whatever the capture left allocated
+      b.release(p);
+      p = nullptr;
+    }
+  }
+  std::chrono::duration<double, std::nano> ns = std::chrono::steady_clock::now() - start;
+  return ns.count() / (static_cast<double>(t.calls.size()) * runs);
+}
+
+}  // namespace
+
+// Report of the target build lives next to the LVGL glue; not needed here.
+void TieredAlloc::logReport() {}
+
+int main(int argc, char** argv) {
+  const char* path = nullptr;
+  bool synthetic = false;
+  int runs = 200;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--synthetic")) {
+      synthetic = true;
+    } else if (!strcmp(argv[i], "--runs") && i + 1 < argc) {
+      runs = atoi(argv[++i]);
+    } else {
+      path = argv[i];
+    }
+  }
+  Trace t;
+  if (synthetic == (path != nullptr) || runs <= 0) {
+    fprintf(stderr, "usage: %s (capture.log | --synthetic) [--runs N]\n", argv[0]);
+    return 2;
+  }
+  if (synthetic) {
+    synthesize(t);
+  } else if (!loadCapture(path, t)) {
+    fprintf(stderr, "lv_alloc_replay: cannot read %s\n", path);
+    return 1;
+  }
+  if (t.calls.empty()) {
+    fprintf(stderr, "lv_alloc_replay: no lvt lines\n");
+    return 1;
+  }
+
+  const Backend tiered = {"tiered", TieredAlloc::alloc, TieredAlloc::resize, TieredAlloc::release};
+  const Backend libc = {"malloc", malloc, realloc, free};
+  double nsTiered = replay(t, tiered, runs);
+  double nsLibc = replay(t, libc, runs);
+
+  printf("%zu calls x %d runs (%s)\n", t.calls.size(), runs, synthetic ? "synthetic" : path);
+  printf("  %-8s %7.1f ns/call\n", tiered.name, nsTiered);
+  printf("  %-8s %7.1f ns/call (host libc, not LVGL's builtin TLSF)\n", libc.name, nsLibc);
+  NativeHost::HeapUse heap = NativeHost::heapUse();
+  printf("peak from heap_caps: internal %zu B (budget %zu), psram %zu B\n", heap.internalPeak,
+         TieredAlloc::INTERNAL_BUDGET, heap.spiramPeak);
+  printf("peak live %zu B, failures %u, free lists %s\n", TieredAlloc::peakLiveBytes(),
+         TieredAlloc::failures(), TieredAlloc::check() ? "ok" : "CORRUPT");
+  printf("class   peak  pages   allocs/run  spills/run\n");
+  for (uint8_t i = 0; i < TieredAlloc::CLASS_COUNT; ++i) {
+    TieredAlloc::ClassStats c = TieredAlloc::classStats(i);
+    printf("%5u %6u %6u %12u %11u\n", c.size, c.peak, c.pages, c.allocs / runs, c.spills / runs);
+  }
+  TieredAlloc::LargeStats l = TieredAlloc::largeStats();
+  printf("psram tier: peak %u B, allocs/run %u, internal fallbacks %u\n", l.peakBytes, l.allocs / runs,
+         l.internalFallbacks);
+  return TieredAlloc::check() && TieredAlloc::liveCount() == 0 ? 0 : 1;
+}
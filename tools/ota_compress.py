@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+"""Compress a Bubu firmware image for OTA and check streaming decompression.
+
+  ota_compress.py pack   firmware.bin firmware.bin.z
+  ota_compress.py verify firmware.bin firmware.bin.z
+
+The output is a zlib stream (header + Adler-32), which the device inflates
+with a 32 KB window in src/ota/inflate_stream.cpp. Publish it as "url_zlib"
+in latest.json; "sha256" stays the hash of the uncompressed image.
+
+`verify` inflates the stream in slices that straddle the pipeline's 16 KB
+chunk size as well as odd sizes, and checks every split gives the original.
+The device's decoder path itself is covered by tools/inflate_stream_test.
+"""
+import hashlib
+import random
+import sys
+import zlib
+
+PIPELINE_CHUNK = 16 * 1024
+
+
+def load(path):
+    with open(path, "rb") as f:
+        return f.read()
+
+
+def inflate_in_slices(blob, sizes):
+    d = zlib.decompressobj(wbits=15)
+    out = bytearray()
+    i = 0
+    k = 0
+    while i < len(blob):
+        n = sizes[k % len(sizes)]
+        out += d.decompress(blob[i:i + n])
+        i += n
+        k += 1
+    out += d.flush()
+    if not d.eof:
+        raise ValueError("stream not terminated")
+    return bytes(out)
+
+
+def main(argv):
+    if len(argv) != 4 or argv[1] not in ("pack", "verify"):
+        print(__doc__)
+        return 2
+    image = load(argv[2])
+    if argv[1] == "pack":
+        blob = zlib.compress(image, 9)
+        with open(argv[3], "wb") as f:
+            f.write(blob)
+        print("%d -> %d bytes (%.1f%%)" % (len(image), len(blob), 100.0 * len(blob) / len(image)))
+        print('"sha256": "%s"' % hashlib.sha256(image).hexdigest())
+        return 0
+
+    blob = load(argv[3])
+    rng = random.Random(0x0B0B)
+    splits = [[PIPELINE_CHUNK], [1], [7], [PIPELINE_CHUNK - 1, PIPELINE_CHUNK + 1],
+              [rng.randint(1, 3 * PIPELINE_CHUNK) for _ in range(64)]]
+    want = hashlib.sha256(image).digest()
+    ok = True
+    for sizes in splits:
+        got = hashlib.sha256(inflate_in_slices(blob, sizes)).digest()
+        label = ",".join(str(s) for s in sizes[:3]) + ("..." if len(sizes) > 3 else "")
+        print("slices [%s]: %s" % (label, "OK" if got == want else "MISMATCH"))
+        ok = ok and got == want
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+"""Generate, apply and verify BDLT delta patches for Bubu OTA.
+
+  ota_delta.py make   old.bin new.bin patch.bdlt
+  ota_delta.py apply  old.bin patch.bdlt out.bin
+  ota_delta.py verify old.bin new.bin [patch.bdlt]
+
+The format matches src/ota/delta_patch.h: a 48-byte header (sizes and the
+sha256 of old.bin, which the device checks against its running image
+before writing) followed by COPY (from the running image) and LITERAL
+ops. `make` prints the target sha256 for latest.json; publish the patch as
+"patch_url" together with "patch_from" set to the version old.bin was
+built from. tools/ota_delta_test runs a patch through the device's
+DeltaApplier (--patch old.bin new.bin patch.bdlt).
+"""
+import hashlib
+import struct
+import sys
+
+MAGIC = b"BDLT"
+VERSION = 2
+HEADER_SIZE = 48
+OP_END, OP_COPY, OP_LITERAL = 0x00, 0x01, 0x02
+
+BLOCK = 32        # source index granularity (bytes)
+MIN_MATCH = 48    # shorter matches are cheaper as literals
+
+
+def varint(v):
+    out = bytearray()
+    while True:
+        b = v & 0x7F
+        v >>= 7
+        if v:
+            out.append(b | 0x80)
+        else:
+            out.append(b)
+            return bytes(out)
+
+
+def zigzag(v):
+    return (v << 1) ^ (v >> 31) if v >= 0 else ((-v) << 1) - 1
+
+
+def match_forward(src, s, dst, d):
+    n = 0
+    limit = min(len(src) - s, len(dst) - d)
+    step = 4096
+    while n + step <= limit and src[s + n:s + n + step] == dst[d + n:d + n + step]:
+        n += step
+    while n < limit and src[s + n] == dst[d + n]:
+        n += 1
+    return n
+
+
+def make_patch(src, dst):
+    index = {}
+    for i in range(0, len(src) - BLOCK + 1, BLOCK):
+        index.setdefault(src[i:i + BLOCK], i)
+
+    ops = []          # ("copy", src_off, len) | ("lit", start, end)
+    lit_start = 0
+    d = 0
+    while d + BLOCK <= len(dst):
+        s = index.get(dst[d:d + BLOCK])
+        if s is None:
+            d += 1
+            continue
+        n = match_forward(src, s, dst, d)
+        # extend backwards into the pending literal run
+        back = 0
+        while back < d - lit_start and back < s and src[s - back - 1] == dst[d - back - 1]:
+            back += 1
+        if n + back < MIN_MATCH:
+            d += 1
+            continue
+        if d - back > lit_start:
+            ops.append(("lit", lit_start, d - back))
+        ops.append(("copy", s - back, n + back))
+        d += n
+        lit_start = d
+    if lit_start < len(dst):
+        ops.append(("lit", lit_start, len(dst)))
+
+    out = bytearray(MAGIC)
+    out += struct.pack("<BBHII", VERSION, 0, 0, len(src), len(dst))
+    out += hashlib.sha256(src).digest()
+    src_pos = 0
+    for op in ops:
+        if op[0] == "copy":
+            _, off, n = op
+            out.append(OP_COPY)
+            out += varint(n)
+            out += varint(zigzag(off - src_pos))
+            src_pos = off + n
+        else:
+            _, a, b = op
+            out.append(OP_LITERAL)
+            out += varint(b - a)
+            out += dst[a:b]
+    out.append(OP_END)
+    return bytes(out)
+
+
+def read_varint(buf, i):
+    v, shift = 0, 0
+    while True:
+        b = buf[i]
+        i += 1
+        v |= (b & 0x7F) << shift
+        shift += 7
+        if not b & 0x80:
+            return v, i
+
+
+def apply_patch(src, patch):
+    if patch[:4] != MAGIC or patch[4] != VERSION:
+        raise ValueError("bad header")
+    src_size, dst_size = struct.unpack_from("<II", patch, 8)
+    if src_size > len(src) or hashlib.sha256(src[:src_size]).digest() != patch[16:HEADER_SIZE]:
+        raise ValueError("patch was built for another source image")
+    out = bytearray()
+    i, src_pos = HEADER_SIZE, 0
+    while True:
+        op = patch[i]
+        i += 1
+        if op == OP_END:
+            break
+        n, i = read_varint(patch, i)
+        if op == OP_COPY:
+            z, i = read_varint(patch, i)
+            src_pos += (z >> 1) ^ -(z & 1)
+            out += src[src_pos:src_pos + n]
+            src_pos += n
+        elif op == OP_LITERAL:
+            out += patch[i:i + n]
+            i += n
+        else:
+            raise ValueError("bad op 0x%02x at %d" % (op, i - 1))
+    if len(out) != dst_size:
+        raise ValueError("target size mismatch")
+    return bytes(out)
+
+
+def load(path):
+    with open(path, "rb") as f:
+        return f.read()
+
+
+def main(argv):
+    if len(argv) < 4:
+        print(__doc__)
+        return 2
+    cmd = argv[1]
+    if cmd == "make" and len(argv) == 5:
+        src, dst = load(argv[2]), load(argv[3])
+        patch = make_patch(src, dst)
+        with open(argv[4], "wb") as f:
+            f.write(patch)
+        assert apply_patch(src, patch) == dst
+        print("patch: %d bytes (%.1f%% of %d)" % (len(patch), 100.0 * len(patch) / len(dst), len(dst)))
+        print('"sha256": "%s"' % hashlib.sha256(dst).hexdigest())
+        return 0
+    if cmd == "apply" and len(argv) == 5:
+        out = apply_patch(load(argv[2]), load(argv[3]))
+        with open(argv[4], "wb") as f:
+            f.write(out)
+        print("sha256 %s" % hashlib.sha256(out).hexdigest())
+        return 0
+    if cmd == "verify" and len(argv) in (4, 5):
+        src, dst = load(argv[2]), load(argv[3])
+        patch = load(argv[4]) if len(argv) == 5 else make_patch(src, dst)
+        ok = hashlib.sha256(apply_patch(src, patch)).digest() == hashlib.sha256(dst).digest()
+        print("round-trip %s (%d byte patch)" % ("OK" if ok else "FAILED", len(patch)))
+        return 0 if ok else 1
+    print(__doc__)
+    return 2
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
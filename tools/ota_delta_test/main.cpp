@@ -0,0 +1,422 @@
+// Host test for DeltaApplier (src/ota/delta_patch.cpp): rebuilds synthetic
+// target images from BDLT patches fed in random-sized slices and compares
+// them with the targets byte for byte, then checks the rejections (another
+// base image, bad header, bad op, out-of-range copy, overflow, truncation).
+//
+//   g++ -O2 -std=gnu++11 -Isrc/ota tools/ota_delta_test/main.cpp
+//       src/ota/delta_patch.cpp -o ota_delta_test
+//   ./ota_delta_test [--cases N] [--seed S]
+//   ./ota_delta_test --patch old.bin new.bin patch.bdlt   a tools/ota_delta.py patch
+//
+// The synthetic patches come from a small greedy encoder below (block index
+// + forward extension, like ota_delta.py), with targets made from the source
+// by inserts, deletes, moved blocks, byte edits and appended data. Exits
+// non-zero on the first mismatch.
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "delta_patch.h"
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+// --- sha256 (FIPS 180-4), for the source digest ---
+
+const uint32_t K[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+void sha256(const uint8_t* data, size_t len, uint8_t out[32]) {
+  uint32_t h[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+  Bytes msg(data, data + len);
+  msg.push_back(0x80);
+  while (msg.size() % 64 != 56) msg.push_back(0);
+  uint64_t bits = static_cast<uint64_t>(len) * 8;
+  for (int i = 7; i >= 0; --i) msg.push_back(static_cast<uint8_t>(bits >> (i * 8)));
+  for (size_t blk = 0; blk < msg.size(); blk += 64) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+      const uint8_t* p = &msg[blk + i * 4];
+      w[i] = (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+    }
+    for (int i = 16; i < 64; ++i) {
+      uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+      uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], hh = h[7];
+    for (int i = 0; i < 64; ++i) {
+      uint32_t t1 = hh + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+      uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+      hh = g; g = f; f = e; e = d + t1; d = c; c = b; b = a; a = t1 + t2;
+    }
+    h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+  }
+  for (int i = 0; i < 8; ++i) {
+    for (int j = 0; j < 4; ++j) out[i * 4 + j] = static_cast<uint8_t>(h[i] >> (24 - j * 8));
+  }
+}
+
+// --- random ---
+
+uint64_t rngState = 0x9e3779b97f4a7c15ull;
+
+uint32_t rnd() {
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 7;
+  rngState ^= rngState << 17;
+  return static_cast<uint32_t>(rngState >> 16);
+}
+
+uint32_t rnd(uint32_t lo, uint32_t hi) {  // inclusive
+  return lo + rnd() % (hi - lo + 1);
+}
+
+Bytes randomBytes(size_t n) {
+  Bytes b(n);
+  // Runs of repeated bytes, like padding in a firmware image, between noise
+  for (size_t i = 0; i < n;) {
+    size_t run = rnd(1, 64);
+    uint8_t v = static_cast<uint8_t>(rnd());
+    bool repeat = rnd() % 4 == 0;
+    for (size_t j = 0; j < run && i < n; ++j, ++i) b[i] = repeat ? v : static_cast<uint8_t>(rnd());
+  }
+  return b;
+}
+
+Bytes mutate(const Bytes& src) {
+  Bytes dst = src;
+  uint32_t edits = rnd(1, 12);
+  for (uint32_t e = 0; e < edits; ++e) {
+    size_t at = dst.empty() ? 0 : rnd(0, static_cast<uint32_t>(dst.size()));
+    switch (rnd() % 5) {
+      case 0: {  // insert new bytes
+        Bytes ins = randomBytes(rnd(1, 3000));
+        dst.insert(dst.begin() + at, ins.begin(), ins.end());
+        break;
+      }
+      case 1: {  // delete
+        size_t n = std::min<size_t>(rnd(1, 5000), dst.size() - at);
+        dst.erase(dst.begin() + at, dst.begin() + at + n);
+        break;
+      }
+      case 2: {  // copy an earlier or later block here (moves the source cursor both ways)
+        if (src.size() < 200) break;
+        size_t from = rnd(0, static_cast<uint32_t>(src.size() - 200));
+        size_t n = std::min<size_t>(rnd(100, 8000), src.size() - from);
+        dst.insert(dst.begin() + at, src.begin() + from, src.begin() + from + n);
+        break;
+      }
+      case 3: {  // scattered byte edits
+        for (uint32_t i = rnd(1, 40); i > 0 && !dst.empty(); --i) dst[rnd(0, static_cast<uint32_t>(dst.size() - 1))] ^= 0x5A;
+        break;
+      }
+      default: {  // append
+        Bytes tail = randomBytes(rnd(1, 2000));
+        dst.insert(dst.end(), tail.begin(), tail.end());
+        break;
+      }
+    }
+  }
+  return dst;
+}
+
+// --- encoder ---
+
+void putVarint(Bytes& out, uint32_t v) {
+  while (v >= 0x80) {
+    out.push_back(static_cast<uint8_t>(v | 0x80));
+    v >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(v));
+}
+
+void putLe32(Bytes& out, uint32_t v) {
+  for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(v >> (i * 8)));
+}
+
+Bytes header(uint32_t srcSize, uint32_t dstSize, const uint8_t digest[32], uint8_t version = DeltaApplier::VERSION) {
+  Bytes out = {'B', 'D', 'L', 'T', version, 0, 0, 0};
+  putLe32(out, srcSize);
+  putLe32(out, dstSize);
+  out.insert(out.end(), digest, digest + 32);
+  return out;
+}
+
+void putCopy(Bytes& out, uint32_t& srcPos, uint32_t off, uint32_t n) {
+  out.push_back(0x01);
+  putVarint(out, n);
+  int32_t delta = static_cast<int32_t>(off - srcPos);
+  putVarint(out, static_cast<uint32_t>((delta << 1) ^ (delta >> 31)));
+  srcPos = off + n;
+}
+
+void putLiteral(Bytes& out, const uint8_t* p, uint32_t n) {
+  out.push_back(0x02);
+  putVarint(out, n);
+  out.insert(out.end(), p, p + n);
+}
+
+Bytes encode(const Bytes& src, const Bytes& dst) {
+  constexpr size_t BLOCK = 32;
+  constexpr size_t MIN_MATCH = 48;
+  std::unordered_map<std::string, uint32_t> index;
+  for (size_t i = 0; i + BLOCK <= src.size(); i += BLOCK) {
+    index.emplace(std::string(reinterpret_cast<const char*>(&src[i]), BLOCK), static_cast<uint32_t>(i));
+  }
+  uint8_t digest[32];
+  sha256(src.data(), src.size(), digest);
+  Bytes out = header(static_cast<uint32_t>(src.size()), static_cast<uint32_t>(dst.size()), digest);
+  uint32_t srcPos = 0;
+  size_t lit = 0;
+  size_t d = 0;
+  while (d + BLOCK <= dst.size()) {
+    auto it = index.find(std::string(reinterpret_cast<const char*>(&dst[d]), BLOCK));
+    if (it == index.end()) {
+      ++d;
+      continue;
+    }
+    size_t s = it->second;
+    size_t n = 0;
+    while (s + n < src.size() && d + n < dst.size() && src[s + n] == dst[d + n]) ++n;
+    if (n < MIN_MATCH) {
+      ++d;
+      continue;
+    }
+    if (d > lit) putLiteral(out, &dst[lit], static_cast<uint32_t>(d - lit));
+    // Split some copies so consecutive COPY ops and zero deltas occur too
+    if (n > 256 && rnd() % 3 == 0) {
+      uint32_t first = rnd(1, static_cast<uint32_t>(n - 1));
+      putCopy(out, srcPos, static_cast<uint32_t>(s), first);
+      putCopy(out, srcPos, static_cast<uint32_t>(s + first), static_cast<uint32_t>(n - first));
+    } else {
+      putCopy(out, srcPos, static_cast<uint32_t>(s), static_cast<uint32_t>(n));
+    }
+    if (rnd() % 8 == 0) putLiteral(out, nullptr, 0);
+    d += n;
+    lit = d;
+  }
+  if (lit < dst.size()) putLiteral(out, &dst[lit], static_cast<uint32_t>(dst.size() - lit));
+  out.push_back(0x00);
+  return out;
+}
+
+// --- applier harness ---
+
+struct Source {
+  const Bytes* image;
+  size_t partitionSize;
+  uint32_t checks;
+};
+
+bool readSource(uint32_t offset, uint8_t* dst, size_t len, void* ctx) {
+  const Source* s = static_cast<const Source*>(ctx);
+  if (offset + len > s->image->size()) return false;
+  memcpy(dst, s->image->data() + offset, len);
+  return true;
+}
+
+bool checkSource(uint32_t sourceSize, const uint8_t* digest, uint8_t*, size_t, void* ctx) {
+  Source* s = static_cast<Source*>(ctx);
+  ++s->checks;
+  if (sourceSize > s->partitionSize || sourceSize > s->image->size()) return false;
+  uint8_t h[32];
+  sha256(s->image->data(), sourceSize, h);
+  return memcmp(h, digest, 32) == 0;
+}
+
+bool collect(const uint8_t* data, size_t len, void* ctx) {
+  Bytes* out = static_cast<Bytes*>(ctx);
+  out->insert(out->end(), data, data + len);
+  return true;
+}
+
+struct Applied {
+  bool ok;
+  DeltaApplier::Status status;
+  Bytes out;
+  uint32_t checks;
+};
+
+// maxSlice 0: random slice sizes from 1 byte to a few KB
+Applied apply(const Bytes& src, const Bytes& patch, size_t partitionSize, size_t maxSlice = 0) {
+  Applied r;
+  Source s = {&src, partitionSize, 0};
+  Bytes scratch(rnd(1, 4096));
+  DeltaApplier a;
+  a.begin(readSource, checkSource, &s, collect, &r.out, scratch.data(), scratch.size());
+  bool fed = true;
+  for (size_t pos = 0; pos < patch.size() && fed;) {
+    size_t n = maxSlice ? maxSlice : (rnd() % 4 == 0 ? rnd(1, 3) : rnd(1, 6000));
+    n = std::min(n, patch.size() - pos);
+    fed = a.feed(patch.data() + pos, n);
+    pos += n;
+  }
+  r.ok = fed && a.finish();
+  r.status = a.status();
+  r.checks = s.checks;
+  return r;
+}
+
+int failures = 0;
+
+void expect(bool cond, const char* what, uint32_t caseNo) {
+  if (cond) return;
+  ++failures;
+  fprintf(stderr, "case %u: %s\n", caseNo, what);
+}
+
+void expectStatus(const Applied& r, DeltaApplier::Status want, const char* what, uint32_t caseNo) {
+  if (!r.ok && r.status == want) return;
+  ++failures;
+  fprintf(stderr, "case %u: %s: got %s (%s), want %s\n", caseNo, what, r.ok ? "ok" : "failed",
+          DeltaApplier::statusToStr(r.status), DeltaApplier::statusToStr(want));
+}
+
+void runCase(uint32_t c) {
+  Bytes src = randomBytes(rnd(0, 10) == 0 ? rnd(0, 64) : rnd(1000, 300000));
+  Bytes dst = rnd() % 10 == 0 ? randomBytes(rnd(0, 5000)) : mutate(src);
+  Bytes patch = encode(src, dst);
+
+  Applied r = apply(src, patch, src.size() + rnd(0, 65536));
+  expect(r.ok && r.out == dst, "rebuilt image differs", c);
+  Applied one = apply(src, patch, src.size(), 1);
+  expect(one.ok && one.out == dst, "rebuilt image differs with 1-byte slices", c);
+
+  // A patch for another base: the check runs once and nothing is written
+  if (!src.empty()) {
+    Bytes other = src;
+    other[rnd(0, static_cast<uint32_t>(other.size() - 1))] ^= 0x01;
+    Applied wrong = apply(other, patch, other.size());
+    expectStatus(wrong, DeltaApplier::Status::SOURCE_MISMATCH, "other base image", c);
+    expect(wrong.out.empty() && wrong.checks == 1, "bytes written before the source check", c);
+  }
+  // The running partition is smaller than the patch's source
+  if (!src.empty()) {
+    expectStatus(apply(src, patch, src.size() - 1), DeltaApplier::Status::SOURCE_MISMATCH, "source > partition", c);
+  }
+  // Cut short anywhere after the header
+  if (patch.size() > DeltaApplier::HEADER_SIZE + 1) {
+    Bytes cut(patch.begin(), patch.begin() + rnd(DeltaApplier::HEADER_SIZE, static_cast<uint32_t>(patch.size() - 1)));
+    Applied t = apply(src, cut, src.size());
+    expect(!t.ok, "truncated patch accepted", c);
+  }
+  // Target size one byte short
+  if (!dst.empty()) {
+    Bytes small = patch;
+    uint32_t dstSize = static_cast<uint32_t>(dst.size() - 1);
+    for (int i = 0; i < 4; ++i) small[12 + i] = static_cast<uint8_t>(dstSize >> (i * 8));
+    expectStatus(apply(src, small, src.size()), DeltaApplier::Status::TARGET_OVERFLOW, "target overflow", c);
+  }
+}
+
+void runFixedCases() {
+  uint8_t digest[32];
+  Bytes src = randomBytes(4096);
+  sha256(src.data(), src.size(), digest);
+
+  Bytes v1 = header(4096, 0, digest, 1);
+  v1.push_back(0x00);
+  expectStatus(apply(src, v1, src.size()), DeltaApplier::Status::BAD_HEADER, "version 1 header", 0);
+
+  Bytes magic = header(4096, 0, digest);
+  magic[0] = 'X';
+  expectStatus(apply(src, magic, src.size()), DeltaApplier::Status::BAD_HEADER, "bad magic", 0);
+
+  Bytes badOp = header(4096, 10, digest);
+  badOp.push_back(0x07);
+  expectStatus(apply(src, badOp, src.size()), DeltaApplier::Status::BAD_OP, "bad op", 0);
+
+  Bytes past = header(4096, 100, digest);
+  uint32_t pos = 0;
+  putCopy(past, pos, 4000, 100);
+  past.push_back(0x00);
+  expectStatus(apply(src, past, src.size()), DeltaApplier::Status::SOURCE_RANGE, "copy past the source", 0);
+
+  Bytes before = header(4096, 10, digest);
+  before.push_back(0x01);
+  putVarint(before, 10);
+  putVarint(before, 1);  // zigzag(-1): before offset 0
+  expectStatus(apply(src, before, src.size()), DeltaApplier::Status::SOURCE_RANGE, "copy before the source", 0);
+
+  Bytes longVarint = header(4096, 10, digest);
+  longVarint.push_back(0x02);
+  for (int i = 0; i < 6; ++i) longVarint.push_back(0xFF);
+  expectStatus(apply(src, longVarint, src.size()), DeltaApplier::Status::BAD_OP, "overlong varint", 0);
+
+  Bytes noEnd = header(4096, 3, digest);
+  putLiteral(noEnd, src.data(), 3);
+  expectStatus(apply(src, noEnd, src.size()), DeltaApplier::Status::TRUNCATED, "missing END", 0);
+
+  Bytes trailing = header(4096, 3, digest);
+  putLiteral(trailing, src.data(), 3);
+  trailing.push_back(0x00);
+  trailing.push_back(0x99);
+  Applied t = apply(src, trailing, src.size());
+  expect(t.ok && t.out == Bytes(src.begin(), src.begin() + 3), "bytes after END", 0);
+}
+
+bool load(const char* path, Bytes& out) {
+  FILE* f = fopen(path, "rb");
+  if (!f) return false;
+  uint8_t buf[65536];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.insert(out.end(), buf, buf + n);
+  fclose(f);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  uint32_t cases = 200;
+  const char* patchArgs[3] = {nullptr, nullptr, nullptr};
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--cases") && i + 1 < argc) {
+      cases = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+    } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+      rngState = strtoull(argv[++i], nullptr, 10) * 2 + 1;
+    } else if (!strcmp(argv[i], "--patch") && i + 3 < argc) {
+      patchArgs[0] = argv[++i];
+      patchArgs[1] = argv[++i];
+      patchArgs[2] = argv[++i];
+    } else {
+      fprintf(stderr, "usage: %s [--cases N] [--seed S] | --patch old.bin new.bin patch.bdlt\n", argv[0]);
+      return 2;
+    }
+  }
+
+  if (patchArgs[0]) {
+    Bytes src, dst, patch;
+    if (!load(patchArgs[0], src) || !load(patchArgs[1], dst) || !load(patchArgs[2], patch)) {
+      fprintf(stderr, "cannot read inputs\n");
+      return 2;
+    }
+    for (uint32_t run = 0; run < 20; ++run) {
+      Applied r = apply(src, patch, src.size(), run == 0 ? 1 : 0);
+      expect(r.ok && r.out == dst, "patch does not rebuild new.bin", run);
+      if (!r.ok) fprintf(stderr, "  status %s\n", DeltaApplier::statusToStr(r.status));
+    }
+    printf("%s: %s\n", patchArgs[2], failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+  }
+
+  runFixedCases();
+  for (uint32_t c = 1; c <= cases; ++c) runCase(c);
+  printf("%u cases, %d failures\n", cases, failures);
+  return failures ? 1 : 0;
+}
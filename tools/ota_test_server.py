@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""Local OTA server that drops connections, for testing resumable downloads.
+
+  ota_test_server.py firmware.bin [--port 8000] [--drop-every 300000]
+                     [--stall] [--no-range] [--version 9.9.9]
+
+Serves /latest.json (pointing "url" back at this server with the image's
+sha256) and /firmware.bin with Range support. Every response is cut off
+after --drop-every bytes: the socket is closed, or with --stall it is held
+open silently so the device hits its stream timeout instead. --no-range
+ignores Range headers to exercise the restart-from-zero path.
+
+Build the firmware with
+  -DBUBU_OTA_MANIFEST_URL=\\"http://<host-ip>:8000/latest.json\\"
+and, to collect flight recorder crash reports (printed here), with
+  -DBUBU_FR_UPLOAD_URL=\\"http://<host-ip>:8000/crash\\"
+"""
+import argparse
+import hashlib
+import http.server
+import json
+import re
+import socket
+import time
+
+
+def make_handler(args, image, sha):
+    class Handler(http.server.BaseHTTPRequestHandler):
+        protocol_version = "HTTP/1.1"
+
+        def do_POST(self):
+            body = self.rfile.read(int(self.headers.get("Content-Length", 0)))
+            if self.path != "/crash":
+                self.send_error(404)
+                return
+            print("---- crash report from %s (fw %s) ----" % (self.client_address[0],
+                                                            self.headers.get("X-Bubu-Version")))
+            print(body.decode("utf-8", "replace"), end="")
+            self.send_response(204)
+            self.send_header("Content-Length", "0")
+            self.end_headers()
+
+        def do_GET(self):
+            if self.path == "/latest.json":
+                host = self.headers.get("Host") or "%s:%d" % (local_ip(), args.port)
+                body = json.dumps({
+                    "version": args.version,
+                    "url": "http://%s/firmware.bin" % host,
+                    "sha256": sha,
+                }).encode()
+                self.send_response(200)
+                self.send_header("Content-Type", "application/json")
+                self.send_header("Content-Length", str(len(body)))
+                self.end_headers()
+                self.wfile.write(body)
+                return
+            if self.path != "/firmware.bin":
+                self.send_error(404)
+                return
+
+            start = 0
+            m = re.match(r"bytes=(\d+)-$", self.headers.get("Range", ""))
+            if m and not args.no_range:
+                start = int(m.group(1))
+                if start >= len(image):
+                    self.send_response(416)
+                    self.send_header("Content-Range", "bytes */%d" % len(image))
+                    self.send_header("Content-Length", "0")
+                    self.end_headers()
+                    return
+                self.send_response(206)
+                self.send_header("Content-Range", "bytes %d-%d/%d" % (start, len(image) - 1, len(image)))
+            else:
+                self.send_response(200)
+            self.send_header("Content-Type", "application/octet-stream")
+            self.send_header("Content-Length", str(len(image) - start))
+            self.end_headers()
+
+            end = min(len(image), start + args.drop_every) if args.drop_every else len(image)
+            pos = start
+            while pos < end:
+                n = min(4096, end - pos)
+                self.wfile.write(image[pos:pos + n])
+                pos += n
+            if pos < len(image):
+                self.log_message("dropping at %d/%d", pos, len(image))
+                if args.stall:
+                    time.sleep(60)
+                self.close_connection = True
+                self.connection.shutdown(socket.SHUT_RDWR)
+
+    return Handler
+
+
+def local_ip():
+    s = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    try:
+        s.connect(("10.255.255.255", 1))
+        return s.getsockname()[0]
+    except OSError:
+        return "127.0.0.1"
+    finally:
+        s.close()
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("image")
+    ap.add_argument("--port", type=int, default=8000)
+    ap.add_argument("--drop-every", type=int, default=300000,
+                    help="bytes sent per response before dropping (0 = never)")
+    ap.add_argument("--stall", action="store_true", help="hang instead of closing")
+    ap.add_argument("--no-range", action="store_true", help="ignore Range requests")
+    ap.add_argument("--version", default="9.9.9")
+    args = ap.parse_args()
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+    sha = hashlib.sha256(image).hexdigest()
+    print("serving %d bytes, sha256 %s, manifest http://%s:%d/latest.json"
+          % (len(image), sha, local_ip(), args.port))
+    srv = http.server.ThreadingHTTPServer(("", args.port), make_handler(args, image, sha))
+    srv.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
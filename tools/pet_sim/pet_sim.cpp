@@ -0,0 +1,265 @@
+// Fast-forward pet-life simulation on the host.
+// Runs the real CareSystem, SubStateSystem, LevelSystem, EventBus and
+// PersistStore on the native build's simulated millis() (lib/bubu_native),
+// one simulated second per tick, through a scripted week: care sessions at
+// fixed hours, nights without care, and one whole day of neglect. Checks the rules each tick and prints
+// one line per simulated day; exits non-zero if a check fails.
+//
+//   g++ -O2 -std=gnu++11 -Ilib/bubu_native/include -Iinclude -Isrc
+//       tools/pet_sim/pet_sim.cpp src/care_system.cpp src/sub_state_system.cpp
+//       src/level_system.cpp src/event_bus.cpp src/persist_store.cpp
+//       lib/bubu_native/src/core.cpp lib/bubu_native/src/heap_caps.cpp -o pet_sim
+//   ./pet_sim [--days N] [--neglect-day D] [--verbose]
+//
+// Sessions happen at 08:00, 13:00, 18:00 and 22:00: one care action every
+// ACTION_GAP_S seconds (sandwich, bath, sleep, or a game hit published as a
+// StatDelta like EyeGame does) until every stat is at SESSION_TARGET.
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Preferences.h>
+#include "battery_system.h"
+#include "bubu_clock.h"
+#include "care_system.h"
+#include "event_bus.h"
+#include "flight_recorder.h"
+#include "level_system.h"
+#include "logger.h"
+#include "native_host.h"
+#include "persist_store.h"
+#include "stat_log/stat_log.h"
+#include "sub_state_system.h"
+
+namespace {
+bool verbose = false;
+}
+
+// --- firmware symbols outside the simulated subsystems ---
+
+namespace Logger {
+void print(const char* msg) {
+  if (verbose) fputs(msg, stdout);
+}
+void println(const char* msg) {
+  if (verbose) puts(msg);
+}
+void vprintf(const char* fmt, va_list args) {
+  if (verbose) ::vprintf(fmt, args);
+}
+void printf(const char* fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  vprintf(fmt, args);
+  va_end(args);
+}
+void writeToken(const uint8_t*, size_t) {}
+}  // namespace Logger
+
+namespace FlightRecorder {
+void record(Event, uint8_t, uint16_t, uint32_t) {}
+}
+
+namespace StatLog {
+void recordEvent(EventCode, int32_t) {}
+}
+
+namespace BatterySystem {
+BatteryStatus getStatus() {
+  BatteryStatus s = {4.2f, 100, false, ChargingState::PLUGGED_IN_FULL};
+  return s;
+}
+}
+
+namespace {
+
+constexpr uint32_t DAY_S = 24UL * 3600UL;
+constexpr uint32_t START_HOUR = 7;  // the pet boots at 07:00 on day 1
+constexpr uint32_t SESSION_HOURS[] = {8, 13, 18, 22};
+constexpr uint32_t ACTION_GAP_S = 5;
+constexpr int SESSION_TARGET = 90;
+
+// Mirrors of the private SubStateSystem thresholds the checks depend on.
+constexpr int LOW_THRESHOLD[4] = {30, 30, 25, 25};  // hunger, mood, energy, cleanliness
+constexpr int RECOVER_THRESHOLD = 80;
+constexpr uint32_t PRIMARY_ACTIVATE_S = 20;
+constexpr uint32_t DEPRESSED_LONG_S = 60;
+
+const char* const STAT_NAMES[4] = {"hunger", "mood", "energy", "cleanliness"};
+
+struct DayReport {
+  int minStat[4];
+  uint32_t subSeconds[5];  // irritable, withdrawn, sluggish, uncomfortable, depressed
+  uint32_t actions;
+};
+
+int stat(int i) {
+  switch (i) {
+    case 0: return CareSystem::getHunger();
+    case 1: return CareSystem::getMood();
+    case 2: return CareSystem::getEnergy();
+    default: return CareSystem::getCleanliness();
+  }
+}
+
+bool primary(const SubStateSystem::Snapshot& s, int i) {
+  switch (i) {
+    case 0: return s.sub_irritable;
+    case 1: return s.sub_withdrawn;
+    case 2: return s.sub_sluggish;
+    default: return s.sub_uncomfortable;
+  }
+}
+
+// One care action for the lowest stat below target; false when all are there.
+bool careAction() {
+  int lowest = -1;
+  for (int i = 0; i < 4; ++i) {
+    if (stat(i) < SESSION_TARGET && (lowest < 0 || stat(i) < stat(lowest))) lowest = i;
+  }
+  switch (lowest) {
+    case 0: CareSystem::addHunger(CareSystem::kSandwichBoost); return true;
+    case 1:
+      EventBus::publish(EventBus::StatDelta{CareSystem::STAT_MOOD,
+                                            static_cast<int16_t>(CareSystem::kGameRewardPerHit)});
+      return true;
+    case 2: CareSystem::addEnergy(CareSystem::kSleepBoost); return true;
+    case 3: CareSystem::addCleanliness(CareSystem::kBathBoost); return true;
+    default: return false;
+  }
+}
+
+unsigned failures = 0;
+
+void fail(uint32_t t, const char* what, int i) {
+  if (++failures <= 20) {
+    printf("FAIL day %lu %02lu:%02lu:%02lu: %s (%s)\n", static_cast<unsigned long>(t / DAY_S + 1),
+           static_cast<unsigned long>(t % DAY_S / 3600), static_cast<unsigned long>(t % 3600 / 60),
+           static_cast<unsigned long>(t % 60), what, i >= 0 ? STAT_NAMES[i] : "-");
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  uint32_t days = 7;
+  uint32_t neglectDay = 5;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--days") && i + 1 < argc) {
+      days = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+    } else if (!strcmp(argv[i], "--neglect-day") && i + 1 < argc) {
+      neglectDay = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+    } else if (!strcmp(argv[i], "--verbose")) {
+      verbose = true;
+    } else {
+      fprintf(stderr, "usage: %s [--days N] [--neglect-day D] [--verbose]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  uint32_t hostStartUs = micros();  // host time; millis() is simulated
+  // Time 0 means "not started" to CareSystem and SubStateSystem.
+  NativeHost::advanceMs(1000);
+  PersistStore::begin();
+  LevelSystem::begin();
+  CareSystem::begin();
+  SubStateSystem::begin();
+
+  uint32_t lowSince[4] = {0, 0, 0, 0};  // seconds + 1, 0: not low
+  uint32_t sessionUntil = 0;
+  bool inSession = false;
+  uint32_t lastActionS = 0;
+  bool sawNeglectDepressed = false;
+  int startLevel = LevelSystem::getLevel();
+  uint32_t ticks = 0;
+  DayReport day;
+
+  printf("day  min H  M  E  C   end H  M  E  C   irrit withdr slugg uncomf depr (min)  actions  lvl   xp  nvs\n");
+  for (uint32_t d = 0; d < days; ++d) {
+    memset(&day, 0, sizeof(day));
+    for (int i = 0; i < 4; ++i) day.minStat[i] = 100;
+    bool neglected = d + 1 == neglectDay;
+
+    for (uint32_t s = 0; s < DAY_S; ++s) {
+      uint32_t t = d * DAY_S + s;                       // seconds since boot
+      uint32_t clock = (t + START_HOUR * 3600) % DAY_S;  // time of day
+      if (t) NativeHost::advanceMs(1000);  // millis() == 1000 + t * 1000
+
+      if (!neglected) {
+        for (uint32_t h : SESSION_HOURS) {
+          if (clock == h * 3600) {
+            inSession = true;
+            sessionUntil = t + 3600;
+          }
+        }
+      }
+      if (inSession && t - lastActionS >= ACTION_GAP_S) {
+        if (careAction()) {
+          lastActionS = t;
+          ++day.actions;
+        } else {
+          inSession = false;
+        }
+      }
+      if (inSession && t >= sessionUntil) inSession = false;
+
+      // The loop task's order: bus, care tick, store, then the frame.
+      EventBus::dispatch();
+      CareSystem::update();
+      PersistStore::update(BubuClock::nowMs());
+      SubStateSystem::Snapshot snap;
+      SubStateSystem::update(snap);
+      ++ticks;
+
+      bool allHigh = true;
+      for (int i = 0; i < 4; ++i) {
+        int v = stat(i);
+        if (v < 0 || v > 100) fail(t, "stat out of range", i);
+        if (v < day.minStat[i]) day.minStat[i] = v;
+        if (v < RECOVER_THRESHOLD) allHigh = false;
+        if (v < LOW_THRESHOLD[i]) {
+          if (!lowSince[i]) lowSince[i] = t + 1;
+        } else {
+          lowSince[i] = 0;
+        }
+        uint32_t lowFor = lowSince[i] ? t + 1 - lowSince[i] : 0;
+        if (lowFor >= PRIMARY_ACTIVATE_S && !primary(snap, i)) fail(t, "low for 20 s without its sub-state", i);
+        if (lowFor >= DEPRESSED_LONG_S && !snap.sub_depressed) fail(t, "low for 60 s without depressed", i);
+        if (v >= RECOVER_THRESHOLD && primary(snap, i)) fail(t, "sub-state kept after recovery", i);
+      }
+      if (allHigh && (snap.sub_depressed || snap.forceCount)) fail(t, "all stats high but still gated", -1);
+
+      for (int i = 0; i < 4; ++i) day.subSeconds[i] += primary(snap, i);
+      day.subSeconds[4] += snap.sub_depressed;
+      if (neglected && snap.sub_depressed) sawNeglectDepressed = true;
+    }
+
+    printf("%3lu%s  %3d%3d%3d%3d    %3d%3d%3d%3d   %5lu %6lu %5lu %6lu %4lu        %7lu %4d %4d %4lu\n",
+           static_cast<unsigned long>(d + 1), neglected ? "*" : " ", day.minStat[0], day.minStat[1],
+           day.minStat[2], day.minStat[3], stat(0), stat(1), stat(2), stat(3),
+           static_cast<unsigned long>(day.subSeconds[0] / 60), static_cast<unsigned long>(day.subSeconds[1] / 60),
+           static_cast<unsigned long>(day.subSeconds[2] / 60), static_cast<unsigned long>(day.subSeconds[3] / 60),
+           static_cast<unsigned long>(day.subSeconds[4] / 60), static_cast<unsigned long>(day.actions),
+           LevelSystem::getLevel(), LevelSystem::getXP(), static_cast<unsigned long>(Preferences::writes()));
+  }
+
+  if (neglectDay >= 1 && neglectDay <= days && !sawNeglectDepressed) {
+    fail((neglectDay - 1) * DAY_S, "never depressed on the neglected day", -1);
+  }
+  if (days >= 2 && LevelSystem::getLevel() <= startLevel) fail(days * DAY_S - 1, "no level gained", -1);
+
+  PersistStore::Stats st = PersistStore::total();
+  printf("* neglected day\n%lu ticks (%lu simulated days) in %lu ms; store: %lu saves, %lu NVS writes, %lu commits\n",
+         static_cast<unsigned long>(ticks), static_cast<unsigned long>(days),
+         static_cast<unsigned long>((micros() - hostStartUs) / 1000),
+         static_cast<unsigned long>(st.saves), static_cast<unsigned long>(st.nvsWrites),
+         static_cast<unsigned long>(st.commits));
+  if (failures) {
+    printf("%u check(s) failed\n", failures);
+    return 1;
+  }
+  printf("all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+"""Load test for the captive portal (src/portal/portal_server.cpp).
+
+  portal_load.py [--url http://192.168.4.1] [--clients 8] [--seconds 20]
+  portal_load.py --loopback      same run against a local stand-in server
+
+Each client loops over the portal's traffic mix: a cold page load, a
+revalidation with If-None-Match (must be 304), /scan, and an OS probe URL
+(must redirect). Every reply is checked against the device contract, and
+latency percentiles plus failures are printed per route. More clients than
+the device's socket pool (PortalServer::MAX_CONNECTIONS) is deliberate: the
+server should purge idle sockets, not refuse or stall.
+
+--loopback serves the generated gzip page from a 127.0.0.1 server limited
+to the same number of concurrent connections, which checks the tool and the
+asset pipeline without hardware; the device's DNS and /save parsing is
+tested on the host by tools/portal_proto_test. Watch the device log and
+UI frame time while running against real hardware.
+"""
+import argparse
+import gzip
+import http.client
+import json
+import os
+import random
+import socketserver
+import sys
+import threading
+import time
+from http.server import BaseHTTPRequestHandler
+from urllib.parse import urlparse
+
+MAX_CONNECTIONS = 4
+PROBES = ["/generate_204", "/hotspot-detect.html", "/connecttest.txt", "/ncsi.txt"]
+
+
+class Stats:
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.lat = {}
+        self.fail = {}
+
+    def ok(self, route, ms):
+        with self.lock:
+            self.lat.setdefault(route, []).append(ms)
+
+    def bad(self, route, why):
+        with self.lock:
+            self.fail.setdefault(route, {}).setdefault(why, 0)
+            self.fail[route][why] += 1
+
+
+def request(host, port, method, path, headers=None, body=None):
+    conn = http.client.HTTPConnection(host, port, timeout=10)
+    try:
+        conn.request(method, path, body=body, headers=headers or {})
+        r = conn.getresponse()
+        return r.status, dict((k.lower(), v) for k, v in r.getheaders()), r.read()
+    finally:
+        conn.close()
+
+
+def client(host, port, deadline, stats, rng):
+    etag = None
+    while time.time() < deadline:
+        step = rng.choice(["root", "revalidate", "scan", "probe"])
+        if step == "revalidate" and not etag:
+            step = "root"
+        t0 = time.time()
+        try:
+            if step == "root":
+                st, h, body = request(host, port, "GET", "/", {"Accept-Encoding": "gzip"})
+                if st != 200 or h.get("content-encoding") != "gzip":
+                    raise ValueError("status %d enc %s" % (st, h.get("content-encoding")))
+                if b"<html" not in gzip.decompress(body):
+                    raise ValueError("not html")
+                etag = h.get("etag")
+            elif step == "revalidate":
+                st, h, body = request(host, port, "GET", "/", {"If-None-Match": etag})
+                if st != 304 or body:
+                    raise ValueError("status %d" % st)
+            elif step == "scan":
+                st, h, body = request(host, port, "GET", "/scan")
+                if st != 200 or not isinstance(json.loads(body), list):
+                    raise ValueError("status %d" % st)
+            else:
+                st, h, body = request(host, port, "GET", rng.choice(PROBES))
+                if st != 302 or not h.get("location", "").startswith("http://"):
+                    raise ValueError("status %d" % st)
+            stats.ok(step, (time.time() - t0) * 1000.0)
+        except Exception as e:  # noqa: BLE001 - every failure is a data point
+            stats.bad(step, type(e).__name__ + ": " + str(e)[:60])
+
+
+def pct(values, p):
+    values = sorted(values)
+    return values[min(len(values) - 1, int(p / 100.0 * len(values)))]
+
+
+def report(stats, seconds):
+    total_fail = 0
+    print("%-11s %7s %8s %8s %8s %8s" % ("route", "ok", "req/s", "p50 ms", "p95 ms", "max ms"))
+    for route in ("root", "revalidate", "scan", "probe"):
+        lat = stats.lat.get(route, [])
+        if lat:
+            print("%-11s %7d %8.1f %8.1f %8.1f %8.1f" % (route, len(lat), len(lat) / seconds,
+                                                       pct(lat, 50), pct(lat, 95), max(lat)))
+        for why, n in sorted(stats.fail.get(route, {}).items()):
+            total_fail += n
+            print("  FAIL %-9s x%d %s" % (route, n, why))
+    return 1 if total_fail else 0
+
+
+# ---- loopback stand-in ----
+
+def load_asset():
+    sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+    import embed_portal
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    _, _, _, gz = embed_portal.build(root)
+    import hashlib
+    return gz, '"%s"' % hashlib.sha256(gz).hexdigest()[:16]
+
+
+def make_server():
+    gz, etag = load_asset()
+    scan = json.dumps([{"ssid": "net%d" % i, "rssi": -40 - 5 * i} for i in range(8)]).encode()
+    slots = threading.BoundedSemaphore(MAX_CONNECTIONS)
+
+    class Handler(BaseHTTPRequestHandler):
+        def log_message(self, *args):
+            pass
+
+        def send(self, code, ctype, body, extra=()):
+            self.send_response(code)
+            for k, v in extra:
+                self.send_header(k, v)
+            if ctype:
+                self.send_header("Content-Type", ctype)
+            self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            self.wfile.write(body)
+
+        def do_GET(self):
+            with slots:
+                if self.path == "/":
+                    common = [("ETag", etag), ("Cache-Control", "no-cache")]
+                    if self.headers.get("If-None-Match") == etag:
+                        self.send(304, None, b"", common)
+                    else:
+                        self.send(200, "text/html", gz, common + [("Content-Encoding", "gzip")])
+                elif self.path == "/scan":
+                    self.send(200, "application/json", scan)
+                else:
+                    self.send(302, "text/plain", b"Redirecting to setup...",
+                              [("Location", "http://127.0.0.1/")])
+
+    class Server(socketserver.ThreadingMixIn, socketserver.TCPServer):
+        daemon_threads = True
+        allow_reuse_address = True
+
+    srv = Server(("127.0.0.1", 0), Handler)
+    threading.Thread(target=srv.serve_forever, daemon=True).start()
+    return srv
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--url", default="http://192.168.4.1")
+    ap.add_argument("--clients", type=int, default=2 * MAX_CONNECTIONS)
+    ap.add_argument("--seconds", type=float, default=20.0)
+    ap.add_argument("--loopback", action="store_true")
+    args = ap.parse_args()
+
+    if args.loopback:
+        srv = make_server()
+        host, port = srv.server_address
+    else:
+        u = urlparse(args.url)
+        host, port = u.hostname, u.port or 80
+
+    stats = Stats()
+    deadline = time.time() + args.seconds
+    threads = [threading.Thread(target=client, args=(host, port, deadline, stats, random.Random(i)))
+               for i in range(args.clients)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    print("%d clients, %.0f s against %s:%d" % (args.clients, args.seconds, host, port))
+    return report(stats, args.seconds)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
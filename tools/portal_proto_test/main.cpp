@@ -0,0 +1,304 @@
+// Host test for the captive portal's wire parsing (src/portal/portal_proto.cpp):
+// DNS replies and /save credential bodies, under ASan/UBSan.
+//
+//   g++ -O1 -g -std=gnu++11 -fsanitize=address,undefined -Isrc -Isrc/portal
+//       tools/portal_proto_test/main.cpp src/portal/portal_proto.cpp
+//       src/json/json_stream.cpp -o portal_proto_test
+//   ./portal_proto_test [--fuzz N] [--seed S]
+//
+// Fixed cases check the replies and parsed credentials against the device
+// contract. The fuzz pass throws random and mutated packets and bodies at
+// both, each in a heap block of exactly the size the firmware provides (a
+// DNS_PACKET_MAX receive buffer, a NUL-terminated body), so any read or
+// write past it is caught. Exits non-zero on the first failure.
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "portal_proto.h"
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+constexpr uint32_t AP_ADDR = 0x0104A8C0;  // 192.168.4.1, network order on a little-endian host
+
+uint64_t rngState = 0x9e3779b97f4a7c15ull;
+
+uint32_t rnd() {
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 7;
+  rngState ^= rngState << 17;
+  return static_cast<uint32_t>(rngState >> 16);
+}
+
+uint32_t rnd(uint32_t lo, uint32_t hi) {  // inclusive
+  return lo + rnd() % (hi - lo + 1);
+}
+
+int failures = 0;
+
+void check(bool cond, const char* what) {
+  if (cond) return;
+  ++failures;
+  fprintf(stderr, "FAIL: %s\n", what);
+}
+
+// --- DNS ---
+
+Bytes query(const char* name, uint16_t qtype, uint16_t qclass = 1, uint8_t flags2 = 0x01, uint16_t qdcount = 1) {
+  Bytes q = {0xBE, 0xEF, flags2, 0x00, static_cast<uint8_t>(qdcount >> 8), static_cast<uint8_t>(qdcount), 0, 0, 0, 0, 0, 0};
+  for (const char* p = name; *p;) {
+    const char* dot = strchr(p, '.');
+    size_t n = dot ? static_cast<size_t>(dot - p) : strlen(p);
+    q.push_back(static_cast<uint8_t>(n));
+    q.insert(q.end(), p, p + n);
+    p += n + (dot ? 1 : 0);
+  }
+  q.push_back(0);
+  q.push_back(static_cast<uint8_t>(qtype >> 8));
+  q.push_back(static_cast<uint8_t>(qtype));
+  q.push_back(static_cast<uint8_t>(qclass >> 8));
+  q.push_back(static_cast<uint8_t>(qclass));
+  return q;
+}
+
+// Runs a packet through buildDnsReply in an exact-size receive buffer.
+struct Reply {
+  size_t len;
+  Bytes data;
+};
+
+Reply reply(const Bytes& packet) {
+  uint8_t* buf = static_cast<uint8_t*>(malloc(PortalProto::DNS_PACKET_MAX));
+  size_t len = std::min(packet.size(), PortalProto::DNS_PACKET_MAX);
+  if (len) memcpy(buf, packet.data(), len);
+  Reply r;
+  r.len = PortalProto::buildDnsReply(buf, len, AP_ADDR);
+  r.data.assign(buf, buf + (r.len ? r.len : 0));
+  free(buf);
+  return r;
+}
+
+uint16_t be16(const Bytes& b, size_t at) { return static_cast<uint16_t>(b[at] << 8 | b[at + 1]); }
+
+void checkDns() {
+  const char* name = "connectivitycheck.gstatic.com";
+  Bytes q = query(name, 1);
+  Reply r = reply(q);
+  check(r.len == q.size() + 16, "A query: reply length");
+  if (r.len == q.size() + 16) {
+    check(r.data[0] == 0xBE && r.data[1] == 0xEF, "A query: id kept");
+    check(r.data[2] == 0x85 && r.data[3] == 0x80, "A query: QR AA RD / RA NOERROR");
+    check(be16(r.data, 4) == 1 && be16(r.data, 6) == 1 && be16(r.data, 8) == 0 && be16(r.data, 10) == 0,
+          "A query: counts");
+    check(std::equal(q.begin() + 12, q.end(), r.data.begin() + 12), "A query: question echoed");
+    const uint8_t rr[] = {0xC0, 0x0C, 0, 1, 0, 1, 0, 0, 0, 60, 0, 4, 192, 168, 4, 1};
+    check(!memcmp(r.data.data() + q.size(), rr, sizeof(rr)), "A query: answer record");
+  }
+
+  Reply any = reply(query(name, 255));
+  check(any.len == q.size() + 16, "ANY query answered");
+
+  Bytes aaaa = query(name, 28);
+  Reply r6 = reply(aaaa);
+  check(r6.len == aaaa.size() && be16(r6.data, 6) == 0 && r6.data[3] == 0x80, "AAAA: empty NOERROR reply");
+
+  Reply chaos = reply(query(name, 1, 3));
+  check(chaos.len > 0 && be16(chaos.data, 6) == 0, "class CH: no answer");
+
+  Bytes noRd = query(name, 1, 1, 0x00);
+  Reply rn = reply(noRd);
+  check(rn.len > 0 && rn.data[2] == 0x84, "RD clear stays clear");
+
+  // EDNS: an OPT record in the additional section is dropped
+  Bytes edns = query(name, 1);
+  edns[11] = 1;
+  const uint8_t opt[] = {0, 0, 41, 0x10, 0, 0, 0, 0, 0, 0, 0};
+  edns.insert(edns.end(), opt, opt + sizeof(opt));
+  Reply re = reply(edns);
+  check(re.len == edns.size() - sizeof(opt) + 16 && be16(re.data, 10) == 0, "EDNS: additional dropped");
+
+  Bytes resp = query(name, 1, 1, 0x81);
+  check(reply(resp).len == 0, "response packet dropped");
+
+  Bytes iquery = query(name, 1, 1, 0x09);  // opcode 1
+  Reply ri = reply(iquery);
+  check(ri.len == 12 && ri.data[3] == 0x04 && (ri.data[2] & 0x80) && be16(ri.data, 4) == 0, "opcode 1: NOTIMP");
+
+  Reply two = reply(query(name, 1, 1, 0x01, 2));
+  check(two.len == 12 && two.data[3] == 0x04, "two questions: NOTIMP");
+
+  Bytes ptr = query(name, 1);
+  ptr[12] = 0xC0;
+  check(reply(ptr).len == 0, "compressed question dropped");
+
+  for (size_t cut = 0; cut < q.size(); ++cut) {
+    Bytes shortQ(q.begin(), q.begin() + cut);
+    Reply rs = reply(shortQ);
+    if (cut < 12) check(rs.len == 0, "short header dropped");
+    else check(rs.len == 0, "cut question dropped");
+  }
+
+  // Longest question that still leaves room for the answer, and one more
+  std::string longName;
+  while (longName.size() < 460) longName += "abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstu.";
+  for (size_t n = 430; n < 500; ++n) {
+    std::string nm = longName.substr(0, n);
+    while (!nm.empty() && nm.back() == '.') nm.pop_back();
+    Bytes lq = query(nm.c_str(), 1);
+    if (lq.size() > PortalProto::DNS_PACKET_MAX) break;
+    Reply rl = reply(lq);
+    if (lq.size() + 16 <= PortalProto::DNS_PACKET_MAX) check(rl.len == lq.size() + 16, "long name answered");
+    else check(rl.len == 0, "no room for the answer: dropped");
+  }
+}
+
+void fuzzDns(uint32_t runs) {
+  Bytes seed = query("captive.apple.com", 1);
+  for (uint32_t i = 0; i < runs; ++i) {
+    Bytes p;
+    if (rnd() % 3 == 0) {
+      p.resize(rnd(0, PortalProto::DNS_PACKET_MAX));
+      for (uint8_t& b : p) b = static_cast<uint8_t>(rnd());
+      if (p.size() > 5 && rnd() % 2) p[2] &= 0x07, p[4] = 0, p[5] = 1;  // mostly a standard query
+    } else {
+      p = seed;
+      for (uint32_t n = rnd(1, 4); n > 0; --n) {
+        size_t at = rnd(0, static_cast<uint32_t>(p.size() - 1));
+        switch (rnd() % 3) {
+          case 0: p[at] = static_cast<uint8_t>(rnd()); break;
+          case 1: p.insert(p.begin() + at, rnd(1, 80), static_cast<uint8_t>(rnd() % 64)); break;
+          default: p.resize(at ? at : 1); break;
+        }
+      }
+      if (p.size() > PortalProto::DNS_PACKET_MAX) p.resize(PortalProto::DNS_PACKET_MAX);
+    }
+    Reply r = reply(p);
+    if (!r.len) continue;
+    bool ok = r.len >= 12 && r.len <= PortalProto::DNS_PACKET_MAX && (r.data[2] & 0x80) &&
+              r.data[0] == p[0] && r.data[1] == p[1] && be16(r.data, 8) == 0 && be16(r.data, 10) == 0;
+    if (!ok) {
+      check(false, "fuzzed DNS reply breaks the contract");
+      return;
+    }
+  }
+}
+
+// --- credentials ---
+
+struct Parsed {
+  bool ok;
+  PortalServer::Credentials c;
+};
+
+// The body as handleSave() hands it over: exactly len bytes plus the NUL.
+Parsed parse(const std::string& body) {
+  char* buf = static_cast<char*>(malloc(body.size() + 1));
+  memcpy(buf, body.data(), body.size());
+  buf[body.size()] = '\0';
+  Parsed p;
+  memset(&p.c, 0x5A, sizeof(p.c));
+  p.ok = PortalProto::parseCredentials(buf, body.size(), p.c);
+  free(buf);
+  return p;
+}
+
+void expectCreds(const std::string& body, const char* ssid, const char* pass) {
+  Parsed p = parse(body);
+  bool good = p.ok && !strcmp(p.c.ssid, ssid) && !strcmp(p.c.pass, pass);
+  if (!good) fprintf(stderr, "  body %s -> %d \"%.40s\" \"%.40s\"\n", body.c_str(), p.ok, p.ok ? p.c.ssid : "", p.ok ? p.c.pass : "");
+  check(good, "credentials parsed");
+}
+
+void expectReject(const std::string& body) {
+  Parsed p = parse(body);
+  if (p.ok) fprintf(stderr, "  body %.80s accepted\n", body.c_str());
+  check(!p.ok, "credentials rejected");
+}
+
+void checkCredentials() {
+  const std::string ssid32(32, 's'), pass64(64, 'p');
+  expectCreds("{\"ssid\":\"Bubu Home\",\"pass\":\"hunter22\"}", "Bubu Home", "hunter22");
+  expectCreds("{\"pass\":\"x\",\"ssid\":\"caf\\u00e9\"}", "caf\xc3\xa9", "x");
+  expectCreds("{\"ssid\":\"open\"}", "open", "");
+  expectCreds("{\"ssid\":\"" + ssid32 + "\",\"pass\":\"" + pass64 + "\"}", ssid32.c_str(), pass64.c_str());
+  expectReject(" {\"ssid\":\"a\"}");  // not JSON at byte 0: read as a form without an ssid
+  expectReject("{\"ssid\":\"" + ssid32 + "s\"}");
+  expectReject("{\"ssid\":\"a\",\"pass\":\"" + pass64 + "p\"}");
+  expectReject("{\"ssid\":\"\",\"pass\":\"x\"}");
+  expectReject("{\"pass\":\"x\"}");
+  expectReject("{\"ssid\":\"a\"");
+  expectReject("{\"ssid\":7}");
+  expectReject("{");
+
+  expectCreds("ssid=Bubu+Home&pass=p%40ss%2Bword", "Bubu Home", "p@ss+word");
+  expectCreds("ssid=Listed&ssid_manual=Typed&pass=x", "Typed", "x");
+  expectCreds("ssid_manual=&ssid=Listed", "Listed", "");
+  expectCreds("pass=x&ssid=a", "a", "x");
+  expectCreds("ssid=100%25&pass=%zz%4", "100%", "%zz%4");
+  expectCreds("xssid=no&ssid=yes", "yes", "");
+  expectCreds("ssid=a&pass=" + std::string(63, 'p'), "a", std::string(63, 'p').c_str());
+  expectReject("ssid=a&pass=" + std::string(65, 'p'));
+  expectReject("ssid=a&pass=" + std::string(3 * 65 + 4, 'p'));  // longer than the encoded buffer
+  expectReject("ssid_manual=" + ssid32 + "s&ssid=Listed");
+  expectCreds("ssid=" + ssid32, ssid32.c_str(), "");
+  expectReject("ssid=" + ssid32 + "s");
+  expectReject("ssid=");
+  expectReject("pass=x");
+  expectReject("ssidx=a");
+  expectReject("");
+}
+
+void fuzzCredentials(uint32_t runs) {
+  static const char* const SEEDS[] = {
+    "{\"ssid\":\"Bubu Home\",\"pass\":\"hunter22\"}",
+    "ssid=Bubu+Home&ssid_manual=&pass=p%40ss",
+    "{\"ssid\":\"caf\\u00e9 \\ud83d\\ude00\",\"pass\":\"\\\"\\\\\"}",
+  };
+  static const char* const PIECES[] = {"&", "=", "%", "%4", "+", "ssid=", "pass=", "ssid_manual=", "{", "\"", "\\u", "}"};
+  for (uint32_t i = 0; i < runs; ++i) {
+    std::string b = SEEDS[rnd() % 3];
+    for (uint32_t n = rnd(1, 5); n > 0; --n) {
+      size_t at = rnd(0, static_cast<uint32_t>(b.size()));
+      switch (rnd() % 4) {
+        case 0: b.insert(at, PIECES[rnd() % (sizeof(PIECES) / sizeof(PIECES[0]))]); break;
+        case 1: b.insert(at, rnd(1, 120), static_cast<char>(rnd(0x20, 0x7E))); break;
+        case 2: b.erase(at, rnd(1, 10)); break;
+        default: if (at < b.size()) b[at] = static_cast<char>(rnd(1, 255)); break;
+      }
+    }
+    if (b.size() > 512) b.resize(512);  // handleSave's SAVE_BODY_MAX
+    Parsed p = parse(b);
+    if (!p.ok) continue;
+    bool ok = strlen(p.c.ssid) > 0 && strlen(p.c.ssid) < sizeof(p.c.ssid) && strlen(p.c.pass) < sizeof(p.c.pass);
+    if (!ok) {
+      check(false, "fuzzed credentials break the contract");
+      return;
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  uint32_t runs = 200000;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--fuzz") && i + 1 < argc) {
+      runs = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+    } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+      rngState = strtoull(argv[++i], nullptr, 10) * 2 + 1;
+    } else {
+      fprintf(stderr, "usage: %s [--fuzz N] [--seed S]\n", argv[0]);
+      return 2;
+    }
+  }
+  checkDns();
+  checkCredentials();
+  fuzzDns(runs);
+  fuzzCredentials(runs);
+  printf("%s\n", failures ? "FAILED" : "OK");
+  return failures ? 1 : 0;
+}
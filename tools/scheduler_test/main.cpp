@@ -0,0 +1,170 @@
+// Host test for Scheduler::runDue() (src/scheduler.cpp): tasks with their
+// own interval checks under randomly late loop passes.
+//
+//   g++ -O2 -g -std=gnu++11 -fsanitize=address,undefined -DBUBU_LOG_LEVELS='"*=WARN"'
+//       -Isrc -Iinclude -Ilib/bubu_native/include tools/scheduler_test/main.cpp
+//       src/scheduler.cpp src/logger.cpp lib/bubu_native/src/core.cpp
+//       lib/bubu_native/src/heap_caps.cpp -o scheduler_test
+//   ./scheduler_test [--passes N] [--seed S]
+//
+// Each task measures the time it is given against its previous run, the
+// way ImuMonitor::update() gates its samples, and takes 0-3 ms of the
+// simulated clock itself, so later tasks in a pass run after the pass's
+// nowMs. Loop passes wake on the returned wait, early, or late: mostly on
+// time, 1 in 4 up to 30 ms late, 1 in 100 stalled for seconds. The clock
+// starts just before the millis() wrap. Every pass checks that exactly the
+// due tasks ran, none early, and the returned wait; at the end no interval
+// check may have failed (except after runSoon()) and the late counts must
+// match runs a whole period or more past their deadline. Exits non-zero on
+// the first failure.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bubu_clock.h"
+#include "native_host.h"
+#include "scheduler.h"
+
+namespace {
+
+uint64_t rngState = 0x9e3779b97f4a7c15ull;
+
+uint32_t rnd() {
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 7;
+  rngState ^= rngState << 17;
+  return static_cast<uint32_t>(rngState >> 32);
+}
+
+bool due(uint32_t nowMs, uint32_t atMs) {
+  return static_cast<int32_t>(nowMs - atMs) >= 0;
+}
+
+// What the test expects of each task, kept from the task's side.
+struct Model {
+  uint32_t periodMs;
+  uint32_t deadlineMs;
+  uint32_t lastRunMs;
+  uint32_t runs;
+  uint32_t late;
+  uint32_t rejected;  // runs the task's own interval check would refuse
+  bool soon;          // runSoon() since the last run: the check may refuse
+};
+
+constexpr uint32_t PERIODS[] = {5, 10, 20, 100, 1000, 60000};
+constexpr uint8_t TASKS = sizeof(PERIODS) / sizeof(PERIODS[0]);
+Model model[TASKS];
+bool failed = false;
+
+void fail(uint32_t pass, uint8_t task, const char* what) {
+  if (failed) return;
+  fprintf(stderr, "FAIL: pass %lu task %u (%lu ms): %s at %lu ms, deadline %lu\n",
+          static_cast<unsigned long>(pass), task, static_cast<unsigned long>(model[task].periodMs), what,
+          static_cast<unsigned long>(BubuClock::nowMs()), static_cast<unsigned long>(model[task].deadlineMs));
+  failed = true;
+}
+
+uint32_t pass = 0;
+
+template <uint8_t I>
+void task(uint32_t nowMs) {
+  Model& m = model[I];
+  if (nowMs != BubuClock::nowMs()) fail(pass, I, "given a stale time");
+  if (!due(nowMs, m.deadlineMs)) fail(pass, I, "ran early");
+  if (m.runs && !m.soon && nowMs - m.lastRunMs < m.periodMs) ++m.rejected;
+  if (due(nowMs, m.deadlineMs + m.periodMs)) ++m.late;
+  m.deadlineMs = nowMs + m.periodMs;
+  m.lastRunMs = nowMs;
+  m.soon = false;
+  ++m.runs;
+  NativeHost::advanceMs(rnd() % 4);  // the task's own work
+}
+
+const Scheduler::TaskFn FNS[TASKS] = {task<0>, task<1>, task<2>, task<3>, task<4>, task<5>};
+
+uint32_t expectedWait() {
+  uint32_t now = BubuClock::nowMs();
+  uint32_t wait = UINT32_MAX;
+  for (const Model& m : model) {
+    if (due(now, m.deadlineMs)) return 0;
+    if (m.deadlineMs - now < wait) wait = m.deadlineMs - now;
+  }
+  return wait;
+}
+
+uint32_t sleepMs(uint32_t wait) {
+  uint32_t r = rnd() % 100;
+  if (r < 12) return wait ? rnd() % wait : 0;            // woken early
+  if (r < 13) return wait + 1000 + rnd() % 5000;         // stalled
+  if (r < 38) return wait + rnd() % 31;                  // late
+  return wait;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  uint32_t passes = 200000;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--passes") && i + 1 < argc) {
+      passes = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+    } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+      rngState = strtoull(argv[++i], nullptr, 0) * 2 + 1;
+    } else {
+      fprintf(stderr, "usage: %s [--passes N] [--seed S]\n", argv[0]);
+      return 2;
+    }
+  }
+  NativeHost::advanceMs(0xFFFFFFFFu - 100000);  // wraps within the first 100 s
+  for (uint8_t i = 0; i < TASKS; ++i) {
+    uint32_t firstDelay = rnd() % 50;
+    model[i] = Model{PERIODS[i], BubuClock::nowMs() + firstDelay, 0, 0, 0, 0, false};
+    if (Scheduler::add("task", FNS[i], PERIODS[i], 0, firstDelay) != i) {
+      fprintf(stderr, "FAIL: cannot add task %u\n", i);
+      return 1;
+    }
+  }
+
+  for (pass = 0; pass < passes && !failed; ++pass) {
+    if (rnd() % 500 == 0) {
+      uint8_t i = static_cast<uint8_t>(rnd() % TASKS);
+      Scheduler::runSoon(i);
+      model[i].deadlineMs = BubuClock::nowMs();
+      model[i].soon = true;
+    }
+    uint32_t now = BubuClock::nowMs();
+    bool wasDue[TASKS];
+    uint32_t runsBefore[TASKS];
+    for (uint8_t i = 0; i < TASKS; ++i) {
+      wasDue[i] = due(now, model[i].deadlineMs);
+      runsBefore[i] = model[i].runs;
+    }
+    uint32_t wait = Scheduler::runDue(now);
+    for (uint8_t i = 0; i < TASKS; ++i) {
+      if (wasDue[i] && model[i].runs == runsBefore[i]) fail(pass, i, "skipped while due");
+      if (model[i].runs > runsBefore[i] + 1) fail(pass, i, "ran twice in a pass");
+    }
+    if (wait != expectedWait()) {
+      fprintf(stderr, "FAIL: pass %lu: runDue() returned a %lu ms wait, expected %lu\n",
+              static_cast<unsigned long>(pass), static_cast<unsigned long>(wait),
+              static_cast<unsigned long>(expectedWait()));
+      return 1;
+    }
+    NativeHost::advanceMs(sleepMs(wait));
+  }
+  if (failed) return 1;
+
+  for (uint8_t i = 0; i < TASKS; ++i) {
+    const Model& m = model[i];
+    Scheduler::TaskStats s;
+    if (!Scheduler::stats(i, s) || s.runs != m.runs || s.late != m.late || m.rejected) {
+      fprintf(stderr, "FAIL: task %u (%lu ms): %lu runs, %lu late, %lu refused by its interval check; "
+                      "expected %lu runs, %lu late, none refused\n",
+              i, static_cast<unsigned long>(m.periodMs), static_cast<unsigned long>(s.runs),
+              static_cast<unsigned long>(s.late), static_cast<unsigned long>(m.rejected),
+              static_cast<unsigned long>(m.runs), static_cast<unsigned long>(m.late));
+      return 1;
+    }
+  }
+  printf("scheduler: %lu passes, %u tasks, no run early or refused by its interval check\n",
+         static_cast<unsigned long>(passes), TASKS);
+  return 0;
+}
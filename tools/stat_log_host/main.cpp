@@ -0,0 +1,288 @@
+// StatLog on the host, against a file-backed partition image.
+//
+//   g++ -O2 -std=gnu++11 -Isrc/stat_log tools/stat_log_host/main.cpp src/stat_log/stat_log.cpp -o stat_log_host
+//   ./stat_log_host selftest /tmp/statlog.bin [--sectors N]
+//   ./stat_log_host dump spiffs.bin [--tier minute|hour|day] [--from T] [--to T]
+//
+// dump reads an image of the device's partition:
+//   esptool.py read_flash 0xD10000 0x2F0000 spiffs.bin   (offsets from default_16MB.csv)
+// The image backend behaves like NOR flash: erase sets 0xFF, a write may only
+// clear bits, and a write over programmed bytes fails the selftest.
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "stat_log.h"
+
+namespace {
+
+struct Image {
+  FILE* f;
+  uint32_t size;
+  uint32_t reads;
+  uint32_t writes;
+  uint32_t erases;
+  bool violation;
+};
+
+bool imgRead(void* ctx, uint32_t offset, void* out, size_t len) {
+  Image* img = static_cast<Image*>(ctx);
+  ++img->reads;
+  return offset + len <= img->size && fseek(img->f, offset, SEEK_SET) == 0 && fread(out, 1, len, img->f) == len;
+}
+
+bool imgWrite(void* ctx, uint32_t offset, const void* data, size_t len) {
+  Image* img = static_cast<Image*>(ctx);
+  ++img->writes;
+  std::vector<uint8_t> cur(len);
+  if (offset + len > img->size || fseek(img->f, offset, SEEK_SET) != 0 || fread(cur.data(), 1, len, img->f) != len) {
+    return false;
+  }
+  const uint8_t* in = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < len; ++i) {
+    if (cur[i] != 0xFF) img->violation = true;  // programmed twice
+    cur[i] &= in[i];
+  }
+  return fseek(img->f, offset, SEEK_SET) == 0 && fwrite(cur.data(), 1, len, img->f) == len;
+}
+
+bool imgErase(void* ctx, uint32_t offset) {
+  Image* img = static_cast<Image*>(ctx);
+  ++img->erases;
+  std::vector<uint8_t> ff(StatLog::SECTOR_SIZE, 0xFF);
+  return offset % StatLog::SECTOR_SIZE == 0 && offset + ff.size() <= img->size &&
+         fseek(img->f, offset, SEEK_SET) == 0 && fwrite(ff.data(), 1, ff.size(), img->f) == ff.size();
+}
+
+bool openImage(Image& img, const char* path, uint32_t createSize) {
+  memset(&img, 0, sizeof(img));
+  if (createSize) {
+    img.f = fopen(path, "w+b");
+    if (!img.f) return false;
+    std::vector<uint8_t> ff(createSize, 0xFF);
+    if (fwrite(ff.data(), 1, ff.size(), img.f) != ff.size()) return false;
+    img.size = createSize;
+    return true;
+  }
+  img.f = fopen(path, "r+b");
+  if (!img.f) img.f = fopen(path, "rb");
+  if (!img.f) return false;
+  fseek(img.f, 0, SEEK_END);
+  img.size = static_cast<uint32_t>(ftell(img.f));
+  return true;
+}
+
+StatLog::Flash flashOf(Image& img) {
+  StatLog::Flash f = {imgRead, imgWrite, imgErase, img.size, &img};
+  return f;
+}
+
+const char* const FIELD_NAMES[] = {"hunger", "mood", "energy", "clean", "level", "xp"};
+
+bool printRecord(const StatLog::Record& r, void*) {
+  if (r.isEvent) {
+    printf("%lu,event,%u,%ld\n", static_cast<unsigned long>(r.time), static_cast<unsigned>(r.code),
+           static_cast<long>(r.arg));
+  } else {
+    printf("%lu,sample", static_cast<unsigned long>(r.time));
+    for (int32_t v : r.values) printf(",%ld", static_cast<long>(v));
+    printf("\n");
+  }
+  return true;
+}
+
+int dump(int argc, char** argv) {
+  StatLog::Tier tier = StatLog::Tier::MINUTE;
+  uint32_t from = 0;
+  uint32_t to = 0xFFFFFFFF;
+  for (int i = 3; i + 1 < argc; i += 2) {
+    if (!strcmp(argv[i], "--tier")) {
+      tier = !strcmp(argv[i + 1], "hour") ? StatLog::Tier::HOUR
+           : !strcmp(argv[i + 1], "day") ? StatLog::Tier::DAY : StatLog::Tier::MINUTE;
+    } else if (!strcmp(argv[i], "--from")) {
+      from = static_cast<uint32_t>(strtoul(argv[i + 1], nullptr, 0));
+    } else if (!strcmp(argv[i], "--to")) {
+      to = static_cast<uint32_t>(strtoul(argv[i + 1], nullptr, 0));
+    }
+  }
+  Image img;
+  if (!openImage(img, argv[2], 0)) {
+    fprintf(stderr, "stat_log_host: cannot open %s\n", argv[2]);
+    return 1;
+  }
+  if (!StatLog::begin(flashOf(img))) {
+    fprintf(stderr, "stat_log_host: not a StatLog image\n");
+    return 1;
+  }
+  printf("time,kind");
+  for (const char* n : FIELD_NAMES) printf(",%s", n);
+  printf("\n");
+  StatLog::query(tier, from, to, printRecord, nullptr);
+  fclose(img.f);  // no end(): dump never writes
+  return 0;
+}
+
+// --- selftest ---
+
+struct Expected {
+  uint32_t time;
+  int32_t values[StatLog::FIELD_COUNT];
+};
+
+struct Collect {
+  std::vector<StatLog::Record> out;
+};
+
+bool collect(const StatLog::Record& r, void* ctx) {
+  static_cast<Collect*>(ctx)->out.push_back(r);
+  return true;
+}
+
+int failures = 0;
+
+void expect(bool ok, const char* what) {
+  if (ok) return;
+  ++failures;
+  fprintf(stderr, "FAIL: %s\n", what);
+}
+
+void sampleAt(uint32_t t, int32_t (&v)[StatLog::FIELD_COUNT]) {
+  uint32_t m = t / 60;
+  v[StatLog::HUNGER] = 100 - static_cast<int32_t>(m % 97);
+  v[StatLog::MOOD] = 100 - static_cast<int32_t>(m / 3 % 89);
+  v[StatLog::ENERGY] = 50 + static_cast<int32_t>(m / 7 % 40);
+  v[StatLog::CLEANLINESS] = 100 - static_cast<int32_t>(m / 11 % 100);
+  v[StatLog::LEVEL] = 1 + static_cast<int32_t>(m / 5000);
+  v[StatLog::XP] = static_cast<int32_t>(m % 5000 / 10);
+}
+
+int selftest(int argc, char** argv) {
+  uint32_t sectors = 64;
+  for (int i = 3; i + 1 < argc; i += 2) {
+    if (!strcmp(argv[i], "--sectors")) sectors = static_cast<uint32_t>(atoi(argv[i + 1]));
+  }
+  Image img;
+  if (!openImage(img, argv[2], sectors * StatLog::SECTOR_SIZE)) {
+    fprintf(stderr, "stat_log_host: cannot create %s\n", argv[2]);
+    return 1;
+  }
+  expect(StatLog::begin(flashOf(img)), "begin on an erased image");
+  expect(StatLog::newestTime() == 0, "empty log");
+
+  // 40 days of minute samples with an event every 97 minutes and a clean
+  // reboot every 5 days.
+  const uint32_t start = 1700000000 - 1700000000 % 86400;
+  const uint32_t minutes = 40 * 1440;
+  std::vector<Expected> all;
+  uint32_t samples = 0;
+  for (uint32_t m = 0; m < minutes; ++m) {
+    uint32_t t = start + m * 60;
+    Expected e;
+    e.time = t;
+    sampleAt(t, e.values);
+    expect(StatLog::appendSample(t, e.values), "appendSample");
+    all.push_back(e);
+    ++samples;
+    if (m % 97 == 0) expect(StatLog::appendEvent(t, StatLog::EventCode::CARE, static_cast<int32_t>(m)), "appendEvent");
+    if (m % (5 * 1440) == 5 * 1440 - 1) {
+      StatLog::end();
+      expect(StatLog::begin(flashOf(img)), "begin after a clean reboot");
+      expect(StatLog::newestTime() == t, "resumes at the newest record");
+    }
+  }
+
+  // The minute tier wrapped: everything it still holds must match.
+  Collect minute;
+  StatLog::query(StatLog::Tier::MINUTE, 0, 0xFFFFFFFF, collect, &minute);
+  size_t sampleCount = 0;
+  uint32_t oldest = 0;
+  size_t ai = 0;
+  bool match = true;
+  for (const StatLog::Record& r : minute.out) {
+    if (r.isEvent) continue;
+    if (!sampleCount) {
+      oldest = r.time;
+      while (ai < all.size() && all[ai].time < r.time) ++ai;
+    }
+    ++sampleCount;
+    if (ai >= all.size() || all[ai].time != r.time || memcmp(all[ai].values, r.values, sizeof(r.values))) match = false;
+    ++ai;
+  }
+  expect(match && ai == all.size(), "minute tier holds the newest samples unchanged");
+  printf("minute tier: %zu samples kept (%.1f days), %zu records total\n", sampleCount,
+         (StatLog::newestTime() - oldest) / 86400.0, minute.out.size());
+
+  // Range query: exactly the samples inside [from, to].
+  uint32_t from = oldest + (StatLog::newestTime() - oldest) / 3 + 17;
+  uint32_t to = from + (StatLog::newestTime() - oldest) / 4;
+  uint32_t readsBefore = img.reads;
+  Collect range;
+  StatLog::query(StatLog::Tier::MINUTE, from, to, collect, &range);
+  size_t inRange = 0;
+  bool bounds = true;
+  for (const StatLog::Record& r : range.out) {
+    bounds = bounds && r.time >= from && r.time <= to;
+    if (!r.isEvent) ++inRange;
+  }
+  expect(bounds, "range query stays inside [from, to]");
+  size_t wanted = 0;
+  for (const Expected& e : all) wanted += e.time >= from && e.time <= to;
+  expect(inRange == wanted, "range query returns every sample in range");
+  printf("range query: %zu records, %u flash reads (%u minute sectors)\n", range.out.size(), img.reads - readsBefore,
+         StatLog::usedSectors(StatLog::Tier::MINUTE));
+
+  // Hour tier: averages of the minute samples of each closed hour.
+  Collect hours;
+  StatLog::query(StatLog::Tier::HOUR, 0, 0xFFFFFFFF, collect, &hours);
+  bool avgOk = !hours.out.empty();
+  for (const StatLog::Record& r : hours.out) {
+    int64_t sum = 0;
+    uint32_t n = 0;
+    for (uint32_t t = r.time; t < r.time + 3600; t += 60) {
+      int32_t v[StatLog::FIELD_COUNT];
+      sampleAt(t, v);
+      sum += v[StatLog::HUNGER];
+      ++n;
+    }
+    if (r.values[StatLog::HUNGER] != sum / n) avgOk = false;
+  }
+  expect(avgOk, "hour averages");
+  expect(hours.out.size() == minutes / 60 - 1, "one record per closed hour, across reboots");
+  Collect days;
+  StatLog::query(StatLog::Tier::DAY, 0, 0xFFFFFFFF, collect, &days);
+  expect(days.out.size() == minutes / 1440 - 1, "one record per closed day, across reboots");
+  printf("hour tier: %zu records, day tier: %zu records\n", hours.out.size(), days.out.size());
+
+  // Power cut: appends after the last flush are lost, the log stays usable.
+  StatLog::flush();
+  uint32_t flushed = StatLog::newestTime();
+  int32_t v[StatLog::FIELD_COUNT];
+  sampleAt(flushed + 60, v);
+  StatLog::appendSample(flushed + 60, v);
+  expect(StatLog::begin(flashOf(img)), "begin after a power cut");
+  expect(StatLog::newestTime() == flushed, "unflushed page lost, flushed data kept");
+  sampleAt(flushed + 120, v);
+  expect(StatLog::appendSample(flushed + 120, v), "append after a power cut");
+  StatLog::end();
+  expect(StatLog::begin(flashOf(img)), "begin again");
+  expect(StatLog::newestTime() == flushed + 120, "append after a power cut persisted");
+  StatLog::end();
+
+  expect(!img.violation, "no byte programmed twice");
+  printf("flash: %u page writes, %u sector erases for %u samples\n", img.writes, img.erases, samples);
+  fclose(img.f);
+  printf(failures ? "selftest FAILED (%d)\n" : "selftest ok\n", failures);
+  return failures ? 1 : 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc >= 3 && !strcmp(argv[1], "selftest")) return selftest(argc, argv);
+  if (argc >= 3 && !strcmp(argv[1], "dump")) return dump(argc, argv);
+  fprintf(stderr, "usage: %s selftest IMAGE [--sectors N] | dump IMAGE [--tier minute|hour|day] [--from T] [--to T]\n",
+          argv[0]);
+  return 2;
+}
@@ -0,0 +1,184 @@
+// Host equivalence test for SubStateSystem::update() (src/sub_state_system.cpp):
+// the cached path against evaluating every rule on every call, over long
+// random timelines.
+//
+//   g++ -O2 -g -std=gnu++11 -fsanitize=address,undefined -Isrc -Iinclude
+//       -Ilib/bubu_native/include tools/sub_state_test/main.cpp -o sub_state_test
+//   ./sub_state_test [--timelines N] [--steps N] [--seed S]
+//
+// sub_state_system.cpp is included twice: Cached:: runs update() and Ref::
+// runs evaluate() on every step, as update() did before it cached. Care
+// stats, level and millis() are stand-ins the timeline drives. Each
+// timeline mixes stat changes (bumping CareSystem::version() only when a
+// value moves, as care_system.cpp does), level changes, short and long
+// gaps, and jumps to a pending sustained-low deadline and to 1 ms before
+// it. Timelines start at 0 and just before the millis() wrap.
+// Every step compares the two snapshots and the sub-state bits sent to the
+// flight recorder. Exits non-zero on the first difference.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bubu_clock.h"
+#include "care_system.h"
+#include "flight_recorder.h"
+#include "level_system.h"
+#include "sub_state_system.h"
+
+// ---- stand-ins ----
+
+namespace {
+uint32_t clockMs = 0;
+int stats[4] = {100, 100, 100, 100};  // hunger, energy, mood, cleanliness
+uint32_t careVersion = 0;
+int level = 1;
+}  // namespace
+
+uint32_t millis() {
+  return clockMs;
+}
+
+namespace CareSystem {
+int getHunger() { return stats[0]; }
+int getEnergy() { return stats[1]; }
+int getMood() { return stats[2]; }
+int getCleanliness() { return stats[3]; }
+uint32_t version() { return careVersion; }
+}  // namespace CareSystem
+
+namespace LevelSystem {
+int getLevel() { return level; }
+bool isUnlocked(FeatureID feature) {
+  return static_cast<int>(feature) < 2 * level;  // 1-5: from few to all features
+}
+}  // namespace LevelSystem
+
+namespace FlightRecorder {
+void record(Event, uint8_t, uint16_t, uint32_t) {}
+}  // namespace FlightRecorder
+
+// ---- the two versions ----
+
+// Each copy in its own namespace: then neither evaluate() lives in
+// ::SubStateSystem, where argument-dependent lookup would find it too.
+namespace Cached {
+namespace SubStateSystem {
+using ::SubStateSystem::Snapshot;
+}
+#include "sub_state_system.cpp"
+}  // namespace Cached
+
+namespace Ref {
+namespace SubStateSystem {
+using ::SubStateSystem::Snapshot;
+}
+#include "sub_state_system.cpp"
+}  // namespace Ref
+
+namespace {
+
+uint64_t rngState = 0x9e3779b97f4a7c15ull;
+
+uint32_t rnd() {
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 7;
+  rngState ^= rngState << 17;
+  return static_cast<uint32_t>(rngState >> 32);
+}
+
+bool same(const SubStateSystem::Snapshot& a, const SubStateSystem::Snapshot& b) {
+  if (a.sub_irritable != b.sub_irritable || a.sub_sluggish != b.sub_sluggish ||
+      a.sub_withdrawn != b.sub_withdrawn || a.sub_uncomfortable != b.sub_uncomfortable ||
+      a.sub_depressed != b.sub_depressed || a.allowAllPositive != b.allowAllPositive ||
+      a.forceCount != b.forceCount || a.suppressSpeedSlow != b.suppressSpeedSlow ||
+      a.suppressSpeedNormal != b.suppressSpeedNormal || a.suppressSpeedFast != b.suppressSpeedFast) {
+    return false;
+  }
+  for (uint8_t i = 0; i < a.forceCount; ++i) {
+    if (a.forced[i] != b.forced[i]) return false;
+  }
+  return memcmp(a.suppress, b.suppress, sizeof(a.suppress)) == 0;
+}
+
+// Stat values cluster around the thresholds the rules test.
+int pickStat() {
+  static const int interesting[] = {0, 24, 25, 29, 30, 31, 50, 51, 79, 80, 100};
+  return rnd() % 3 ? static_cast<int>(interesting[rnd() % 11]) : static_cast<int>(rnd() % 101);
+}
+
+void setStat(int i, int v) {
+  if (stats[i] == v) return;
+  stats[i] = v;
+  ++careVersion;
+}
+
+uint32_t gap() {
+  switch (rnd() % 8) {
+    case 0: return 0;
+    case 1: return 1 + rnd() % 50;                  // frame-rate calls
+    case 2: return 19000 + rnd() % 2000;           // around the 20 s activation
+    case 3: return 59000 + rnd() % 2000;           // around the 60 s depression
+    case 4: return rnd() % 200000;
+    default: return 1 + rnd() % 2000;
+  }
+}
+
+bool runTimeline(uint32_t index, uint32_t steps) {
+  clockMs = index % 2 ? 0xFFFFFFFFu - rnd() % 200000 : (index % 4 == 0 ? 0 : rnd() % 100000);
+  for (int& s : stats) s = pickStat();
+  level = 1 + rnd() % 5;
+  Cached::SubStateSystem::begin();
+  Ref::SubStateSystem::begin();
+  SubStateSystem::Snapshot got, want;
+  for (uint32_t step = 0; step < steps; ++step) {
+    uint32_t r = rnd() % 100;
+    if (r < 20) {
+      setStat(rnd() % 4, pickStat());
+    } else if (r < 22) {
+      level = 1 + rnd() % 5;
+    } else if (r < 30 && Cached::SubStateSystem::deadlinePending) {
+      // To the cached path's pending deadline, or 1 ms short of it.
+      uint32_t at = Cached::SubStateSystem::evaluatedMs + Cached::SubStateSystem::deadlineWaitMs;
+      clockMs = at - (rnd() % 2);
+    } else {
+      clockMs += gap();
+    }
+    Cached::SubStateSystem::update(got);
+    Ref::SubStateSystem::evaluate(clockMs, want);
+    if (!same(got, want) || Cached::SubStateSystem::recordedBits != Ref::SubStateSystem::recordedBits) {
+      fprintf(stderr,
+              "FAIL: timeline %u step %u at %lu ms: stats %d/%d/%d/%d level %d\n"
+              "  cached: %d%d%d%d%d force %u bits %02x\n  every call: %d%d%d%d%d force %u bits %02x\n",
+              index, step, static_cast<unsigned long>(clockMs), stats[0], stats[1], stats[2], stats[3], level,
+              got.sub_irritable, got.sub_sluggish, got.sub_withdrawn, got.sub_uncomfortable,
+              got.sub_depressed, got.forceCount, Cached::SubStateSystem::recordedBits, want.sub_irritable,
+              want.sub_sluggish, want.sub_withdrawn, want.sub_uncomfortable, want.sub_depressed,
+              want.forceCount, Ref::SubStateSystem::recordedBits);
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  uint32_t timelines = 200;
+  uint32_t steps = 200000;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--timelines") && i + 1 < argc) {
+      timelines = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+    } else if (!strcmp(argv[i], "--steps") && i + 1 < argc) {
+      steps = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+    } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+      rngState = strtoull(argv[++i], nullptr, 0) * 2 + 1;
+    } else {
+      fprintf(stderr, "usage: %s [--timelines N] [--steps N] [--seed S]\n", argv[0]);
+      return 2;
+    }
+  }
+  for (uint32_t t = 0; t < timelines; ++t) {
+    if (!runTimeline(t, steps)) return 1;
+  }
+  printf("sub-states: %u timelines x %u updates, cached == every-call evaluation\n", timelines, steps);
+  return 0;
+}
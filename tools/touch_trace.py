@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""Touch traces (include/touch_trace.h): capture from a device, inspect.
+
+  touch_trace.py extract capture.log -o session.btr [--lead-ms 2000]
+      joins the "btr" lines a -DBUBU_TOUCH_RECORD build prints into one
+      trace; the idle time before the first touch is cut to --lead-ms
+  touch_trace.py dump session.btr
+      prints one sample per line: time, fingers, x, y, hardware gesture
+
+Replay a trace on the host with the touch_bench env:
+  .pio/build/touch_bench/program -- --trace session.btr
+"""
+import argparse
+import re
+import struct
+import sys
+
+MAGIC = b"BTR"
+VERSION = 1
+RECORD = struct.Struct("<HBBB")
+GAP_FINGERS = 0x0F
+LINE = re.compile(r"\bbtr ([0-9a-f]+)\s*$")
+
+
+def decode(records):
+    """Yields (t_ms, x, y, fingers, gesture) from packed records."""
+    t = 0
+    for off in range(0, len(records) - RECORD.size + 1, RECORD.size):
+        dt, x, y, packed = RECORD.unpack_from(records, off)
+        t += dt
+        if packed & 0x0F == GAP_FINGERS:
+            continue
+        yield t, x, y, packed & 0x0F, packed >> 4
+
+
+def encode(samples):
+    out = bytearray()
+    last = 0
+    count = 0
+    for t, x, y, fingers, gesture in samples:
+        dt = t - last
+        while dt > 0xFFFF:
+            out += RECORD.pack(0xFFFF, 0, 0, GAP_FINGERS)
+            dt -= 0xFFFF
+            count += 1
+        out += RECORD.pack(dt, x, y, (gesture << 4) | fingers)
+        last = t
+        count += 1
+    return MAGIC + bytes([VERSION]) + struct.pack("<I", count) + bytes(out)
+
+
+def read_trace(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) < 8 or data[:3] != MAGIC or data[3] != VERSION:
+        sys.exit("%s: not a touch trace" % path)
+    (count,) = struct.unpack_from("<I", data, 4)
+    records = data[8:8 + count * RECORD.size]
+    if len(records) != count * RECORD.size:
+        sys.exit("%s: cut short" % path)
+    return list(decode(records))
+
+
+def extract(args):
+    records = bytearray()
+    with open(args.capture, "r", errors="replace") as f:
+        for line in f:
+            m = LINE.search(line)
+            if m and len(m.group(1)) % (2 * RECORD.size) == 0:
+                records += bytes.fromhex(m.group(1))
+    samples = list(decode(records))
+    if not samples:
+        sys.exit("%s: no btr lines" % args.capture)
+    first_touch = next((s[0] for s in samples if s[3] > 0), samples[0][0])
+    shift = max(0, first_touch - args.lead_ms)
+    samples = [(t - shift, x, y, n, g) for t, x, y, n, g in samples if t >= shift]
+    with open(args.output, "wb") as f:
+        f.write(encode(samples))
+    touches = sum(1 for s in samples if s[3] > 0)
+    print("%s: %d samples (%d touching), %.1f s" % (args.output, len(samples), touches, samples[-1][0] / 1000.0))
+
+
+def dump(args):
+    for t, x, y, fingers, gesture in read_trace(args.trace):
+        print("%8d  %d  %3d %3d  0x%02X" % (t, fingers, x, y, gesture))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = ap.add_subparsers(dest="cmd")
+    ex = sub.add_parser("extract")
+    ex.add_argument("capture")
+    ex.add_argument("-o", "--output", required=True)
+    ex.add_argument("--lead-ms", type=int, default=2000)
+    du = sub.add_parser("dump")
+    du.add_argument("trace")
+    args = ap.parse_args()
+    if args.cmd == "extract":
+        extract(args)
+    elif args.cmd == "dump":
+        dump(args)
+    else:
+        ap.print_help()
+        return 2
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())